@@ -0,0 +1,63 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "GameTuning.h"
+#include "RenderSnapshot.h"
+#include "Simulation.h"
+#include "StressMode.h"
+
+//Stress mode without a window, a device or sound, for machines that cannot run the game. The ramp, the autopilot and
+//the render build are the game's own, only the sprites are built and dropped instead of drawn. They are built for
+//every entity and particle alive rather than into a capped snapshot, so the render build keeps growing with the load.
+//Masks are not loaded, so bounding boxes decide every collision. The autopilot's input goes through the latency
+//tracker like the game's, with the end of the sprite build standing in for Present.
+//  SpaceshipStress [budget ms] [-levels count] [-ticks ticksPerLevel] [-tuning file]
+
+const char* tuningFileName = "Assets/tuning.cfg";
+const char* latencyFileName = "stress_latency.csv";
+EntitySprites* sprites = new EntitySprites();
+LatencyTracker* latencyTracker = new LatencyTracker();
+
+void buildSprites() {
+	buildAllEntitySprites(*sprites);
+	latencyTracker->framePresented(gameTick);
+}
+
+int main(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (argument == "-levels" && i + 1 < argc) {
+			stressMaxLevels = atoi(argv[++i]);
+		}
+		else if (argument == "-ticks" && i + 1 < argc) {
+			stressTicksPerLevel = atoi(argv[++i]);
+		}
+		else if (argument == "-tuning" && i + 1 < argc) {
+			tuningFileName = argv[++i];
+		}
+		else {
+			stressBudgetMs = (float)atof(argv[i]);
+		}
+	}
+	TuningFile tuningFile;
+	if (!tuningFile.loadFromFile(tuningFileName, tuning)) {
+		std::cout << "Tuning not applied, " << tuningFile.getError() << std::endl;
+	}
+	//every run gets the same asteroids so runs can be compared, with the game's -stress too
+	seedSimulation(1);
+	particleSystem->init(maxParticles);
+	asteroidSolver->reserve(asteroidSolverBodies, asteroidSolverContacts, asteroidSolverCells);
+	jobSystem->init(0);
+	stressLatencyTracker = latencyTracker;
+	StressCallbacks callbacks = { buildSprites };
+	runStressTest(callbacks);
+	jobSystem->shutdown();
+	char latencyText[256];
+	latencyTracker->formatOverlay(latencyText, sizeof(latencyText));
+	std::cout << latencyText << std::endl;
+	if (latencyTracker->exportToFile(latencyFileName)) {
+		std::cout << "Input latency exported to " << latencyFileName << std::endl;
+	}
+	return 0;
+}
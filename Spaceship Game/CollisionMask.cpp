@@ -0,0 +1,139 @@
+#include "CollisionMask.h"
+#include <cmath>
+
+static const float twoPi = 6.2831853f;
+
+void CollisionMask::build(const unsigned char* alpha, int alphaPitch, int left, int top, int width, int height,
+	float scale, float rotation, float centerX, float centerY, unsigned char alphaThreshold)
+{
+	float cosine = cosf(rotation);
+	float sine = sinf(rotation);
+
+	//Bounding box of the transformed frame, pixel p lands on center + rotate((p - center) * scale)
+	float cornersX[4] = { 0, (float)width, 0, (float)width };
+	float cornersY[4] = { 0, 0, (float)height, (float)height };
+	float minX = 1e9f, minY = 1e9f, maxX = -1e9f, maxY = -1e9f;
+	for (int i = 0; i < 4; i++) {
+		float localX = (cornersX[i] - centerX) * scale;
+		float localY = (cornersY[i] - centerY) * scale;
+		float worldX = centerX + localX * cosine - localY * sine;
+		float worldY = centerY + localX * sine + localY * cosine;
+		minX = fminf(minX, worldX);
+		minY = fminf(minY, worldY);
+		maxX = fmaxf(maxX, worldX);
+		maxY = fmaxf(maxY, worldY);
+	}
+	offsetX = (int)floorf(minX);
+	offsetY = (int)floorf(minY);
+	this->width = (int)ceilf(maxX) - offsetX;
+	this->height = (int)ceilf(maxY) - offsetY;
+	wordsPerRow = (this->width + 63) / 64;
+	rows.assign(wordsPerRow * this->height, 0);
+
+	//Every mask pixel samples the frame pixel it came from
+	for (int y = 0; y < this->height; y++) {
+		for (int x = 0; x < this->width; x++) {
+			float worldX = offsetX + x + 0.5f - centerX;
+			float worldY = offsetY + y + 0.5f - centerY;
+			float sourceX = centerX + (worldX * cosine + worldY * sine) / scale;
+			float sourceY = centerY + (-worldX * sine + worldY * cosine) / scale;
+			int pixelX = (int)floorf(sourceX);
+			int pixelY = (int)floorf(sourceY);
+			if (pixelX < 0 || pixelY < 0 || pixelX >= width || pixelY >= height) {
+				continue;
+			}
+			if (alpha[(top + pixelY) * alphaPitch + left + pixelX] > alphaThreshold) {
+				rows[y * wordsPerRow + x / 64] |= uint64_t(1) << (x % 64);
+			}
+		}
+	}
+}
+
+int CollisionMask::getOffsetX() const
+{
+	return offsetX;
+}
+
+int CollisionMask::getOffsetY() const
+{
+	return offsetY;
+}
+
+int CollisionMask::getWidth() const
+{
+	return width;
+}
+
+int CollisionMask::getHeight() const
+{
+	return height;
+}
+
+bool CollisionMask::getPixel(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= width || y >= height) {
+		return false;
+	}
+	return (rows[y * wordsPerRow + x / 64] >> (x % 64)) & 1;
+}
+
+uint64_t CollisionMask::getBits(int y, int x) const
+{
+	const uint64_t* row = &rows[y * wordsPerRow];
+	int word = x / 64;
+	int shift = x % 64;
+	uint64_t bits = row[word] >> shift;
+	if (shift != 0 && word + 1 < wordsPerRow) {
+		bits |= row[word + 1] << (64 - shift);
+	}
+	return bits;
+}
+
+bool CollisionMask::overlaps(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by)
+{
+	int left = ax > bx ? ax : bx;
+	int top = ay > by ? ay : by;
+	int right = ax + a.width < bx + b.width ? ax + a.width : bx + b.width;
+	int bottom = ay + a.height < by + b.height ? ay + a.height : by + b.height;
+	if (left >= right || top >= bottom) {
+		return false;
+	}
+	for (int y = top; y < bottom; y++) {
+		for (int x = left; x < right; x += 64) {
+			uint64_t bits = a.getBits(y - ay, x - ax) & b.getBits(y - by, x - bx);
+			if (right - x < 64) {
+				bits &= (uint64_t(1) << (right - x)) - 1;
+			}
+			if (bits != 0) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void CollisionMaskSet::build(const unsigned char* alpha, int alphaPitch, int left, int top, int width, int height,
+	const float* scales, int scaleCount, int rotationBuckets, float centerX, float centerY, unsigned char alphaThreshold)
+{
+	this->rotationBuckets = rotationBuckets;
+	masks.resize(scaleCount * rotationBuckets);
+	for (int scale = 0; scale < scaleCount; scale++) {
+		for (int bucket = 0; bucket < rotationBuckets; bucket++) {
+			masks[scale * rotationBuckets + bucket].build(alpha, alphaPitch, left, top, width, height,
+				scales[scale], bucket * twoPi / rotationBuckets, centerX, centerY, alphaThreshold);
+		}
+	}
+}
+
+const CollisionMask& CollisionMaskSet::get(int scaleIndex, float rotation) const
+{
+	float turns = rotation / twoPi;
+	turns -= floorf(turns);
+	int bucket = (int)(turns * rotationBuckets + 0.5f) % rotationBuckets;
+	return masks[scaleIndex * rotationBuckets + bucket];
+}
+
+bool CollisionMaskSet::isEmpty() const
+{
+	return masks.empty();
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//1 bit per pixel collision shape of a transformed sprite, each row is packed into 64 bit words.
+//Built from the sprite's alpha with the same scaling and rotation the sprite is drawn with.
+class CollisionMask
+{
+public:
+	//alpha is the whole image (alphaPitch bytes per row), left/top/width/height select the sprite's frame.
+	//Scaling and rotation are around (centerX, centerY) in frame pixels, like D3DXMatrixTransformation2D.
+	void build(const unsigned char* alpha, int alphaPitch, int left, int top, int width, int height,
+		float scale, float rotation, float centerX, float centerY, unsigned char alphaThreshold);
+
+	//The mask's top left corner relative to the sprite's translation
+	int getOffsetX() const;
+	int getOffsetY() const;
+	int getWidth() const;
+	int getHeight() const;
+	bool getPixel(int x, int y) const;
+
+	//a and b are placed with their top left corners at (ax, ay) and (bx, by)
+	static bool overlaps(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by);
+
+private:
+	uint64_t getBits(int y, int x) const; //64 pixels of a row starting at x, zeros past the end
+
+	int offsetX = 0;
+	int offsetY = 0;
+	int width = 0;
+	int height = 0;
+	int wordsPerRow = 0;
+	std::vector<uint64_t> rows;
+};
+
+//Masks of one sprite frame for a few scales and evenly spaced rotation buckets
+class CollisionMaskSet
+{
+public:
+	void build(const unsigned char* alpha, int alphaPitch, int left, int top, int width, int height,
+		const float* scales, int scaleCount, int rotationBuckets, float centerX, float centerY, unsigned char alphaThreshold);
+	const CollisionMask& get(int scaleIndex, float rotation) const;
+	bool isEmpty() const;
+
+private:
+	int rotationBuckets = 0;
+	std::vector<CollisionMask> masks;
+};
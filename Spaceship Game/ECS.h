@@ -0,0 +1,578 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "SlotMap.h"
+#include "StateBuffer.h"
+
+//Archetype based entity component system.
+//Entities with the same set of components share an archetype that stores each component in its own packed array,
+//so systems walk dense memory instead of hopping between objects.
+
+//Generational entity id, an id whose generation no longer matches belongs to an entity that was destroyed
+typedef SlotHandle Entity;
+
+typedef uint64_t ComponentMask;
+
+//Gives every component type a small id the first time it is used (at most 64 types) and remembers its size,
+//so loading can check saved columns against the components this build has
+class ComponentRegistry
+{
+public:
+	static const int maxTypes = 64;
+
+	template <typename T>
+	static int id() {
+		static int typeId = registerType(sizeof(T));
+		return typeId;
+	}
+	template <typename T>
+	static ComponentMask mask() {
+		return ComponentMask(1) << id<T>();
+	}
+	//0 for ids no component has been given yet
+	static int getSize(int typeId) {
+		return typeId >= 0 && typeId < maxTypes ? sizes()[typeId].load() : 0;
+	}
+
+private:
+	static int registerType(int size) {
+		static std::atomic<int> nextId(0);
+		int typeId = nextId.fetch_add(1);
+		sizes()[typeId].store(size);
+		return typeId;
+	}
+	static std::atomic<int>* sizes() {
+		static std::atomic<int> typeSizes[maxTypes];
+		return typeSizes;
+	}
+};
+
+class Archetype
+{
+public:
+	static const int maxComponentTypes = ComponentRegistry::maxTypes;
+
+	Archetype(ComponentMask mask, int index) : mask(mask), index(index) {
+		for (int i = 0; i < maxComponentTypes; i++) {
+			columnIndex[i] = -1;
+		}
+	}
+
+	ComponentMask getMask() {
+		return mask;
+	}
+	int size() {
+		return (int)entities.size();
+	}
+	Entity getEntity(int row) {
+		return entities[row];
+	}
+	//Pointer to the packed array of one component, only valid until the next entity is created or destroyed
+	template <typename T>
+	T* getColumn() {
+		return (T*)columns[columnIndex[ComponentRegistry::id<T>()]].data.data();
+	}
+
+private:
+	friend class World;
+
+	struct Column {
+		int elementSize;
+		std::vector<unsigned char> data;
+	};
+
+	template <typename T>
+	void addColumn() {
+		addColumn(ComponentRegistry::id<T>(), sizeof(T));
+	}
+	void addColumn(int componentId, int elementSize) {
+		columnIndex[componentId] = (int)columns.size();
+		Column column;
+		column.elementSize = elementSize;
+		columns.push_back(column);
+		loadedColumns.push_back(column);
+	}
+	//Columns for every component in the mask, false if one of them is not a component of this build
+	bool addColumns() {
+		for (int id = 0; id < maxComponentTypes; id++) {
+			if ((mask & (ComponentMask(1) << id)) != 0) {
+				if (ComponentRegistry::getSize(id) == 0) {
+					return false;
+				}
+				addColumn(id, ComponentRegistry::getSize(id));
+			}
+		}
+		return true;
+	}
+	template <typename T>
+	void pushComponent(const T& component) {
+		Column& column = columns[columnIndex[ComponentRegistry::id<T>()]];
+		size_t offset = column.data.size();
+		column.data.resize(offset + sizeof(T));
+		memcpy(&column.data[offset], &component, sizeof(T));
+	}
+	//Swap-removes a row, returns the entity that was moved into it (only meaningful if it was not the last row)
+	Entity removeRow(int row) {
+		int lastRow = size() - 1;
+		for (int i = 0; i < (int)columns.size(); i++) {
+			Column& column = columns[i];
+			if (row != lastRow) {
+				memcpy(&column.data[row * column.elementSize], &column.data[lastRow * column.elementSize], column.elementSize);
+			}
+			column.data.resize(lastRow * column.elementSize);
+		}
+		entities[row] = entities[lastRow];
+		entities.pop_back();
+		return row < lastRow ? entities[row] : Entity();
+	}
+	//Every column is written as one block together with its component id, the mask is written by the World
+	void save(StateWriter& writer) {
+		writer.write((int)columns.size());
+		for (int id = 0; id < maxComponentTypes; id++) {
+			if (columnIndex[id] >= 0) {
+				Column& column = columns[columnIndex[id]];
+				writer.write(id);
+				writer.write(column.elementSize);
+				writer.writeArray(column.data.data(), (int)column.data.size());
+			}
+		}
+		writer.writeArray(entities.data(), (int)entities.size());
+	}
+	//Reads the rows into the loaded buffers, the live rows are untouched until swapLoaded().
+	//Every saved column must be one of this archetype's, saved once, with the size the component has in this build.
+	bool load(StateReader& reader) {
+		int columnCount;
+		if (!reader.read(columnCount) || columnCount != (int)columns.size()) {
+			return false;
+		}
+		ComponentMask loadedMask = 0;
+		for (int i = 0; i < columnCount; i++) {
+			int id;
+			int elementSize;
+			if (!reader.read(id) || !reader.read(elementSize) || id < 0 || id >= maxComponentTypes || columnIndex[id] < 0) {
+				return false;
+			}
+			if ((loadedMask & (ComponentMask(1) << id)) != 0 || columns[columnIndex[id]].elementSize != elementSize) {
+				return false;
+			}
+			loadedMask |= ComponentMask(1) << id;
+			if (!reader.readArray(loadedColumns[columnIndex[id]].data)) {
+				return false;
+			}
+		}
+		if (!reader.readArray(loadedEntities)) {
+			return false;
+		}
+		for (int i = 0; i < (int)loadedColumns.size(); i++) {
+			if (loadedColumns[i].data.size() != loadedEntities.size() * loadedColumns[i].elementSize) {
+				return false;
+			}
+		}
+		return true;
+	}
+	void clearLoaded() {
+		for (int i = 0; i < (int)loadedColumns.size(); i++) {
+			loadedColumns[i].data.clear();
+		}
+		loadedEntities.clear();
+	}
+	//Swapping keeps the memory of both sides, so the next load does not allocate, and swapping again undoes it
+	void swapLoaded() {
+		for (int i = 0; i < (int)columns.size(); i++) {
+			std::swap(columns[i].data, loadedColumns[i].data);
+		}
+		std::swap(entities, loadedEntities);
+	}
+	void clearRows() {
+		for (int i = 0; i < (int)columns.size(); i++) {
+			columns[i].data.clear();
+		}
+		entities.clear();
+	}
+
+	ComponentMask mask;
+	int index; //position in the World, entity records refer to archetypes by it
+	int columnIndex[maxComponentTypes];
+	std::vector<Column> columns;
+	std::vector<Entity> entities;
+	std::vector<Column> loadedColumns; //filled by load(), same layout as columns
+	std::vector<Entity> loadedEntities;
+};
+
+class World
+{
+public:
+	//Components must be plain data, they are moved around with memcpy
+	template <typename... Components>
+	Entity create(const Components&... components) {
+		ComponentMask mask = 0;
+		int maskParts[] = { 0, (mask |= ComponentRegistry::mask<Components>(), 0)... };
+		(void)maskParts;
+		Archetype* archetype = findArchetype(mask);
+		if (archetype == NULL) {
+			archetype = new Archetype(mask, (int)archetypes.size());
+			int columnParts[] = { 0, (archetype->addColumn<Components>(), 0)... };
+			(void)columnParts;
+			archetypes.push_back(std::unique_ptr<Archetype>(archetype));
+		}
+		int componentParts[] = { 0, (checkComponent<Components>(), archetype->pushComponent(components), 0)... };
+		(void)componentParts;
+
+		Entity entity = records.insert(EntityRecord{ archetype->index, archetype->size() });
+		archetype->entities.push_back(entity);
+		return entity;
+	}
+
+	void destroy(Entity entity) {
+		EntityRecord* record = records.get(entity);
+		if (record == NULL) {
+			return;
+		}
+		Archetype* archetype = archetypes[record->archetype].get();
+		int row = record->row;
+		bool movedLast = row != archetype->size() - 1;
+		Entity moved = archetype->removeRow(row);
+		if (movedLast) {
+			records.get(moved)->row = row;
+		}
+		records.erase(entity);
+	}
+
+	bool isAlive(Entity entity) {
+		return records.contains(entity);
+	}
+
+	//NULL if the entity is gone or does not have the component
+	template <typename T>
+	T* get(Entity entity) {
+		EntityRecord* record = records.get(entity);
+		if (record == NULL) {
+			return NULL;
+		}
+		Archetype& archetype = *archetypes[record->archetype];
+		if ((archetype.getMask() & ComponentRegistry::mask<T>()) == 0) {
+			return NULL;
+		}
+		return &archetype.getColumn<T>()[record->row];
+	}
+
+	//Destroys every entity but keeps the archetypes (and their memory) for reuse
+	void clear() {
+		for (int i = 0; i < (int)archetypes.size(); i++) {
+			archetypes[i]->clearRows();
+		}
+		records.clear();
+	}
+
+	//clear() that also numbers entities from the start again, a new game is then the same whatever came before.
+	//No entity handle may be kept across it.
+	void reset() {
+		for (int i = 0; i < (int)archetypes.size(); i++) {
+			archetypes[i]->clearRows();
+		}
+		records.reset();
+	}
+
+	//Writes the archetypes that have entities, ordered by mask, and the entity records, entity ids are the same after a load.
+	//The same entities always give the same bytes whatever archetypes this world made before (load matches them by mask).
+	void save(StateWriter& writer) {
+		savedArchetypes.clear();
+		for (int i = 0; i < (int)archetypes.size(); i++) {
+			if (archetypes[i]->size() > 0) {
+				savedArchetypes.push_back(i);
+			}
+		}
+		std::sort(savedArchetypes.begin(), savedArchetypes.end(), [this](int a, int b) {
+			return archetypes[a]->getMask() < archetypes[b]->getMask();
+		});
+		savedIndex.resize(archetypes.size());
+		writer.write((int)savedArchetypes.size());
+		for (int i = 0; i < (int)savedArchetypes.size(); i++) {
+			Archetype& archetype = *archetypes[savedArchetypes[i]];
+			savedIndex[archetype.index] = i;
+			writer.write(archetype.getMask());
+			archetype.save(writer);
+		}
+		//the records refer to archetypes by their saved position while they are written
+		for (int i = 0; i < records.size(); i++) {
+			records.at(i).archetype = savedIndex[records.at(i).archetype];
+		}
+		records.save(writer);
+		for (int i = 0; i < records.size(); i++) {
+			records.at(i).archetype = savedArchetypes[records.at(i).archetype];
+		}
+	}
+	//Replaces every entity with the saved ones. Returns false and leaves the world as it was if the data is bad.
+	bool load(StateReader& reader) {
+		if (!decode(reader)) {
+			return false;
+		}
+		swapDecoded();
+		return true;
+	}
+	//The two halves of load(), for callers that check more of the state before using it:
+	//decode() reads and checks the saved entities into buffers of their own, the world itself is not touched,
+	//checkDecoded() looks at their components, and swapDecoded() swaps them in.
+	//Archetypes are matched by mask, missing ones are added by swapDecoded(). They are never removed so queries stay valid.
+	bool decode(StateReader& reader) {
+		decodedArchetypes.clear();
+		if (!decodeEntities(reader)) {
+			return false;
+		}
+		//archetypes created after the save are not in the data, they end up empty
+		for (int i = 0; i < (int)archetypes.size(); i++) {
+			if (std::find(loadedArchetypes.begin(), loadedArchetypes.end(), i) == loadedArchetypes.end()) {
+				archetypes[i]->clearLoaded();
+			}
+		}
+		return true;
+	}
+	//function(const T&) for every decoded T until it returns false, true if it never did
+	template <typename T, typename Function>
+	bool checkDecoded(Function function) {
+		int id = ComponentRegistry::id<T>();
+		for (int i = 0; i < (int)(archetypes.size() + decodedArchetypes.size()); i++) {
+			Archetype& archetype = getDecodedArchetype(i);
+			if ((archetype.getMask() & ComponentRegistry::mask<T>()) == 0) {
+				continue;
+			}
+			const T* column = (const T*)archetype.loadedColumns[archetype.columnIndex[id]].data.data();
+			for (int row = 0; row < (int)archetype.loadedEntities.size(); row++) {
+				if (!function(column[row])) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	void swapDecoded() {
+		for (int i = 0; i < (int)decodedArchetypes.size(); i++) {
+			archetypes.push_back(std::move(decodedArchetypes[i]));
+		}
+		decodedArchetypes.clear();
+		for (int i = 0; i < (int)archetypes.size(); i++) {
+			archetypes[i]->swapLoaded();
+		}
+		std::swap(records, loadedRecords);
+	}
+
+	int getEntityCount() {
+		return records.size();
+	}
+	int getArchetypeCount() {
+		return (int)archetypes.size();
+	}
+	Archetype& getArchetype(int index) {
+		return *archetypes[index];
+	}
+
+private:
+	struct EntityRecord {
+		int archetype;
+		int row;
+	};
+
+	bool decodeEntities(StateReader& reader) {
+		int savedCount;
+		if (!reader.read(savedCount) || savedCount < 0 || savedCount > (1 << 16)) {
+			return false;
+		}
+		//saved archetype index to the index in this world, they only differ if archetypes were created in another order
+		loadedArchetypes.resize(savedCount);
+		bool sameOrder = true;
+		int rowCount = 0;
+		for (int i = 0; i < savedCount; i++) {
+			ComponentMask mask;
+			if (!reader.read(mask) || mask == 0) {
+				return false;
+			}
+			Archetype* archetype = findDecodedArchetype(mask);
+			if (archetype == NULL) {
+				std::unique_ptr<Archetype> created(new Archetype(mask, (int)(archetypes.size() + decodedArchetypes.size())));
+				if (!created->addColumns()) {
+					return false;
+				}
+				archetype = created.get();
+				decodedArchetypes.push_back(std::move(created));
+			}
+			//a mask saved twice would load over its own rows
+			if (std::find(loadedArchetypes.begin(), loadedArchetypes.begin() + i, archetype->index) != loadedArchetypes.begin() + i) {
+				return false;
+			}
+			if (!archetype->load(reader)) {
+				return false;
+			}
+			loadedArchetypes[i] = archetype->index;
+			sameOrder = sameOrder && archetype->index == i;
+			rowCount += (int)archetype->loadedEntities.size();
+		}
+		if (!loadedRecords.load(reader) || loadedRecords.size() != rowCount) {
+			return false;
+		}
+		//trusted data was consistent when it was saved, only the archetype indices of the records may need fixing
+		if (reader.isTrusted()) {
+			for (int i = 0; !sameOrder && i < loadedRecords.size(); i++) {
+				EntityRecord& record = loadedRecords.at(i);
+				record.archetype = loadedArchetypes[record.archetype];
+			}
+		}
+		else {
+			for (int i = 0; i < loadedRecords.size(); i++) {
+				EntityRecord& record = loadedRecords.at(i);
+				if (record.archetype < 0 || record.archetype >= savedCount) {
+					return false;
+				}
+				record.archetype = loadedArchetypes[record.archetype];
+				std::vector<Entity>& entities = getDecodedArchetype(record.archetype).loadedEntities;
+				Entity handle = loadedRecords.getHandle(i);
+				if (record.row < 0 || record.row >= (int)entities.size() || entities[record.row].index != handle.index || entities[record.row].generation != handle.generation) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	template <typename T>
+	static void checkComponent() {
+		static_assert(std::is_trivially_copyable<T>::value, "components must be trivially copyable");
+	}
+
+	Archetype* findArchetype(ComponentMask mask) {
+		for (int i = 0; i < (int)archetypes.size(); i++) {
+			if (archetypes[i]->getMask() == mask) {
+				return archetypes[i].get();
+			}
+		}
+		return NULL;
+	}
+	//While decoding, the archetypes the data adds come after the world's own
+	Archetype* findDecodedArchetype(ComponentMask mask) {
+		Archetype* archetype = findArchetype(mask);
+		for (int i = 0; archetype == NULL && i < (int)decodedArchetypes.size(); i++) {
+			if (decodedArchetypes[i]->getMask() == mask) {
+				archetype = decodedArchetypes[i].get();
+			}
+		}
+		return archetype;
+	}
+	Archetype& getDecodedArchetype(int index) {
+		return index < (int)archetypes.size() ? *archetypes[index] : *decodedArchetypes[index - archetypes.size()];
+	}
+
+	std::vector<std::unique_ptr<Archetype>> archetypes;
+	std::vector<std::unique_ptr<Archetype>> decodedArchetypes; //in the decoded data but not in the world yet
+	SlotMap<EntityRecord> records;
+	SlotMap<EntityRecord> loadedRecords; //filled by decode() and swapped in once the caller knows the state is valid
+	std::vector<int> loadedArchetypes;
+	std::vector<int> savedArchetypes; //world indices in the order save() writes them
+	std::vector<int> savedIndex; //world index to saved position
+};
+
+//Cached list of archetypes that have all the requested components.
+//Archetypes are never removed, so the cache only has to look at archetypes created since the last use.
+template <typename... Components>
+class Query
+{
+public:
+	Query(World& world) : world(world) {
+		int maskParts[] = { 0, (mask |= ComponentRegistry::mask<Components>(), 0)... };
+		(void)maskParts;
+	}
+
+	//Column pointers of one matching archetype, call(row, function) runs function(Entity, Components&...) on that row.
+	//Lets systems split the rows of an archetype across jobs.
+	class Rows
+	{
+	public:
+		Rows(Archetype& archetype) : archetype(&archetype), columns(archetype.getColumn<Components>()...) {
+		}
+		int size() {
+			return archetype->size();
+		}
+		template <typename Function>
+		auto call(int row, Function& function) {
+			return callRow(row, function, std::index_sequence_for<Components...>());
+		}
+
+	private:
+		template <typename Function, size_t... I>
+		auto callRow(int row, Function& function, std::index_sequence<I...>) {
+			return function(archetype->getEntity(row), std::get<I>(columns)[row]...);
+		}
+
+		Archetype* archetype;
+		std::tuple<Components*...> columns;
+	};
+
+	//function(Entity, Components&...) for every matching entity, entities must not be created or destroyed inside it
+	template <typename Function>
+	void forEach(Function function) {
+		refresh();
+		for (int i = 0; i < (int)matches.size(); i++) {
+			Rows rows(*matches[i]);
+			int size = rows.size();
+			for (int row = 0; row < size; row++) {
+				rows.call(row, function);
+			}
+		}
+	}
+	//Stops at the first entity the function returns true for, returns false if there was none
+	template <typename Function>
+	bool findFirst(Function function, Entity& found) {
+		refresh();
+		for (int i = 0; i < (int)matches.size(); i++) {
+			Rows rows(*matches[i]);
+			int size = rows.size();
+			for (int row = 0; row < size; row++) {
+				if (rows.call(row, function)) {
+					found = matches[i]->getEntity(row);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	int getArchetypeCount() {
+		refresh();
+		return (int)matches.size();
+	}
+	Archetype& getArchetype(int index) {
+		return *matches[index];
+	}
+	Rows getRows(int index) {
+		return Rows(*matches[index]);
+	}
+	int count() {
+		refresh();
+		int total = 0;
+		for (int i = 0; i < (int)matches.size(); i++) {
+			total += matches[i]->size();
+		}
+		return total;
+	}
+
+private:
+	void refresh() {
+		while (checkedArchetypes < world.getArchetypeCount()) {
+			Archetype& archetype = world.getArchetype(checkedArchetypes);
+			if ((archetype.getMask() & mask) == mask) {
+				matches.push_back(&archetype);
+			}
+			checkedArchetypes++;
+		}
+	}
+
+	World& world;
+	ComponentMask mask = 0;
+	std::vector<Archetype*> matches;
+	int checkedArchetypes = 0;
+};
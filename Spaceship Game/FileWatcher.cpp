@@ -0,0 +1,137 @@
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+#include "FileWatcher.h"
+#include <cstring>
+
+FileWatcher::~FileWatcher()
+{
+	shutdown();
+}
+
+bool FileWatcher::init(const std::string& fileName)
+{
+	shutdown();
+	size_t slash = fileName.find_last_of("/\\");
+	folder = slash == std::string::npos ? "." : fileName.substr(0, slash);
+	name = slash == std::string::npos ? fileName : fileName.substr(slash + 1);
+#ifdef _WIN32
+	folderHandle = CreateFileA(folder.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+	if (folderHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	changeEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	overlapped = new OVERLAPPED();
+	return watch();
+#else
+	inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify < 0) {
+		return false;
+	}
+	//a write ends with the file closed, a save through a temporary file ends with it moved over the old one.
+	//Not IN_CREATE, it comes before anything is written.
+	if (inotify_add_watch(inotify, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		shutdown();
+		return false;
+	}
+	return true;
+#endif
+}
+
+#ifdef _WIN32
+bool FileWatcher::watch()
+{
+	OVERLAPPED* request = (OVERLAPPED*)overlapped;
+	ZeroMemory(request, sizeof(OVERLAPPED));
+	request->hEvent = changeEvent;
+	return ReadDirectoryChangesW(folderHandle, changes, sizeof(changes), FALSE,
+		FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE, NULL, request, NULL) != 0;
+}
+
+bool FileWatcher::hasChanged()
+{
+	if (folderHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	bool changed = false;
+	DWORD size;
+	while (WaitForSingleObject(changeEvent, 0) == WAIT_OBJECT_0) {
+		ResetEvent(changeEvent);
+		if (!GetOverlappedResult(folderHandle, (OVERLAPPED*)overlapped, &size, FALSE)) {
+			return changed;
+		}
+		if (size == 0) {
+			changed = true; //more changes than fit in the buffer, one of them may be ours
+		}
+		wchar_t wideName[MAX_PATH];
+		int wideLength = MultiByteToWideChar(CP_ACP, 0, name.c_str(), -1, wideName, MAX_PATH) - 1;
+		for (DWORD offset = 0; size != 0;) {
+			FILE_NOTIFY_INFORMATION* change = (FILE_NOTIFY_INFORMATION*)(changes + offset);
+			if ((int)(change->FileNameLength / sizeof(wchar_t)) == wideLength &&
+				_wcsnicmp(change->FileName, wideName, wideLength) == 0) {
+				changed = true;
+			}
+			if (change->NextEntryOffset == 0) {
+				break;
+			}
+			offset += change->NextEntryOffset;
+		}
+		if (!watch()) {
+			break;
+		}
+	}
+	return changed;
+}
+
+void FileWatcher::shutdown()
+{
+	if (folderHandle != INVALID_HANDLE_VALUE) {
+		//the request has to be finished before its buffer and OVERLAPPED go away
+		DWORD size;
+		if (CancelIoEx(folderHandle, (OVERLAPPED*)overlapped) || GetLastError() != ERROR_NOT_FOUND) {
+			GetOverlappedResult(folderHandle, (OVERLAPPED*)overlapped, &size, TRUE);
+		}
+		CloseHandle(folderHandle);
+		folderHandle = INVALID_HANDLE_VALUE;
+	}
+	if (changeEvent != NULL) {
+		CloseHandle(changeEvent);
+		changeEvent = NULL;
+	}
+	delete (OVERLAPPED*)overlapped;
+	overlapped = NULL;
+}
+#else
+bool FileWatcher::hasChanged()
+{
+	if (inotify < 0) {
+		return false;
+	}
+	bool changed = false;
+	alignas(inotify_event) char events[4096];
+	ssize_t size;
+	while ((size = read(inotify, events, sizeof(events))) > 0) {
+		for (ssize_t offset = 0; offset < size;) {
+			inotify_event* event = (inotify_event*)(events + offset);
+			if (event->len > 0 && name == event->name) {
+				changed = true;
+			}
+			offset += sizeof(inotify_event) + event->len;
+		}
+	}
+	return changed;
+}
+
+void FileWatcher::shutdown()
+{
+	if (inotify >= 0) {
+		close(inotify);
+		inotify = -1;
+	}
+}
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+
+//Tells when a file has been written, without reading it or checking its time every frame.
+//The folder is watched rather than the file, so editors that save by replacing the file are seen too.
+//Windows uses ReadDirectoryChangesW, Linux inotify. Both are polled, hasChanged() never blocks.
+class FileWatcher
+{
+public:
+	~FileWatcher();
+
+	bool init(const std::string& fileName); //false if the folder cannot be watched
+	bool hasChanged(); //true once for any number of writes since the last call
+	void shutdown();
+
+private:
+	std::string folder;
+	std::string name;
+#ifdef _WIN32
+	void* folderHandle = (void*)-1; //INVALID_HANDLE_VALUE
+	void* changeEvent = NULL;
+	void* overlapped = NULL;
+	alignas(4) unsigned char changes[4096];
+
+	bool watch();
+#else
+	int inotify = -1;
+#endif
+};
@@ -0,0 +1,102 @@
+#include "FrameArena.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+FrameArena::~FrameArena()
+{
+	reset();
+	free(memory);
+}
+
+void FrameArena::init(size_t capacity)
+{
+	reset();
+	free(memory);
+	memory = (char*)malloc(capacity);
+	this->capacity = memory != NULL ? capacity : 0;
+	highWaterMark = 0;
+	overflowCount = 0;
+}
+
+void FrameArena::reset()
+{
+#ifndef NDEBUG
+	if (memory != NULL) {
+		memset(memory, 0xCD, used);
+	}
+#endif
+	while (overflows != NULL) {
+		Overflow* next = overflows->next;
+		free(overflows);
+		overflows = next;
+	}
+	used = 0;
+	overflowBytes = 0;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+	size_t start = (used + alignment - 1) & ~(alignment - 1);
+	if (start + size <= capacity) {
+		used = start + size;
+		if (used + overflowBytes > highWaterMark) {
+			highWaterMark = used + overflowBytes;
+		}
+		return memory + start;
+	}
+	//the header is padded to the alignment so the allocation after it stays aligned
+	size_t header = (sizeof(Overflow) + alignment - 1) & ~(alignment - 1);
+	Overflow* block = (Overflow*)malloc(header + size);
+	if (block == NULL) {
+		throw std::bad_alloc();
+	}
+	block->next = overflows;
+	overflows = block;
+	overflowCount++;
+	overflowBytes += size;
+	if (used + overflowBytes > highWaterMark) {
+		highWaterMark = used + overflowBytes;
+	}
+	return (char*)block + header;
+}
+
+char* FrameArena::format(const char* format, ...)
+{
+	va_list arguments;
+	va_start(arguments, format);
+	va_list copy;
+	va_copy(copy, arguments);
+	int length = vsnprintf(NULL, 0, format, copy);
+	va_end(copy);
+	char* text = (char*)allocate(length > 0 ? length + 1 : 1, 1);
+	if (length > 0) {
+		vsnprintf(text, length + 1, format, arguments);
+	}
+	else {
+		text[0] = 0;
+	}
+	va_end(arguments);
+	return text;
+}
+
+size_t FrameArena::getCapacity()
+{
+	return capacity;
+}
+
+size_t FrameArena::getUsed()
+{
+	return used + overflowBytes;
+}
+
+size_t FrameArena::getHighWaterMark()
+{
+	return highWaterMark;
+}
+
+long long FrameArena::getOverflowCount()
+{
+	return overflowCount;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+//Linear allocator for data that only lives until the end of the frame (HUD text, pair lists, command lists).
+//Allocating moves a pointer through one block reserved up front, reset() at the end of the frame frees everything
+//at once. Nothing is destroyed, so only trivially destructible types can be created in it.
+//An arena belongs to one thread, each thread that needs scratch memory keeps its own.
+//If a frame needs more than the block, the rest comes from malloc and is freed by reset(), getOverflowCount() says
+//how often that happened so the capacity can be raised.
+class FrameArena
+{
+public:
+	~FrameArena();
+
+	void init(size_t capacity);
+	void reset(); //end of frame, debug builds fill the released memory with 0xCD so stale pointers show up
+
+	void* allocate(size_t size, size_t alignment);
+	template <typename T>
+	T* allocateArray(int count) {
+		static_assert(std::is_trivially_destructible<T>::value, "the arena never runs destructors");
+		T* values = (T*)allocate(sizeof(T) * count, alignof(T));
+		for (int i = 0; i < count; i++) {
+			new (values + i) T();
+		}
+		return values;
+	}
+	template <typename T, typename... Args>
+	T* create(Args&&... args) {
+		static_assert(std::is_trivially_destructible<T>::value, "the arena never runs destructors");
+		return new (allocate(sizeof(T), alignof(T))) T(static_cast<Args&&>(args)...);
+	}
+	//printf into the arena, the text is valid until reset()
+	char* format(const char* format, ...);
+
+	size_t getCapacity();
+	size_t getUsed();
+	size_t getHighWaterMark(); //most used by any frame, overflow included
+	long long getOverflowCount();
+
+private:
+	//malloc'd block for an allocation that did not fit, chained so reset() can free them
+	struct Overflow {
+		Overflow* next;
+	};
+
+	char* memory = NULL;
+	size_t capacity = 0;
+	size_t used = 0;
+	size_t overflowBytes = 0;
+	size_t highWaterMark = 0;
+	Overflow* overflows = NULL;
+	long long overflowCount = 0;
+};
+
+//Lets standard containers take their storage from an arena, deallocate does nothing.
+//A container using it has to be gone (or at least never touched again) before the arena is reset.
+template <typename T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+
+	FrameAllocator(FrameArena& arena) : arena(&arena) {}
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(size_t count) {
+		return (T*)arena->allocate(sizeof(T) * count, alignof(T));
+	}
+	void deallocate(T*, size_t) {}
+
+	template <typename U>
+	bool operator==(const FrameAllocator<U>& other) const {
+		return arena == other.arena;
+	}
+	template <typename U>
+	bool operator!=(const FrameAllocator<U>& other) const {
+		return arena != other.arena;
+	}
+
+private:
+	template <typename U>
+	friend class FrameAllocator;
+
+	FrameArena* arena;
+};
@@ -0,0 +1,197 @@
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+#include "FramePacer.h"
+#include <thread>
+
+FramePacer::FramePacer()
+{
+#ifdef _WIN32
+	timer = CreateWaitableTimerEx(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (timer == NULL) {
+		//before Windows 10 1803 the timer follows the system tick, so make the tick 1ms
+		timer = CreateWaitableTimer(NULL, TRUE, NULL);
+		raisedTimerResolution = timeBeginPeriod(1) == TIMERR_NOERROR;
+	}
+#endif
+	init(60, 60);
+}
+
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+	if (timer != NULL) {
+		CloseHandle(timer);
+	}
+	if (raisedTimerResolution) {
+		timeEndPeriod(1);
+	}
+#endif
+}
+
+void FramePacer::init(int framesPerSecond, int idleFramesPerSecond)
+{
+	period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond));
+	idlePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / idleFramesPerSecond));
+	spinMargin = std::chrono::microseconds(1000);
+	nextFrame = Clock::now();
+	startTime = nextFrame;
+	sampleTime = nextFrame;
+	startCpu = processCpuMicroseconds();
+	sampleCpuTime = startCpu;
+	jitter.reset();
+	frameCount = 0;
+	jitterSum = 0;
+	maxJitter = 0;
+}
+
+void FramePacer::setIdle(bool idle)
+{
+	this->idle = idle;
+}
+
+void FramePacer::waitForNextFrame()
+{
+	Clock::duration framePeriod = idle ? idlePeriod : period;
+	nextFrame += framePeriod;
+	Clock::time_point now = Clock::now();
+	if (now < nextFrame) {
+		if (nextFrame - now > spinMargin) {
+			sleepUntil(nextFrame - spinMargin);
+		}
+		while (Clock::now() < nextFrame) {
+			std::this_thread::yield();
+		}
+		now = Clock::now();
+	}
+
+	long long late = std::chrono::duration_cast<std::chrono::microseconds>(now - nextFrame).count();
+	jitter.record(late);
+	jitterSum += late;
+	if (late > maxJitter) {
+		maxJitter = late;
+	}
+	frameCount++;
+	if (now - nextFrame > framePeriod) {
+		nextFrame = now;
+	}
+	sampleCpu(now);
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline)
+{
+#ifdef _WIN32
+	LARGE_INTEGER dueTime;
+	//relative, in 100ns units
+	dueTime.QuadPart = -std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now()).count() / 100;
+	if (timer == NULL || dueTime.QuadPart >= 0 || !SetWaitableTimer(timer, &dueTime, 0, NULL, NULL, FALSE)) {
+		std::this_thread::sleep_until(deadline);
+	}
+	else {
+		WaitForSingleObject(timer, INFINITE);
+	}
+#else
+	//steady_clock is CLOCK_MONOTONIC, so the deadline can be used as an absolute time
+	long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+	timespec wakeTime;
+	wakeTime.tv_sec = (time_t)(nanoseconds / 1000000000);
+	wakeTime.tv_nsec = (long)(nanoseconds % 1000000000);
+	//an interrupting signal sleeps the rest, any other error (a clock without absolute sleeps) falls back to sleep_until
+	int result;
+	while ((result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, NULL)) == EINTR) {
+	}
+	if (result != 0) {
+		std::this_thread::sleep_until(deadline);
+	}
+#endif
+	//spin for as long as sleeps have been overshooting, falling back slowly when they get more precise
+	Clock::duration overshoot = Clock::now() - deadline;
+	if (overshoot > spinMargin) {
+		spinMargin = overshoot;
+	}
+	else {
+		spinMargin -= (spinMargin - overshoot) / 16;
+	}
+	if (spinMargin < std::chrono::microseconds(minSpinMicroseconds)) {
+		spinMargin = std::chrono::microseconds(minSpinMicroseconds);
+	}
+	if (spinMargin > std::chrono::microseconds(maxSpinMicroseconds)) {
+		spinMargin = std::chrono::microseconds(maxSpinMicroseconds);
+	}
+}
+
+void FramePacer::sampleCpu(Clock::time_point now)
+{
+	if (now - sampleTime < std::chrono::seconds(1)) {
+		return;
+	}
+	long long cpu = processCpuMicroseconds();
+	long long wall = std::chrono::duration_cast<std::chrono::microseconds>(now - sampleTime).count();
+	cpuUtilisation = 100.0f * (cpu - sampleCpuTime) / wall;
+	sampleTime = now;
+	sampleCpuTime = cpu;
+}
+
+LatencyHistogram& FramePacer::getJitter()
+{
+	return jitter;
+}
+
+float FramePacer::getAverageJitter()
+{
+	if (frameCount == 0) {
+		return 0;
+	}
+	return jitterSum / 1000.0f / frameCount;
+}
+
+float FramePacer::getMaxJitter()
+{
+	return maxJitter / 1000.0f;
+}
+
+float FramePacer::getCpuUtilisation()
+{
+	return cpuUtilisation;
+}
+
+float FramePacer::getAverageCpuUtilisation()
+{
+	long long wall = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime).count();
+	if (wall == 0) {
+		return 0;
+	}
+	return 100.0f * (processCpuMicroseconds() - startCpu) / wall;
+}
+
+long long FramePacer::getFrameCount()
+{
+	return frameCount;
+}
+
+long long FramePacer::processCpuMicroseconds()
+{
+#ifdef _WIN32
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+		return 0;
+	}
+	ULARGE_INTEGER kernel, user;
+	kernel.LowPart = kernelTime.dwLowDateTime;
+	kernel.HighPart = kernelTime.dwHighDateTime;
+	user.LowPart = userTime.dwLowDateTime;
+	user.HighPart = userTime.dwHighDateTime;
+	return (long long)((kernel.QuadPart + user.QuadPart) / 10); //100ns units
+#else
+	timespec cpuTime;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTime);
+	return (long long)cpuTime.tv_sec * 1000000 + cpuTime.tv_nsec / 1000;
+#endif
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include "LatencyTracker.h"
+
+//Paces a loop to a target frame rate without spinning a core. Each wait sleeps on a high resolution timer until
+//spinMargin before the deadline, then yields until the deadline. The margin follows how late the sleeps have been
+//waking up, so the spin is only as long as this machine needs.
+//Deadlines are on a fixed schedule, a frame that starts late does not push the following ones back.
+class FramePacer
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	FramePacer();
+	~FramePacer();
+
+	void init(int framesPerSecond, int idleFramesPerSecond);
+	//Idle loops (unfocused window, a menu where nothing moves) wait at the idle rate
+	void setIdle(bool idle);
+	//Blocks until the next frame is due. A loop more than a frame behind starts again from now instead of rushing to catch up.
+	void waitForNextFrame();
+
+	LatencyHistogram& getJitter(); //how late each frame started against its deadline
+	float getAverageJitter();      //in milliseconds
+	float getMaxJitter();
+	float getCpuUtilisation();     //percent of one core used by the whole process over the last second
+	float getAverageCpuUtilisation(); //same, since init()
+	long long getFrameCount();
+
+	static long long processCpuMicroseconds(); //user and kernel time of every thread of the process
+
+private:
+	static const int minSpinMicroseconds = 50;
+	static const int maxSpinMicroseconds = 4000;
+
+	void sleepUntil(Clock::time_point deadline);
+	void sampleCpu(Clock::time_point now);
+
+	Clock::duration period;
+	Clock::duration idlePeriod;
+	bool idle = false;
+	Clock::time_point nextFrame;
+	Clock::duration spinMargin;
+
+	LatencyHistogram jitter;
+	std::atomic<long long> frameCount{ 0 };
+	std::atomic<long long> jitterSum{ 0 }; //microseconds
+	std::atomic<long long> maxJitter{ 0 };
+
+	Clock::time_point startTime;
+	long long startCpu = 0;
+	Clock::time_point sampleTime;
+	long long sampleCpuTime = 0;
+	std::atomic<float> cpuUtilisation{ 0 };
+
+#ifdef _WIN32
+	void* timer = NULL;          //waitable timer, high resolution where Windows supports it
+	bool raisedTimerResolution = false; //older Windows, timeBeginPeriod(1) instead
+#endif
+};
@@ -0,0 +1,137 @@
+#include "GameTuning.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+//Name, member and the range a value has to be in. Exactly one of the two members is set.
+struct TuningField {
+	const char* name;
+	float GameTuning::* floatValue;
+	int GameTuning::* intValue;
+	float minimum;
+	float maximum;
+};
+
+static const TuningField tuningFields[] = {
+	{ "friction", &GameTuning::friction, NULL, 0, 1 },
+	{ "asteroidFriction", &GameTuning::asteroidFriction, NULL, 0, 1 },
+	{ "spaceshipEnginePower", &GameTuning::spaceshipEnginePower, NULL, 0, 1000 },
+	{ "spaceshipMass", &GameTuning::spaceshipMass, NULL, 0.01f, 10000 },
+	{ "defaultBulletInterval", NULL, &GameTuning::defaultBulletInterval, 1, 1000 },
+	{ "bulletPower", &GameTuning::bulletPower, NULL, 0, 1000 },
+	{ "bulletMass", &GameTuning::bulletMass, NULL, 0.01f, 10000 },
+	{ "asteroidRotationRate", &GameTuning::asteroidRotationRate, NULL, -10, 10 },
+	{ "smallAsteroidHp", NULL, &GameTuning::smallAsteroidHp, 1, 1000 },
+	{ "mediumAsteroidHp", NULL, &GameTuning::mediumAsteroidHp, 1, 1000 },
+	{ "largeAsteroidHp", NULL, &GameTuning::largeAsteroidHp, 1, 1000 },
+	{ "smallAsteroidMass", &GameTuning::smallAsteroidMass, NULL, 0.01f, 10000 },
+	{ "mediumAsteroidMass", &GameTuning::mediumAsteroidMass, NULL, 0.01f, 10000 },
+	{ "largeAsteroidMass", &GameTuning::largeAsteroidMass, NULL, 0.01f, 10000 },
+	{ "smallAsteroidPower", &GameTuning::smallAsteroidPower, NULL, 0, 1000 },
+	{ "mediumAsteroidPower", &GameTuning::mediumAsteroidPower, NULL, 0, 1000 },
+	{ "largeAsteroidPower", &GameTuning::largeAsteroidPower, NULL, 0, 1000 },
+	{ "asteroidSolverIterations", NULL, &GameTuning::asteroidSolverIterations, 0, 64 },
+	{ "asteroidRestitution", &GameTuning::asteroidRestitution, NULL, 0, 1 },
+	{ "timeStopDuration", NULL, &GameTuning::timeStopDuration, 1, 3600 },
+	{ "bulletPowerUpDuration", NULL, &GameTuning::bulletPowerUpDuration, 1, 3600 },
+	{ "bulletPowerUpSpeed", NULL, &GameTuning::bulletPowerUpSpeed, 1, 1000 },
+	{ "powerUpSpawnRate", NULL, &GameTuning::powerUpSpawnRate, 1, 3600 },
+	{ "maxPowerUps", NULL, &GameTuning::maxPowerUps, 0, 100 },
+	{ "secondPhaseTimer", NULL, &GameTuning::secondPhaseTimer, 0, 59 },
+	{ "thirdPhaseTimer", NULL, &GameTuning::thirdPhaseTimer, 0, 59 },
+};
+
+bool TuningFile::loadFromFile(const std::string& fileName, GameTuning& tuning)
+{
+	std::ifstream file(fileName);
+	if (!file) {
+		error = "cannot open " + fileName;
+		return false;
+	}
+	std::stringstream text;
+	text << file.rdbuf();
+	return loadFromText(text.str(), tuning);
+}
+
+bool TuningFile::loadFromText(const std::string& text, GameTuning& tuning)
+{
+	error.clear();
+	GameTuning loaded = tuning;
+	std::istringstream lines(text);
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(lines, line)) {
+		lineNumber++;
+		if (!parseLine(line, lineNumber, loaded)) {
+			return false;
+		}
+	}
+	tuning = loaded;
+	return true;
+}
+
+const std::string& TuningFile::getError()
+{
+	return error;
+}
+
+bool TuningFile::fail(int lineNumber, const std::string& message)
+{
+	error = "line " + std::to_string(lineNumber) + ": " + message;
+	return false;
+}
+
+static std::string trim(const std::string& text)
+{
+	size_t first = text.find_first_not_of(" \t\r");
+	if (first == std::string::npos) {
+		return "";
+	}
+	size_t last = text.find_last_not_of(" \t\r");
+	return text.substr(first, last - first + 1);
+}
+
+bool TuningFile::parseLine(const std::string& line, int lineNumber, GameTuning& tuning)
+{
+	std::string content = trim(line.substr(0, line.find('#')));
+	if (content.empty()) {
+		return true;
+	}
+	size_t equals = content.find('=');
+	if (equals == std::string::npos) {
+		return fail(lineNumber, "expected name = value, got " + content);
+	}
+	std::string name = trim(content.substr(0, equals));
+	std::string value = trim(content.substr(equals + 1));
+	const TuningField* field = NULL;
+	for (int i = 0; i < (int)(sizeof(tuningFields) / sizeof(tuningFields[0])); i++) {
+		if (name == tuningFields[i].name) {
+			field = &tuningFields[i];
+			break;
+		}
+	}
+	if (field == NULL) {
+		return fail(lineNumber, "unknown name " + name);
+	}
+	char* end;
+	float number = strtof(value.c_str(), &end);
+	if (value.empty() || *end != 0 || !std::isfinite(number)) {
+		return fail(lineNumber, "bad value for " + name + ": " + value);
+	}
+	if (field->intValue != NULL && number != std::floor(number)) {
+		return fail(lineNumber, name + " has to be a whole number: " + value);
+	}
+	if (number < field->minimum || number > field->maximum) {
+		std::ostringstream range;
+		range << field->minimum << " to " << field->maximum;
+		return fail(lineNumber, name + " has to be from " + range.str() + ": " + value);
+	}
+	if (field->intValue != NULL) {
+		tuning.*field->intValue = (int)number;
+	}
+	else {
+		tuning.*field->floatValue = number;
+	}
+	return true;
+}
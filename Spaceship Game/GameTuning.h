@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+
+//Every balance value of the game in one flat struct, gameplay code reads the members directly.
+//The defaults are the values the game shipped with, a tuning file only needs the ones it changes.
+struct GameTuning {
+	//Friction, 0 = none, 1 = stops at once
+	float friction = 0.01f;
+	float asteroidFriction = 0.3f;
+
+	//Spaceship
+	float spaceshipEnginePower = 30;
+	float spaceshipMass = 100;
+
+	//Bullet, intervals are bullets per second
+	int defaultBulletInterval = 5;
+	float bulletPower = 10;
+	float bulletMass = 100;
+
+	//Asteroid
+	float asteroidRotationRate = 0.05f;
+	int smallAsteroidHp = 1;
+	int mediumAsteroidHp = 3;
+	int largeAsteroidHp = 5;
+	float smallAsteroidMass = 10;
+	float mediumAsteroidMass = 20;
+	float largeAsteroidMass = 50;
+	float smallAsteroidPower = 10;
+	float mediumAsteroidPower = 8;
+	float largeAsteroidPower = 5;
+	int asteroidSolverIterations = 4;
+	float asteroidRestitution = 1; //1 = elastic
+
+	//Power Up, durations and spawn rate in seconds
+	int timeStopDuration = 10;
+	int bulletPowerUpDuration = 10;
+	int bulletPowerUpSpeed = 15;
+	int powerUpSpawnRate = 5;
+	int maxPowerUps = 3;
+
+	//Waves, in seconds
+	int secondPhaseTimer = 10;
+	int thirdPhaseTimer = 30;
+};
+
+//Reads a tuning file, one value per line:
+//  name = value
+//Names are the members of GameTuning, # starts a comment. A file with an unknown name, a value that is not a number
+//or one out of its range is rejected as a whole, so a half edited file never reaches the game.
+class TuningFile
+{
+public:
+	//Starts from the values already in tuning and only writes it if the whole file is valid
+	bool loadFromFile(const std::string& fileName, GameTuning& tuning);
+	bool loadFromText(const std::string& text, GameTuning& tuning);
+
+	const std::string& getError();
+
+private:
+	bool parseLine(const std::string& line, int lineNumber, GameTuning& tuning);
+	bool fail(int lineNumber, const std::string& message);
+
+	std::string error;
+};
@@ -0,0 +1,263 @@
+#include "ImpulseSolver.h"
+#include <cmath>
+
+//Bodies closer than this are left overlapping, stops resting contacts from jittering
+static const float penetrationSlop = 0.5f;
+//Fraction of the overlap removed per step
+static const float separationRate = 0.8f;
+//Keeps the grid small when bodies are spread far apart (e.g. something flew off screen)
+static const int maxGridCells = 1 << 16;
+
+void ImpulseSolver::reserve(int bodies, int contacts, int cells)
+{
+	x.reserve(bodies);
+	y.reserve(bodies);
+	velocityX.reserve(bodies);
+	velocityY.reserve(bodies);
+	radius.reserve(bodies);
+	inverseMass.reserve(bodies);
+	bodyCell.reserve(bodies);
+	cellBodies.reserve(bodies);
+	sortedX.reserve(bodies);
+	sortedY.reserve(bodies);
+	sortedRadius.reserve(bodies);
+	contactA.reserve(contacts);
+	contactB.reserve(contacts);
+	normalX.reserve(contacts);
+	normalY.reserve(contacts);
+	penetration.reserve(contacts);
+	normalMass.reserve(contacts);
+	targetSpeed.reserve(contacts);
+	totalImpulse.reserve(contacts);
+	cellStart.reserve(cells + 1);
+	cellFill.reserve(cells);
+}
+
+void ImpulseSolver::clear()
+{
+	x.clear();
+	y.clear();
+	velocityX.clear();
+	velocityY.clear();
+	radius.clear();
+	inverseMass.clear();
+}
+
+int ImpulseSolver::addBody(float x, float y, float velocityX, float velocityY, float radius, float mass)
+{
+	this->x.push_back(x);
+	this->y.push_back(y);
+	this->velocityX.push_back(velocityX);
+	this->velocityY.push_back(velocityY);
+	this->radius.push_back(radius);
+	inverseMass.push_back(mass > 0 ? 1 / mass : 0);
+	return (int)this->x.size() - 1;
+}
+
+void ImpulseSolver::solve(int iterations, float restitution)
+{
+	findContacts();
+	int contactCount = getContactCount();
+	for (int i = 0; i < contactCount; i++) {
+		int a = contactA[i];
+		int b = contactB[i];
+		float approachSpeed = (velocityX[b] - velocityX[a]) * normalX[i] + (velocityY[b] - velocityY[a]) * normalY[i];
+		targetSpeed[i] = approachSpeed < 0 ? -restitution * approachSpeed : 0;
+		totalImpulse[i] = 0;
+	}
+	for (int i = 0; i < iterations; i++) {
+		solveVelocities();
+	}
+	separateBodies();
+}
+
+void ImpulseSolver::findContacts()
+{
+	contactA.clear();
+	contactB.clear();
+	normalX.clear();
+	normalY.clear();
+	penetration.clear();
+	normalMass.clear();
+	int bodyCount = getBodyCount();
+	if (bodyCount < 2) {
+		targetSpeed.clear();
+		totalImpulse.clear();
+		return;
+	}
+
+	//Cells as wide as the biggest body, so overlapping bodies are always in the same or a neighbouring cell
+	float left = x[0], top = y[0], right = x[0], bottom = y[0], maxRadius = 0;
+	for (int i = 0; i < bodyCount; i++) {
+		left = fminf(left, x[i]);
+		top = fminf(top, y[i]);
+		right = fmaxf(right, x[i]);
+		bottom = fmaxf(bottom, y[i]);
+		maxRadius = fmaxf(maxRadius, radius[i]);
+	}
+	cellSize = fmaxf(maxRadius * 2, 1.0f);
+	while (((right - left) / cellSize + 1) * ((bottom - top) / cellSize + 1) > maxGridCells) {
+		cellSize *= 2;
+	}
+	gridLeft = left;
+	gridTop = top;
+	gridColumns = (int)((right - left) / cellSize) + 1;
+	gridRows = (int)((bottom - top) / cellSize) + 1;
+
+	//Counting sort of the bodies by cell, the sorted copies keep each cell's bodies next to each other in memory
+	int cellCount = gridColumns * gridRows;
+	bodyCell.resize(bodyCount);
+	cellStart.assign(cellCount + 1, 0);
+	cellBodies.resize(bodyCount);
+	sortedX.resize(bodyCount);
+	sortedY.resize(bodyCount);
+	sortedRadius.resize(bodyCount);
+	for (int i = 0; i < bodyCount; i++) {
+		int column = (int)((x[i] - gridLeft) / cellSize);
+		int row = (int)((y[i] - gridTop) / cellSize);
+		bodyCell[i] = row * gridColumns + column;
+		cellStart[bodyCell[i] + 1]++;
+	}
+	for (int i = 0; i < cellCount; i++) {
+		cellStart[i + 1] += cellStart[i];
+	}
+	cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+	for (int i = 0; i < bodyCount; i++) {
+		int slot = cellFill[bodyCell[i]]++;
+		cellBodies[slot] = i;
+		sortedX[slot] = x[i];
+		sortedY[slot] = y[i];
+		sortedRadius[slot] = radius[i];
+	}
+
+	//Every cell is paired with itself and the four neighbours after it (right, and the three below),
+	//which covers all eight neighbours exactly once across the grid
+	for (int row = 0; row < gridRows; row++) {
+		for (int column = 0; column < gridColumns; column++) {
+			int cell = row * gridColumns + column;
+			if (cellStart[cell] == cellStart[cell + 1]) {
+				continue;
+			}
+			testCells(cell, cell);
+			if (column + 1 < gridColumns) {
+				testCells(cell, cell + 1);
+			}
+			if (row + 1 < gridRows) {
+				if (column > 0) {
+					testCells(cell, cell + gridColumns - 1);
+				}
+				testCells(cell, cell + gridColumns);
+				if (column + 1 < gridColumns) {
+					testCells(cell, cell + gridColumns + 1);
+				}
+			}
+		}
+	}
+	targetSpeed.resize(contactA.size());
+	totalImpulse.resize(contactA.size());
+}
+
+void ImpulseSolver::testCells(int cell, int otherCell)
+{
+	int end = cellStart[cell + 1];
+	int otherEnd = cellStart[otherCell + 1];
+	for (int i = cellStart[cell]; i < end; i++) {
+		//inside one cell each pair is tested once
+		int otherBegin = cell == otherCell ? i + 1 : cellStart[otherCell];
+		for (int j = otherBegin; j < otherEnd; j++) {
+			float diffX = sortedX[j] - sortedX[i];
+			float diffY = sortedY[j] - sortedY[i];
+			float radiusSum = sortedRadius[i] + sortedRadius[j];
+			if (diffX * diffX + diffY * diffY < radiusSum * radiusSum) {
+				addContact(cellBodies[i], cellBodies[j]);
+			}
+		}
+	}
+}
+
+void ImpulseSolver::addContact(int a, int b)
+{
+	float inverseMassSum = inverseMass[a] + inverseMass[b];
+	if (inverseMassSum == 0) {
+		return;
+	}
+	float diffX = x[b] - x[a];
+	float diffY = y[b] - y[a];
+	float distance = sqrtf(diffX * diffX + diffY * diffY);
+	contactA.push_back(a);
+	contactB.push_back(b);
+	if (distance > 0) {
+		normalX.push_back(diffX / distance);
+		normalY.push_back(diffY / distance);
+	}
+	else {
+		//exactly on top of each other, any direction works
+		normalX.push_back(1);
+		normalY.push_back(0);
+	}
+	penetration.push_back(radius[a] + radius[b] - distance);
+	normalMass.push_back(1 / inverseMassSum);
+}
+
+void ImpulseSolver::solveVelocities()
+{
+	int contactCount = getContactCount();
+	for (int i = 0; i < contactCount; i++) {
+		int a = contactA[i];
+		int b = contactB[i];
+		float separatingSpeed = (velocityX[b] - velocityX[a]) * normalX[i] + (velocityY[b] - velocityY[a]) * normalY[i];
+		float impulse = (targetSpeed[i] - separatingSpeed) * normalMass[i];
+		//clamp the running total rather than each step so later iterations can take back an overshoot
+		float previousTotal = totalImpulse[i];
+		totalImpulse[i] = fmaxf(previousTotal + impulse, 0.0f);
+		impulse = totalImpulse[i] - previousTotal;
+		velocityX[a] -= impulse * normalX[i] * inverseMass[a];
+		velocityY[a] -= impulse * normalY[i] * inverseMass[a];
+		velocityX[b] += impulse * normalX[i] * inverseMass[b];
+		velocityY[b] += impulse * normalY[i] * inverseMass[b];
+	}
+}
+
+void ImpulseSolver::separateBodies()
+{
+	int contactCount = getContactCount();
+	for (int i = 0; i < contactCount; i++) {
+		float correction = fmaxf(penetration[i] - penetrationSlop, 0.0f) * separationRate * normalMass[i];
+		int a = contactA[i];
+		int b = contactB[i];
+		x[a] -= correction * normalX[i] * inverseMass[a];
+		y[a] -= correction * normalY[i] * inverseMass[a];
+		x[b] += correction * normalX[i] * inverseMass[b];
+		y[b] += correction * normalY[i] * inverseMass[b];
+	}
+}
+
+int ImpulseSolver::getBodyCount()
+{
+	return (int)x.size();
+}
+
+int ImpulseSolver::getContactCount()
+{
+	return (int)contactA.size();
+}
+
+float ImpulseSolver::getX(int body)
+{
+	return x[body];
+}
+
+float ImpulseSolver::getY(int body)
+{
+	return y[body];
+}
+
+float ImpulseSolver::getVelocityX(int body)
+{
+	return velocityX[body];
+}
+
+float ImpulseSolver::getVelocityY(int body)
+{
+	return velocityY[body];
+}
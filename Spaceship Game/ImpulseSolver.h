@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+
+//Batched impulse solver for colliding circles.
+//Bodies and contacts are kept as separate arrays per field (structure of arrays) so every pass over them
+//streams through memory instead of jumping between objects.
+class ImpulseSolver
+{
+public:
+	//Room for this many bodies, contacts and broadphase cells up front, a scene that fits never allocates while solving
+	void reserve(int bodies, int contacts, int cells);
+	void clear();
+	int addBody(float x, float y, float velocityX, float velocityY, float radius, float mass);
+	//Finds overlapping bodies then runs the given number of velocity iterations, restitution 1 is fully elastic
+	void solve(int iterations, float restitution);
+
+	int getBodyCount();
+	int getContactCount();
+	float getX(int body);
+	float getY(int body);
+	float getVelocityX(int body);
+	float getVelocityY(int body);
+
+private:
+	void findContacts();
+	void testCells(int cell, int otherCell);
+	void addContact(int a, int b);
+	void solveVelocities();
+	void separateBodies();
+
+	//Bodies
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> radius;
+	std::vector<float> inverseMass;
+
+	//Contacts
+	std::vector<int> contactA;
+	std::vector<int> contactB;
+	std::vector<float> normalX;
+	std::vector<float> normalY;
+	std::vector<float> penetration;
+	std::vector<float> normalMass;    //1 / (inverse mass a + inverse mass b)
+	std::vector<float> targetSpeed;   //separating speed the contact should end with
+	std::vector<float> totalImpulse;  //accumulated over iterations, never negative (contacts only push)
+
+	//Broadphase grid, bodies are counting sorted by cell
+	float cellSize = 0;
+	float gridLeft = 0;
+	float gridTop = 0;
+	int gridColumns = 0;
+	int gridRows = 0;
+	std::vector<int> bodyCell;
+	std::vector<int> cellStart;
+	std::vector<int> cellBodies;
+	std::vector<int> cellFill;
+	std::vector<float> sortedX;
+	std::vector<float> sortedY;
+	std::vector<float> sortedRadius;
+};
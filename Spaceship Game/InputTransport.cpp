@@ -0,0 +1,182 @@
+#ifdef _WIN32
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+typedef int socklen_t;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include "InputTransport.h"
+#include <chrono>
+#include <cstring>
+
+void LoopbackTransport::connect(LoopbackTransport& a, LoopbackTransport& b)
+{
+	a.outgoing = std::make_shared<Channel>();
+	b.outgoing = std::make_shared<Channel>();
+	a.incoming = b.outgoing;
+	b.incoming = a.outgoing;
+}
+
+void LoopbackTransport::setConditions(int latencyMilliseconds, int jitterMilliseconds, float lossRate, uint64_t seed)
+{
+	latency = latencyMilliseconds;
+	jitter = jitterMilliseconds;
+	this->lossRate = lossRate;
+	random.seed(seed, 0);
+}
+
+void LoopbackTransport::setClock(MillisecondClock clock)
+{
+	this->clock = clock;
+}
+
+long long LoopbackTransport::now()
+{
+	if (clock != NULL) {
+		return clock();
+	}
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LoopbackTransport::send(const InputPacket& packet)
+{
+	sentCount++;
+	if (lossRate > 0 && random.nextFloat() < lossRate) {
+		droppedCount++;
+		return;
+	}
+	Delivery delivery;
+	delivery.arrivalTime = now() + latency + (jitter > 0 ? random.range(0, jitter + 1) : 0);
+	delivery.packet = packet;
+	std::lock_guard<std::mutex> guard(outgoing->lock);
+	outgoing->packets.push_back(delivery);
+}
+
+bool LoopbackTransport::receive(InputPacket& packet)
+{
+	long long time = now();
+	std::lock_guard<std::mutex> guard(incoming->lock);
+	//jitter lets a later packet overtake an earlier one, the one that arrives first is handed out first
+	int earliest = -1;
+	for (int i = 0; i < (int)incoming->packets.size(); i++) {
+		if (incoming->packets[i].arrivalTime <= time && (earliest < 0 || incoming->packets[i].arrivalTime < incoming->packets[earliest].arrivalTime)) {
+			earliest = i;
+		}
+	}
+	if (earliest < 0) {
+		return false;
+	}
+	packet = incoming->packets[earliest].packet;
+	incoming->packets.erase(incoming->packets.begin() + earliest);
+	return true;
+}
+
+long long LoopbackTransport::getSentCount()
+{
+	return sentCount;
+}
+
+long long LoopbackTransport::getDroppedCount()
+{
+	return droppedCount;
+}
+
+bool UdpTransport::open(int localPort, const char* remoteAddress, int remotePort)
+{
+	close();
+#ifdef _WIN32
+	WSADATA wsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+		return false;
+	}
+#endif
+	intptr_t handle = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (handle < 0) {
+		return false;
+	}
+	socketHandle = handle;
+
+	sockaddr_in local = {};
+	local.sin_family = AF_INET;
+	local.sin_addr.s_addr = htonl(INADDR_ANY);
+	local.sin_port = htons((unsigned short)localPort);
+	if (bind(socketHandle, (sockaddr*)&local, sizeof(local)) != 0) {
+		close();
+		return false;
+	}
+#ifdef _WIN32
+	u_long nonBlocking = 1;
+	ioctlsocket(socketHandle, FIONBIO, &nonBlocking);
+#else
+	fcntl((int)socketHandle, F_SETFL, fcntl((int)socketHandle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons((unsigned short)remotePort);
+	if (inet_pton(AF_INET, remoteAddress, &address.sin_addr) != 1) {
+		close();
+		return false;
+	}
+	static_assert(sizeof(address) <= sizeof(remote), "remote address does not fit");
+	memcpy(remote, &address, sizeof(address));
+	return true;
+}
+
+void UdpTransport::close()
+{
+	if (socketHandle < 0) {
+		return;
+	}
+#ifdef _WIN32
+	closesocket(socketHandle);
+	WSACleanup();
+#else
+	::close((int)socketHandle);
+#endif
+	socketHandle = -1;
+}
+
+void UdpTransport::send(const InputPacket& packet)
+{
+	if (socketHandle < 0) {
+		return;
+	}
+	//only the used inputs go on the wire
+	int size = (int)(sizeof(packet) - sizeof(packet.inputs) + packet.count * sizeof(PlayerInput));
+	sendto(socketHandle, (const char*)&packet, size, 0, (const sockaddr*)remote, sizeof(sockaddr_in));
+}
+
+bool UdpTransport::receive(InputPacket& packet)
+{
+	if (socketHandle < 0) {
+		return false;
+	}
+	sockaddr_in expected;
+	memcpy(&expected, remote, sizeof(expected));
+	int headerSize = (int)(sizeof(packet) - sizeof(packet.inputs));
+	while (true) {
+		sockaddr_in from;
+		socklen_t fromSize = sizeof(from);
+		int size = (int)recvfrom(socketHandle, (char*)&packet, sizeof(packet), 0, (sockaddr*)&from, &fromSize);
+		if (size < 0) {
+			return false;
+		}
+		//anything that is not a whole packet from the other player is dropped
+		if (from.sin_port != expected.sin_port || from.sin_addr.s_addr != expected.sin_addr.s_addr) {
+			continue;
+		}
+		if (size >= headerSize && packet.count <= maxPacketInputs && size == headerSize + packet.count * (int)sizeof(PlayerInput)) {
+			return true;
+		}
+	}
+}
+
+UdpTransport::~UdpTransport()
+{
+	close();
+}
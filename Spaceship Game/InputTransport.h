@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include "PlayerInput.h"
+#include "RandomStream.h"
+
+//Carries input packets to the other player. Packets may be late, reordered or lost, never corrupted.
+class InputTransport
+{
+public:
+	virtual ~InputTransport() {}
+	virtual void send(const InputPacket& packet) = 0;
+	virtual bool receive(InputPacket& packet) = 0; //false when nothing has arrived
+};
+
+typedef long long (*MillisecondClock)();
+
+//In-process transport, both ends live in the same program. It can delay, reorder and drop packets
+//to imitate a real network, and takes a fake clock so tests decide when packets arrive.
+class LoopbackTransport : public InputTransport
+{
+public:
+	static void connect(LoopbackTransport& a, LoopbackTransport& b);
+
+	//Applies to packets sent from this end. Each packet takes latency plus up to jitter milliseconds.
+	void setConditions(int latencyMilliseconds, int jitterMilliseconds, float lossRate, uint64_t seed);
+	void setClock(MillisecondClock clock);
+
+	void send(const InputPacket& packet) override;
+	bool receive(InputPacket& packet) override;
+
+	long long getSentCount();
+	long long getDroppedCount();
+
+private:
+	struct Delivery {
+		long long arrivalTime;
+		InputPacket packet;
+	};
+	//one direction, locked because the two ends may be used from different threads
+	struct Channel {
+		std::mutex lock;
+		std::deque<Delivery> packets;
+	};
+
+	long long now();
+
+	std::shared_ptr<Channel> incoming;
+	std::shared_ptr<Channel> outgoing;
+	int latency = 0;
+	int jitter = 0;
+	float lossRate = 0;
+	RandomStream random;
+	MillisecondClock clock = NULL;
+	long long sentCount = 0;
+	long long droppedCount = 0;
+};
+
+//Non-blocking UDP socket, one datagram per packet
+class UdpTransport : public InputTransport
+{
+public:
+	bool open(int localPort, const char* remoteAddress, int remotePort);
+	void close();
+
+	void send(const InputPacket& packet) override;
+	bool receive(InputPacket& packet) override;
+
+	~UdpTransport();
+
+private:
+	intptr_t socketHandle = -1;
+	unsigned char remote[16] = {}; //sockaddr_in of the other player
+};
@@ -0,0 +1,273 @@
+#include "JobSystem.h"
+
+//Queue owned by the current thread, -1 for threads that are not workers
+static thread_local int currentQueue = -1;
+
+JobSystem::JobQueue::JobQueue()
+{
+	ring.resize(initialCapacity);
+}
+
+void JobSystem::JobQueue::pushBack(const Job& job)
+{
+	if (count == (int)ring.size()) {
+		//unwrap into a ring twice the size
+		std::vector<Job> grown(ring.size() * 2);
+		for (int i = 0; i < count; i++) {
+			grown[i] = ring[(head + i) % ring.size()];
+		}
+		ring.swap(grown);
+		head = 0;
+	}
+	ring[(head + count) % ring.size()] = job;
+	count++;
+}
+
+JobSystem::Job JobSystem::JobQueue::popBack()
+{
+	count--;
+	return ring[(head + count) % ring.size()];
+}
+
+JobSystem::Job JobSystem::JobQueue::popFront()
+{
+	Job job = ring[head];
+	head = (head + 1) % ring.size();
+	count--;
+	return job;
+}
+
+void JobSystem::init(int workerCount)
+{
+	if (workerCount <= 0) {
+		//leave a core each for the main and simulation threads
+		workerCount = (int)std::thread::hardware_concurrency() - 2;
+		if (workerCount < 1) {
+			workerCount = 1;
+		}
+	}
+	for (int i = 0; i <= workerCount; i++) {
+		queues.push_back(std::unique_ptr<JobQueue>(new JobQueue()));
+	}
+	running = true;
+	for (int i = 0; i < workerCount; i++) {
+		workers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+	}
+}
+
+void JobSystem::shutdown()
+{
+	if (!running) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		running = false;
+	}
+	wakeUp.notify_all();
+	for (int i = 0; i < (int)workers.size(); i++) {
+		workers[i].join();
+	}
+	workers.clear();
+	queues.clear();
+}
+
+int JobSystem::getWorkerCount()
+{
+	return (int)workers.size();
+}
+
+void JobSystem::run(JobFunction function, void* data, int begin, int end, JobCounter& counter)
+{
+	Job job = { function, NULL, data, begin, end, &counter, NULL };
+	push(job);
+}
+
+void JobSystem::run(IndexFunction function, int begin, int end, JobCounter& counter)
+{
+	Job job = { NULL, function, NULL, begin, end, &counter, NULL };
+	push(job);
+}
+
+void JobSystem::runAfter(JobCounter& dependency, JobFunction function, void* data, int begin, int end, JobCounter& counter)
+{
+	Job job = { function, NULL, data, begin, end, &counter, &dependency };
+	runAfter(dependency, job);
+}
+
+void JobSystem::runAfter(JobCounter& dependency, IndexFunction function, int begin, int end, JobCounter& counter)
+{
+	Job job = { NULL, function, NULL, begin, end, &counter, &dependency };
+	runAfter(dependency, job);
+}
+
+void JobSystem::runAfter(JobCounter& dependency, Job job)
+{
+	job.counter->count.fetch_add(1, std::memory_order_relaxed);
+	std::unique_lock<std::mutex> guard(dependentLock);
+	//counted before the dependency is checked, so a job finishing in between sees there is something to release
+	dependentCount.fetch_add(1);
+	if (!dependency.isDone()) {
+		dependentJobs.push_back(job);
+		return;
+	}
+	dependentCount.fetch_sub(1);
+	guard.unlock();
+	//already counted above
+	job.counter->count.fetch_sub(1, std::memory_order_relaxed);
+	job.dependency = NULL;
+	push(job);
+}
+
+void JobSystem::parallelFor(int begin, int end, int grainSize, IndexFunction function, JobCounter& counter)
+{
+	if (end - begin <= grainSize || workers.empty()) {
+		for (int i = begin; i < end; i++) {
+			function(i);
+		}
+		return;
+	}
+	for (int chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize) {
+		int chunkEnd = chunkBegin + grainSize < end ? chunkBegin + grainSize : end;
+		run(function, chunkBegin, chunkEnd, counter);
+	}
+}
+
+void JobSystem::parallelFor(int begin, int end, int grainSize, IndexFunction function)
+{
+	JobCounter counter;
+	parallelFor(begin, end, grainSize, function, counter);
+	wait(counter);
+}
+
+void JobSystem::push(const Job& job)
+{
+	job.counter->count.fetch_add(1, std::memory_order_relaxed);
+	int queueIndex = currentQueue >= 0 ? currentQueue : (int)queues.size() - 1;
+	{
+		std::lock_guard<std::mutex> guard(queues[queueIndex]->lock);
+		queues[queueIndex]->pushBack(job);
+	}
+	//a sleeper counts itself under sleepLock before it checks for jobs, so taking the lock here means it either
+	//sees this job or is already asleep and gets the notification
+	queuedJobs.fetch_add(1);
+	if (sleepingThreads.load() > 0) {
+		std::lock_guard<std::mutex> guard(sleepLock);
+		wakeUp.notify_one();
+	}
+}
+
+//The counter may be gone once it reaches zero, so it is only compared afterwards, never read
+void JobSystem::finishJob(JobCounter* counter)
+{
+	if (counter->count.fetch_sub(1) != 1) {
+		return;
+	}
+	if (dependentCount.load() > 0) {
+		std::lock_guard<std::mutex> guard(dependentLock);
+		for (int i = 0; i < (int)dependentJobs.size();) {
+			if (dependentJobs[i].dependency != counter) {
+				i++;
+				continue;
+			}
+			Job job = dependentJobs[i];
+			dependentJobs[i] = dependentJobs.back();
+			dependentJobs.pop_back();
+			dependentCount.fetch_sub(1);
+			job.dependency = NULL;
+			//push counts the job again
+			job.counter->count.fetch_sub(1, std::memory_order_relaxed);
+			push(job);
+		}
+	}
+	if (sleepingThreads.load() > 0) {
+		std::lock_guard<std::mutex> guard(sleepLock);
+		wakeUp.notify_all();
+	}
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	int queueIndex = currentQueue >= 0 ? currentQueue : (int)queues.size() - 1;
+	int spins = 0;
+	while (!counter.isDone()) {
+		if (tryRunJob(queueIndex)) {
+			spins = 0;
+			continue;
+		}
+		if (spins < waitSpins) {
+			spins++;
+			std::this_thread::yield();
+			continue;
+		}
+		std::unique_lock<std::mutex> guard(sleepLock);
+		sleepingThreads.fetch_add(1);
+		wakeUp.wait(guard, [this, &counter] { return counter.isDone() || queuedJobs.load() > 0; });
+		sleepingThreads.fetch_sub(1);
+	}
+}
+
+void JobSystem::workerLoop(int index)
+{
+	currentQueue = index;
+	while (running) {
+		if (tryRunJob(index)) {
+			continue;
+		}
+		std::unique_lock<std::mutex> guard(sleepLock);
+		sleepingThreads.fetch_add(1);
+		wakeUp.wait(guard, [this] { return queuedJobs.load() > 0 || !running; });
+		sleepingThreads.fetch_sub(1);
+	}
+}
+
+bool JobSystem::popJob(int queueIndex, Job& job)
+{
+	JobQueue& queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> guard(queue.lock);
+	if (queue.count == 0) {
+		return false;
+	}
+	//newest first, its data is most likely still in cache
+	job = queue.popBack();
+	return true;
+}
+
+bool JobSystem::stealJob(int thiefIndex, Job& job)
+{
+	int queueCount = (int)queues.size();
+	for (int offset = 1; offset < queueCount; offset++) {
+		JobQueue& queue = *queues[(thiefIndex + offset) % queueCount];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		if (queue.count != 0) {
+			//oldest first, usually the biggest remaining piece of work
+			job = queue.popFront();
+			return true;
+		}
+	}
+	return false;
+}
+
+bool JobSystem::tryRunJob(int queueIndex)
+{
+	Job job;
+	if (!popJob(queueIndex, job) && !stealJob(queueIndex, job)) {
+		return false;
+	}
+	queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+	if (job.function != NULL) {
+		job.function(job.data, job.begin, job.end);
+	}
+	else {
+		for (int i = job.begin; i < job.end; i++) {
+			job.indexFunction(i);
+		}
+	}
+	finishJob(job.counter);
+	return true;
+}
+
+JobSystem::~JobSystem()
+{
+	shutdown();
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Counts unfinished jobs, anything waiting on it can continue once it reaches zero.
+//Jobs can also be made to start once a counter reaches zero (JobSystem::runAfter).
+class JobCounter
+{
+public:
+	bool isDone() {
+		return count.load(std::memory_order_acquire) == 0;
+	}
+
+private:
+	friend class JobSystem;
+	std::atomic<int> count{ 0 };
+};
+
+typedef void (*JobFunction)(void* data, int begin, int end);
+typedef void (*IndexFunction)(int index);
+
+//Small work-stealing job system.
+//Every worker owns a queue, it pops its newest job from the back while idle workers steal the oldest from the front.
+//Threads that are not workers (main, simulation) submit into a shared queue and help run jobs while they wait.
+//Idle workers, and waiting threads with nothing left to help with, sleep until a job is queued or a counter finishes.
+class JobSystem
+{
+public:
+	void init(int workerCount); //0 picks one worker per spare core
+	void shutdown();
+	int getWorkerCount();
+
+	void run(JobFunction function, void* data, int begin, int end, JobCounter& counter);
+	void run(IndexFunction function, int begin, int end, JobCounter& counter);
+	//Queued once dependency reaches zero (right away if it already has), counter counts the job from now on.
+	//The dependency must stay alive until counter has been waited on.
+	void runAfter(JobCounter& dependency, JobFunction function, void* data, int begin, int end, JobCounter& counter);
+	void runAfter(JobCounter& dependency, IndexFunction function, int begin, int end, JobCounter& counter);
+	void wait(JobCounter& counter); //runs other jobs while there are any, then sleeps until the counter is done
+
+	//Splits [begin, end) into grainSize chunks, function(i) is called once per index.
+	//Ranges no bigger than one grain run inline, so small entity counts cost nothing extra.
+	//The function object must stay alive until the counter is waited on.
+	template <typename Function>
+	void parallelFor(int begin, int end, int grainSize, Function& function, JobCounter& counter) {
+		if (end - begin <= grainSize || workers.empty()) {
+			for (int i = begin; i < end; i++) {
+				function(i);
+			}
+			return;
+		}
+		for (int chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize) {
+			int chunkEnd = chunkBegin + grainSize < end ? chunkBegin + grainSize : end;
+			run(&runRange<Function>, &function, chunkBegin, chunkEnd, counter);
+		}
+	}
+	template <typename Function>
+	void parallelFor(int begin, int end, int grainSize, Function function) {
+		JobCounter counter;
+		parallelFor(begin, end, grainSize, function, counter);
+		wait(counter);
+	}
+	//Plain functions need no storage, so these can be given any free function
+	void parallelFor(int begin, int end, int grainSize, IndexFunction function, JobCounter& counter);
+	void parallelFor(int begin, int end, int grainSize, IndexFunction function);
+
+	~JobSystem();
+
+private:
+	struct Job {
+		JobFunction function;
+		IndexFunction indexFunction;
+		void* data;
+		int begin;
+		int end;
+		JobCounter* counter;
+		JobCounter* dependency; //only set while the job waits in dependentJobs
+	};
+	//Ring buffer that only ever grows, so once a queue has seen its busiest frame pushing never allocates again
+	struct JobQueue {
+		static const int initialCapacity = 256;
+
+		std::mutex lock;
+		std::vector<Job> ring;
+		int head = 0; //oldest job
+		int count = 0;
+
+		JobQueue();
+		void pushBack(const Job& job);
+		Job popBack();
+		Job popFront();
+	};
+
+	template <typename Function>
+	static void runRange(void* data, int begin, int end) {
+		Function& function = *(Function*)data;
+		for (int i = begin; i < end; i++) {
+			function(i);
+		}
+	}
+
+	static const int waitSpins = 64; //yields before a waiting thread goes to sleep, the last jobs are usually almost done
+
+	void push(const Job& job);
+	void runAfter(JobCounter& dependency, Job job);
+	void finishJob(JobCounter* counter);
+	void workerLoop(int index);
+	bool popJob(int queueIndex, Job& job);
+	bool stealJob(int thiefIndex, Job& job);
+	bool tryRunJob(int queueIndex);
+
+	std::vector<std::unique_ptr<JobQueue>> queues; //one per worker, the last one is shared by non-worker threads
+	std::vector<std::thread> workers;
+	std::atomic<bool> running{ false };
+	std::atomic<int> queuedJobs{ 0 };
+	std::atomic<int> sleepingThreads{ 0 };
+	std::mutex sleepLock;
+	std::condition_variable wakeUp;
+	std::mutex dependentLock;
+	std::vector<Job> dependentJobs; //waiting for their dependency, reused so steady use does not allocate
+	std::atomic<int> dependentCount{ 0 };
+};
@@ -0,0 +1,168 @@
+#include "LatencyTracker.h"
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+void LatencyHistogram::record(long long microseconds)
+{
+	int bucket = (int)(microseconds / bucketMicroseconds);
+	if (bucket < 0) {
+		bucket = 0;
+	}
+	if (bucket > bucketCount - 1) {
+		bucket = bucketCount - 1;
+	}
+	buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	sampleCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset()
+{
+	for (int i = 0; i < bucketCount; i++) {
+		buckets[i] = 0;
+	}
+	sampleCount = 0;
+}
+
+float LatencyHistogram::percentile(float p)
+{
+	if (sampleCount == 0) {
+		return 0;
+	}
+	long long target = (long long)(sampleCount.load() * p / 100);
+	long long seen = 0;
+	for (int i = 0; i < bucketCount; i++) {
+		seen += buckets[i];
+		if (seen > target) {
+			//report the upper edge of the bucket so the value is never optimistic
+			return (i + 1) * bucketMicroseconds / 1000.0f;
+		}
+	}
+	return bucketCount * bucketMicroseconds / 1000.0f;
+}
+
+long long LatencyHistogram::getSampleCount()
+{
+	return sampleCount;
+}
+
+int LatencyHistogram::getBucket(int index)
+{
+	return buckets[index];
+}
+
+void LatencyTracker::captureInput(int sources)
+{
+	if (sources == 0) {
+		return;
+	}
+	if (pendingCount == maxPendingEvents) {
+		droppedEvents++;
+		return;
+	}
+	pendingEvents[pendingCount].captured = Clock::now();
+	pendingEvents[pendingCount].sources = sources;
+	pendingCount++;
+}
+
+void LatencyTracker::consumeInput(int sources)
+{
+	consumeInput(sources, 0);
+}
+
+void LatencyTracker::consumeInput(int sources, long long tick)
+{
+	Clock::time_point now = Clock::now();
+	unsigned int head = consumedHead.load(std::memory_order_relaxed);
+	int kept = 0;
+	for (int i = 0; i < pendingCount; i++) {
+		if ((pendingEvents[i].sources & sources) == 0) {
+			//still waiting for a tick, keep it in capture order
+			pendingEvents[kept] = pendingEvents[i];
+			kept++;
+			continue;
+		}
+		inputToSim.record(std::chrono::duration_cast<std::chrono::microseconds>(now - pendingEvents[i].captured).count());
+		if (head - consumedTail.load(std::memory_order_acquire) == maxConsumedEvents) {
+			droppedEvents++;
+			continue;
+		}
+		consumedEvents[head % maxConsumedEvents].captured = pendingEvents[i].captured;
+		consumedEvents[head % maxConsumedEvents].tick = tick;
+		head++;
+	}
+	pendingCount = kept;
+	consumedHead.store(head, std::memory_order_release);
+}
+
+void LatencyTracker::framePresented()
+{
+	framePresented(LLONG_MAX);
+}
+
+void LatencyTracker::framePresented(long long presentedTick)
+{
+	Clock::time_point now = Clock::now();
+	unsigned int head = consumedHead.load(std::memory_order_acquire);
+	unsigned int tail = consumedTail.load(std::memory_order_relaxed);
+	while (tail != head && consumedEvents[tail % maxConsumedEvents].tick <= presentedTick) {
+		inputToPresent.record(std::chrono::duration_cast<std::chrono::microseconds>(now - consumedEvents[tail % maxConsumedEvents].captured).count());
+		tail++;
+	}
+	consumedTail.store(tail, std::memory_order_release);
+}
+
+LatencyHistogram& LatencyTracker::getInputToSim()
+{
+	return inputToSim;
+}
+
+LatencyHistogram& LatencyTracker::getInputToPresent()
+{
+	return inputToPresent;
+}
+
+long long LatencyTracker::getDroppedEvents()
+{
+	return droppedEvents;
+}
+
+void LatencyTracker::formatOverlay(char* text, int textSize)
+{
+	snprintf(text, textSize, "Input->Sim      p50 %.1fms  p95 %.1fms  p99 %.1fms\nInput->Present p50 %.1fms  p95 %.1fms  p99 %.1fms",
+		inputToSim.percentile(50), inputToSim.percentile(95), inputToSim.percentile(99),
+		inputToPresent.percentile(50), inputToPresent.percentile(95), inputToPresent.percentile(99));
+}
+
+bool LatencyTracker::exportToFile(const char* fileName)
+{
+	std::ofstream file(fileName);
+	if (!file.is_open()) {
+		return false;
+	}
+	file << std::fixed << std::setprecision(2);
+	file << "metric,samples,p50_ms,p95_ms,p99_ms\n";
+	file << "input_to_sim," << inputToSim.getSampleCount() << "," << inputToSim.percentile(50) << "," << inputToSim.percentile(95) << "," << inputToSim.percentile(99) << "\n";
+	file << "input_to_present," << inputToPresent.getSampleCount() << "," << inputToPresent.percentile(50) << "," << inputToPresent.percentile(95) << "," << inputToPresent.percentile(99) << "\n";
+	file << "dropped_events," << droppedEvents << "\n\n";
+
+	//raw buckets so the distributions can be plotted, empty buckets are skipped
+	file << std::setprecision(1);
+	file << "bucket_ms,input_to_sim,input_to_present\n";
+	for (int i = 0; i < LatencyHistogram::bucketCount; i++) {
+		if (inputToSim.getBucket(i) != 0 || inputToPresent.getBucket(i) != 0) {
+			file << i * LatencyHistogram::bucketMicroseconds / 1000.0f << "," << inputToSim.getBucket(i) << "," << inputToPresent.getBucket(i) << "\n";
+		}
+	}
+	return true;
+}
+
+void LatencyTracker::reset()
+{
+	pendingCount = 0;
+	consumedTail.store(consumedHead.load());
+	droppedEvents = 0;
+	inputToSim.reset();
+	inputToPresent.reset();
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+
+enum InputSource { KeyboardInput = 1, MouseInput = 2 };
+
+//Fixed bucket histogram for latency samples (0.1ms buckets, last bucket holds everything above)
+//Counters are atomic so another thread can read percentiles while samples are recorded
+class LatencyHistogram
+{
+public:
+	static const int bucketCount = 2000;
+	static const int bucketMicroseconds = 100;
+
+	void record(long long microseconds);
+	void reset();
+	float percentile(float p); //in milliseconds
+	long long getSampleCount();
+	int getBucket(int index);
+
+private:
+	std::atomic<int> buckets[bucketCount] = {};
+	std::atomic<long long> sampleCount{ 0 };
+};
+
+//Traces every input event from the poll that captured it to the tick that consumed it and the Present that showed it
+//Capture/consume run on the simulation thread and framePresented on the render thread, consumed events are handed over through a lock-free ring
+class LatencyTracker
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	void captureInput(int sources); //call after polling the devices
+	void consumeInput(int sources); //call when the input is applied and shown by the next Present
+	void consumeInput(int sources, long long tick); //call when the simulation tick has applied the input
+	void framePresented(); //call right after Present (headless builds call it in place of Present)
+	void framePresented(long long presentedTick); //only events consumed up to this tick are visible
+
+	LatencyHistogram& getInputToSim();
+	LatencyHistogram& getInputToPresent();
+	long long getDroppedEvents();
+	void formatOverlay(char* text, int textSize);
+	bool exportToFile(const char* fileName);
+	void reset();
+
+private:
+	static const int maxPendingEvents = 256;
+	static const int maxConsumedEvents = 1024;
+
+	struct InputEvent {
+		Clock::time_point captured;
+		int sources;
+	};
+	struct ConsumedEvent {
+		Clock::time_point captured;
+		long long tick;
+	};
+
+	//Owned by the thread polling input
+	InputEvent pendingEvents[maxPendingEvents];
+	int pendingCount = 0;
+
+	//Single producer / single consumer ring between consumeInput and framePresented
+	ConsumedEvent consumedEvents[maxConsumedEvents];
+	std::atomic<unsigned int> consumedHead{ 0 };
+	std::atomic<unsigned int> consumedTail{ 0 };
+
+	std::atomic<long long> droppedEvents{ 0 };
+	LatencyHistogram inputToSim;
+	LatencyHistogram inputToPresent;
+};
@@ -0,0 +1,281 @@
+#pragma once
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MATH2D_SSE2
+#endif
+
+//2D math for the game without D3DX, so gameplay code builds on any platform. Matrices use the D3DX row vector
+//convention, a point is transformed as [x y 1] * M and A * B applies A first, so a Mat3x2 is the top two columns of
+//the D3DXMATRIX D3DX would build. Vec2 has the same layout and operators as D3DXVECTOR2.
+//The SIMD and scalar paths round the same only if a * b + c is never fused into an FMA: the Linux build passes
+//-ffp-contract=off, MSVC does not contract without /fp:contract.
+
+struct Vec2 {
+	float x;
+	float y;
+
+	Vec2() = default; //uninitialised like D3DXVECTOR2, Vec2() with parentheses is zero
+	constexpr Vec2(float x, float y) : x(x), y(y) {
+	}
+
+	constexpr Vec2 operator-() const {
+		return Vec2(-x, -y);
+	}
+	constexpr Vec2& operator+=(const Vec2& other) {
+		x += other.x;
+		y += other.y;
+		return *this;
+	}
+	constexpr Vec2& operator-=(const Vec2& other) {
+		x -= other.x;
+		y -= other.y;
+		return *this;
+	}
+	constexpr Vec2& operator*=(float scale) {
+		x *= scale;
+		y *= scale;
+		return *this;
+	}
+	constexpr Vec2& operator/=(float divisor) {
+		x /= divisor;
+		y /= divisor;
+		return *this;
+	}
+};
+
+constexpr Vec2 operator+(const Vec2& a, const Vec2& b) {
+	return Vec2(a.x + b.x, a.y + b.y);
+}
+
+constexpr Vec2 operator-(const Vec2& a, const Vec2& b) {
+	return Vec2(a.x - b.x, a.y - b.y);
+}
+
+constexpr Vec2 operator*(const Vec2& v, float scale) {
+	return Vec2(v.x * scale, v.y * scale);
+}
+
+constexpr Vec2 operator*(float scale, const Vec2& v) {
+	return Vec2(v.x * scale, v.y * scale);
+}
+
+constexpr Vec2 operator/(const Vec2& v, float divisor) {
+	return Vec2(v.x / divisor, v.y / divisor);
+}
+
+constexpr bool operator==(const Vec2& a, const Vec2& b) {
+	return a.x == b.x && a.y == b.y;
+}
+
+constexpr bool operator!=(const Vec2& a, const Vec2& b) {
+	return !(a == b);
+}
+
+constexpr float dot(const Vec2& a, const Vec2& b) {
+	return a.x * b.x + a.y * b.y;
+}
+
+constexpr float lengthSquared(const Vec2& v) {
+	return v.x * v.x + v.y * v.y;
+}
+
+inline float length(const Vec2& v) {
+	return std::sqrt(lengthSquared(v));
+}
+
+//Zero stays zero
+inline Vec2 normalize(const Vec2& v) {
+	float vectorLength = length(v);
+	return vectorLength > 0 ? v / vectorLength : Vec2(0, 0);
+}
+
+//| m11 m12 |
+//| m21 m22 |
+//| dx  dy  |
+struct Mat3x2 {
+	float m11, m12;
+	float m21, m22;
+	float dx, dy;
+};
+
+constexpr Mat3x2 identity2D() {
+	return Mat3x2{ 1, 0, 0, 1, 0, 0 };
+}
+
+constexpr Mat3x2 translation2D(float x, float y) {
+	return Mat3x2{ 1, 0, 0, 1, x, y };
+}
+
+constexpr Mat3x2 scaling2D(float x, float y) {
+	return Mat3x2{ x, 0, 0, y, 0, 0 };
+}
+
+inline Mat3x2 rotation2D(float angle) {
+	float sine = std::sin(angle);
+	float cosine = std::cos(angle);
+	return Mat3x2{ cosine, sine, -sine, cosine, 0, 0 };
+}
+
+constexpr Mat3x2 operator*(const Mat3x2& a, const Mat3x2& b) {
+	return Mat3x2{
+		a.m11 * b.m11 + a.m12 * b.m21, a.m11 * b.m12 + a.m12 * b.m22,
+		a.m21 * b.m11 + a.m22 * b.m21, a.m21 * b.m12 + a.m22 * b.m22,
+		a.dx * b.m11 + a.dy * b.m21 + b.dx, a.dx * b.m12 + a.dy * b.m22 + b.dy
+	};
+}
+
+constexpr Vec2 transformPoint(const Mat3x2& m, const Vec2& point) {
+	return Vec2{ point.x * m.m11 + point.y * m.m21 + m.dx, point.x * m.m12 + point.y * m.m22 + m.dy };
+}
+
+//Same parameters and result as D3DXMatrixTransformation2D:
+//scale around scalingCenter along axes turned by scalingRotation, then rotate around rotationCenter, then translate
+inline Mat3x2 transformation2D(const Vec2& scalingCenter, float scalingRotation, const Vec2& scaling, const Vec2& rotationCenter, float rotation, const Vec2& translation) {
+	Mat3x2 scale = scaling2D(scaling.x, scaling.y);
+	if (scalingRotation != 0) {
+		scale = rotation2D(-scalingRotation) * scale * rotation2D(scalingRotation);
+	}
+	return translation2D(-scalingCenter.x, -scalingCenter.y) * scale * translation2D(scalingCenter.x - rotationCenter.x, scalingCenter.y - rotationCenter.y)
+		* rotation2D(rotation) * translation2D(rotationCenter.x + translation.x, rotationCenter.y + translation.y);
+}
+
+//sin and cos of the same angle, good to about 1e-7 for angles up to a few thousand radians.
+//The angle is reduced to [-pi/4, pi/4] around the nearest multiple of pi/2 and both come from short polynomials,
+//the batched version below runs the same steps on four angles at once.
+namespace math2D {
+	const float twoOverPi = 0.636619772f;
+	//pi/2 split in three so the reduction stays exact
+	const float halfPi1 = 1.5703125f;
+	const float halfPi2 = 4.837512969970703125e-4f;
+	const float halfPi3 = 7.54978995489188216e-8f;
+	const float sin3 = -1.6666654611e-1f;
+	const float sin5 = 8.3321608736e-3f;
+	const float sin7 = -1.9515295891e-4f;
+	const float cos4 = 4.166664568298827e-2f;
+	const float cos6 = -1.388731625493765e-3f;
+	const float cos8 = 2.443315711809948e-5f;
+}
+
+inline void sinCos(float angle, float& sine, float& cosine) {
+	using namespace math2D;
+	float quadrant = std::nearbyint(angle * twoOverPi);
+	float reduced = ((angle - quadrant * halfPi1) - quadrant * halfPi2) - quadrant * halfPi3;
+	float squared = reduced * reduced;
+	float s = reduced + reduced * squared * (sin3 + squared * (sin5 + squared * sin7));
+	float c = 1 - 0.5f * squared + squared * squared * (cos4 + squared * (cos6 + squared * cos8));
+	int q = (int)quadrant;
+	sine = (q & 1) ? c : s;
+	cosine = (q & 1) ? s : c;
+	if (q & 2) {
+		sine = -sine;
+	}
+	if ((q + 1) & 2) {
+		cosine = -cosine;
+	}
+}
+
+#ifdef MATH2D_SSE2
+inline void sinCos4(__m128 angle, __m128& sine, __m128& cosine) {
+	using namespace math2D;
+	__m128i q = _mm_cvtps_epi32(_mm_mul_ps(angle, _mm_set1_ps(twoOverPi))); //rounds to nearest like nearbyint
+	__m128 quadrant = _mm_cvtepi32_ps(q);
+	__m128 reduced = _mm_sub_ps(angle, _mm_mul_ps(quadrant, _mm_set1_ps(halfPi1)));
+	reduced = _mm_sub_ps(reduced, _mm_mul_ps(quadrant, _mm_set1_ps(halfPi2)));
+	reduced = _mm_sub_ps(reduced, _mm_mul_ps(quadrant, _mm_set1_ps(halfPi3)));
+	__m128 squared = _mm_mul_ps(reduced, reduced);
+
+	__m128 s = _mm_add_ps(_mm_set1_ps(sin5), _mm_mul_ps(squared, _mm_set1_ps(sin7)));
+	s = _mm_add_ps(_mm_set1_ps(sin3), _mm_mul_ps(squared, s));
+	s = _mm_add_ps(reduced, _mm_mul_ps(_mm_mul_ps(reduced, squared), s));
+	__m128 c = _mm_add_ps(_mm_set1_ps(cos6), _mm_mul_ps(squared, _mm_set1_ps(cos8)));
+	c = _mm_add_ps(_mm_set1_ps(cos4), _mm_mul_ps(squared, c));
+	c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1), _mm_mul_ps(_mm_set1_ps(0.5f), squared)), _mm_mul_ps(_mm_mul_ps(squared, squared), c));
+
+	//odd quadrants swap the two, the sign bits come from bit 1 of q and q + 1
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+	__m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+	sine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sineSign);
+	cosine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosineSign);
+}
+#endif
+
+//World matrices for count sprites drawn the usual way: scaled and rotated about the same point of their frame
+//(center), no scaling rotation, then moved to (x, y). Equal to transformation2D(center, 0, scale, center, rotation, xy).
+//Inputs are one array per field, scaleX/scaleY can be NULL for sprites drawn at their own size.
+inline void buildSpriteMatrices(int count, const float* x, const float* y, const float* rotation, const float* scaleX, const float* scaleY, float centerX, float centerY, Mat3x2* matrices) {
+	int i = 0;
+#ifdef MATH2D_SSE2
+	__m128 cx = _mm_set1_ps(centerX);
+	__m128 cy = _mm_set1_ps(centerY);
+	for (; i + 4 <= count; i += 4) {
+		__m128 sine, cosine;
+		sinCos4(_mm_loadu_ps(rotation + i), sine, cosine);
+		__m128 sx = scaleX != NULL ? _mm_loadu_ps(scaleX + i) : _mm_set1_ps(1);
+		__m128 sy = scaleY != NULL ? _mm_loadu_ps(scaleY + i) : _mm_set1_ps(1);
+		__m128 m11 = _mm_mul_ps(sx, cosine);
+		__m128 m12 = _mm_mul_ps(sx, sine);
+		__m128 m21 = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(sy, sine));
+		__m128 m22 = _mm_mul_ps(sy, cosine);
+		__m128 dx = _mm_add_ps(_mm_sub_ps(_mm_add_ps(cx, _mm_loadu_ps(x + i)), _mm_mul_ps(cx, m11)), _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), cy), m21));
+		__m128 dy = _mm_add_ps(_mm_sub_ps(_mm_add_ps(cy, _mm_loadu_ps(y + i)), _mm_mul_ps(cx, m12)), _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), cy), m22));
+		//four matrices are 24 floats, written field by field
+		float fields[6][4];
+		_mm_storeu_ps(fields[0], m11);
+		_mm_storeu_ps(fields[1], m12);
+		_mm_storeu_ps(fields[2], m21);
+		_mm_storeu_ps(fields[3], m22);
+		_mm_storeu_ps(fields[4], dx);
+		_mm_storeu_ps(fields[5], dy);
+		for (int lane = 0; lane < 4; lane++) {
+			matrices[i + lane] = Mat3x2{ fields[0][lane], fields[1][lane], fields[2][lane], fields[3][lane], fields[4][lane], fields[5][lane] };
+		}
+	}
+#endif
+	for (; i < count; i++) {
+		float sine, cosine;
+		sinCos(rotation[i], sine, cosine);
+		float sx = scaleX != NULL ? scaleX[i] : 1;
+		float sy = scaleY != NULL ? scaleY[i] : 1;
+		Mat3x2& m = matrices[i];
+		m.m11 = sx * cosine;
+		m.m12 = sx * sine;
+		m.m21 = -(sy * sine);
+		m.m22 = sy * cosine;
+		m.dx = centerX + x[i] - centerX * m.m11 + -centerY * m.m21;
+		m.dy = centerY + y[i] - centerX * m.m12 + -centerY * m.m22;
+	}
+}
+
+//position[i] += velocity[i], then velocity[i] *= damping, for count bodies. Same results as the scalar steps.
+inline void integrate2D(int count, Vec2* position, Vec2* velocity, float damping) {
+	int i = 0;
+#ifdef MATH2D_SSE2
+	//two vectors per register
+	__m128 scale = _mm_set1_ps(damping);
+	for (; i + 2 <= count; i += 2) {
+		__m128 v = _mm_loadu_ps(&velocity[i].x);
+		_mm_storeu_ps(&position[i].x, _mm_add_ps(_mm_loadu_ps(&position[i].x), v));
+		_mm_storeu_ps(&velocity[i].x, _mm_mul_ps(v, scale));
+	}
+#endif
+	for (; i < count; i++) {
+		position[i] += velocity[i];
+		velocity[i] *= damping;
+	}
+}
+
+//out[i] += add[i] * scale for count vectors
+inline void addScaled2D(int count, Vec2* out, const Vec2* add, float scale) {
+	int i = 0;
+#ifdef MATH2D_SSE2
+	__m128 factor = _mm_set1_ps(scale);
+	for (; i + 2 <= count; i += 2) {
+		_mm_storeu_ps(&out[i].x, _mm_add_ps(_mm_loadu_ps(&out[i].x), _mm_mul_ps(_mm_loadu_ps(&add[i].x), factor)));
+	}
+#endif
+	for (; i < count; i++) {
+		out[i] += add[i] * scale;
+	}
+}
@@ -0,0 +1,437 @@
+#include "MenuLayout.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+MenuScreen::MenuScreen(const std::string& name)
+{
+	this->name = name;
+}
+
+int MenuScreen::addWidget(const MenuWidget& widget)
+{
+	widgets.push_back(widget);
+	widgets.back().text.reserve(textCapacity);
+	shown.push_back(false);
+	dirty = true;
+	return (int)widgets.size() - 1;
+}
+
+int MenuScreen::findWidget(const std::string& name)
+{
+	for (int i = 0; i < (int)widgets.size(); i++) {
+		if (widgets[i].name == name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+MenuWidget& MenuScreen::getWidget(int index)
+{
+	return widgets[index];
+}
+
+int MenuScreen::getWidgetCount()
+{
+	return (int)widgets.size();
+}
+
+const std::string& MenuScreen::getName()
+{
+	return name;
+}
+
+void MenuScreen::setOffset(float x, float y)
+{
+	if (x != offsetX || y != offsetY) {
+		offsetX = x;
+		offsetY = y;
+		dirty = true;
+	}
+}
+
+void MenuScreen::setText(int widget, const std::string& text)
+{
+	if (widgets[widget].text != text) {
+		widgets[widget].text = text;
+		dirty = true;
+	}
+}
+
+void MenuScreen::setText(int widget, const char* text)
+{
+	if (widgets[widget].text != text) {
+		widgets[widget].text = text;
+		dirty = true;
+	}
+}
+
+void MenuScreen::setVisible(int widget, bool visible)
+{
+	if (widgets[widget].visible != visible) {
+		widgets[widget].visible = visible;
+		dirty = true;
+	}
+}
+
+const std::vector<MenuDrawItem>& MenuScreen::getDrawList()
+{
+	if (dirty) {
+		layout();
+	}
+	return drawList;
+}
+
+int MenuScreen::getVersion()
+{
+	if (dirty) {
+		layout();
+	}
+	return version;
+}
+
+void MenuScreen::layout()
+{
+	drawList.clear();
+	//parents come first, so one pass in order sees every parent already placed
+	for (int i = 0; i < (int)widgets.size(); i++) {
+		MenuWidget& widget = widgets[i];
+		float parentX = offsetX;
+		float parentY = offsetY;
+		bool parentShown = true;
+		if (widget.parent >= 0) {
+			parentX = widgets[widget.parent].worldX;
+			parentY = widgets[widget.parent].worldY;
+			parentShown = shown[widget.parent];
+		}
+		//scaling about the origin moves the top left corner, the same as D3DXMatrixTransformation2D with a scaling centre
+		widget.worldX = parentX + widget.x + widget.originX * (1 - widget.scaleX);
+		widget.worldY = parentY + widget.y + widget.originY * (1 - widget.scaleY);
+		shown[i] = parentShown && widget.visible;
+		if (shown[i]) {
+			MenuDrawItem item = { i, widget.scaleX, widget.scaleY, widget.worldX, widget.worldY };
+			drawList.push_back(item);
+		}
+	}
+	buildHitGrid();
+	version++;
+	dirty = false;
+}
+
+void MenuScreen::buildHitGrid()
+{
+	for (int i = 0; i < (int)hitGrid.size(); i++) {
+		hitGrid[i].clear();
+	}
+	float left = 0;
+	float top = 0;
+	float right = 0;
+	float bottom = 0;
+	bool any = false;
+	for (int i = 0; i < (int)drawList.size(); i++) {
+		MenuWidget& widget = widgets[drawList[i].widget];
+		if (widget.type != MenuButton) {
+			continue;
+		}
+		if (!any || widget.worldX < left) {
+			left = widget.worldX;
+		}
+		if (!any || widget.worldY < top) {
+			top = widget.worldY;
+		}
+		if (!any || widget.worldX + widget.width > right) {
+			right = widget.worldX + widget.width;
+		}
+		if (!any || widget.worldY + widget.height > bottom) {
+			bottom = widget.worldY + widget.height;
+		}
+		any = true;
+	}
+	if (!any) {
+		gridColumns = 0;
+		gridRows = 0;
+		return;
+	}
+	gridLeft = left;
+	gridTop = top;
+	gridColumns = (int)((right - left) / cellSize) + 1;
+	gridRows = (int)((bottom - top) / cellSize) + 1;
+	if ((int)hitGrid.size() < gridColumns * gridRows) {
+		hitGrid.resize(gridColumns * gridRows);
+	}
+	//in draw order, so the last button of a cell is the one on top
+	for (int i = 0; i < (int)drawList.size(); i++) {
+		int index = drawList[i].widget;
+		MenuWidget& widget = widgets[index];
+		if (widget.type != MenuButton) {
+			continue;
+		}
+		int firstColumn = (int)((widget.worldX - gridLeft) / cellSize);
+		int lastColumn = (int)((widget.worldX + widget.width - gridLeft) / cellSize);
+		int firstRow = (int)((widget.worldY - gridTop) / cellSize);
+		int lastRow = (int)((widget.worldY + widget.height - gridTop) / cellSize);
+		for (int row = firstRow; row <= lastRow; row++) {
+			for (int column = firstColumn; column <= lastColumn; column++) {
+				hitGrid[row * gridColumns + column].push_back(index);
+			}
+		}
+	}
+}
+
+int MenuScreen::hitTest(float x, float y)
+{
+	if (dirty) {
+		layout();
+	}
+	if (x < gridLeft || y < gridTop) {
+		return -1;
+	}
+	int column = (int)((x - gridLeft) / cellSize);
+	int row = (int)((y - gridTop) / cellSize);
+	if (column >= gridColumns || row >= gridRows) {
+		return -1;
+	}
+	const std::vector<int>& cell = hitGrid[row * gridColumns + column];
+	for (int i = (int)cell.size() - 1; i >= 0; i--) {
+		MenuWidget& widget = widgets[cell[i]];
+		if (x >= widget.worldX && x <= widget.worldX + widget.width && y >= widget.worldY && y <= widget.worldY + widget.height) {
+			return cell[i];
+		}
+	}
+	return -1;
+}
+
+int MenuScreen::click(float x, float y)
+{
+	int button = hitTest(x, y);
+	if (button < 0) {
+		return -1;
+	}
+	std::map<std::string, MenuAction>::iterator action = actions.find(widgets[button].action);
+	if (action != actions.end()) {
+		action->second(widgets[button].argument);
+	}
+	return button;
+}
+
+void MenuScreen::bindAction(const std::string& action, MenuAction function)
+{
+	actions[action] = function;
+}
+
+bool MenuLayout::loadFromFile(const std::string& fileName)
+{
+	std::ifstream file(fileName);
+	if (!file) {
+		error = "cannot open " + fileName;
+		screens.clear();
+		return false;
+	}
+	std::stringstream text;
+	text << file.rdbuf();
+	return loadFromText(text.str());
+}
+
+bool MenuLayout::loadFromText(const std::string& text)
+{
+	screens.clear();
+	error.clear();
+	std::istringstream lines(text);
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(lines, line)) {
+		lineNumber++;
+		if (!parseLine(line, lineNumber)) {
+			screens.clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+MenuScreen* MenuLayout::getScreen(const std::string& name)
+{
+	for (int i = 0; i < (int)screens.size(); i++) {
+		if (screens[i]->getName() == name) {
+			return screens[i].get();
+		}
+	}
+	return NULL;
+}
+
+const std::string& MenuLayout::getError()
+{
+	return error;
+}
+
+bool MenuLayout::fail(int lineNumber, const std::string& message)
+{
+	error = "line " + std::to_string(lineNumber) + ": " + message;
+	return false;
+}
+
+//Splits on spaces outside double quotes, quotes are removed
+static std::vector<std::string> splitLine(const std::string& line)
+{
+	std::vector<std::string> tokens;
+	std::string token;
+	bool quoted = false;
+	bool inToken = false;
+	for (int i = 0; i < (int)line.size(); i++) {
+		char c = line[i];
+		if (c == '"') {
+			quoted = !quoted;
+			inToken = true;
+		}
+		else if (!quoted && c == '#') {
+			break;
+		}
+		else if (!quoted && (c == ' ' || c == '\t' || c == '\r')) {
+			if (inToken) {
+				tokens.push_back(token);
+				token.clear();
+				inToken = false;
+			}
+		}
+		else {
+			token += c;
+			inToken = true;
+		}
+	}
+	if (inToken) {
+		tokens.push_back(token);
+	}
+	return tokens;
+}
+
+//Reads count comma separated numbers, a single number is repeated
+static bool parseNumbers(const std::string& value, float* numbers, int count)
+{
+	std::vector<float> parsed;
+	size_t start = 0;
+	while (start <= value.size()) {
+		size_t comma = value.find(',', start);
+		std::string part = value.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+		char* end;
+		float number = strtof(part.c_str(), &end);
+		if (part.empty() || *end != 0) {
+			return false;
+		}
+		parsed.push_back(number);
+		if (comma == std::string::npos) {
+			break;
+		}
+		start = comma + 1;
+	}
+	if ((int)parsed.size() != count && parsed.size() != 1) {
+		return false;
+	}
+	for (int i = 0; i < count; i++) {
+		numbers[i] = parsed.size() == 1 ? parsed[0] : parsed[i];
+	}
+	return true;
+}
+
+bool MenuLayout::parseLine(const std::string& line, int lineNumber)
+{
+	std::vector<std::string> tokens = splitLine(line);
+	if (tokens.empty()) {
+		return true;
+	}
+	if (tokens[0] == "screen") {
+		if (tokens.size() != 2) {
+			return fail(lineNumber, "screen needs a name");
+		}
+		screens.push_back(std::unique_ptr<MenuScreen>(new MenuScreen(tokens[1])));
+		return true;
+	}
+	MenuWidget widget;
+	if (tokens[0] == "image") {
+		widget.type = MenuImage;
+	}
+	else if (tokens[0] == "text") {
+		widget.type = MenuText;
+	}
+	else if (tokens[0] == "button") {
+		widget.type = MenuButton;
+	}
+	else {
+		return fail(lineNumber, "unknown widget " + tokens[0]);
+	}
+	if (screens.empty()) {
+		return fail(lineNumber, "widget before the first screen");
+	}
+	if (tokens.size() < 2 || tokens[1].find('=') != std::string::npos) {
+		return fail(lineNumber, "widget needs a name");
+	}
+	MenuScreen& screen = *screens.back();
+	widget.name = tokens[1];
+	for (int i = 2; i < (int)tokens.size(); i++) {
+		size_t equals = tokens[i].find('=');
+		if (equals == std::string::npos) {
+			return fail(lineNumber, "expected key=value, got " + tokens[i]);
+		}
+		std::string key = tokens[i].substr(0, equals);
+		std::string value = tokens[i].substr(equals + 1);
+		float numbers[3] = {};
+		bool valid = true;
+		if (key == "parent") {
+			widget.parent = screen.findWidget(value);
+			valid = widget.parent >= 0;
+		}
+		else if (key == "x") {
+			valid = parseNumbers(value, &widget.x, 1);
+		}
+		else if (key == "y") {
+			valid = parseNumbers(value, &widget.y, 1);
+		}
+		else if (key == "scale") {
+			valid = parseNumbers(value, numbers, 2);
+			widget.scaleX = numbers[0];
+			widget.scaleY = numbers[1];
+		}
+		else if (key == "origin") {
+			valid = parseNumbers(value, numbers, 2);
+			widget.originX = numbers[0];
+			widget.originY = numbers[1];
+		}
+		else if (key == "size") {
+			valid = parseNumbers(value, numbers, 2);
+			widget.width = numbers[0];
+			widget.height = numbers[1];
+		}
+		else if (key == "frame") {
+			valid = parseNumbers(value, numbers, 1);
+			widget.frame = (int)numbers[0];
+		}
+		else if (key == "argument") {
+			valid = parseNumbers(value, numbers, 1);
+			widget.argument = (int)numbers[0];
+		}
+		else if (key == "color") {
+			valid = parseNumbers(value, numbers, 3);
+			widget.color = 0xFF000000 | ((uint32_t)numbers[0] & 0xFF) << 16 | ((uint32_t)numbers[1] & 0xFF) << 8 | ((uint32_t)numbers[2] & 0xFF);
+		}
+		else if (key == "image") {
+			widget.image = value;
+		}
+		else if (key == "text") {
+			widget.text = value;
+		}
+		else if (key == "action") {
+			widget.action = value;
+		}
+		else {
+			return fail(lineNumber, "unknown key " + key);
+		}
+		if (!valid) {
+			return fail(lineNumber, "bad value for " + key + ": " + value);
+		}
+	}
+	if (screen.findWidget(widget.name) >= 0) {
+		return fail(lineNumber, "duplicate widget " + widget.name);
+	}
+	screen.addWidget(widget);
+	return true;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum MenuWidgetType { MenuImage, MenuText, MenuButton };
+
+typedef void (*MenuAction)(int argument);
+
+//One node of a menu. Positions are relative to the parent, the world values are filled in by the layout pass.
+struct MenuWidget {
+	std::string name;
+	int type = MenuImage;
+	int parent = -1;
+	float x = 0;
+	float y = 0;
+	float scaleX = 1;
+	float scaleY = 1;
+	float originX = 0;   //scaling centre
+	float originY = 0;
+	float width = 0;     //hit area of buttons, text box of text
+	float height = 0;
+	std::string image;   //resolved to a texture by the game
+	int frame = -1;      //sprite sheet frame, -1 draws the whole texture
+	std::string text;
+	uint32_t color = 0xFFFFFFFF;
+	std::string action;  //buttons only
+	int argument = 0;
+	bool visible = true;
+
+	float worldX = 0;
+	float worldY = 0;
+};
+
+//What the renderer draws for one widget: a scale and translation plus the widget's image or text
+struct MenuDrawItem {
+	int widget;
+	float scaleX;
+	float scaleY;
+	float x;
+	float y;
+};
+
+//A retained tree of widgets. Transforms, the draw list and the hit test grid are only rebuilt after something
+//changes (offset, text, visibility), so an idle menu costs nothing but drawing the cached list.
+class MenuScreen
+{
+public:
+	MenuScreen(const std::string& name);
+
+	int addWidget(const MenuWidget& widget); //parents must be added before their children
+	int findWidget(const std::string& name);
+	MenuWidget& getWidget(int index);
+	int getWidgetCount();
+	const std::string& getName();
+
+	//Moves the whole screen, used by the slide in and out transitions
+	void setOffset(float x, float y);
+	void setText(int widget, const std::string& text);
+	//No temporary string, unchanged text costs a compare. Text up to textCapacity characters is copied into the
+	//space the widget reserved, so changing it every frame never allocates.
+	void setText(int widget, const char* text);
+	void setVisible(int widget, bool visible);
+
+	//Draw items in widget order, rebuilt if anything was invalidated since the last call
+	const std::vector<MenuDrawItem>& getDrawList();
+	//Bumped every time the draw list is rebuilt, so the renderer knows when its cached matrices are stale
+	int getVersion();
+
+	//Topmost visible button under the point, -1 if none
+	int hitTest(float x, float y);
+	//Runs the action of the button under the point, returns the button or -1
+	int click(float x, float y);
+	void bindAction(const std::string& action, MenuAction function);
+
+	static const int textCapacity = 63;
+
+private:
+	static const int cellSize = 128;
+
+	void layout();
+	void buildHitGrid();
+
+	std::string name;
+	std::vector<MenuWidget> widgets;
+	std::vector<bool> shown; //per widget, filled by layout()
+	std::map<std::string, MenuAction> actions;
+	float offsetX = 0;
+	float offsetY = 0;
+	bool dirty = true;
+	int version = 0;
+	std::vector<MenuDrawItem> drawList;
+	//buttons overlapping each cell, cells cover the bounds of all buttons
+	float gridLeft = 0;
+	float gridTop = 0;
+	int gridColumns = 0;
+	int gridRows = 0;
+	std::vector<std::vector<int>> hitGrid;
+};
+
+//Every menu screen of the game, read from a layout description. One widget per line:
+//  screen <name>
+//  <image|text|button> <name> key=value ...
+//Keys are parent, x, y, scale (one or two values), origin, size, image, frame, text, color (r,g,b), action and argument.
+//Values with spaces go in double quotes, lists are separated by commas, # starts a comment.
+class MenuLayout
+{
+public:
+	bool loadFromFile(const std::string& fileName);
+	//Returns false and keeps no screens if the description has an error, getError() says where
+	bool loadFromText(const std::string& text);
+
+	MenuScreen* getScreen(const std::string& name); //NULL if the layout has no such screen
+	const std::string& getError();
+
+private:
+	bool parseLine(const std::string& line, int lineNumber);
+	bool fail(int lineNumber, const std::string& message);
+
+	std::vector<std::unique_ptr<MenuScreen>> screens;
+	std::string error;
+};
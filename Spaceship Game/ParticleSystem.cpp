@@ -0,0 +1,131 @@
+#include "ParticleSystem.h"
+#include <cmath>
+
+void ParticleSystem::init(int capacity)
+{
+	this->capacity = capacity;
+	count = 0;
+	positionX.resize(capacity);
+	positionY.resize(capacity);
+	velocityX.resize(capacity);
+	velocityY.resize(capacity);
+	drag.resize(capacity);
+	life.resize(capacity);
+	inverseLifetime.resize(capacity);
+	size.resize(capacity);
+	startColor.resize(capacity);
+	endColor.resize(capacity);
+}
+
+void ParticleSystem::emit(const ParticleEmitter& emitter, float x, float y, float direction, RandomStream& random)
+{
+	for (int i = 0; i < emitter.count; i++) {
+		if (count == capacity) {
+			droppedCount += emitter.count - i;
+			return;
+		}
+		float angle = direction + (random.nextFloat() - 0.5f) * emitter.spread;
+		float speed = emitter.speedMin + random.nextFloat() * (emitter.speedMax - emitter.speedMin);
+		float lifetime = emitter.lifetimeMin + random.nextFloat() * (emitter.lifetimeMax - emitter.lifetimeMin);
+		positionX[count] = x;
+		positionY[count] = y;
+		velocityX[count] = sinf(angle) * speed;
+		velocityY[count] = -cosf(angle) * speed;
+		drag[count] = 1 - emitter.drag;
+		life[count] = lifetime;
+		inverseLifetime[count] = 1 / lifetime;
+		size[count] = emitter.sizeMin + random.nextFloat() * (emitter.sizeMax - emitter.sizeMin);
+		startColor[count] = emitter.startColor;
+		endColor[count] = emitter.endColor;
+		count++;
+	}
+}
+
+void ParticleSystem::update(float deltaTime)
+{
+	integrate(deltaTime);
+	removeDead();
+}
+
+//Kept as a free function so the compiler knows the arrays never overlap
+static void integrateParticles(int count, float deltaTime, float* __restrict x, float* __restrict y,
+	float* __restrict velocityX, float* __restrict velocityY, const float* __restrict drag, float* __restrict life)
+{
+	for (int i = 0; i < count; i++) {
+		x[i] += velocityX[i] * deltaTime;
+		y[i] += velocityY[i] * deltaTime;
+		velocityX[i] *= drag[i];
+		velocityY[i] *= drag[i];
+		life[i] -= deltaTime;
+	}
+}
+
+void ParticleSystem::integrate(float deltaTime)
+{
+	integrateParticles(count, deltaTime, positionX.data(), positionY.data(), velocityX.data(), velocityY.data(), drag.data(), life.data());
+}
+
+void ParticleSystem::removeDead()
+{
+	//stable compaction, live particles slide down over the dead ones
+	int live = 0;
+	for (int i = 0; i < count; i++) {
+		if (life[i] <= 0) {
+			continue;
+		}
+		if (live != i) {
+			positionX[live] = positionX[i];
+			positionY[live] = positionY[i];
+			velocityX[live] = velocityX[i];
+			velocityY[live] = velocityY[i];
+			drag[live] = drag[i];
+			life[live] = life[i];
+			inverseLifetime[live] = inverseLifetime[i];
+			size[live] = size[i];
+			startColor[live] = startColor[i];
+			endColor[live] = endColor[i];
+		}
+		live++;
+	}
+	count = live;
+}
+
+void ParticleSystem::clear()
+{
+	count = 0;
+}
+
+int ParticleSystem::getCount()
+{
+	return count;
+}
+
+int ParticleSystem::getCapacity()
+{
+	return capacity;
+}
+
+long long ParticleSystem::getDroppedCount()
+{
+	return droppedCount;
+}
+
+int ParticleSystem::copySprites(ParticleSprite* sprites, int maxSprites)
+{
+	int copied = count < maxSprites ? count : maxSprites;
+	for (int i = 0; i < copied; i++) {
+		//1 when the particle is born, 0 when it dies
+		float remaining = life[i] * inverseLifetime[i];
+		uint32_t color = 0;
+		for (int shift = 0; shift < 32; shift += 8) {
+			float start = (float)((startColor[i] >> shift) & 0xff);
+			float end = (float)((endColor[i] >> shift) & 0xff);
+			color |= (uint32_t)(end + (start - end) * remaining + 0.5f) << shift;
+		}
+		sprites[i].x = positionX[i];
+		sprites[i].y = positionY[i];
+		sprites[i].size = size[i];
+		sprites[i].color = color;
+	}
+	return copied;
+}
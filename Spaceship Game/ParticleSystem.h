@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "RandomStream.h"
+
+//How a burst of particles is spawned, angles follow the game's convention (0 is up, clockwise in radians)
+struct ParticleEmitter {
+	int count;
+	float speedMin;
+	float speedMax;
+	float spread;        //angle range centred on the emit direction, 2 PI for a full circle
+	float lifetimeMin;   //in ticks
+	float lifetimeMax;
+	float drag;          //fraction of velocity lost per tick
+	float sizeMin;
+	float sizeMax;
+	uint32_t startColor; //ARGB, faded towards endColor over the particle's life
+	uint32_t endColor;
+};
+
+//What the renderer needs of a live particle
+struct ParticleSprite {
+	float x;
+	float y;
+	float size;
+	uint32_t color;
+};
+
+//Particles kept as one array per field (structure of arrays). The integration loop has no branches
+//so the compiler turns it into SIMD code, and dead particles are removed by compacting in place,
+//the arrays are allocated once in init() and never grow.
+class ParticleSystem
+{
+public:
+	void init(int capacity);
+	void emit(const ParticleEmitter& emitter, float x, float y, float direction, RandomStream& random);
+	void update(float deltaTime);
+	void clear();
+
+	int getCount();
+	int getCapacity();
+	long long getDroppedCount(); //emitted while full
+	//Copies up to maxSprites live particles with their faded colour, returns how many were copied
+	int copySprites(ParticleSprite* sprites, int maxSprites);
+
+private:
+	void integrate(float deltaTime);
+	void removeDead();
+
+	int count = 0;
+	int capacity = 0;
+	long long droppedCount = 0;
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> drag;
+	std::vector<float> life;            //ticks left
+	std::vector<float> inverseLifetime;
+	std::vector<float> size;
+	std::vector<uint32_t> startColor;
+	std::vector<uint32_t> endColor;
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+enum PlayerButton { MoveLeftButton = 1, MoveRightButton = 2, MoveUpButton = 4, MoveDownButton = 8, FireButton = 16 };
+
+//Everything one player does in one simulation tick. Small and plain so every tick's input can be sent over the network
+//and the simulation never has to look at the devices directly.
+struct PlayerInput {
+	uint16_t buttons;
+	int16_t aimX; //pointer position the turret aims at
+	int16_t aimY;
+};
+
+inline bool operator==(const PlayerInput& a, const PlayerInput& b) {
+	return a.buttons == b.buttons && a.aimX == b.aimX && a.aimY == b.aimY;
+}
+inline bool operator!=(const PlayerInput& a, const PlayerInput& b) {
+	return !(a == b);
+}
+
+//Inputs of consecutive ticks. Every packet repeats the inputs the receiver has not acknowledged yet,
+//so a lost packet is covered by the next one and nothing has to be resent on a timer.
+const int maxPacketInputs = 32;
+struct InputPacket {
+	uint32_t firstTick; //tick of inputs[0]
+	uint32_t ackTick;   //the sender has every input of the receiver before this tick
+	uint16_t count;
+	uint16_t round;     //bumped every restart, packets of an earlier round are ignored
+	PlayerInput inputs[maxPacketInputs];
+};
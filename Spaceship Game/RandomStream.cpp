@@ -0,0 +1,99 @@
+#include "RandomStream.h"
+
+static const uint64_t multiplier = 6364136223846793005ULL;
+
+void RandomStream::seed(uint64_t seed, uint64_t stream)
+{
+	state = 0;
+	increment = (stream << 1) | 1;
+	next();
+	state += seed;
+	next();
+}
+
+uint32_t RandomStream::output(uint64_t state)
+{
+	uint32_t xorShifted = (uint32_t)(((state >> 18) ^ state) >> 27);
+	uint32_t rotation = (uint32_t)(state >> 59);
+	return (xorShifted >> rotation) | (xorShifted << ((0 - rotation) & 31));
+}
+
+uint32_t RandomStream::next()
+{
+	uint64_t previous = state;
+	state = previous * multiplier + increment;
+	return output(previous);
+}
+
+//Lemire's multiply and shift, values landing in the short first slice are redrawn
+uint32_t RandomStream::reduce(uint32_t value, uint32_t bound, uint32_t threshold)
+{
+	uint64_t product = (uint64_t)value * bound;
+	while ((uint32_t)product < threshold) {
+		product = (uint64_t)next() * bound;
+	}
+	return (uint32_t)(product >> 32);
+}
+
+uint32_t RandomStream::range(uint32_t bound)
+{
+	if (bound == 0) {
+		return 0;
+	}
+	return reduce(next(), bound, (0 - bound) % bound);
+}
+
+int RandomStream::range(int low, int high)
+{
+	if (high <= low) {
+		return low;
+	}
+	return low + (int)range((uint32_t)(high - low));
+}
+
+float RandomStream::nextFloat()
+{
+	//24 bits fit a float mantissa exactly
+	return (next() >> 8) * (1.0f / 16777216.0f);
+}
+
+void RandomStream::fill(uint32_t* values, int count)
+{
+	//state(n + 4) = state(n) * multiplier^4 + increment * (multiplier^3 + multiplier^2 + multiplier + 1)
+	uint64_t multiplier2 = multiplier * multiplier;
+	uint64_t multiplier4 = multiplier2 * multiplier2;
+	uint64_t increment4 = increment * (multiplier2 * multiplier + multiplier2 + multiplier + 1);
+	uint64_t lanes[4];
+	lanes[0] = state;
+	for (int lane = 1; lane < 4; lane++) {
+		lanes[lane] = lanes[lane - 1] * multiplier + increment;
+	}
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		for (int lane = 0; lane < 4; lane++) {
+			values[i + lane] = output(lanes[lane]);
+			lanes[lane] = lanes[lane] * multiplier4 + increment4;
+		}
+	}
+	state = lanes[0];
+	for (; i < count; i++) {
+		values[i] = next();
+	}
+}
+
+void RandomStream::fillRange(uint32_t* values, int count, uint32_t bound)
+{
+	if (bound == 0) {
+		for (int i = 0; i < count; i++) {
+			values[i] = 0;
+		}
+		return;
+	}
+	fill(values, count);
+	//redraws are rare, they come from the stream after the bulk values so the sequence stays reproducible
+	uint32_t threshold = (0 - bound) % bound;
+	for (int i = 0; i < count; i++) {
+		values[i] = reduce(values[i], bound, threshold);
+	}
+}
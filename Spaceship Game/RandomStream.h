@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+//Every subsystem draws from its own stream so adding a random call in one never changes another's sequence
+enum RandomStreamId { AsteroidStream = 1, PowerUpStream = 2, EffectStream = 3 };
+
+//PCG32 random number generator (pcg-random.org).
+//Only fixed width integer math, so a seed gives the same sequence on every platform and compiler.
+class RandomStream
+{
+public:
+	void seed(uint64_t seed, uint64_t stream);
+	uint32_t next();
+	uint32_t range(uint32_t bound); //[0, bound) without modulo bias
+	int range(int low, int high);   //[low, high)
+	float nextFloat();              //[0, 1)
+
+	//Same numbers as calling next() count times, but four steps are generated per iteration
+	//so the loop has no dependency on the previous value and can be vectorized
+	void fill(uint32_t* values, int count);
+	void fillRange(uint32_t* values, int count, uint32_t bound); //bulk range(bound)
+
+private:
+	static uint32_t output(uint64_t state);
+	uint32_t reduce(uint32_t value, uint32_t bound, uint32_t threshold);
+
+	uint64_t state = 0x853c49e6748fea9bULL;
+	uint64_t increment = 0xda3e39cb94b95bdbULL;
+};
@@ -0,0 +1,84 @@
+#include "RenderSnapshot.h"
+#include <algorithm>
+
+//Matrices of the query's sprites up to maxMatrices, returns how many were built. The ECS columns are copied into one
+//array per field, a chunk of maxDrawnSprites rows at a time, and each chunk is one batched call.
+template <typename QueryType>
+static int buildQueryMatrices(QueryType& query, bool scaled, float centerX, float centerY, Mat3x2* matrices, int maxMatrices)
+{
+	float spriteX[maxDrawnSprites];
+	float spriteY[maxDrawnSprites];
+	float spriteRotation[maxDrawnSprites];
+	float spriteScaleX[maxDrawnSprites];
+	float spriteScaleY[maxDrawnSprites];
+	int entry = 0;
+	for (int i = 0; i < query.getArchetypeCount(); i++) {
+		Archetype& archetype = query.getArchetype(i);
+		Position* position = archetype.template getColumn<Position>();
+		Rotation* rotation = archetype.template getColumn<Rotation>();
+		Scaling* scaling = scaled ? archetype.template getColumn<Scaling>() : NULL;
+		int rows = std::min(archetype.size(), maxMatrices - entry);
+		for (int first = 0; first < rows; first += maxDrawnSprites) {
+			int count = std::min(rows - first, maxDrawnSprites);
+			for (int row = 0; row < count; row++) {
+				spriteX[row] = position[first + row].value.x;
+				spriteY[row] = position[first + row].value.y;
+				spriteRotation[row] = rotation[first + row].value;
+				if (scaled) {
+					spriteScaleX[row] = scaling[first + row].value.x;
+					spriteScaleY[row] = scaling[first + row].value.y;
+				}
+			}
+			buildSpriteMatrices(count, spriteX, spriteY, spriteRotation, scaled ? spriteScaleX : NULL, scaled ? spriteScaleY : NULL, centerX, centerY, matrices + entry);
+			entry += count;
+		}
+	}
+	return entry;
+}
+
+static int buildBulletMatrices(Mat3x2* matrices, int maxMatrices)
+{
+	return buildQueryMatrices(bulletQuery, false, bulletSprite.getTotalSpriteWidth() / 2, bulletSprite.getTotalSpriteHeight() / 2, matrices, maxMatrices);
+}
+
+static int buildAsteroidMatrices(Mat3x2* matrices, int maxMatrices)
+{
+	return buildQueryMatrices(asteroidQuery, true, 35, 35, matrices, maxMatrices);
+}
+
+static int buildPowerUpMatrices(Mat3x2* matrices, int* types, int maxMatrices)
+{
+	int entry = 0;
+	powerUpQuery.forEach([&](Entity, Position& position, PowerUp& powerUp) {
+		if (entry == maxMatrices) {
+			return;
+		}
+		//power ups never turn or scale
+		matrices[entry] = translation2D(position.value.x, position.value.y);
+		types[entry] = powerUp.type;
+		entry++;
+	});
+	return entry;
+}
+
+void buildEntitySprites(RenderSnapshot& snapshot)
+{
+	snapshot.bulletEntry = buildBulletMatrices(snapshot.bulletMatrices, maxDrawnBullets);
+	snapshot.asteroidEntry = buildAsteroidMatrices(snapshot.asteroidMatrices, maxDrawnAsteroids);
+	snapshot.powerUpEntry = buildPowerUpMatrices(snapshot.powerUpMatrices, snapshot.powerUpType, maxDrawnPowerUps);
+	snapshot.particleEntry = particleSystem->copySprites(snapshot.particles, maxDrawnParticles);
+}
+
+void buildAllEntitySprites(EntitySprites& sprites)
+{
+	//the vectors only grow, a level after the first reuses the memory of the one before
+	sprites.bulletMatrices.resize(std::max((int)sprites.bulletMatrices.size(), bulletQuery.count()));
+	sprites.asteroidMatrices.resize(std::max((int)sprites.asteroidMatrices.size(), asteroidQuery.count()));
+	sprites.powerUpMatrices.resize(std::max((int)sprites.powerUpMatrices.size(), powerUpQuery.count()));
+	sprites.powerUpType.resize(sprites.powerUpMatrices.size());
+	sprites.particles.resize(std::max((int)sprites.particles.size(), particleSystem->getCount()));
+	sprites.bulletEntry = buildBulletMatrices(sprites.bulletMatrices.data(), (int)sprites.bulletMatrices.size());
+	sprites.asteroidEntry = buildAsteroidMatrices(sprites.asteroidMatrices.data(), (int)sprites.asteroidMatrices.size());
+	sprites.powerUpEntry = buildPowerUpMatrices(sprites.powerUpMatrices.data(), sprites.powerUpType.data(), (int)sprites.powerUpMatrices.size());
+	sprites.particleEntry = particleSystem->copySprites(sprites.particles.data(), (int)sprites.particles.size());
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include "LatencyTracker.h"
+#include "Math2D.h"
+#include "ParticleSystem.h"
+#include "Simulation.h"
+
+//Drawable state produced by the simulation thread once per tick, the render thread only reads it
+const int maxDrawnBullets = 200;
+const int maxDrawnAsteroids = 200;
+const int maxDrawnPowerUps = 30;
+const int maxDrawnParticles = 4096;
+const int maxDrawnSprites = maxDrawnBullets > maxDrawnAsteroids ? maxDrawnBullets : maxDrawnAsteroids;
+struct RenderSnapshot {
+	long long tick;
+	LatencyTracker::Clock::time_point publishTime;
+	int spaceshipCount;
+	Vec2 spaceshipPosition[maxPlayers];
+	float spaceshipRotation[maxPlayers];
+	int spaceshipFrame[maxPlayers];
+	int spaceshipHull[maxPlayers];
+	int thrustFrame[maxPlayers];
+	Vec2 turretPosition[maxPlayers];
+	float turretRotation[maxPlayers];
+	int turretFrame[maxPlayers];
+	long pointerX;
+	long pointerY;
+	Mat3x2 bulletMatrices[maxDrawnBullets];
+	int bulletEntry;
+	Mat3x2 asteroidMatrices[maxDrawnAsteroids];
+	int asteroidEntry;
+	Mat3x2 powerUpMatrices[maxDrawnPowerUps];
+	int powerUpType[maxDrawnPowerUps];
+	int powerUpEntry;
+	ParticleSprite particles[maxDrawnParticles];
+	int particleEntry;
+	int waveSec;
+	int waveMin;
+	int lives;
+	int scores;
+	int highScores;
+	long long rollbackCount;
+	int unconfirmedTicks;
+};
+
+//Fills the entity matrices and particles of a snapshot from the world, the part of a snapshot that grows with the load.
+//Matrices are built here so the render thread only submits them.
+void buildEntitySprites(RenderSnapshot& snapshot);
+
+//The same sprites without the snapshot's limits, sized to what is alive. The headless stress mode builds this instead of
+//a snapshot, the game draws no more than a snapshot holds but a render build timed over a capped snapshot would stop
+//growing at the caps.
+struct EntitySprites {
+	std::vector<Mat3x2> bulletMatrices;
+	int bulletEntry = 0;
+	std::vector<Mat3x2> asteroidMatrices;
+	int asteroidEntry = 0;
+	std::vector<Mat3x2> powerUpMatrices;
+	std::vector<int> powerUpType;
+	int powerUpEntry = 0;
+	std::vector<ParticleSprite> particles;
+	int particleEntry = 0;
+};
+void buildAllEntitySprites(EntitySprites& sprites);
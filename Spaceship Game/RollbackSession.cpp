@@ -0,0 +1,190 @@
+#include "RollbackSession.h"
+
+void RollbackSession::init(int localPlayer, int maxRollback, int inputDelay, InputTransport* transport, const RollbackCallbacks& callbacks)
+{
+	//bounded so every input that may still be needed fits in the history
+	if (maxRollback < 1) {
+		maxRollback = 1;
+	}
+	if (maxRollback > 16) {
+		maxRollback = 16;
+	}
+	if (inputDelay < 0) {
+		inputDelay = 0;
+	}
+	if (inputDelay > 8) {
+		inputDelay = 8;
+	}
+	this->localPlayer = localPlayer;
+	this->maxRollback = maxRollback;
+	this->inputDelay = inputDelay;
+	this->transport = transport;
+	this->callbacks = callbacks;
+	round = 0;
+	states.resize(maxRollback + 1);
+	rollbackCount = 0;
+	resimulatedTicks = 0;
+	resimulationTime.reset();
+	restart();
+}
+
+void RollbackSession::restart()
+{
+	round++;
+	tick = 0;
+	localInputCount = inputDelay; //the first ticks run without local input
+	remoteInputCount = 0;
+	remoteAck = 0;
+	firstMisprediction = -1;
+	for (int i = 0; i < historySize; i++) {
+		localInputs[i] = PlayerInput();
+		remoteInputs[i] = PlayerInput();
+		predictedInputs[i] = PlayerInput();
+	}
+	resimulating = false;
+}
+
+bool RollbackSession::advance(const PlayerInput& localInput)
+{
+	receiveInputs();
+	if (firstMisprediction >= 0) {
+		rollback(firstMisprediction);
+		firstMisprediction = -1;
+	}
+	if (tick - remoteInputCount >= maxRollback) {
+		//keep the remote player supplied so they can catch up
+		sendInputs();
+		return false;
+	}
+	localInputs[localInputCount % historySize] = localInput;
+	localInputCount++;
+	sendInputs();
+	runTick(tick);
+	tick++;
+	return true;
+}
+
+void RollbackSession::flushInputs()
+{
+	receiveInputs();
+	if (remoteAck < localInputCount) {
+		sendInputs();
+	}
+}
+
+void RollbackSession::receiveInputs()
+{
+	InputPacket packet;
+	while (transport->receive(packet)) {
+		if (packet.round != round) {
+			continue;
+		}
+		if (packet.ackTick > remoteAck) {
+			remoteAck = packet.ackTick;
+		}
+		for (int i = 0; i < packet.count; i++) {
+			long long inputTick = (long long)packet.firstTick + i;
+			if (inputTick < remoteInputCount) {
+				continue;
+			}
+			//inputs after a gap wait for a packet that fills it
+			if (inputTick > remoteInputCount || inputTick >= tick + historySize / 2) {
+				break;
+			}
+			remoteInputs[inputTick % historySize] = packet.inputs[i];
+			if (inputTick < tick && packet.inputs[i] != predictedInputs[inputTick % historySize] && (firstMisprediction < 0 || inputTick < firstMisprediction)) {
+				firstMisprediction = inputTick;
+			}
+			remoteInputCount++;
+		}
+	}
+}
+
+void RollbackSession::sendInputs()
+{
+	InputPacket packet;
+	long long first = remoteAck;
+	if (first < localInputCount - historySize) {
+		first = localInputCount - historySize;
+	}
+	if (first > localInputCount) {
+		first = localInputCount;
+	}
+	long long count = localInputCount - first;
+	if (count > maxPacketInputs) {
+		count = maxPacketInputs;
+	}
+	packet.firstTick = (uint32_t)first;
+	packet.ackTick = (uint32_t)remoteInputCount;
+	packet.count = (uint16_t)count;
+	packet.round = round;
+	for (int i = 0; i < count; i++) {
+		packet.inputs[i] = localInputs[(first + i) % historySize];
+	}
+	transport->send(packet);
+}
+
+void RollbackSession::rollback(long long toTick)
+{
+	LatencyTracker::Clock::time_point start = LatencyTracker::Clock::now();
+	StateWriter& state = states[toTick % states.size()];
+	callbacks.loadState(state.getData(), state.getSize());
+	resimulating = true;
+	for (long long replayTick = toTick; replayTick < tick; replayTick++) {
+		runTick(replayTick);
+	}
+	resimulating = false;
+	rollbackCount++;
+	resimulatedTicks += tick - toTick;
+	resimulationTime.record(std::chrono::duration_cast<std::chrono::microseconds>(LatencyTracker::Clock::now() - start).count());
+}
+
+void RollbackSession::runTick(long long runTick)
+{
+	callbacks.saveState(states[runTick % states.size()]);
+	//the remote player is predicted to keep doing what they did last
+	PlayerInput remoteInput = PlayerInput();
+	if (runTick < remoteInputCount) {
+		remoteInput = remoteInputs[runTick % historySize];
+	}
+	else if (remoteInputCount > 0) {
+		remoteInput = remoteInputs[(remoteInputCount - 1) % historySize];
+	}
+	predictedInputs[runTick % historySize] = remoteInput;
+	PlayerInput inputs[2];
+	inputs[localPlayer] = localInputs[runTick % historySize];
+	inputs[1 - localPlayer] = remoteInput;
+	callbacks.advance(inputs);
+}
+
+bool RollbackSession::isResimulating()
+{
+	return resimulating;
+}
+
+long long RollbackSession::getTick()
+{
+	return tick;
+}
+
+long long RollbackSession::getConfirmedTick()
+{
+	long long confirmed = remoteInputCount < tick ? remoteInputCount : tick;
+	//inputs received by flushInputs() are not rolled back to yet, the ticks from the first wrong one are still predicted
+	return firstMisprediction >= 0 && firstMisprediction < confirmed ? firstMisprediction : confirmed;
+}
+
+long long RollbackSession::getRollbackCount()
+{
+	return rollbackCount;
+}
+
+long long RollbackSession::getResimulatedTicks()
+{
+	return resimulatedTicks;
+}
+
+LatencyHistogram& RollbackSession::getResimulationTime()
+{
+	return resimulationTime;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include "InputTransport.h"
+#include "LatencyTracker.h"
+#include "PlayerInput.h"
+#include "StateBuffer.h"
+
+typedef void (*SaveStateFunction)(StateWriter& writer);
+typedef bool (*LoadStateFunction)(const unsigned char* data, size_t size);
+typedef void (*AdvanceFunction)(const PlayerInput* inputs); //one tick, inputs[player] for both players
+
+//What the session needs from the game, the game state must only change through advance()
+struct RollbackCallbacks {
+	SaveStateFunction saveState;
+	LoadStateFunction loadState;
+	AdvanceFunction advance;
+};
+
+//Two player lockstep without waiting: ticks run with a prediction of the remote input (their last known input),
+//the state before every tick is saved, and when the real input turns out different the game is loaded back to
+//the first wrong tick and simulated again up to the present.
+//The local player's input is applied inputDelay ticks late, which hides that much latency without any rollback.
+class RollbackSession
+{
+public:
+	void init(int localPlayer, int maxRollback, int inputDelay, InputTransport* transport, const RollbackCallbacks& callbacks);
+
+	//Runs the next tick. Returns false (and runs nothing) while the remote player is maxRollback ticks behind,
+	//predicting any further would leave the saved states behind.
+	bool advance(const PlayerInput& localInput);
+	//Starts again from tick 0 with the same settings, both players restart when the stage resets
+	void restart();
+	//For while this side no longer advances (its game is over): resends the inputs the remote player has not
+	//acknowledged, they may still need them to reach the end too. Call it every tick, arriving inputs are
+	//applied by the next advance().
+	void flushInputs();
+
+	bool isResimulating(); //true inside advance callbacks that replay ticks, effects should stay quiet
+	long long getTick();
+	long long getConfirmedTick(); //every tick before this has the real remote input
+	long long getRollbackCount();
+	long long getResimulatedTicks();
+	LatencyHistogram& getResimulationTime();
+
+private:
+	static const int historySize = 64; //ticks of inputs kept, more than maxRollback + inputDelay + maxPacketInputs
+
+	void receiveInputs();
+	void sendInputs();
+	void rollback(long long toTick);
+	void runTick(long long tick);
+
+	int localPlayer = 0;
+	int maxRollback = 8;
+	int inputDelay = 0;
+	InputTransport* transport = NULL;
+	RollbackCallbacks callbacks = {};
+
+	uint16_t round = 0;
+	long long tick = 0;             //next tick to run
+	long long localInputCount = 0;  //local inputs are known for ticks before this
+	long long remoteInputCount = 0; //remote inputs are known for ticks before this
+	long long remoteAck = 0;        //the remote player has our inputs for ticks before this
+	long long firstMisprediction = -1;
+	PlayerInput localInputs[historySize] = {};
+	PlayerInput remoteInputs[historySize] = {};
+	PlayerInput predictedInputs[historySize] = {}; //remote input each tick was last simulated with
+	std::vector<StateWriter> states;               //state before tick t in states[t % states.size()]
+	bool resimulating = false;
+
+	long long rollbackCount = 0;
+	long long resimulatedTicks = 0;
+	LatencyHistogram resimulationTime;
+};
@@ -0,0 +1,905 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+SimulationCallbacks simulationCallbacks = { NULL };
+
+//Screen Resolution
+int screenWidth = 1280;
+int screenHeight = 720;
+
+GameTuning tuning;
+
+//Animation Clips - (name, firstFrame, frameCount, frameTicks, loop), in the order of the clip lists
+const AnimationClip spaceshipClips[] = {
+	{ "static", 0, 1, 1, true },
+	{ "bankLeft", 2, 1, 1, true },
+	{ "bankRight", 4, 1, 1, true },
+};
+const AnimationClip thrustClips[] = {
+	{ "thrust", 0, 2, 12, true }, //about 4 frames a second
+};
+const AnimationClip turretClips[] = {
+	{ "idle", 0, 1, 1, true },
+};
+
+//Sprite Sheet Object - (totalWidth, totalHeight, row, col, frameCount, clips, clipCount)
+//                    - (totalWidth, totalHeight)
+SpriteSheet pointerSprite(30, 30);
+SpriteSheet spaceshipSprite(250, 50, 1, 5, 5, spaceshipClips, sizeof(spaceshipClips) / sizeof(spaceshipClips[0]));
+SpriteSheet thrustSprite(32, 20, 1, 2, 2, thrustClips, sizeof(thrustClips) / sizeof(thrustClips[0]));
+SpriteSheet turretSprite(1024, 128, 1, 8, 8, turretClips, sizeof(turretClips) / sizeof(turretClips[0]));
+SpriteSheet asteroidSprite(60, 60);
+SpriteSheet bulletSprite(16, 28);
+SpriteSheet hpPowerUpSprite(35, 35);
+
+CollisionMaskSet asteroidMasks;
+CollisionMaskSet bulletMasks;
+CollisionMaskSet spaceshipMasks[5];
+CollisionMaskSet spaceship2Masks[5];
+
+World world;
+Query<Position, Rotation, Bullet> bulletQuery(world);
+Query<Position, Rotation, Scaling, Velocity, Asteroid> asteroidQuery(world);
+Query<Position, Scaling, CollisionBounds> boundsQuery(world);
+Query<Position, Rotation, Velocity, Asteroid, CollisionBounds> asteroidHitQuery(world);
+Query<Position, PowerUp> powerUpQuery(world);
+
+Spaceship spaceships[maxPlayers] = { { Vec2(600, 600), 0, Vec2(0, 0), Vec2(0, 0), Vec2(0, 0), 0, Vec2(0, 0), 0 } };
+Animation spaceshipAnimations[maxPlayers];
+Animation thrustAnimations[maxPlayers];
+Animation turretAnimations[maxPlayers];
+int playerCount = 1;
+int selectedHull = 0;
+
+RandomStream* asteroidRandom = new RandomStream();
+RandomStream* powerUpRandom = new RandomStream();
+RandomStream* effectRandom = new RandomStream();
+uint64_t simulationSeed = 0;
+JobSystem* jobSystem = new JobSystem();
+int entityGrainSize = 64; //entities per job, smaller counts are updated inline
+ImpulseSolver* asteroidSolver = new ImpulseSolver();
+int asteroidSolverBodies = 512; //reserved up front so a busy wave does not allocate mid game
+int asteroidSolverContacts = 2048;
+int asteroidSolverCells = 4096;
+
+//Particles
+//Emitter - (count, speedMin, speedMax, spread, lifetimeMin, lifetimeMax, drag, sizeMin, sizeMax, startColor, endColor), colors are ARGB
+ParticleSystem* particleSystem = new ParticleSystem();
+int maxParticles = 200000;
+ParticleEmitter asteroidExplosionEmitter = { 40, 1, 5, 2 * PI, 15, 35, 0.06, 2, 5, 0xffffc850, 0x0078280a };
+ParticleEmitter bulletImpactEmitter = { 8, 1, 3, PI / 2, 5, 12, 0.1, 1, 3, 0xffffffb4, 0x00ff7800 };
+ParticleEmitter exhaustEmitter = { 3, 2, 4, PI / 6, 8, 16, 0.08, 2, 3, 0xc878c8ff, 0x00282878 };
+
+//Timer Stuff
+int waveSec;
+int waveMin;
+//Spaceship Live
+int lives = 3;
+//Scores
+int scores = 0;
+int highScores = 0;
+//Waves
+int currentPhase = FirstPhase;
+bool gameOver = false;
+long long gameOverTick = 0;
+
+// Turret
+float pointerCenterX;
+float pointerCenterY;
+float turretCenterX;
+float turretCenterY;
+
+// Bullet
+Vec2 bulletStartPosition;
+Vec2 bulletPos;
+float bulletSweepThreshold = 20; //bullets moving further than this per tick use the swept test so they cannot skip small asteroids
+
+// Asteroid
+float asteroidRotation;
+float asteroidStartRotation;
+Vec2 asteroidStartPosition(500, -100);
+Vec2 asteroidPosition;
+Vec2 asteroidScaling;
+int chosenAsteroid;
+int chosenAsteroidHp;
+
+//Power Up
+bool timeStop;
+int timeStopDurationLeft = tuning.timeStopDuration;
+bool bulletPowerUpPicked;
+int bulletPowerUpDurationLeft = tuning.bulletPowerUpDuration;
+Vec2 powerUpPosition;
+int powerUpSpawnRateLeft = tuning.powerUpSpawnRate;
+int powerUpChosen;
+long long powerUpSpawnCount = 0; //spawn order, the oldest power up is removed once there are too many
+
+int gameUpdateRate = 50;
+int asteroidSpawnRate = 10;
+int waveUpdateRate = 1;
+long long gameTick = 0;
+
+bool replayingTicks = false;
+int tickCollisions = 0;
+long long collisionMicroseconds = 0;
+
+//Game State Snapshots
+//Everything the simulation needs to carry on from a tick
+const uint32_t gameStateVersion = 4;
+
+//Start positions, two players start side by side and fly different ships so either machine can tell them apart
+void placeSpaceships() {
+	for (int player = 0; player < playerCount; player++) {
+		Spaceship& ship = spaceships[player];
+		ship = Spaceship();
+		ship.position = playerCount == 1 ? Vec2(600, 600) : Vec2(400 + player * 400, 600);
+		ship.hull = playerCount == 1 ? selectedHull : player;
+		spaceshipAnimations[player] = Animation();
+		spaceshipSprite.play(spaceshipAnimations[player], StaticClip);
+		thrustAnimations[player] = Animation();
+		thrustSprite.play(thrustAnimations[player], ThrustClip);
+		turretAnimations[player] = Animation();
+		turretSprite.play(turretAnimations[player], TurretIdleClip);
+	}
+}
+
+//Seed of the game, kept for every later reset
+void seedSimulation(uint64_t seed) {
+	simulationSeed = seed;
+	asteroidRandom->seed(seed, AsteroidStream);
+	powerUpRandom->seed(seed, PowerUpStream);
+	effectRandom->seed(seed, EffectStream);
+}
+
+//Back to the start of the first wave, the world keeps its archetypes so nothing is allocated again.
+//Everything in the saved state is reset, the streams too, so a Retry plays the same game as the first try.
+void resetSimulation() {
+	seedSimulation(simulationSeed);
+	lives = 3;
+	gameOver = false;
+	gameOverTick = 0;
+	waveSec = 0;
+	waveMin = 0;
+	world.reset();
+	particleSystem->clear();
+	scores = 0;
+	currentPhase = FirstPhase;
+	placeSpaceships();
+	timeStop = false;
+	timeStopDurationLeft = 0;
+	bulletPowerUpPicked = false;
+	bulletPowerUpDurationLeft = 0;
+	powerUpSpawnCount = 0;
+	powerUpSpawnRateLeft = tuning.powerUpSpawnRate;
+	gameTick = 0;
+}
+
+//Runs function(Entity, Components&...) over every entity of a query, split into jobs of entityGrainSize rows
+template <typename QueryType, typename Function>
+void parallelForEach(QueryType& query, Function function) {
+	for (int i = 0; i < query.getArchetypeCount(); i++) {
+		auto rows = query.getRows(i);
+		auto runRow = [&rows, &function](int row) {
+			rows.call(row, function);
+		};
+		jobSystem->parallelFor(0, rows.size(), entityGrainSize, runRow);
+	}
+}
+
+//Earliest time (0 to 1) a point moving from start by displacement enters the circle, false if it never does
+bool sweepCircle(const Vec2& start, const Vec2& displacement, const Vec2& center, float radius, float& impact) {
+	Vec2 offset = start - center;
+	float c = offset.x * offset.x + offset.y * offset.y - radius * radius;
+	if (c <= 0) {
+		impact = 0;
+		return true;
+	}
+	float a = displacement.x * displacement.x + displacement.y * displacement.y;
+	float b = offset.x * displacement.x + offset.y * displacement.y;
+	if (a == 0 || b >= 0) {
+		return false;
+	}
+	float discriminant = b * b - a * c;
+	if (discriminant < 0) {
+		return false;
+	}
+	impact = (-b - sqrt(discriminant)) / a;
+	return impact <= 1;
+}
+
+float getAsteroidMass(int type) {
+	if (type == mediumAsteroid) {
+		return tuning.mediumAsteroidMass;
+	}
+	if (type == largeAsteroid) {
+		return tuning.largeAsteroidMass;
+	}
+	return tuning.smallAsteroidMass;
+}
+
+//Constant fall speed, bigger asteroids are slower
+Vec2 getAsteroidFallVelocity(int type) {
+	float power = 0;
+	if (type == smallAsteroid) {
+		power = tuning.smallAsteroidPower;
+	}
+	else if (type == mediumAsteroid) {
+		power = tuning.mediumAsteroidPower;
+	}
+	else if (type == largeAsteroid) {
+		power = tuning.largeAsteroidPower;
+	}
+	return Vec2(0, power);
+}
+
+//Elastic bullet impulse along the line between the two, the same contact math as ImpulseSolver with restitution 1.
+//The bullet is far heavier than small asteroids, so they fly off while large ones only drift.
+void bulletHitAsteroid(Position& bulletPosition, Rotation& bulletRotation, Position& position, Velocity& velocity, Asteroid& asteroid) {
+	scores++;
+	if (asteroid.hp <= 0) {
+		return;
+	}
+	Vec2 bulletVelocity(sin(bulletRotation.value) * tuning.bulletPower, -cos(bulletRotation.value) * tuning.bulletPower);
+	Vec2 normal = position.value - bulletPosition.value;
+	float distanceSquared = lengthSquared(normal);
+	//approach speed times the normal's length, the normal is never normalised
+	float approach = dot(getAsteroidFallVelocity(asteroid.type) - bulletVelocity, normal);
+	if (distanceSquared > 0 && approach < 0) {
+		float asteroidMass = getAsteroidMass(asteroid.type);
+		float normalMass = 1 / (1 / tuning.bulletMass + 1 / asteroidMass);
+		float impulse = -2 * approach * normalMass / distanceSquared;
+		//added to the collision velocity, the asteroid slides away over the next ticks instead of jumping (also while time is stopped)
+		velocity.value += normal * (impulse / asteroidMass);
+	}
+	asteroid.hp--;
+}
+
+//Fine test once the bounding boxes overlap, without masks (image failed to load) the boxes decide
+bool asteroidPixelsOverlap(Position& position, Rotation& rotation, Asteroid& asteroid, const CollisionMaskSet& otherMasks, int otherScale, float otherRotation, const Vec2& otherPosition) {
+	if (asteroidMasks.isEmpty() || otherMasks.isEmpty()) {
+		return true;
+	}
+	const CollisionMask& mask = asteroidMasks.get(asteroid.type, rotation.value);
+	const CollisionMask& otherMask = otherMasks.get(otherScale, otherRotation);
+	return CollisionMask::overlaps(mask, (int)floor(position.value.x) + mask.getOffsetX(), (int)floor(position.value.y) + mask.getOffsetY(),
+		otherMask, (int)floor(otherPosition.x) + otherMask.getOffsetX(), (int)floor(otherPosition.y) + otherMask.getOffsetY());
+}
+
+bool effectsEnabled() {
+	return !replayingTicks;
+}
+
+void playSound(int sound, float x) {
+	if (effectsEnabled() && simulationCallbacks.playSound != NULL) {
+		simulationCallbacks.playSound(sound, x);
+	}
+}
+
+void emitAtBoundsCenter(const ParticleEmitter& emitter, const CollisionBounds& bounds) {
+	if (effectsEnabled()) {
+		particleSystem->emit(emitter, (bounds.left + bounds.right) / 2, (bounds.top + bounds.bottom) / 2, 0, *effectRandom);
+	}
+}
+
+void collisionDetection() {
+	Entity hit;
+	Entity hitAsteroid;
+
+	// Collision Between Bullet and Wall
+	auto bulletOutside = [](Entity, Position& position, Rotation&, Bullet&) {
+		return position.value.x > screenWidth - bulletSprite.getTotalSpriteWidth() || position.value.x < 0 || position.value.y < 0 || position.value.y > screenHeight - bulletSprite.getTotalSpriteHeight();
+	};
+	if (bulletQuery.findFirst(bulletOutside, hit)) {
+		world.destroy(hit);
+	}
+	// Collision Between Asteroid and Wall
+	auto asteroidOutside = [](Entity, Position& position, Rotation&, Scaling& scaling, Velocity&, Asteroid&) {
+		return position.value.x > screenWidth || position.value.x < 0 - asteroidSprite.getTotalSpriteWidth() * scaling.value.x || position.value.y > screenHeight;
+	};
+	if (asteroidQuery.findFirst(asteroidOutside, hit)) {
+		world.destroy(hit);
+	}
+
+	// Collision Between Asteroid and Spaceship, the players share their lives
+	for (int player = 0; player < playerCount; player++) {
+		Spaceship& ship = spaceships[player];
+		int frame = spaceshipAnimations[player].frame;
+		auto hitsSpaceship = [&ship, frame](Entity, Position& position, Rotation& rotation, Velocity&, Asteroid& asteroid, CollisionBounds& bounds) {
+			if (!(ship.position.x + spaceshipSprite.getSpriteWidth() >= bounds.left && ship.position.x <= bounds.right && ship.position.y <= bounds.bottom && ship.position.y + spaceshipSprite.getSpriteHeight() >= bounds.top)) {
+				return false;
+			}
+			CollisionMaskSet& masks = ship.hull == 1 ? spaceship2Masks[frame] : spaceshipMasks[frame];
+			return asteroidPixelsOverlap(position, rotation, asteroid, masks, 0, ship.rotation, ship.position);
+		};
+		if (asteroidHitQuery.findFirst(hitsSpaceship, hit)) {
+			if (lives > 0) {
+				playSound(HitSound, ship.position.x);
+				lives--;
+			}
+			if (lives <= 0 && !gameOver) {
+				//MessageBox(NULL, TEXT("YOU DIED\n"), TEXT("GIT GUD"), MB_OK | MB_ICONWARNING);
+				//the game switches menus once the tick can no longer be rolled back
+				gameOver = true;
+				gameOverTick = gameTick;
+				playSound(BoomSound, ship.position.x);
+				if (scores > highScores) {
+					highScores = scores;
+				}
+			}
+			emitAtBoundsCenter(asteroidExplosionEmitter, *world.get<CollisionBounds>(hit));
+			world.destroy(hit);
+			tickCollisions++;
+		}
+	}
+	// Collision Between Bullet and Asteroid
+	auto bulletHitsAsteroid = [&hitAsteroid](Entity, Position& bulletPosition, Rotation& bulletRotation, Bullet&) {
+		Vec2 displacement(sin(bulletRotation.value) * tuning.bulletPower, -cos(bulletRotation.value) * tuning.bulletPower);
+		if (displacement.x * displacement.x + displacement.y * displacement.y > bulletSweepThreshold * bulletSweepThreshold) {
+			// Fast bullets sweep the whole step and hit the asteroid they reach first
+			float bulletRadius = bulletSprite.getTotalSpriteWidth() / 2;
+			Vec2 end = bulletPosition.value + Vec2(bulletRadius, bulletSprite.getTotalSpriteHeight() / 2);
+			Vec2 start = end - displacement;
+			float sweptLeft = min(start.x, end.x) - bulletRadius;
+			float sweptRight = max(start.x, end.x) + bulletRadius;
+			float sweptTop = min(start.y, end.y) - bulletRadius;
+			float sweptBottom = max(start.y, end.y) + bulletRadius;
+			float earliestImpact = 2;
+			auto sweep = [&](Entity asteroid, Position&, Rotation&, Velocity&, Asteroid&, CollisionBounds& bounds) {
+				if (sweptRight < bounds.left || sweptLeft > bounds.right || sweptBottom < bounds.top || sweptTop > bounds.bottom) {
+					return;
+				}
+				float radius = (bounds.right - bounds.left) / 2;
+				float impact;
+				if (sweepCircle(start, displacement, Vec2(bounds.left + radius, bounds.top + radius), radius + bulletRadius, impact) && impact < earliestImpact) {
+					earliestImpact = impact;
+					hitAsteroid = asteroid;
+				}
+			};
+			asteroidHitQuery.forEach(sweep);
+			if (earliestImpact > 1) {
+				return false;
+			}
+			bulletPosition.value -= displacement * (1 - earliestImpact);
+			bulletHitAsteroid(bulletPosition, bulletRotation, *world.get<Position>(hitAsteroid), *world.get<Velocity>(hitAsteroid), *world.get<Asteroid>(hitAsteroid));
+			return true;
+		}
+		auto asteroidHit = [&bulletPosition, &bulletRotation](Entity, Position& position, Rotation& rotation, Velocity& velocity, Asteroid& asteroid, CollisionBounds& bounds) {
+			if (!(bulletPosition.value.x + bulletSprite.getTotalSpriteWidth() >= bounds.left && bulletPosition.value.x <= bounds.right && bulletPosition.value.y <= bounds.bottom && bulletPosition.value.y + bulletSprite.getTotalSpriteHeight() >= bounds.top)) {
+				return false;
+			}
+			if (!asteroidPixelsOverlap(position, rotation, asteroid, bulletMasks, 0, bulletRotation.value, bulletPosition.value)) {
+				return false;
+			}
+			bulletHitAsteroid(bulletPosition, bulletRotation, position, velocity, asteroid);
+			return true;
+		};
+		return asteroidHitQuery.findFirst(asteroidHit, hitAsteroid);
+	};
+	if (bulletQuery.findFirst(bulletHitsAsteroid, hit)) {
+		Position& bulletPosition = *world.get<Position>(hit);
+		float bulletRotation = world.get<Rotation>(hit)->value;
+		if (effectsEnabled()) {
+			particleSystem->emit(bulletImpactEmitter, bulletPosition.value.x + bulletSprite.getTotalSpriteWidth() / 2, bulletPosition.value.y + bulletSprite.getTotalSpriteHeight() / 2, bulletRotation + PI, *effectRandom);
+		}
+		if (world.get<Asteroid>(hitAsteroid)->hp <= 0) {
+			emitAtBoundsCenter(asteroidExplosionEmitter, *world.get<CollisionBounds>(hitAsteroid));
+			world.destroy(hitAsteroid);
+		}
+		world.destroy(hit);
+		tickCollisions++;
+	}
+	// Collision Between Spaceship and Powerup, power ups work for both players
+	for (int player = 0; player < playerCount; player++) {
+		Spaceship& ship = spaceships[player];
+		auto touchesPowerUp = [&ship](Entity, Position& position, PowerUp&) {
+			return ship.position.x + spaceshipSprite.getSpriteWidth() >= position.value.x && ship.position.x <= position.value.x + hpPowerUpSprite.getTotalSpriteWidth() && ship.position.y <= position.value.y + hpPowerUpSprite.getTotalSpriteHeight() && ship.position.y + spaceshipSprite.getSpriteHeight() >= position.value.y;
+		};
+		if (!powerUpQuery.findFirst(touchesPowerUp, hit)) {
+			continue;
+		}
+		int type = world.get<PowerUp>(hit)->type;
+		if (type == hpPowerUp) {
+			cout << "HP PICKED" << endl;
+			playSound(PickUpSound, ship.position.x);
+			if (lives < 3) {
+				lives++;
+			}
+		}
+		if (type == bulletPowerUp) {
+			cout << "BULLET PICKED" << endl;
+			playSound(PickUpSound, ship.position.x);
+			bulletPowerUpPicked = true;
+			bulletPowerUpDurationLeft = tuning.bulletPowerUpDuration;
+		}
+		if (type == timePowerUp) {
+			cout << "TIMESTOP PICKED" << endl;
+			playSound(TimeStopSound, ship.position.x);
+			timeStop = true;
+			timeStopDurationLeft = tuning.timeStopDuration;
+		}
+		world.destroy(hit);
+		tickCollisions++;
+	}
+}
+
+// Per entity update steps, each call only touches its own entity so they can run in parallel
+void moveBullet(Entity, Position& position, Rotation& rotation, Bullet&) {
+	Vec2 velocity;
+	velocity.x = sin(rotation.value) * tuning.bulletPower;
+	velocity.y = -cos(rotation.value) * tuning.bulletPower;
+	position.value += velocity;
+}
+
+//Velocity holds what collisions added on top of the fall, it dies off with asteroidFriction
+void moveAsteroid(Entity, Position& position, Rotation& rotation, Scaling&, Velocity& velocity, Asteroid& asteroid) {
+	position.value += getAsteroidFallVelocity(asteroid.type) + velocity.value;
+	velocity.value *= (1 - tuning.asteroidFriction);
+	rotation.value += tuning.asteroidRotationRate;
+}
+
+//Asteroids keep the velocity they got from bullets while time is stopped.
+//Only positions and velocities change, so every archetype is moved by one batch over its columns
+void driftAsteroids() {
+	static_assert(sizeof(Position) == sizeof(Vec2) && sizeof(Velocity) == sizeof(Vec2), "components are read as Vec2 arrays");
+	for (int i = 0; i < asteroidQuery.getArchetypeCount(); i++) {
+		Archetype& archetype = asteroidQuery.getArchetype(i);
+		if (archetype.size() > 0) {
+			integrate2D(archetype.size(), &archetype.getColumn<Position>()->value, &archetype.getColumn<Velocity>()->value, 1 - tuning.asteroidFriction);
+		}
+	}
+}
+
+//Asteroid vs asteroid, solved on full velocities so a fast asteroid bounces off a slower one in front of it
+void solveAsteroidCollisions() {
+	asteroidSolver->clear();
+	asteroidQuery.forEach([](Entity, Position& position, Rotation&, Scaling& scaling, Velocity& velocity, Asteroid& asteroid) {
+		float radius = asteroidSprite.getTotalSpriteWidth() / 2 * scaling.value.x;
+		Vec2 totalVelocity = velocity.value;
+		if (!timeStop) {
+			totalVelocity += getAsteroidFallVelocity(asteroid.type);
+		}
+		asteroidSolver->addBody(position.value.x + radius, position.value.y + radius, totalVelocity.x, totalVelocity.y, radius, getAsteroidMass(asteroid.type));
+	});
+	asteroidSolver->solve(tuning.asteroidSolverIterations, tuning.asteroidRestitution);
+	tickCollisions += asteroidSolver->getContactCount();
+	int body = 0;
+	asteroidQuery.forEach([&body](Entity, Position& position, Rotation&, Scaling& scaling, Velocity& velocity, Asteroid& asteroid) {
+		float radius = asteroidSprite.getTotalSpriteWidth() / 2 * scaling.value.x;
+		position.value = Vec2(asteroidSolver->getX(body) - radius, asteroidSolver->getY(body) - radius);
+		velocity.value = Vec2(asteroidSolver->getVelocityX(body), asteroidSolver->getVelocityY(body));
+		if (!timeStop) {
+			velocity.value -= getAsteroidFallVelocity(asteroid.type);
+		}
+		body++;
+	});
+}
+
+void buildBounds(Entity, Position& position, Scaling& scaling, CollisionBounds& bounds) {
+	bounds.left = position.value.x;
+	bounds.top = position.value.y;
+	bounds.right = bounds.left + asteroidSprite.getTotalSpriteWidth() * scaling.value.x;
+	bounds.bottom = bounds.top + asteroidSprite.getTotalSpriteHeight() * scaling.value.y;
+}
+
+//Bullet and asteroid movement, runs as one job so it overlaps the spaceship movement
+void integrateEntities(int) {
+	parallelForEach(bulletQuery, moveBullet);
+	if (!timeStop) {
+		parallelForEach(asteroidQuery, moveAsteroid);
+	}
+	if (timeStop) {
+		driftAsteroids();
+	}
+}
+
+// Spaceship Movement
+void moveSpaceship(Spaceship& ship, Animation& animation, const PlayerInput& input) {
+	int clip = animation.clip;
+	if ((int)ship.velocity.x == 0 && (int)ship.velocity.y == 0) {
+		clip = StaticClip;
+	}
+	if (input.buttons & MoveLeftButton) {
+		ship.engineForce.x += sin(270 * PI / 180) * tuning.spaceshipEnginePower;
+		ship.engineForce.y += -cos(270 * PI / 180) * tuning.spaceshipEnginePower;
+		ship.acceleration = ship.engineForce / tuning.spaceshipMass;
+		clip = BankLeftClip;
+	}
+	if (input.buttons & MoveRightButton) {
+		ship.engineForce.x += sin(90 * PI / 180) * tuning.spaceshipEnginePower;
+		ship.engineForce.y += -cos(90 * PI / 180) * tuning.spaceshipEnginePower;
+		ship.acceleration = ship.engineForce / tuning.spaceshipMass;
+		clip = BankRightClip;
+	}
+	if (input.buttons & MoveUpButton) {
+		ship.engineForce.x += sin(0) * tuning.spaceshipEnginePower;
+		ship.engineForce.y += -cos(0) * tuning.spaceshipEnginePower;
+		ship.acceleration = ship.engineForce / tuning.spaceshipMass;
+		clip = StaticClip;
+	}
+	if (input.buttons & MoveDownButton) {
+		ship.engineForce.x += sin(180 * PI / 180) * tuning.spaceshipEnginePower;
+		ship.engineForce.y += -cos(180 * PI / 180) * tuning.spaceshipEnginePower;
+		ship.acceleration = ship.engineForce / tuning.spaceshipMass;
+		clip = StaticClip;
+	}
+	if ((input.buttons & MoveLeftButton) && (input.buttons & MoveUpButton)) {
+		clip = BankLeftClip;
+	}
+	if ((input.buttons & MoveUpButton) && (input.buttons & MoveRightButton)) {
+		clip = BankRightClip;
+	}
+	if ((input.buttons & MoveDownButton) && (input.buttons & MoveLeftButton)) {
+		clip = BankLeftClip;
+	}
+	if ((input.buttons & MoveDownButton) && (input.buttons & MoveRightButton)) {
+		clip = BankRightClip;
+	}
+	spaceshipSprite.play(animation, clip);
+
+	ship.velocity += ship.acceleration;
+	ship.velocity *= (1 - tuning.friction);
+	ship.position += ship.velocity;
+
+
+	//Spaceship right checking
+	if (ship.position.x > screenWidth - spaceshipSprite.getSpriteWidth()) {
+		ship.position.x = screenWidth - spaceshipSprite.getSpriteWidth();
+		ship.velocity.x *= -1;
+	}
+	//Spaceship left checking
+	if (ship.position.x < 0) {
+		ship.position.x = 0;
+		ship.velocity.x *= -1;
+	}
+	//Spaceship top checking
+	if (ship.position.y < 0) {
+		ship.position.y = 0;
+		ship.velocity.y *= -1;
+	}
+	//Spaceship bottom checking
+	if (ship.position.y > screenHeight - spaceshipSprite.getSpriteHeight()) {
+		ship.position.y = screenHeight - spaceshipSprite.getSpriteHeight();
+		ship.velocity.y *= -1;
+	}
+}
+
+void aimTurret(Spaceship& ship, const PlayerInput& input) {
+	pointerCenterX = input.aimX + pointerSprite.getTotalSpriteWidth() / 2;
+	pointerCenterY = input.aimY + pointerSprite.getTotalSpriteHeight() / 2;
+	turretCenterX = ship.turretPosition.x + turretSprite.getSpriteWidth() / 2;
+	turretCenterY = ship.turretPosition.y + turretSprite.getSpriteHeight() / 2;
+
+	if (pointerCenterY > turretCenterY) {
+		ship.turretRotation = PI - asin((pointerCenterX - turretCenterX) / sqrt(pow(pointerCenterX - turretCenterX, 2) + pow(turretCenterY - pointerCenterY, 2)));
+	}
+	else {
+		ship.turretRotation = asin((pointerCenterX - turretCenterX) / sqrt(pow(pointerCenterX - turretCenterX, 2) + pow(turretCenterY - pointerCenterY, 2)));
+	}
+}
+
+//One tick of every spaceship animation, each sheet walks its own array
+void animateSpaceships() {
+	spaceshipSprite.advance(spaceshipAnimations, playerCount, 1);
+	thrustSprite.advance(thrustAnimations, playerCount, 1);
+	turretSprite.advance(turretAnimations, playerCount, 1);
+}
+
+//inputs[player] for every player
+void update(int frames, const PlayerInput* inputs) {
+	for (int player = 0; player < playerCount; player++) {
+		Spaceship& ship = spaceships[player];
+		ship.turretPosition = ship.position - Vec2(spaceshipSprite.getSpriteWidth() / 2 + 10, spaceshipSprite.getSpriteHeight() / 2 + 5);
+	}
+	if (frames > 1) {
+		frames = 1;
+	}
+	for (int i = 0; i < frames; i++)
+	{
+		// Bullet and Asteroid Movement run on the job system while the spaceships move on this thread
+		JobCounter integrationCounter;
+		jobSystem->run(integrateEntities, 0, 1, integrationCounter);
+
+		for (int player = 0; player < playerCount; player++) {
+			moveSpaceship(spaceships[player], spaceshipAnimations[player], inputs[player]);
+		}
+		animateSpaceships();
+
+		jobSystem->wait(integrationCounter);
+		chrono::steady_clock::time_point collisionStart = chrono::steady_clock::now();
+		solveAsteroidCollisions();
+		parallelForEach(boundsQuery, buildBounds);
+		collisionDetection();
+		collisionMicroseconds = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - collisionStart).count();
+
+		for (int player = 0; player < playerCount; player++) {
+			Spaceship& ship = spaceships[player];
+			// Exhaust goes out opposite the engine force
+			if ((ship.engineForce.x != 0 || ship.engineForce.y != 0) && effectsEnabled()) {
+				float exhaustDirection = atan2(-ship.engineForce.x, ship.engineForce.y);
+				particleSystem->emit(exhaustEmitter, ship.position.x + spaceshipSprite.getSpriteWidth() / 2, ship.position.y + spaceshipSprite.getSpriteHeight(), exhaustDirection, *effectRandom);
+			}
+		}
+		if (effectsEnabled()) {
+			particleSystem->update(1);
+		}
+
+		for (int player = 0; player < playerCount; player++) {
+			spaceships[player].acceleration = Vec2(0, 0);
+			spaceships[player].engineForce = Vec2(0, 0);
+		}
+	}
+
+	for (int player = 0; player < playerCount; player++) {
+		aimTurret(spaceships[player], inputs[player]);
+	}
+}
+
+void updateBullet(int frames, const PlayerInput* inputs) {
+	if (frames > 1) {
+		frames = 1;
+	}
+	for (int i = 0; i < frames; i++) {
+		for (int player = 0; player < playerCount; player++) {
+			Spaceship& ship = spaceships[player];
+			if (inputs[player].buttons & FireButton) {
+				bulletStartPosition = Vec2(ship.position.x + spaceshipSprite.getSpriteWidth() / 2 - 5, ship.position.y + spaceshipSprite.getSpriteHeight() / 2 - 5);
+				world.create(Position{ bulletStartPosition }, Rotation{ ship.turretRotation }, Bullet());
+				playSound(ShootSound, ship.position.x);
+			}
+		}
+	}
+
+}
+void updateAsteroid(int frames) {
+	if (frames > 1) {
+		frames = 1;
+	}
+	if (!timeStop) {
+		for (int i = 0; i < frames; i++) {
+			asteroidStartPosition.x = asteroidRandom->range(50, 1150);
+			asteroidStartRotation = asteroidRandom->range(360);
+			if(currentPhase== FirstPhase){
+				chosenAsteroid = asteroidRandom->range(1);
+			} 
+			if (currentPhase == SecondPhase) {
+				chosenAsteroid = asteroidRandom->range(2);
+			}
+			if (currentPhase == ThirdPhase) {
+				chosenAsteroid = asteroidRandom->range(3);
+			}
+
+			if (chosenAsteroid == smallAsteroid) {
+				chosenAsteroidHp = tuning.smallAsteroidHp;
+				asteroidScaling = Vec2(1, 1);
+			}
+			if (chosenAsteroid == mediumAsteroid) {
+				chosenAsteroidHp = tuning.mediumAsteroidHp;
+				asteroidScaling = Vec2(1.5, 1.5);
+			}
+			if (chosenAsteroid == largeAsteroid) {
+				chosenAsteroidHp = tuning.largeAsteroidHp;
+				asteroidScaling = Vec2(2, 2);
+			}
+			CollisionBounds bounds = {};
+			world.create(Position{ asteroidStartPosition }, Rotation{ asteroidStartRotation }, Scaling{ asteroidScaling }, Velocity{ Vec2(0, 0) }, Asteroid{ chosenAsteroidHp, chosenAsteroid }, bounds);
+		}
+	}
+}
+
+//Power ups beyond tuning.maxPowerUps push out the oldest
+void spawnPowerUp(const Vec2& position, int type) {
+	world.create(Position{ position }, PowerUp{ type, powerUpSpawnCount });
+	powerUpSpawnCount++;
+	if (powerUpQuery.count() > tuning.maxPowerUps) {
+		Entity oldest = Entity(); //generation 0 never matches an entity
+		long long oldestOrder = powerUpSpawnCount;
+		powerUpQuery.forEach([&oldest, &oldestOrder](Entity entity, Position&, PowerUp& powerUp) {
+			if (powerUp.spawnOrder < oldestOrder) {
+				oldest = entity;
+				oldestOrder = powerUp.spawnOrder;
+			}
+		});
+		if (world.isAlive(oldest)) {
+			world.destroy(oldest);
+		}
+	}
+}
+
+void updateWave(int frames) {
+	if (frames > 1) {
+		frames = 1;
+	}
+	powerUpPosition.x = powerUpRandom->range(50, 1250);
+	powerUpPosition.y = 600;
+	powerUpChosen = powerUpRandom->range(3);
+	for (int i = 0; i < frames; i++) {
+		waveSec++;
+		powerUpSpawnRateLeft--;
+		if (waveSec == 60) {
+			waveSec = 0;
+			waveMin++;
+		}
+		if (timeStop) {
+			timeStopDurationLeft--;
+			if (timeStopDurationLeft <= 0) {
+				timeStop = false;
+				timeStopDurationLeft = tuning.timeStopDuration;
+			}
+		}
+		if (bulletPowerUpPicked) {
+			bulletPowerUpDurationLeft--;
+			if (bulletPowerUpDurationLeft <= 0) {
+				bulletPowerUpPicked = false;
+				bulletPowerUpDurationLeft = tuning.bulletPowerUpDuration;
+			}
+		}
+		if (powerUpSpawnRateLeft <= 0) {
+			powerUpSpawnRateLeft = tuning.powerUpSpawnRate;
+			spawnPowerUp(powerUpPosition, powerUpChosen);
+		}
+		if (waveSec == tuning.secondPhaseTimer && waveMin < 1) {
+			currentPhase = SecondPhase;
+		}
+		if (waveSec == tuning.thirdPhaseTimer && waveMin < 1) {
+			currentPhase = ThirdPhase;
+			playSound(ThirdPhaseSound, 0);
+		}
+	}
+}
+
+//Particles, their random stream and this machine's pointer are left out, they never affect the simulation
+//(and rollback replays ticks without particles, so the effect stream would not match)
+void saveGameState(StateWriter& writer) {
+	writer.begin(gameStateVersion);
+	writer.write(gameTick);
+	writer.write(playerCount);
+	writer.write(spaceships);
+	writer.write(spaceshipAnimations);
+	writer.write(thrustAnimations);
+	writer.write(turretAnimations);
+	writer.write(timeStop);
+	writer.write(timeStopDurationLeft);
+	writer.write(bulletPowerUpPicked);
+	writer.write(bulletPowerUpDurationLeft);
+	writer.write(powerUpSpawnRateLeft);
+	writer.write(powerUpSpawnCount);
+	writer.write(waveSec);
+	writer.write(waveMin);
+	writer.write(currentPhase);
+	writer.write(lives);
+	writer.write(scores);
+	writer.write(highScores);
+	writer.write(gameOver);
+	writer.write(gameOverTick);
+	writer.write(*asteroidRandom);
+	writer.write(*powerUpRandom);
+	world.save(writer);
+	writer.end();
+}
+
+//Everything saveGameState writes before the world, read into here first so a bad state never reaches the running game
+struct SavedStage {
+	long long gameTick;
+	int playerCount;
+	Spaceship spaceships[maxPlayers];
+	Animation spaceshipAnimations[maxPlayers];
+	Animation thrustAnimations[maxPlayers];
+	Animation turretAnimations[maxPlayers];
+	bool timeStop;
+	int timeStopDurationLeft;
+	bool bulletPowerUpPicked;
+	int bulletPowerUpDurationLeft;
+	int powerUpSpawnRateLeft;
+	long long powerUpSpawnCount;
+	int waveSec;
+	int waveMin;
+	int currentPhase;
+	int lives;
+	int scores;
+	int highScores;
+	bool gameOver;
+	long long gameOverTick;
+	RandomStream asteroidRandom;
+	RandomStream powerUpRandom;
+};
+
+//Values that index tables or arrays, or that the stage logic never lets go out of range
+bool isStageValid(const SavedStage& stage) {
+	if (stage.playerCount != playerCount || stage.gameTick < 0 || stage.powerUpSpawnCount < 0) {
+		return false;
+	}
+	//slots of players that are not in the game are never used
+	for (int player = 0; player < playerCount; player++) {
+		if ((stage.spaceships[player].hull != 0 && stage.spaceships[player].hull != 1) || !spaceshipSprite.isValid(stage.spaceshipAnimations[player]) ||
+			!thrustSprite.isValid(stage.thrustAnimations[player]) || !turretSprite.isValid(stage.turretAnimations[player])) {
+			return false;
+		}
+	}
+	return stage.currentPhase >= FirstPhase && stage.currentPhase <= ThirdPhase && stage.waveSec >= 0 && stage.waveSec < 60 && stage.waveMin >= 0 &&
+		stage.lives >= 0 && stage.scores >= 0 && stage.highScores >= 0 && stage.timeStopDurationLeft >= 0 && stage.bulletPowerUpDurationLeft >= 0 &&
+		stage.gameOverTick >= 0 && stage.gameOverTick <= stage.gameTick;
+}
+
+//Decoded entity components that index tables, only checked for untrusted data since it means a pass over every entity
+bool areEntitiesValid() {
+	return world.checkDecoded<Asteroid>([](const Asteroid& asteroid) { return asteroid.type >= smallAsteroid && asteroid.type <= largeAsteroid; }) &&
+		world.checkDecoded<PowerUp>([](const PowerUp& powerUp) { return powerUp.type >= hpPowerUp && powerUp.type <= timePowerUp; });
+}
+
+//Returns false if the data is from another version or damaged, the running stage is then left as it was.
+//Only states saved by this run may be trusted, anything read from a file is fully checked.
+bool loadGameState(const unsigned char* data, size_t size, bool trusted) {
+	StateReader reader;
+	if (!reader.begin(data, size, gameStateVersion, trusted)) {
+		cout << "Game State Is Invalid Or From Another Version" << endl;
+		return false;
+	}
+	SavedStage stage = {};
+	reader.read(stage.gameTick);
+	reader.read(stage.playerCount);
+	reader.read(stage.spaceships);
+	reader.read(stage.spaceshipAnimations);
+	reader.read(stage.thrustAnimations);
+	reader.read(stage.turretAnimations);
+	reader.read(stage.timeStop);
+	reader.read(stage.timeStopDurationLeft);
+	reader.read(stage.bulletPowerUpPicked);
+	reader.read(stage.bulletPowerUpDurationLeft);
+	reader.read(stage.powerUpSpawnRateLeft);
+	reader.read(stage.powerUpSpawnCount);
+	reader.read(stage.waveSec);
+	reader.read(stage.waveMin);
+	reader.read(stage.currentPhase);
+	reader.read(stage.lives);
+	reader.read(stage.scores);
+	reader.read(stage.highScores);
+	reader.read(stage.gameOver);
+	reader.read(stage.gameOverTick);
+	reader.read(stage.asteroidRandom);
+	reader.read(stage.powerUpRandom);
+	if (!reader.isValid() || !isStageValid(stage) || !world.decode(reader) || !reader.isFinished() || (!trusted && !areEntitiesValid())) {
+		cout << "Game State Is Damaged" << endl;
+		return false;
+	}
+	world.swapDecoded();
+	gameTick = stage.gameTick;
+	std::copy(stage.spaceships, stage.spaceships + maxPlayers, spaceships);
+	std::copy(stage.spaceshipAnimations, stage.spaceshipAnimations + maxPlayers, spaceshipAnimations);
+	std::copy(stage.thrustAnimations, stage.thrustAnimations + maxPlayers, thrustAnimations);
+	std::copy(stage.turretAnimations, stage.turretAnimations + maxPlayers, turretAnimations);
+	timeStop = stage.timeStop;
+	timeStopDurationLeft = stage.timeStopDurationLeft;
+	bulletPowerUpPicked = stage.bulletPowerUpPicked;
+	bulletPowerUpDurationLeft = stage.bulletPowerUpDurationLeft;
+	powerUpSpawnRateLeft = stage.powerUpSpawnRateLeft;
+	powerUpSpawnCount = stage.powerUpSpawnCount;
+	waveSec = stage.waveSec;
+	waveMin = stage.waveMin;
+	currentPhase = stage.currentPhase;
+	lives = stage.lives;
+	scores = stage.scores;
+	highScores = stage.highScores;
+	//a rollback to before the last life was lost takes the game over back, a state loaded from a file can be played on
+	gameOver = trusted && stage.gameOver;
+	gameOverTick = stage.gameOverTick;
+	*asteroidRandom = stage.asteroidRandom;
+	*powerUpRandom = stage.powerUpRandom;
+	return true;
+}
+
+//Ticks are counted instead of reading wall clock timers, so replaying a tick gives the same result
+int ticksDue(long long tick, int perSecond) {
+	return (int)((tick + 1) * perSecond / gameUpdateRate - tick * perSecond / gameUpdateRate);
+}
+
+void advanceTick(const PlayerInput* inputs) {
+	updateBullet(ticksDue(gameTick, bulletPowerUpPicked ? tuning.bulletPowerUpSpeed : tuning.defaultBulletInterval), inputs);
+	updateAsteroid(ticksDue(gameTick, asteroidSpawnRate));
+	updateWave(ticksDue(gameTick, waveUpdateRate));
+	update(1, inputs);
+	gameTick++;
+}
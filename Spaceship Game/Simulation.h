@@ -0,0 +1,183 @@
+#pragma once
+#include <cstddef>
+#include "CollisionMask.h"
+#include "ECS.h"
+#include "GameTuning.h"
+#include "ImpulseSolver.h"
+#include "JobSystem.h"
+#include "Math2D.h"
+#include "ParticleSystem.h"
+#include "PlayerInput.h"
+#include "RandomStream.h"
+#include "SpriteSheet.h"
+#include "StateBuffer.h"
+
+//The game itself: entities, spaceships, waves and the tick that moves them. Nothing in here knows about Direct3D,
+//DirectInput or FMOD, so it builds on any platform. The game feeds it player inputs and draws what it leaves behind.
+
+enum powerUp { hpPowerUp, bulletPowerUp, timePowerUp };
+enum phaseList { FirstPhase, SecondPhase, ThirdPhase };
+enum asteroidList { smallAsteroid, mediumAsteroid, largeAsteroid };
+//Clips of the spaceship, thrust and turret sheets, in the order of their clip tables
+enum spaceshipClipList { StaticClip, BankLeftClip, BankRightClip };
+enum thrustClipList { ThrustClip };
+enum turretClipList { TurretIdleClip };
+enum gameSound { ShootSound, HitSound, BoomSound, PickUpSound, TimeStopSound, ThirdPhaseSound };
+
+const float PI = 3.142f;
+
+//Spaceships, one per player, player one is spaceships[0]
+struct Spaceship {
+	Vec2 position;
+	float rotation;
+	Vec2 velocity;
+	Vec2 acceleration;
+	Vec2 engineForce;
+	int hull; //0 = ship.png, 1 = ship2.png
+	Vec2 turretPosition;
+	float turretRotation;
+};
+const int maxPlayers = 2;
+
+// Entity Components
+struct Position {
+	Vec2 value;
+};
+struct Rotation {
+	float value;
+};
+struct Scaling {
+	Vec2 value;
+};
+struct Velocity {
+	Vec2 value;
+};
+struct Bullet {
+};
+struct Asteroid {
+	int hp;
+	int type;
+};
+struct PowerUp {
+	int type;
+	long long spawnOrder;
+};
+// Broadphase, asteroid bounds are rebuilt after every movement step
+struct CollisionBounds {
+	float left;
+	float top;
+	float right;
+	float bottom;
+};
+
+//What the simulation needs from the platform, set by the game before the first tick
+struct SimulationCallbacks {
+	void (*playSound)(int sound, float x); //x is where the sound comes from on the screen
+};
+extern SimulationCallbacks simulationCallbacks;
+
+//Playfield
+extern int screenWidth;
+extern int screenHeight;
+
+//Tuning, the balance values
+extern GameTuning tuning;
+
+//Sprite sheets the hit boxes and spawn points are measured from, the renderer draws with the same ones
+extern SpriteSheet pointerSprite;
+extern SpriteSheet spaceshipSprite;
+extern SpriteSheet thrustSprite;
+extern SpriteSheet turretSprite;
+extern SpriteSheet asteroidSprite;
+extern SpriteSheet bulletSprite;
+extern SpriteSheet hpPowerUpSprite;
+
+// Collision Masks, built from the sprites' alpha after the textures are loaded
+// Pairs whose bounding boxes overlap only collide if their visible pixels do
+extern CollisionMaskSet asteroidMasks; //one scale per asteroid type
+extern CollisionMaskSet bulletMasks;
+extern CollisionMaskSet spaceshipMasks[5]; //one per sprite sheet frame
+extern CollisionMaskSet spaceship2Masks[5];
+
+// Entities (bullets, asteroids and power ups), each system walks the packed component arrays of a query
+extern World world;
+extern Query<Position, Rotation, Bullet> bulletQuery;
+extern Query<Position, Rotation, Scaling, Velocity, Asteroid> asteroidQuery;
+extern Query<Position, Scaling, CollisionBounds> boundsQuery;
+extern Query<Position, Rotation, Velocity, Asteroid, CollisionBounds> asteroidHitQuery;
+extern Query<Position, PowerUp> powerUpQuery;
+
+extern Spaceship spaceships[maxPlayers];
+//Animation playback of each spaceship, one array per sheet so a tick advances all of a sheet's animations together
+extern Animation spaceshipAnimations[maxPlayers];
+extern Animation thrustAnimations[maxPlayers];
+extern Animation turretAnimations[maxPlayers];
+extern int playerCount;
+extern int selectedHull; //ship picked in the menu, single player only
+extern float bulletSweepThreshold; //bullets moving further than this per tick are swept instead of tested where they end
+
+// Random Streams
+extern RandomStream* asteroidRandom;
+extern RandomStream* powerUpRandom;
+extern RandomStream* effectRandom;
+extern uint64_t simulationSeed; //the streams start from it at every reset
+// Job System Object
+extern JobSystem* jobSystem;
+extern int entityGrainSize;
+// Asteroid Collision Solver Object
+extern ImpulseSolver* asteroidSolver;
+extern int asteroidSolverBodies;
+extern int asteroidSolverContacts;
+extern int asteroidSolverCells;
+//Particles
+extern ParticleSystem* particleSystem;
+extern int maxParticles;
+
+//Stage
+extern int waveSec;
+extern int waveMin;
+extern int lives;
+extern int scores;
+extern int highScores;
+extern int currentPhase;
+extern bool gameOver; //set by the tick that loses the last life, saved with the state so a rolled back tick takes it back
+extern long long gameOverTick;
+extern bool timeStop;
+extern int timeStopDurationLeft;
+extern bool bulletPowerUpPicked;
+extern int bulletPowerUpDurationLeft;
+extern int powerUpSpawnRateLeft;
+
+//Update rates (per second), every one of them is derived from gameTick
+extern int gameUpdateRate;
+extern int asteroidSpawnRate;
+extern int waveUpdateRate;
+extern long long gameTick;
+
+//Sounds and particles are skipped while this is set, the rollback session replays ticks that were already shown
+extern bool replayingTicks;
+
+//Counters of the last tick for telemetry and the stress mode
+extern int tickCollisions; //resolved during the current tick
+extern long long collisionMicroseconds; //spent on collisions by the last update
+
+extern const uint32_t gameStateVersion;
+
+void placeSpaceships();
+void seedSimulation(uint64_t seed);
+void resetSimulation();
+
+//inputs[player] for every player
+void update(int frames, const PlayerInput* inputs);
+void updateBullet(int frames, const PlayerInput* inputs);
+void updateAsteroid(int frames);
+void updateWave(int frames);
+void spawnPowerUp(const Vec2& position, int type);
+
+//How many times something that happens perSecond times a second falls in a given tick
+int ticksDue(long long tick, int perSecond);
+//One game tick: fires, spawns and counts down the wave by ticksDue, then moves everything once
+void advanceTick(const PlayerInput* inputs);
+
+void saveGameState(StateWriter& writer);
+bool loadGameState(const unsigned char* data, size_t size, bool trusted);
@@ -0,0 +1,164 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "StateBuffer.h"
+
+//Handle into a SlotMap, stays comparable after the value is erased so stale handles can be detected
+struct SlotHandle {
+	uint32_t index;
+	uint32_t generation;
+};
+
+//Values are stored densely (erase swaps the last one into the gap) and found through a sparse slot array.
+//Every slot has a generation that is odd while it holds a value and is bumped on insert and erase,
+//so a handle to an erased value never matches again. Insert, erase and lookup are O(1).
+//A slot whose generation wraps around is retired instead of reused, so even a very old handle cannot match.
+template <typename T>
+class SlotMap
+{
+public:
+	SlotHandle insert(const T& value) {
+		uint32_t index;
+		if (freeHead != noSlot) {
+			index = freeHead;
+			freeHead = slots[index].denseIndex;
+		}
+		else {
+			index = (uint32_t)slots.size();
+			slots.push_back(Slot{ 0, 0 });
+		}
+		Slot& slot = slots[index];
+		slot.denseIndex = (uint32_t)values.size();
+		slot.generation++;
+		values.push_back(value);
+		denseSlots.push_back(index);
+		return SlotHandle{ index, slot.generation };
+	}
+
+	//Returns false if the handle was already stale
+	bool erase(SlotHandle handle) {
+		if (!contains(handle)) {
+			return false;
+		}
+		Slot& slot = slots[handle.index];
+		uint32_t last = (uint32_t)values.size() - 1;
+		if (slot.denseIndex != last) {
+			values[slot.denseIndex] = values[last];
+			denseSlots[slot.denseIndex] = denseSlots[last];
+			slots[denseSlots[last]].denseIndex = slot.denseIndex;
+		}
+		values.pop_back();
+		denseSlots.pop_back();
+		release(handle.index);
+		return true;
+	}
+
+	bool contains(SlotHandle handle) const {
+		return handle.index < slots.size() && slots[handle.index].generation == handle.generation && (handle.generation & 1) != 0;
+	}
+
+	//NULL for stale handles, the pointer is only valid until the next insert or erase
+	T* get(SlotHandle handle) {
+		return contains(handle) ? &values[slots[handle.index].denseIndex] : NULL;
+	}
+	const T* get(SlotHandle handle) const {
+		return contains(handle) ? &values[slots[handle.index].denseIndex] : NULL;
+	}
+
+	//Erases everything, all outstanding handles become stale
+	void clear() {
+		for (size_t i = 0; i < denseSlots.size(); i++) {
+			release(denseSlots[i]);
+		}
+		values.clear();
+		denseSlots.clear();
+	}
+
+	//Erases everything and forgets the slots too, so the map is as if new (the memory is kept).
+	//Handles from before may match again, only for when none are kept.
+	void reset() {
+		values.clear();
+		denseSlots.clear();
+		slots.clear();
+		freeHead = noSlot;
+	}
+
+	//Dense access, for walking every value without touching the slots
+	int size() const {
+		return (int)values.size();
+	}
+	T& at(int denseIndex) {
+		return values[denseIndex];
+	}
+	SlotHandle getHandle(int denseIndex) const {
+		uint32_t index = denseSlots[denseIndex];
+		return SlotHandle{ index, slots[index].generation };
+	}
+	typename std::vector<T>::iterator begin() {
+		return values.begin();
+	}
+	typename std::vector<T>::iterator end() {
+		return values.end();
+	}
+
+	//Copies the slots too (generations and free list), so handles taken before a save are valid again after a load.
+	//T must be plain data.
+	void save(StateWriter& writer) const {
+		writer.writeArray(values.data(), (int)values.size());
+		writer.writeArray(denseSlots.data(), (int)denseSlots.size());
+		writer.writeArray(slots.data(), (int)slots.size());
+		writer.write(freeHead);
+	}
+	//Returns false if the data is inconsistent (not checked for trusted data), the map is then left in an unspecified state
+	bool load(StateReader& reader) {
+		if (!reader.readArray(values) || !reader.readArray(denseSlots) || !reader.readArray(slots) || !reader.read(freeHead)) {
+			return false;
+		}
+		if (denseSlots.size() != values.size()) {
+			return false;
+		}
+		if (reader.isTrusted()) {
+			return true;
+		}
+		for (size_t i = 0; i < denseSlots.size(); i++) {
+			if (denseSlots[i] >= slots.size() || slots[denseSlots[i]].denseIndex != i || (slots[denseSlots[i]].generation & 1) == 0) {
+				return false;
+			}
+		}
+		//the free list must only go through empty slots and end
+		uint32_t freeSlot = freeHead;
+		for (size_t steps = 0; freeSlot != noSlot; steps++) {
+			if (steps == slots.size() || freeSlot >= slots.size() || (slots[freeSlot].generation & 1) != 0) {
+				return false;
+			}
+			freeSlot = slots[freeSlot].denseIndex;
+		}
+		return true;
+	}
+
+private:
+	static const uint32_t noSlot = 0xffffffff;
+
+	struct Slot {
+		uint32_t denseIndex; //next free slot while the slot is empty
+		uint32_t generation;
+	};
+
+	void release(uint32_t index) {
+		Slot& slot = slots[index];
+		slot.generation++;
+		if (slot.generation == 0) {
+			//wrapped, reusing it would revive handles from 2^31 uses ago
+			slot.denseIndex = noSlot;
+			return;
+		}
+		slot.denseIndex = freeHead;
+		freeHead = index;
+	}
+
+	std::vector<T> values;
+	std::vector<uint32_t> denseSlots; //slot of every value
+	std::vector<Slot> slots;
+	uint32_t freeHead = noSlot;
+};
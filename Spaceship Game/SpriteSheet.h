@@ -0,0 +1,164 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+//Part of a sprite sheet in pixels, laid out like a Windows RECT
+struct SpriteRect {
+	long left;
+	long top;
+	long right;
+	long bottom;
+};
+
+//A named run of sheet frames, each shown for frameTicks simulation ticks
+struct AnimationClip {
+	const char* name;
+	int firstFrame;
+	int frameCount;
+	int frameTicks;
+	bool loop; //otherwise it stays on its last frame
+};
+
+//Playback state of one entity, frame is the sheet frame to draw so the renderer never looks at the clip
+struct Animation {
+	int clip;
+	int frame;
+	int ticksLeft;
+};
+
+//SpriteSheet Class
+//The rect of every frame is worked out once when the sheet is made, drawing a frame is a lookup in that table
+
+class SpriteSheet
+{
+private:
+	float totalSpriteWidth = 0;
+	float totalSpriteHeight = 0;
+	float spriteWidth = 0;
+	float spriteHeight = 0;
+	int spriteRow = 0;
+	int spriteCol = 0;
+	std::vector<SpriteRect> frames;
+	std::vector<AnimationClip> clips;
+
+	void buildFrames(int frameCount) {
+		frames.resize(frameCount);
+		for (int frame = 0; frame < frameCount; frame++) {
+			SpriteRect& frameRect = frames[frame];
+			frameRect.left = (long)((frame % spriteCol) * spriteWidth);
+			frameRect.right = (long)(frameRect.left + spriteWidth);
+			frameRect.top = (long)((frame / spriteCol) * spriteHeight);
+			frameRect.bottom = (long)(frameRect.top + spriteHeight);
+		}
+	}
+
+public:
+	//Frames are read left to right, top to bottom, clips are numbered in the order of the table
+	SpriteSheet(float totalSpriteWidth, float totalSpriteHeight, int spriteRow, int spriteCol, int frameCount, const AnimationClip* clipTable = NULL, int clipCount = 0)
+	{
+		this->totalSpriteWidth = totalSpriteWidth;
+		this->totalSpriteHeight = totalSpriteHeight;
+		this->spriteRow = spriteRow;
+		this->spriteCol = spriteCol;
+		this->spriteWidth = totalSpriteWidth / spriteCol;
+		this->spriteHeight = totalSpriteHeight / spriteRow;
+		buildFrames(frameCount);
+		clips.assign(clipTable, clipTable + clipCount);
+	}
+
+	//A single image, one frame covering all of it
+	SpriteSheet(float totalSpriteWidth, float totalSpriteHeight) {
+		this->totalSpriteWidth = totalSpriteWidth;
+		this->totalSpriteHeight = totalSpriteHeight;
+		this->spriteRow = 1;
+		this->spriteCol = 1;
+		this->spriteWidth = totalSpriteWidth;
+		this->spriteHeight = totalSpriteHeight;
+		buildFrames(1);
+	}
+
+	float getTotalSpriteWidth() {
+		return totalSpriteWidth;
+	}
+	float getTotalSpriteHeight() {
+		return totalSpriteHeight;
+	}
+	int getSpriteRow() {
+		return spriteRow;
+	}
+	int getSpriteCol() {
+		return spriteCol;
+	}
+	int getFrameCount() {
+		return (int)frames.size();
+	}
+	float getSpriteWidth() {
+		return spriteWidth;
+	}
+	float getSpriteHeight() {
+		return spriteHeight;
+	}
+	const SpriteRect& getFrameRect(int frame) {
+		return frames[frame];
+	}
+
+	int getClipCount() {
+		return (int)clips.size();
+	}
+	//-1 if the sheet has no clip of that name
+	int findClip(const char* name) {
+		for (int i = 0; i < (int)clips.size(); i++) {
+			if (strcmp(clips[i].name, name) == 0) {
+				return i;
+			}
+		}
+		return -1;
+	}
+	const AnimationClip& getClip(int clip) {
+		return clips[clip];
+	}
+
+	//Starts a clip from its first frame, asking for the clip that is already playing leaves it running
+	void play(Animation& animation, int clip) {
+		if (animation.clip == clip && animation.ticksLeft > 0) {
+			return;
+		}
+		animation.clip = clip;
+		animation.frame = clips[clip].firstFrame;
+		animation.ticksLeft = clips[clip].frameTicks;
+	}
+
+	//For playback state read from a file, a clip or frame outside the tables would be drawn from past their end
+	bool isValid(const Animation& animation) {
+		if (animation.clip < 0 || animation.clip >= (int)clips.size()) {
+			return false;
+		}
+		const AnimationClip& clip = clips[animation.clip];
+		return animation.frame >= clip.firstFrame && animation.frame < clip.firstFrame + clip.frameCount &&
+			animation.ticksLeft >= 1 && animation.ticksLeft <= clip.frameTicks;
+	}
+
+	//Moves every animation of this sheet on by some ticks in one pass
+	void advance(Animation* animations, int count, int ticks) {
+		for (int i = 0; i < count; i++) {
+			Animation& animation = animations[i];
+			const AnimationClip& clip = clips[animation.clip];
+			animation.ticksLeft -= ticks;
+			while (animation.ticksLeft <= 0) {
+				int lastFrame = clip.firstFrame + clip.frameCount - 1;
+				if (animation.frame < lastFrame) {
+					animation.frame++;
+				}
+				else if (clip.loop) {
+					animation.frame = clip.firstFrame;
+				}
+				else {
+					animation.ticksLeft = 1;
+					break;
+				}
+				animation.ticksLeft += clip.frameTicks;
+			}
+		}
+	}
+};
@@ -0,0 +1,100 @@
+#include "StateBuffer.h"
+#include <fstream>
+
+static const uint32_t stateMagic = 0x54534753; //"SGST"
+
+struct StateHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t payloadSize;
+};
+
+void StateWriter::begin(uint32_t version)
+{
+	used = 0;
+	StateHeader header = { stateMagic, version, 0 };
+	write(header);
+}
+
+void StateWriter::end()
+{
+	StateHeader header;
+	memcpy(&header, data.data(), sizeof(header));
+	header.payloadSize = used - sizeof(header);
+	memcpy(data.data(), &header, sizeof(header));
+}
+
+const unsigned char* StateWriter::getData()
+{
+	return data.data();
+}
+
+size_t StateWriter::getSize()
+{
+	return used;
+}
+
+bool StateWriter::saveToFile(const char* fileName)
+{
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+	file.write((const char*)data.data(), used);
+	return file.good();
+}
+
+void StateWriter::grow(size_t size)
+{
+	//doubling keeps the number of reallocations small while the first snapshots find their size
+	size_t capacity = data.size() < 4096 ? 4096 : data.size();
+	while (capacity < size) {
+		capacity *= 2;
+	}
+	data.resize(capacity);
+}
+
+bool StateReader::begin(const unsigned char* data, size_t size, uint32_t version, bool trusted)
+{
+	this->data = data;
+	this->size = size;
+	this->trusted = trusted;
+	position = 0;
+	valid = true;
+	StateHeader header;
+	if (!read(header) || header.magic != stateMagic || header.version != version || header.payloadSize != size - sizeof(header)) {
+		valid = false;
+	}
+	return valid;
+}
+
+bool StateReader::isValid()
+{
+	return valid;
+}
+
+bool StateReader::isFinished()
+{
+	return valid && position == size;
+}
+
+bool StateReader::isTrusted()
+{
+	return trusted;
+}
+
+bool loadStateFile(const char* fileName, std::vector<unsigned char>& data)
+{
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	std::streamoff size = file.tellg();
+	if (size <= 0) {
+		return false;
+	}
+	data.resize((size_t)size);
+	file.seekg(0);
+	file.read((char*)data.data(), size);
+	return file.good();
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+//Binary snapshot of plain data.
+//Everything is copied into one growing byte buffer that is reused between snapshots, so after the first few
+//snapshots no memory is allocated, and the whole state can be written to or read from a file in one call.
+//Layout: header (magic, version, payload size) followed by the raw bytes in the order they were written.
+class StateWriter
+{
+public:
+	void begin(uint32_t version);
+	void end(); //fills in the payload size
+
+	template <typename T>
+	void write(const T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written");
+		writeBytes(&value, sizeof(T));
+	}
+	//Element count followed by the elements
+	template <typename T>
+	void writeArray(const T* values, int count) {
+		static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written");
+		write(count);
+		writeBytes(values, count * sizeof(T));
+	}
+	void writeBytes(const void* bytes, size_t size) {
+		if (used + size > data.size()) {
+			grow(used + size);
+		}
+		memcpy(&data[used], bytes, size);
+		used += size;
+	}
+
+	const unsigned char* getData();
+	size_t getSize();
+	bool saveToFile(const char* fileName);
+
+private:
+	void grow(size_t size);
+
+	std::vector<unsigned char> data;
+	size_t used = 0;
+};
+
+//Reads back what a StateWriter wrote. Any read past the end fails and so does every read after it,
+//so callers can read everything and check isValid() once at the end.
+class StateReader
+{
+public:
+	//Fails if the header is damaged, the version differs or the payload is cut short.
+	//Trusted data was written by this process (quick saves, rollback), readers may skip their slower consistency checks on it,
+	//sizes are still checked on every read.
+	bool begin(const unsigned char* data, size_t size, uint32_t version, bool trusted = false);
+
+	template <typename T>
+	bool read(T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read");
+		return readBytes(&value, sizeof(T));
+	}
+	//Fails if more than maxCount elements were written
+	template <typename T>
+	bool readArray(T* values, int maxCount, int& count) {
+		static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read");
+		if (!read(count) || count < 0 || count > maxCount) {
+			valid = false;
+			return false;
+		}
+		return readBytes(values, count * sizeof(T));
+	}
+	template <typename T>
+	bool readArray(std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read");
+		int count;
+		if (!read(count) || count < 0 || (size_t)count > (size - position) / sizeof(T)) {
+			valid = false;
+			return false;
+		}
+		values.resize(count);
+		return readBytes(values.data(), count * sizeof(T));
+	}
+	bool readBytes(void* bytes, size_t byteCount) {
+		if (!valid || byteCount > size - position) {
+			valid = false;
+			return false;
+		}
+		memcpy(bytes, data + position, byteCount);
+		position += byteCount;
+		return true;
+	}
+
+	bool isValid();
+	bool isFinished(); //valid and every byte was read
+	bool isTrusted();
+
+private:
+	const unsigned char* data = NULL;
+	size_t size = 0;
+	size_t position = 0;
+	bool valid = false;
+	bool trusted = false;
+};
+
+bool loadStateFile(const char* fileName, std::vector<unsigned char>& data);
@@ -0,0 +1,104 @@
+#include "StressMode.h"
+#include <chrono>
+#include <iostream>
+#include "Simulation.h"
+
+StressTest* stressTest = new StressTest();
+Autopilot stressAutopilot;
+int stressTicksPerLevel = 150; //3 seconds of game time
+float stressGrowth = 1.5;      //load multiplier from one level to the next
+float stressBudgetMs = 20;     //one tick at gameUpdateRate
+int stressMaxLevels = 30;
+const char* stressReportFile = "stress_report.csv";
+LatencyTracker* stressLatencyTracker = NULL;
+
+typedef std::chrono::steady_clock Clock;
+
+long long microsecondsBetween(Clock::time_point start, Clock::time_point end) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+void printStressResults() {
+	const std::vector<StressLevel>& levels = stressTest->getLevels();
+	if (stressTest->isOverBudget()) {
+		std::cout << "Tick p95 passed " << stressBudgetMs << "ms at level " << levels.back().level << " (load x" << levels.back().load << ")" << std::endl;
+	}
+	else {
+		std::cout << "Tick p95 stayed under " << stressBudgetMs << "ms for all " << levels.size() << " levels" << std::endl;
+	}
+	for (int i = 0; i < stressSubsystemCount; i++) {
+		int knee = stressTest->getKnee(i);
+		if (knee >= 0) {
+			std::cout << "Knee of " << StressTest::getSubsystemName(i) << " at level " << levels[knee].level << " with "
+				<< (int)(levels[knee].bullets + levels[knee].asteroids + levels[knee].powerUps) << " entities" << std::endl;
+		}
+		else {
+			std::cout << "No knee for " << StressTest::getSubsystemName(i) << std::endl;
+		}
+	}
+	if (stressTest->writeReport(stressReportFile)) {
+		std::cout << "Stress report written to " << stressReportFile << std::endl;
+	}
+}
+
+//Spawn rates and the power up count are the normal ones times the load of the current level, fractions carry over to
+//the next tick
+void runStressTest(const StressCallbacks& callbacks) {
+	stressTest->init(stressTicksPerLevel, stressGrowth, stressBudgetMs, stressMaxLevels);
+	stressAutopilot.reset();
+	resetSimulation();
+	int normalPowerUps = tuning.maxPowerUps;
+	float asteroidsDue = 0;
+	float bulletsDue = 0;
+	int reportedLevel = -1;
+	while (!stressTest->isFinished()) {
+		float load = stressTest->getLoad();
+		if (stressTest->getLevel() != reportedLevel) {
+			reportedLevel = stressTest->getLevel();
+			std::cout << "Stress level " << reportedLevel << ", load x" << load << std::endl;
+		}
+		PlayerInput inputs[maxPlayers] = { stressAutopilot.next(screenWidth, screenHeight) };
+		if (stressLatencyTracker != NULL) {
+			stressLatencyTracker->captureInput(KeyboardInput | MouseInput);
+		}
+		//the autopilot never dies and time never stops, so every tick carries the whole load
+		lives = 3;
+		timeStop = false;
+
+		Clock::time_point tickStart = Clock::now();
+		bulletsDue += tuning.defaultBulletInterval * load / gameUpdateRate;
+		for (; bulletsDue >= 1; bulletsDue--) {
+			updateBullet(1, inputs);
+		}
+		asteroidsDue += asteroidSpawnRate * load / gameUpdateRate;
+		for (; asteroidsDue >= 1; asteroidsDue--) {
+			updateAsteroid(1);
+		}
+		tuning.maxPowerUps = (int)(normalPowerUps * load);
+		while (powerUpQuery.count() < tuning.maxPowerUps) {
+			Vec2 position;
+			position.x = powerUpRandom->range(50, 1250);
+			position.y = powerUpRandom->range(100, 650);
+			spawnPowerUp(position, powerUpRandom->range(3));
+		}
+		updateWave(ticksDue(gameTick, waveUpdateRate));
+		update(1, inputs);
+		gameTick++;
+		if (stressLatencyTracker != NULL) {
+			stressLatencyTracker->consumeInput(KeyboardInput | MouseInput, gameTick);
+		}
+		Clock::time_point simulationEnd = Clock::now();
+		if (callbacks.buildFrame != NULL) {
+			callbacks.buildFrame();
+		}
+		Clock::time_point buildEnd = Clock::now();
+
+		long long times[stressSubsystemCount];
+		times[CollisionSubsystem] = collisionMicroseconds;
+		times[SimulationSubsystem] = microsecondsBetween(tickStart, simulationEnd) - collisionMicroseconds;
+		times[RenderBuildSubsystem] = microsecondsBetween(simulationEnd, buildEnd);
+		stressTest->recordTick(times, bulletQuery.count(), asteroidQuery.count(), powerUpQuery.count());
+	}
+	tuning.maxPowerUps = normalPowerUps;
+	printStressResults();
+}
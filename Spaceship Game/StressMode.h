@@ -0,0 +1,24 @@
+#pragma once
+#include "LatencyTracker.h"
+#include "StressTest.h"
+
+//Stress mode (-stress [budget ms]), no menus and no rendering, the load is ramped until a tick passes the budget.
+//Runs the same on the game and on the headless build, the platform only decides what a frame's render build is.
+
+//What the stress mode needs from the platform
+struct StressCallbacks {
+	void (*buildFrame)(); //timed as the render build after every tick, NULL for none
+};
+
+extern StressTest* stressTest;
+extern Autopilot stressAutopilot;
+extern int stressTicksPerLevel;
+extern float stressGrowth;
+extern float stressBudgetMs;
+extern int stressMaxLevels;
+extern const char* stressReportFile;
+extern LatencyTracker* stressLatencyTracker; //when set the autopilot's input is captured and consumed through it, buildFrame presents
+
+//Ticks run back to back on the calling thread with the autopilot flying, the results are printed and written to
+//stressReportFile. Starts from a reset stage, the job system and the particles have to be set up before.
+void runStressTest(const StressCallbacks& callbacks);
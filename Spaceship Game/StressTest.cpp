@@ -0,0 +1,204 @@
+#include "StressTest.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+const float StressTest::kneeRatio = 2;
+const float StressTest::kneeMinimumMs = 0.05f;
+
+void StressTest::init(int ticksPerLevel, float growth, float budgetMs, int maxLevels)
+{
+	this->ticksPerLevel = ticksPerLevel;
+	this->growth = growth;
+	this->budgetMs = budgetMs;
+	this->maxLevels = maxLevels;
+	level = 0;
+	finished = false;
+	overBudget = false;
+	for (int i = 0; i < stressSubsystemCount; i++) {
+		samples[i].clear();
+		samples[i].reserve(ticksPerLevel);
+		knees[i] = -1;
+	}
+	tickSamples.clear();
+	tickSamples.reserve(ticksPerLevel);
+	entityTotals[0] = entityTotals[1] = entityTotals[2] = 0;
+	levels.clear();
+}
+
+void StressTest::recordTick(const long long* subsystemMicroseconds, int bullets, int asteroids, int powerUps)
+{
+	if (finished) {
+		return;
+	}
+	long long total = 0;
+	for (int i = 0; i < stressSubsystemCount; i++) {
+		samples[i].push_back(subsystemMicroseconds[i]);
+		total += subsystemMicroseconds[i];
+	}
+	tickSamples.push_back(total);
+	entityTotals[0] += bullets;
+	entityTotals[1] += asteroids;
+	entityTotals[2] += powerUps;
+	if ((int)tickSamples.size() == ticksPerLevel) {
+		finishLevel();
+	}
+}
+
+//Sorts the samples, they are not needed in order afterwards
+static float percentileMs(std::vector<long long>& samples, float p)
+{
+	if (samples.empty()) {
+		return 0;
+	}
+	size_t index = std::min(samples.size() - 1, (size_t)(samples.size() * p / 100));
+	std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+	return samples[index] / 1000.0f;
+}
+
+void StressTest::finishLevel()
+{
+	StressLevel result;
+	result.level = level;
+	result.load = getLoad();
+	result.bullets = entityTotals[0] / (float)ticksPerLevel;
+	result.asteroids = entityTotals[1] / (float)ticksPerLevel;
+	result.powerUps = entityTotals[2] / (float)ticksPerLevel;
+	for (int i = 0; i < stressSubsystemCount; i++) {
+		result.p50[i] = percentileMs(samples[i], 50);
+		result.p95[i] = percentileMs(samples[i], 95);
+		samples[i].clear();
+	}
+	result.tickP95 = percentileMs(tickSamples, 95);
+	tickSamples.clear();
+	entityTotals[0] = entityTotals[1] = entityTotals[2] = 0;
+	levels.push_back(result);
+
+	float entities = result.bullets + result.asteroids + result.powerUps;
+	for (int i = 0; i < stressSubsystemCount; i++) {
+		if (knees[i] >= 0 || entities < kneeMinimumEntities || result.p50[i] < kneeMinimumMs) {
+			continue;
+		}
+		float best = -1;
+		for (int j = 0; j < (int)levels.size() - 1; j++) {
+			float earlierEntities = levels[j].bullets + levels[j].asteroids + levels[j].powerUps;
+			if (earlierEntities < kneeMinimumEntities || levels[j].p50[i] < kneeMinimumMs) {
+				continue;
+			}
+			float cost = levels[j].p50[i] / earlierEntities;
+			if (best < 0 || cost < best) {
+				best = cost;
+			}
+		}
+		if (best > 0 && result.p50[i] / entities > best * kneeRatio) {
+			knees[i] = (int)levels.size() - 1;
+		}
+	}
+
+	level++;
+	if (result.tickP95 > budgetMs) {
+		finished = true;
+		overBudget = true;
+	}
+	else if (level == maxLevels) {
+		finished = true;
+	}
+}
+
+float StressTest::getLoad()
+{
+	return std::pow(growth, (float)level);
+}
+
+int StressTest::getLevel()
+{
+	return level;
+}
+
+bool StressTest::isFinished()
+{
+	return finished;
+}
+
+bool StressTest::isOverBudget()
+{
+	return overBudget;
+}
+
+int StressTest::getKnee(int subsystem)
+{
+	return knees[subsystem];
+}
+
+const std::vector<StressLevel>& StressTest::getLevels()
+{
+	return levels;
+}
+
+const char* StressTest::getSubsystemName(int subsystem)
+{
+	static const char* names[stressSubsystemCount] = { "simulation", "collision", "render_build" };
+	return names[subsystem];
+}
+
+bool StressTest::writeReport(const char* fileName)
+{
+	std::ofstream file(fileName);
+	if (!file.is_open()) {
+		return false;
+	}
+	file << std::fixed << std::setprecision(3);
+	file << "level,load,bullets,asteroids,power_ups";
+	for (int i = 0; i < stressSubsystemCount; i++) {
+		file << "," << getSubsystemName(i) << "_p50_ms," << getSubsystemName(i) << "_p95_ms";
+	}
+	file << ",tick_p95_ms\n";
+	for (const StressLevel& result : levels) {
+		file << result.level << "," << result.load << "," << result.bullets << "," << result.asteroids << "," << result.powerUps;
+		for (int i = 0; i < stressSubsystemCount; i++) {
+			file << "," << result.p50[i] << "," << result.p95[i];
+		}
+		file << "," << result.tickP95 << "\n";
+	}
+
+	//where each subsystem stopped scaling, empty fields when it never did
+	file << "\nsubsystem,knee_level,knee_load,knee_entities\n";
+	for (int i = 0; i < stressSubsystemCount; i++) {
+		file << getSubsystemName(i) << ",";
+		if (knees[i] >= 0) {
+			const StressLevel& knee = levels[knees[i]];
+			file << knee.level << "," << knee.load << "," << knee.bullets + knee.asteroids + knee.powerUps;
+		}
+		else {
+			file << ",,";
+		}
+		file << "\n";
+	}
+	file << "budget_ms," << budgetMs << "\n";
+	file << "budget_passed_at_level,";
+	if (overBudget) {
+		file << levels.back().level;
+	}
+	file << "\n";
+	return true;
+}
+
+PlayerInput Autopilot::next(int screenWidth, int screenHeight)
+{
+	PlayerInput input = PlayerInput();
+	input.buttons = FireButton;
+	//two seconds each way at 50 ticks a second
+	input.buttons |= (tick / 100) % 2 == 0 ? MoveLeftButton : MoveRightButton;
+	int sweep = (int)(tick % 200);
+	int across = sweep < 100 ? sweep : 200 - sweep;
+	input.aimX = (int16_t)(screenWidth * across / 100);
+	input.aimY = (int16_t)(screenHeight / 4);
+	tick++;
+	return input;
+}
+
+void Autopilot::reset()
+{
+	tick = 0;
+}
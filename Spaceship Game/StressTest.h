@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include "PlayerInput.h"
+
+enum StressSubsystem { SimulationSubsystem, CollisionSubsystem, RenderBuildSubsystem, stressSubsystemCount };
+
+//Results of one load level, times in milliseconds
+struct StressLevel {
+	int level;
+	float load; //multiplier of the normal spawn rates
+	float bullets; //average live entities over the level
+	float asteroids;
+	float powerUps;
+	float p50[stressSubsystemCount];
+	float p95[stressSubsystemCount];
+	float tickP95; //all subsystems together
+};
+
+//Ramps the load geometrically and finds where each subsystem stops scaling.
+//Every level runs for ticksPerLevel ticks at load growth^level, the run ends at the first level whose p95 tick time
+//is over the budget (or after maxLevels). A subsystem's knee is the first level where its time per live entity is more
+//than kneeRatio times the best of the levels before, the point where it starts growing faster than the load.
+class StressTest
+{
+public:
+	static const float kneeRatio;
+	static const float kneeMinimumMs; //levels where a subsystem takes less are timer noise for it
+	static const int kneeMinimumEntities = 50;
+
+	void init(int ticksPerLevel, float growth, float budgetMs, int maxLevels);
+	void recordTick(const long long* subsystemMicroseconds, int bullets, int asteroids, int powerUps);
+
+	float getLoad(); //multiplier for the level being run
+	int getLevel();
+	bool isFinished();
+	bool isOverBudget(); //finished because the budget was passed rather than by running out of levels
+	int getKnee(int subsystem); //index into getLevels(), -1 if the subsystem kept scaling
+	const std::vector<StressLevel>& getLevels();
+	bool writeReport(const char* fileName);
+
+	static const char* getSubsystemName(int subsystem);
+
+private:
+	void finishLevel();
+
+	int ticksPerLevel = 150;
+	float growth = 1.5f;
+	float budgetMs = 20;
+	int maxLevels = 30;
+
+	int level = 0;
+	bool finished = false;
+	bool overBudget = false;
+	std::vector<long long> samples[stressSubsystemCount];
+	std::vector<long long> tickSamples;
+	long long entityTotals[3] = {};
+	std::vector<StressLevel> levels;
+	int knees[stressSubsystemCount];
+};
+
+//Input for a ship nobody is playing: fires every tick, weaves left and right and sweeps the turret across the screen,
+//so every part of a tick runs without a keyboard or a mouse
+class Autopilot
+{
+public:
+	PlayerInput next(int screenWidth, int screenHeight);
+	void reset();
+
+private:
+	long long tick = 0;
+};
@@ -0,0 +1,221 @@
+#include "Telemetry.h"
+#include <cstdio>
+
+int HdrHistogram::bucketIndex(long long microseconds)
+{
+	if (microseconds < 0) {
+		microseconds = 0;
+	}
+	//the first two powers of two are exact
+	if (microseconds < 2 * subBucketCount) {
+		return (int)microseconds;
+	}
+	int highestBit = 0;
+	while ((microseconds >> (highestBit + 1)) != 0) {
+		highestBit++;
+	}
+	int shift = highestBit - subBucketBits;
+	if (shift > maxShift) {
+		return bucketCount - 1;
+	}
+	int subBucket = (int)(microseconds >> shift) - subBucketCount;
+	return (shift + 1) * subBucketCount + subBucket;
+}
+
+long long HdrHistogram::bucketUpperEdge(int index)
+{
+	if (index < 2 * subBucketCount) {
+		return index + 1;
+	}
+	int shift = index / subBucketCount - 1;
+	long long subBucket = index % subBucketCount + subBucketCount;
+	return (subBucket + 1) << shift;
+}
+
+void HdrHistogram::record(long long microseconds)
+{
+	buckets[bucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+	sampleCount.fetch_add(1, std::memory_order_relaxed);
+	total.fetch_add(microseconds, std::memory_order_relaxed);
+	long long previous = maximum.load(std::memory_order_relaxed);
+	while (microseconds > previous && !maximum.compare_exchange_weak(previous, microseconds, std::memory_order_relaxed)) {
+	}
+}
+
+void HdrHistogram::reset()
+{
+	for (int i = 0; i < bucketCount; i++) {
+		buckets[i] = 0;
+	}
+	sampleCount = 0;
+	total = 0;
+	maximum = 0;
+}
+
+float HdrHistogram::percentile(float p)
+{
+	if (sampleCount == 0) {
+		return 0;
+	}
+	long long target = (long long)(sampleCount.load() * p / 100);
+	long long seen = 0;
+	for (int i = 0; i < bucketCount; i++) {
+		seen += buckets[i];
+		if (seen > target) {
+			//report the upper edge of the bucket so the value is never optimistic
+			return bucketUpperEdge(i) / 1000.0f;
+		}
+	}
+	return bucketUpperEdge(bucketCount - 1) / 1000.0f;
+}
+
+float HdrHistogram::getMean()
+{
+	long long samples = sampleCount;
+	return samples == 0 ? 0 : total / (float)samples / 1000.0f;
+}
+
+float HdrHistogram::getMax()
+{
+	return maximum / 1000.0f;
+}
+
+long long HdrHistogram::getSampleCount()
+{
+	return sampleCount;
+}
+
+Telemetry::~Telemetry()
+{
+	shutdown();
+}
+
+bool Telemetry::init(const char* fileName, int flushMilliseconds)
+{
+	shutdown();
+	startTime = Clock::now();
+	tickCount = 0;
+	flushInterval = std::chrono::milliseconds(flushMilliseconds);
+	file.open(fileName, std::ios::out | std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+	file << "tick,time_ms,tick_us,frame_us,bullets,asteroids,power_ups,collisions,sounds,draw_calls\n";
+	writerRunning = true;
+	writer = std::thread(&Telemetry::writerLoop, this);
+	return true;
+}
+
+void Telemetry::shutdown()
+{
+	if (writer.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(writerMutex);
+			writerRunning = false;
+		}
+		writerWake.notify_one();
+		writer.join();
+		//the writer may have stopped before its first pass, the thread is gone so this is the only reader
+		writeQueuedRows();
+	}
+	if (file.is_open()) {
+		file.close();
+	}
+}
+
+void Telemetry::recordFrame(long long microseconds)
+{
+	frameTime.record(microseconds);
+	lastFrame.store(microseconds, std::memory_order_relaxed);
+}
+
+void Telemetry::recordTick(long long microseconds)
+{
+	tickTime.record(microseconds);
+	lastTick.store(microseconds, std::memory_order_relaxed);
+}
+
+void Telemetry::setGauge(int gauge, int value)
+{
+	gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+void Telemetry::endTick()
+{
+	tickCount++;
+	unsigned int head = rowHead.load(std::memory_order_relaxed);
+	if (head - rowTail.load(std::memory_order_acquire) == maxQueuedRows) {
+		droppedRows++;
+		return;
+	}
+	Row& row = rows[head % maxQueuedRows];
+	row.tick = tickCount;
+	row.milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime).count();
+	row.tickMicroseconds = lastTick.load(std::memory_order_relaxed);
+	row.frameMicroseconds = lastFrame.load(std::memory_order_relaxed);
+	for (int i = 0; i < telemetryGaugeCount; i++) {
+		row.gauges[i] = gauges[i].load(std::memory_order_relaxed);
+	}
+	rowHead.store(head + 1, std::memory_order_release);
+}
+
+HdrHistogram& Telemetry::getFrameTime()
+{
+	return frameTime;
+}
+
+HdrHistogram& Telemetry::getTickTime()
+{
+	return tickTime;
+}
+
+int Telemetry::getGauge(int gauge)
+{
+	return gauges[gauge];
+}
+
+long long Telemetry::getDroppedRows()
+{
+	return droppedRows;
+}
+
+long long Telemetry::getWrittenRows()
+{
+	return writtenRows;
+}
+
+void Telemetry::formatOverlay(char* text, int textSize)
+{
+	snprintf(text, textSize, "Frame p50 %.2fms  p99 %.2fms  Tick p50 %.2fms  p99 %.2fms\nBullets %d  Asteroids %d  Power ups %d  Collisions %d  Sounds %d  Draws %d",
+		frameTime.percentile(50), frameTime.percentile(99), tickTime.percentile(50), tickTime.percentile(99),
+		getGauge(BulletGauge), getGauge(AsteroidGauge), getGauge(PowerUpGauge), getGauge(CollisionGauge), getGauge(SoundGauge), getGauge(DrawCallGauge));
+}
+
+void Telemetry::writerLoop()
+{
+	std::unique_lock<std::mutex> lock(writerMutex);
+	while (writerRunning) {
+		writerWake.wait_for(lock, flushInterval, [this] { return !writerRunning; });
+		lock.unlock();
+		writeQueuedRows();
+		lock.lock();
+	}
+}
+
+void Telemetry::writeQueuedRows()
+{
+	unsigned int head = rowHead.load(std::memory_order_acquire);
+	unsigned int tail = rowTail.load(std::memory_order_relaxed);
+	while (tail != head) {
+		const Row& row = rows[tail % maxQueuedRows];
+		file << row.tick << ',' << row.milliseconds << ',' << row.tickMicroseconds << ',' << row.frameMicroseconds;
+		for (int i = 0; i < telemetryGaugeCount; i++) {
+			file << ',' << row.gauges[i];
+		}
+		file << '\n';
+		tail++;
+		writtenRows++;
+	}
+	rowTail.store(tail, std::memory_order_release);
+	file.flush();
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+//Histogram with buckets that grow with the value (HDR style): 32 buckets per power of two keep every sample within
+//about 3% from 1us up to an hour in a fixed number of buckets, so a slow spike and a fast frame are both readable.
+//Counters are atomic so another thread can read percentiles while samples are recorded
+class HdrHistogram
+{
+public:
+	static const int subBucketBits = 5;
+	static const int subBucketCount = 1 << subBucketBits;
+	static const int maxShift = 26; //values up to 2^32us
+	static const int bucketCount = (maxShift + 2) * subBucketCount;
+
+	void record(long long microseconds);
+	void reset();
+	float percentile(float p); //in milliseconds
+	float getMean(); //in milliseconds
+	float getMax(); //in milliseconds
+	long long getSampleCount();
+
+	static int bucketIndex(long long microseconds);
+	static long long bucketUpperEdge(int index); //first value past the bucket
+
+private:
+	std::atomic<long long> buckets[bucketCount] = {};
+	std::atomic<long long> sampleCount{ 0 };
+	std::atomic<long long> total{ 0 };
+	std::atomic<long long> maximum{ 0 };
+};
+
+enum TelemetryGauge { BulletGauge, AsteroidGauge, PowerUpGauge, CollisionGauge, SoundGauge, DrawCallGauge, telemetryGaugeCount };
+
+//Health data of a running game: frame and tick time histograms plus one row of gauges per simulation tick.
+//Rows go through a fixed ring to a writer thread that appends them to a CSV file every flush interval, so memory stays
+//bounded however long a session runs and the game threads never wait on the disk. Rows that find the ring full are
+//dropped and counted.
+//recordTick/endTick are called by the simulation thread, recordFrame by the render thread, setGauge by either.
+class Telemetry
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	~Telemetry();
+
+	bool init(const char* fileName, int flushMilliseconds); //false if the file cannot be written, the histograms still work
+	void shutdown(); //writes the rows still queued
+
+	void recordFrame(long long microseconds);
+	void recordTick(long long microseconds);
+	void setGauge(int gauge, int value);
+	void endTick(); //queues a row with the last tick time and the gauges as they are now
+
+	HdrHistogram& getFrameTime();
+	HdrHistogram& getTickTime();
+	int getGauge(int gauge);
+	long long getDroppedRows();
+	long long getWrittenRows();
+	void formatOverlay(char* text, int textSize);
+
+private:
+	static const int maxQueuedRows = 512;
+
+	struct Row {
+		long long tick;
+		long long milliseconds; //since init
+		long long tickMicroseconds;
+		long long frameMicroseconds;
+		int gauges[telemetryGaugeCount];
+	};
+
+	void writerLoop();
+	void writeQueuedRows();
+
+	HdrHistogram frameTime;
+	HdrHistogram tickTime;
+	std::atomic<long long> lastFrame{ 0 };
+	std::atomic<long long> lastTick{ 0 };
+	std::atomic<int> gauges[telemetryGaugeCount] = {};
+	Clock::time_point startTime;
+
+	//Single producer / single consumer ring between endTick and the writer thread
+	Row rows[maxQueuedRows];
+	std::atomic<unsigned int> rowHead{ 0 };
+	std::atomic<unsigned int> rowTail{ 0 };
+	long long tickCount = 0;
+	std::atomic<long long> droppedRows{ 0 };
+	std::atomic<long long> writtenRows{ 0 };
+
+	std::ofstream file;
+	std::thread writer;
+	std::mutex writerMutex;
+	std::condition_variable writerWake;
+	bool writerRunning = false;
+	std::chrono::milliseconds flushInterval{ 1000 };
+};
@@ -0,0 +1,318 @@
+#include "TextureCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+TextureCache::~TextureCache()
+{
+	shutdown();
+}
+
+void TextureCache::init(const TextureCallbacks& callbacks, long long budgetBytes)
+{
+	shutdown();
+	this->callbacks = callbacks;
+	this->budgetBytes = budgetBytes;
+	loaderRunning = true;
+	loader = std::thread(&TextureCache::loaderLoop, this);
+}
+
+void TextureCache::shutdown()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	if (loader.joinable()) {
+		loaderRunning = false;
+		wake.notify_one();
+		guard.unlock();
+		loader.join();
+		guard.lock();
+	}
+	queue.clear();
+	//a load started by another thread finishes before its texture is released
+	for (int asset = 0; asset < (int)entries.size(); asset++) {
+		while (entries[asset].state == Loading) {
+			loaded.wait(guard);
+		}
+		Entry& entry = entries[asset];
+		if (entry.state == Resident && callbacks.release != NULL) {
+			callbacks.release(entry.texture);
+		}
+		entry.texture = NULL;
+		entry.state = Unloaded;
+	}
+	residentBytes = 0;
+}
+
+int TextureCache::add(const std::string& fileName)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	for (int asset = 0; asset < (int)entries.size(); asset++) {
+		if (entries[asset].fileName == fileName) {
+			return asset;
+		}
+	}
+	Entry entry;
+	entry.fileName = fileName;
+	entries.push_back(entry);
+	return (int)entries.size() - 1;
+}
+
+std::string TextureCache::getFileName(int asset)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return entries[asset].fileName;
+}
+
+void TextureCache::acquire(int asset)
+{
+	if (asset < 0) {
+		return;
+	}
+	std::unique_lock<std::mutex> guard(lock);
+	entries[asset].references++;
+	loadLocked(asset, guard);
+}
+
+void TextureCache::release(int asset)
+{
+	if (asset < 0) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	if (entries[asset].references > 0) {
+		entries[asset].references--;
+	}
+}
+
+void TextureCache::request(int asset)
+{
+	if (asset < 0) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	queueLocked(asset);
+}
+
+void TextureCache::load(int asset)
+{
+	if (asset < 0) {
+		return;
+	}
+	std::unique_lock<std::mutex> guard(lock);
+	loadLocked(asset, guard);
+}
+
+void* TextureCache::get(int asset)
+{
+	if (asset < 0) {
+		return NULL;
+	}
+	std::unique_lock<std::mutex> guard(lock);
+	markUsedLocked(asset);
+	loadLocked(asset, guard);
+	return entries[asset].texture;
+}
+
+bool TextureCache::isResident(int asset)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return asset >= 0 && entries[asset].state == Resident;
+}
+
+void TextureCache::beginScene(const std::string& name)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	currentScene = -1;
+	for (int i = 0; i < (int)scenes.size(); i++) {
+		if (scenes[i].name == name) {
+			currentScene = i;
+		}
+	}
+	if (currentScene < 0) {
+		Scene scene;
+		scene.name = name;
+		scenes.push_back(scene);
+		currentScene = (int)scenes.size() - 1;
+	}
+	//what the last scene drew and this one does not goes first, before this scene's textures come back
+	evictLocked();
+	Scene& scene = scenes[currentScene];
+	for (int asset = 0; asset < (int)scene.uses.size(); asset++) {
+		if (scene.uses[asset]) {
+			queueLocked(asset);
+		}
+	}
+	scene.peakResidentBytes = std::max(scene.peakResidentBytes, residentBytes);
+}
+
+void TextureCache::endFrame()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	frame++;
+	if (currentScene < 0) {
+		return;
+	}
+	Scene& scene = scenes[currentScene];
+	scene.frames++;
+	evictLocked();
+	scene.peakResidentBytes = std::max(scene.peakResidentBytes, residentBytes);
+}
+
+void TextureCache::evictLocked()
+{
+	Scene& scene = scenes[currentScene];
+	if (residentBytes > budgetBytes) {
+		evictable.clear();
+		for (int asset = 0; asset < (int)entries.size(); asset++) {
+			const Entry& entry = entries[asset];
+			bool usedByScene = asset < (int)scene.uses.size() && scene.uses[asset];
+			if (entry.state == Resident && entry.references == 0 && !usedByScene) {
+				evictable.push_back(asset);
+			}
+		}
+		std::sort(evictable.begin(), evictable.end(), [this](int a, int b) {
+			return entries[a].lastUsedFrame < entries[b].lastUsedFrame;
+		});
+		for (int i = 0; i < (int)evictable.size() && residentBytes > budgetBytes; i++) {
+			Entry& entry = entries[evictable[i]];
+			if (callbacks.release != NULL) {
+				callbacks.release(entry.texture);
+			}
+			entry.texture = NULL;
+			entry.state = Unloaded;
+			residentBytes -= entry.bytes;
+			evictionCount++;
+			scene.evictions++;
+		}
+	}
+}
+
+long long TextureCache::getResidentBytes()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return residentBytes;
+}
+
+long long TextureCache::getBudget()
+{
+	return budgetBytes;
+}
+
+int TextureCache::getLoadCount()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return loadCount;
+}
+
+int TextureCache::getEvictionCount()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return evictionCount;
+}
+
+void TextureCache::formatOverlay(char* text, int textSize)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	const char* sceneName = currentScene >= 0 ? scenes[currentScene].name.c_str() : "none";
+	long long usedBytes = currentScene >= 0 ? sceneBytes(scenes[currentScene]) : 0;
+	snprintf(text, textSize, "Textures %.2fMB of %.2fMB  scene %s %.2fMB  loads %d  evictions %d",
+		residentBytes / 1048576.0, budgetBytes / 1048576.0, sceneName, usedBytes / 1048576.0, loadCount, evictionCount);
+}
+
+bool TextureCache::writeReport(const char* fileName)
+{
+	std::ofstream file(fileName);
+	if (!file.is_open()) {
+		return false;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	file << "scene,frames,textures,scene_bytes,peak_resident_bytes,budget_bytes,loads,evictions\n";
+	for (const Scene& scene : scenes) {
+		int textures = (int)std::count(scene.uses.begin(), scene.uses.end(), true);
+		file << scene.name << "," << scene.frames << "," << textures << "," << sceneBytes(scene) << "," << scene.peakResidentBytes << ","
+			<< budgetBytes << "," << scene.loads << "," << scene.evictions << "\n";
+	}
+	return true;
+}
+
+void TextureCache::loaderLoop()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	while (true) {
+		wake.wait(guard, [this] { return !loaderRunning || !queue.empty(); });
+		if (!loaderRunning) {
+			return;
+		}
+		int asset = queue.front();
+		queue.pop_front();
+		//loaded on demand since it was queued
+		if (entries[asset].state != Queued) {
+			continue;
+		}
+		loadLocked(asset, guard);
+	}
+}
+
+void TextureCache::loadLocked(int asset, std::unique_lock<std::mutex>& guard)
+{
+	while (entries[asset].state == Loading) {
+		loaded.wait(guard);
+	}
+	if (entries[asset].state == Resident || entries[asset].state == Failed) {
+		return;
+	}
+	entries[asset].state = Loading;
+	std::string fileName = entries[asset].fileName;
+	guard.unlock();
+	long long bytes = 0;
+	void* texture = callbacks.load != NULL ? callbacks.load(fileName.c_str(), bytes) : NULL;
+	guard.lock();
+
+	Entry& entry = entries[asset];
+	entry.texture = texture;
+	entry.state = texture != NULL ? Resident : Failed;
+	if (texture != NULL) {
+		entry.bytes = bytes;
+		residentBytes += bytes;
+	}
+	loadCount++;
+	if (currentScene >= 0) {
+		scenes[currentScene].loads++;
+		scenes[currentScene].peakResidentBytes = std::max(scenes[currentScene].peakResidentBytes, residentBytes);
+	}
+	loaded.notify_all();
+}
+
+void TextureCache::queueLocked(int asset)
+{
+	if (entries[asset].state != Unloaded) {
+		return;
+	}
+	entries[asset].state = Queued;
+	queue.push_back(asset);
+	wake.notify_one();
+}
+
+void TextureCache::markUsedLocked(int asset)
+{
+	entries[asset].lastUsedFrame = frame;
+	if (currentScene < 0) {
+		return;
+	}
+	std::vector<bool>& uses = scenes[currentScene].uses;
+	if ((int)uses.size() <= asset) {
+		uses.resize(entries.size(), false);
+	}
+	uses[asset] = true;
+}
+
+long long TextureCache::sceneBytes(const Scene& scene)
+{
+	long long bytes = 0;
+	for (int asset = 0; asset < (int)scene.uses.size(); asset++) {
+		if (scene.uses[asset]) {
+			bytes += entries[asset].bytes;
+		}
+	}
+	return bytes;
+}
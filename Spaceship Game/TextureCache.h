@@ -0,0 +1,99 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//What the cache needs from the renderer, textures are opaque pointers to it
+struct TextureCallbacks {
+	//Called on the loader thread (so the device must be created multithreaded), NULL if the file cannot be loaded.
+	//bytes is set to the video memory the texture takes
+	void* (*load)(const char* fileName, long long& bytes);
+	void (*release)(void* texture);
+};
+
+//Owns every texture loaded from a file, handed out by asset id so copies of an id never own anything.
+//A scene is what the game is showing (a menu, the game). Textures drawn in the current scene, or held by a reference,
+//stay resident. Once the resident textures pass the budget, the least recently drawn of the others are released,
+//and they are loaded again in the background when a scene that used them comes back.
+//Any thread may call in, one lock guards the cache and is never held while a file loads.
+class TextureCache
+{
+public:
+	~TextureCache();
+
+	void init(const TextureCallbacks& callbacks, long long budgetBytes);
+	void shutdown(); //stops the loader and releases every texture
+
+	int add(const std::string& fileName); //the same file always gets the same id, nothing is loaded yet
+	std::string getFileName(int asset);
+
+	//Referenced textures are loaded right away and never released
+	void acquire(int asset);
+	void release(int asset);
+
+	void request(int asset); //loads in the background if it is not resident
+	void load(int asset); //loads now on the calling thread if it is not resident
+	//Texture to draw, marks it used by the current scene. One that is not resident is loaded now rather than drawn blank.
+	//NULL for -1 and for files that failed to load
+	void* get(int asset);
+	bool isResident(int asset);
+
+	//Textures outside the new scene are released first if the cache is over the budget, then the ones the scene drew the
+	//last time it was shown are requested again
+	void beginScene(const std::string& name);
+	void endFrame(); //releases least recently drawn textures outside the scene while over the budget
+
+	long long getResidentBytes();
+	long long getBudget();
+	int getLoadCount();
+	int getEvictionCount();
+	void formatOverlay(char* text, int textSize);
+	bool writeReport(const char* fileName); //one row per scene
+
+private:
+	enum State { Unloaded, Queued, Loading, Resident, Failed };
+
+	struct Entry {
+		std::string fileName;
+		void* texture = NULL;
+		long long bytes = 0; //as of the last load, kept after eviction for the scene report
+		int references = 0;
+		long long lastUsedFrame = -1;
+		State state = Unloaded;
+	};
+	struct Scene {
+		std::string name;
+		std::vector<bool> uses; //by asset, grows with the cache
+		long long frames = 0;
+		long long peakResidentBytes = 0;
+		int loads = 0; //textures loaded while the scene was shown
+		int evictions = 0;
+	};
+
+	void loaderLoop();
+	void loadLocked(int asset, std::unique_lock<std::mutex>& lock); //waits for a load in flight instead of starting another
+	void queueLocked(int asset);
+	void markUsedLocked(int asset);
+	void evictLocked(); //the eviction of endFrame and beginScene
+	long long sceneBytes(const Scene& scene);
+
+	TextureCallbacks callbacks = {};
+	long long budgetBytes = 0;
+	std::vector<Entry> entries;
+	std::vector<Scene> scenes;
+	int currentScene = -1;
+	long long frame = 0;
+	long long residentBytes = 0;
+	int loadCount = 0;
+	int evictionCount = 0;
+	std::vector<int> evictable; //reused by endFrame
+	std::mutex lock;
+	std::condition_variable loaded; //a load finished
+	std::condition_variable wake; //the loader has work or should stop
+	std::deque<int> queue;
+	std::thread loader;
+	bool loaderRunning = false;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+
+//Lock-free single producer / single consumer triple buffer.
+//The producer always has a private buffer to write into and the consumer always has a private buffer to read from,
+//the third buffer is swapped between them atomically so neither side ever waits on the other.
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() : middle(1)
+	{
+	}
+
+	//Producer side
+	T& getWriteBuffer() {
+		return buffers[writeIndex];
+	}
+	//Returns true if the previously published buffer was never read (a dropped frame)
+	bool publish() {
+		int previous = middle.exchange(writeIndex | dirtyBit, std::memory_order_acq_rel);
+		writeIndex = previous & indexMask;
+		return (previous & dirtyBit) != 0;
+	}
+
+	//Consumer side
+	//Returns false if nothing new was published since the last call (the read buffer is shown again)
+	bool consume() {
+		if ((middle.load(std::memory_order_acquire) & dirtyBit) == 0) {
+			return false;
+		}
+		int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+		readIndex = previous & indexMask;
+		return true;
+	}
+	const T& getReadBuffer() {
+		return buffers[readIndex];
+	}
+
+private:
+	static const int indexMask = 3;
+	static const int dirtyBit = 4;
+
+	T buffers[3] = {};
+	int writeIndex = 0;
+	int readIndex = 2;
+	std::atomic<int> middle;
+};
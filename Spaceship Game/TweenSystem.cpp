@@ -0,0 +1,129 @@
+#include "TweenSystem.h"
+
+TweenHandle TweenSystem::start(float* target, float from, float to, float duration, int easing)
+{
+	Tween tween = { target, from, to, duration, 0, easing, false, TweenHandle{ 0, 0 }, NULL, 0 };
+	*target = from;
+	return tweens.insert(tween);
+}
+
+TweenHandle TweenSystem::then(TweenHandle previous, float* target, float from, float to, float duration, int easing)
+{
+	Tween tween = { target, from, to, duration, 0, easing, true, TweenHandle{ 0, 0 }, NULL, 0 };
+	TweenHandle handle = tweens.insert(tween);
+	Tween* before = tweens.get(previous); //after the insert, which may have moved the values
+	if (before == NULL) {
+		//nothing to wait for
+		tweens.get(handle)->waiting = false;
+		*target = from;
+		return handle;
+	}
+	//queued at the end of the sequence previous belongs to
+	while (tweens.get(before->next) != NULL) {
+		before = tweens.get(before->next);
+	}
+	before->next = handle;
+	return handle;
+}
+
+void TweenSystem::setOnComplete(TweenHandle tween, TweenCallback onComplete, int argument)
+{
+	Tween* value = tweens.get(tween);
+	if (value != NULL) {
+		value->onComplete = onComplete;
+		value->argument = argument;
+	}
+}
+
+void TweenSystem::stop(TweenHandle tween)
+{
+	Tween* value = tweens.get(tween);
+	while (value != NULL) {
+		TweenHandle next = value->next;
+		tweens.erase(tween);
+		tween = next;
+		value = tweens.get(tween);
+	}
+}
+
+void TweenSystem::clear()
+{
+	tweens.clear();
+}
+
+bool TweenSystem::isActive(TweenHandle tween)
+{
+	return tweens.contains(tween);
+}
+
+int TweenSystem::getCount()
+{
+	return tweens.size();
+}
+
+void TweenSystem::update(float seconds)
+{
+	finished.clear();
+	for (int i = 0; i < tweens.size(); i++) {
+		Tween& tween = tweens.at(i);
+		if (tween.waiting) {
+			continue;
+		}
+		tween.elapsed += seconds;
+		if (tween.elapsed >= tween.duration) {
+			*tween.target = tween.to;
+			finished.push_back(tweens.getHandle(i));
+		}
+		else {
+			*tween.target = tween.from + (tween.to - tween.from) * ease(tween.easing, tween.elapsed / tween.duration);
+		}
+	}
+	//callbacks may start or stop tweens, so they run after the pass
+	for (int i = 0; i < (int)finished.size(); i++) {
+		Tween* tween = tweens.get(finished[i]);
+		if (tween == NULL) {
+			continue; //stopped by an earlier callback
+		}
+		Tween done = *tween;
+		tweens.erase(finished[i]);
+		Tween* next = tweens.get(done.next);
+		if (next != NULL) {
+			//the time past the end carries over, so a sequence takes the same time at any frame rate
+			next->waiting = false;
+			next->elapsed = done.elapsed - done.duration;
+			*next->target = next->from + (next->to - next->from) * ease(next->easing, next->elapsed < next->duration ? next->elapsed / next->duration : 1);
+		}
+		if (done.onComplete != NULL) {
+			done.onComplete(done.argument);
+		}
+	}
+}
+
+float TweenSystem::ease(int easing, float t)
+{
+	switch (easing) {
+	case EaseInQuad:
+		return t * t;
+	case EaseOutQuad:
+		return t * (2 - t);
+	case EaseInOutQuad:
+		return t < 0.5f ? 2 * t * t : -1 + (4 - 2 * t) * t;
+	case EaseInCubic:
+		return t * t * t;
+	case EaseOutCubic:
+		t -= 1;
+		return t * t * t + 1;
+	case EaseInOutCubic:
+		if (t < 0.5f) {
+			return 4 * t * t * t;
+		}
+		t = 2 * t - 2;
+		return t * t * t / 2 + 1;
+	case EaseOutBack:
+		//overshoots the end a little before settling
+		t -= 1;
+		return t * t * (2.70158f * t + 1.70158f) + 1;
+	default:
+		return t;
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <vector>
+#include "SlotMap.h"
+
+enum TweenEasing { Linear, EaseInQuad, EaseOutQuad, EaseInOutQuad, EaseInCubic, EaseOutCubic, EaseInOutCubic, EaseOutBack };
+
+typedef SlotHandle TweenHandle;
+typedef void (*TweenCallback)(int argument);
+
+//Animates a float from one value to another over a time. Anything that can be given as a float pointer can be
+//tweened (a transform's x, a colour channel, a menu offset), a vector takes one tween per component.
+struct Tween {
+	float* target;
+	float from;
+	float to;
+	float duration; //in seconds
+	float elapsed;
+	int easing;
+	bool waiting;   //queued behind another tween of a sequence
+	TweenHandle next;
+	TweenCallback onComplete;
+	int argument;
+};
+
+//Every tween lives in one SlotMap, so the update is a single pass over a contiguous array.
+//Time only moves through update(), the caller decides what a second is (a real clock, simulation time or a test).
+class TweenSystem
+{
+public:
+	TweenHandle start(float* target, float from, float to, float duration, int easing);
+	//Starts when previous finishes, so tweens can be chained into a sequence
+	TweenHandle then(TweenHandle previous, float* target, float from, float to, float duration, int easing);
+	//Called with argument once the tween reaches its end, after the target has been set to the end value
+	void setOnComplete(TweenHandle tween, TweenCallback onComplete, int argument);
+	//Leaves the target where it is, the rest of its sequence is stopped too and no callback runs
+	void stop(TweenHandle tween);
+	void clear();
+
+	bool isActive(TweenHandle tween); //running or waiting in a sequence
+	int getCount();
+
+	void update(float seconds);
+
+	static float ease(int easing, float t);
+
+private:
+	SlotMap<Tween> tweens;
+	std::vector<TweenHandle> finished; //kept so update() does not allocate
+};
@@ -1,2133 +1,1873 @@
-//	Refer to Direct3D 9 documentation for the meaning of the members.
-//https://learn.microsoft.com/en-us/windows/win32/direct3d9/dx9-graphics
-//https://learn.microsoft.com/en-us/windows/win32/api/_direct3d9/
-
-#include <d3d9.h>
-#include <d3dx9.h>
-#include <Windows.h>
-#include <iostream>
-#include <dinput.h>
-#include <string>
-#include <D3dx9math.h>
-#include <cmath>
-#include <ctime>
-#include <cstdlib>
-#include "FrameTimer.h"
-#include "AudioManager.h"
-#define WIN32_LEAN_AND_MEAN
-
-using namespace std;
-enum powerUp { hpPowerUp, bulletPowerUp, timePowerUp };
-enum UIController { MainMenu, GameMenu, GameOverMenu, SpaceshipSelectionMenu, CrosshairSelectionMenu };
-enum phaseList {FirstPhase, SecondPhase, ThirdPhase};
-enum asteroidList {smallAsteroid, mediumAsteroid, largeAsteroid};
-enum gameOver {Retry, Exit};
-
-//Window Structure
-struct {
-	WNDCLASS wndClass;
-	WNDCLASS splashWndClass;
-	HWND g_hWnd = NULL;
-	HWND g_hWnd2 = NULL;
-	MSG msg;
-} wndStruct;
-
-//Direct3D Structure
-struct {
-	D3DPRESENT_PARAMETERS d3dPP;
-	IDirect3D9* direct3D9 = Direct3DCreate9(D3D_SDK_VERSION);
-	IDirect3DDevice9* d3dDevice;
-
-	D3DPRESENT_PARAMETERS splashD3dPP;
-	IDirect3D9* splashDirect3D9 = Direct3DCreate9(D3D_SDK_VERSION);
-	IDirect3DDevice9* splashD3dDevice;
-} directStruct;
-
-//SpriteSheet Class
-class SpriteSheet
-{
-private:
-	float totalSpriteWidth = NULL;
-	float totalSpriteHeight = NULL;
-	float spriteWidth = NULL;
-	float spriteHeight = NULL;
-	int spriteRow = NULL;
-	int spriteCol = NULL;
-	int currentFrame = NULL;
-	int maxFrame = NULL;
-	RECT spriteRect;
-
-public:
-	SpriteSheet(float totalSpriteWidth, float totalSpriteHeight, int spriteRow, int spriteCol, int currentFrame, int maxFrame)
-	{
-		this->totalSpriteWidth = totalSpriteWidth;
-		this->totalSpriteHeight = totalSpriteHeight;
-		this->spriteRow = spriteRow;
-		this->spriteCol = spriteCol;
-		this->currentFrame = currentFrame - 1;
-		this->maxFrame = maxFrame;
-		this->spriteWidth = totalSpriteWidth / spriteCol;
-		this->spriteHeight = totalSpriteHeight / spriteRow;
-		spriteRect.top = 0;
-		spriteRect.right = 0;
-		spriteRect.bottom = 0;
-		spriteRect.left = 0;
-	}
-
-	SpriteSheet(float totalSpriteWidth, float totalSpriteHeight) {
-		this->totalSpriteWidth = totalSpriteWidth;
-		this->totalSpriteHeight = totalSpriteHeight;
-		spriteRect.top = 0;
-		spriteRect.right = 0;
-		spriteRect.bottom = 0;
-		spriteRect.left = 0;
-	}
-
-	float getTotalSpriteWidth() {
-		return totalSpriteWidth;
-	}
-	float getTotalSpriteHeight() {
-		return totalSpriteHeight;
-	}
-	int getSpriteRow() {
-		return spriteRow;
-	}
-	int getSpriteCol() {
-		return spriteCol;
-	}
-	int getCurrentFrame() {
-		return currentFrame;
-	}
-	int getMaxFrame() {
-		return maxFrame;
-	}
-	float getSpriteWidth() {
-		return spriteWidth;
-	}
-	float getSpriteHeight() {
-		return spriteHeight;
-	}
-	RECT& getRect() {
-		return spriteRect;
-	}
-	void setCurrentFrame(int currentFrame) {
-		this->currentFrame = currentFrame - 1;
-	}
-	void staticFrame() {
-		currentFrame = 0;
-	}
-	void leftFrame() {
-		currentFrame = 2;
-	}
-	void rightFrame() {
-		currentFrame = 4;
-	}
-	void nextThrustFrame() {
-		currentFrame++;
-		if (currentFrame > maxFrame - 1) {
-			currentFrame = 0;
-		}
-	}
-	void prevFrame() {
-		currentFrame--;
-		if (currentFrame < 0) {
-			currentFrame = maxFrame - 1;
-		}
-	}
-	RECT& crop() {
-		if (spriteRow == NULL || spriteCol == NULL) {
-			spriteRect.left = 0;
-			spriteRect.right = totalSpriteWidth;
-			spriteRect.top = 0;
-			spriteRect.bottom = totalSpriteHeight;
-			return spriteRect;
-		}
-		spriteRect.left = (currentFrame % spriteCol) * spriteWidth;
-		spriteRect.right = spriteRect.left + spriteWidth;
-		spriteRect.top = (currentFrame / spriteCol) * spriteHeight;
-		spriteRect.bottom = spriteRect.top + spriteHeight;
-		return spriteRect;
-	}
-};
-
-//Sprite Transformation Class
-class SpriteTransform {
-private:
-	D3DXMATRIX mat;
-	D3DXVECTOR2 scalingCenter;
-	float scalingRotation;
-	D3DXVECTOR2 scaling;
-	D3DXVECTOR2 rotationCenter;
-	float rotation;
-	D3DXVECTOR2 trans;
-	int powerUpChosen;
-	int asteroidHp;
-	int asteroidChosen;
-	D3DXVECTOR2 asteroidVelocity = D3DXVECTOR2 (0,0);
-public:
-	SpriteTransform(D3DXVECTOR2 scalingCenter, float scalingRotation, D3DXVECTOR2 scaling, D3DXVECTOR2 rotationCenter, float rotation, D3DXVECTOR2 trans) {
-		this->scalingCenter = scalingCenter;
-		this->scalingRotation = scalingRotation;
-		this->scaling = scaling;
-		this->rotationCenter = rotationCenter;
-		this->rotation = rotation;
-		this->trans = trans;
-	}
-	SpriteTransform(D3DXVECTOR2 scalingCenter, float scalingRotation, D3DXVECTOR2 scaling, D3DXVECTOR2 rotationCenter, float rotation, D3DXVECTOR2 trans, int powerUpChosen) {
-		this->scalingCenter = scalingCenter;
-		this->scalingRotation = scalingRotation;
-		this->scaling = scaling;
-		this->rotationCenter = rotationCenter;
-		this->rotation = rotation;
-		this->trans = trans;
-		this->powerUpChosen = powerUpChosen;
-	}
-	SpriteTransform(D3DXVECTOR2 scalingCenter, float scalingRotation, D3DXVECTOR2 scaling, D3DXVECTOR2 rotationCenter, float rotation, D3DXVECTOR2 trans, int asteroidHp, int asteroidChosen) {
-		this->scalingCenter = scalingCenter;
-		this->scalingRotation = scalingRotation;
-		this->scaling = scaling;
-		this->rotationCenter = rotationCenter;
-		this->rotation = rotation;
-		this->trans = trans;
-		this->asteroidHp = asteroidHp;
-		this->asteroidChosen = asteroidChosen;
-	}
-	SpriteTransform() {
-
-	}
-	
-	int getAsteroidHp() {
-		return asteroidHp;
-	}
-	int getAsteroidChosen() {
-		return asteroidChosen;
-	}
-	D3DXMATRIX& getMat() {
-		return mat;
-	}
-	D3DXVECTOR2& getScalingCenter() {
-		return scalingCenter;
-	}
-	float getScalingRotation() {
-		return scalingRotation;
-	}
-	D3DXVECTOR2& getScaling() {
-		return scaling;
-	}
-	D3DXVECTOR2& getRotationCenter() {
-		return rotationCenter;
-	}
-	float getRotation() {
-		return rotation;
-	}
-	D3DXVECTOR2& getTrans() {
-		return trans;
-	}
-	int getPowerUpChosen() {
-		return powerUpChosen;
-	}
-	D3DXVECTOR2& getAsteroidVelocity() {
-		return asteroidVelocity;
-	}
-	void setAsteroidHp(int asteroidHp) {
-		this->asteroidHp = asteroidHp;
-	}
-	void setAsteroidChosen(int asteroidChosen) {
-		this->asteroidChosen = asteroidChosen;
-	}
-	void setMat(D3DXMATRIX mat) {
-		this->mat = mat;
-	}
-	void setScalingCenter(D3DXVECTOR2 scalingCenter) {
-		this->scalingCenter = scalingCenter;
-	}
-	void setScalingRotation(float scalingRotation) {
-		this->scalingRotation = scalingRotation;
-	}
-	void setScaling(D3DXVECTOR2 scaling) {
-		this->scaling = scaling;
-	}
-	void setRotationCenter(D3DXVECTOR2 rotationCenter) {
-		this->rotationCenter = rotationCenter;
-	}
-	void setRotation(float rotation) {
-		this->rotation = rotation;
-	}
-	void setTrans(D3DXVECTOR2 trans) {
-		this->trans = trans;
-	}
-	void setAsteroidVelocity(D3DXVECTOR2 asteroidVelocity){
-		this->asteroidVelocity = asteroidVelocity;
-	}
-	void transform() {
-		D3DXMatrixTransformation2D(&mat, &scalingCenter, scalingRotation, &scaling, &rotationCenter, rotation, &trans);
-	}
-	void reduceAsteroidHp() {
-		asteroidHp--;
-	}
-};
-
-//Texture Class
-class Texture {
-private:
-	LPDIRECT3DTEXTURE9 texture = NULL;
-	LPCTSTR fileLocation = "";
-	int redKey = 0, greenKey = 0, blueKey = 0;
-public:
-	Texture(LPCTSTR fileLocation, int redKey, int greenKey, int blueKey) {
-		this->fileLocation = fileLocation;
-		this->redKey = redKey;
-		this->greenKey = greenKey;
-		this->blueKey = blueKey;
-	}
-	Texture(LPCTSTR fileLocation) {
-		this->fileLocation = fileLocation;
-	}
-	HRESULT createTextureFromFile() {
-		return D3DXCreateTextureFromFile(directStruct.d3dDevice, fileLocation, &texture);
-	}
-	HRESULT createSplashTextureFromFile() {
-		return D3DXCreateTextureFromFile(directStruct.splashD3dDevice, fileLocation, &texture);
-	}
-
-	HRESULT createTextureFromFileEx() {
-		return D3DXCreateTextureFromFileEx(directStruct.d3dDevice, fileLocation, D3DX_DEFAULT, D3DX_DEFAULT,
-			D3DX_DEFAULT, NULL, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED,
-			D3DX_DEFAULT, D3DX_DEFAULT, D3DCOLOR_XRGB(redKey, greenKey, blueKey),
-			NULL, NULL, &texture);
-	}
-
-	LPDIRECT3DTEXTURE9 getTexture() {
-		return texture;
-	}
-	void setTexture(LPDIRECT3DTEXTURE9 texture) {
-		this->texture = texture;
-	}
-	void releaseTexture() {
-		texture->Release();
-		texture = NULL;
-	}
-};
-
-//Textures
-Texture pointerTexture(NULL);
-Texture crosshairTexture("Assets/crosshair.png");
-Texture crosshair2Texture("Assets/crosshair2.png");
-Texture crosshair3Texture("Assets/crosshair3.png");
-Texture spaceshipTexture("Assets/ship.png");
-Texture spaceship2Texture("Assets/ship2.png");
-Texture currentSpaceshipTexture(NULL);
-Texture thrustTexture("Assets/thrust.png");
-Texture turretTexture("Assets/turret.png");
-Texture asteroidTexture("Assets/asteroid.png");
-Texture bulletTexture("Assets/bullet.png");
-Texture hpPowerUpTexture("Assets/powerup1.png");
-Texture bulletPowerUpTexture("Assets/powerup2.png");
-Texture timePowerUpTexture("Assets/powerup3.png");
-Texture powerUpTexture(NULL);
-Texture splashTexture("Assets/splash.jpg");
-Texture cursorTexture("Assets/cursor.png");
-Texture buttonBgTexture("Assets/buttonBg.png");
-Texture bgTexture("Assets/bg.png");
-
-//Sprite Sheet
-//Sprite Sheet Object - (totalWidth, totalHeight, row, col, currentFrame, maxFrame)
-//                    - (totalWidth, totalHeight)
-//                    - (spriteRectLeft, spriteRectRight, spriteRectTop, spriteRectBottom)
-SpriteSheet pointerSprite(30, 30);
-SpriteSheet cursorSprite(30, 30);
-SpriteSheet buttonBgSprite(250, 120);
-SpriteSheet spaceshipSprite(250, 50, 1, 5, 1, 5);
-SpriteSheet thrustSprite(32, 20, 1, 2, 1, 2);
-SpriteSheet turretSprite(1024, 128, 1, 8, 1, 8);
-SpriteSheet asteroidSprite(60, 60);
-SpriteSheet bulletSprite(16, 28);
-SpriteSheet hpPowerUpSprite(35, 35);
-SpriteSheet bulletPowerUpSprite(35, 35);
-SpriteSheet timePowerUpSprite(35, 35);
-
-//Sprite Transformation
-SpriteTransform pointerTrans;
-SpriteTransform cursorTrans;
-SpriteTransform spaceshipTrans;
-SpriteTransform thrustTrans;
-SpriteTransform turretTrans;
-//lazy to dynamically increase the size
-SpriteTransform bulletTrans[200];
-SpriteTransform asteroidTrans[200];
-SpriteTransform powerUpTrans[30];
-SpriteTransform buttonBgTrans;
-SpriteTransform textTrans;
-SpriteTransform timerTextTrans;
-SpriteTransform livesTextTrans;
-SpriteTransform helpTextTrans;
-SpriteTransform scoresTextTrans;
-SpriteTransform highScoresTextTrans;
-SpriteTransform bgTrans;
-SpriteTransform spaceship2Trans;
-SpriteTransform spaceshipSelectionTrans;
-SpriteTransform spaceship2SelectionTrans;
-SpriteTransform spaceshipSelectionTextTrans;
-SpriteTransform spaceship2SelectionTextTrans;
-SpriteTransform crosshairTrans;
-SpriteTransform crosshair2Trans;
-SpriteTransform crosshair3Trans;
-SpriteTransform crosshairSelectionTrans;
-SpriteTransform crosshair2SelectionTrans;
-SpriteTransform crosshair3SelectionTrans;
-SpriteTransform crosshairSelectionTextTrans;
-SpriteTransform crosshair2SelectionTextTrans;
-SpriteTransform crosshair3SelectionTextTrans;
-SpriteTransform titleTextTrans;
-SpriteTransform continueButtonTrans;
-SpriteTransform exitButtonTrans;
-SpriteTransform continueTextTrans;
-SpriteTransform exitTextTrans;
-SpriteTransform helpText2Trans;
-
-//Default value for rgb color
-int red = 0;
-int green = 0;
-int blue = 0;
-
-//pointer to a sprite interface 
-LPD3DXSPRITE sprite = NULL;
-
-//pointer to font interface
-LPD3DXFONT font = NULL;
-//Rect for text
-RECT textRect;
-RECT timerTextRect;
-RECT scoresTextRect;
-RECT livesTextRect;
-
-//Screen Resolution
-int screenWidth = 1280;
-int screenHeight = 720;
-
-//Input 
-LPDIRECTINPUT8 dInput;
-LPDIRECTINPUTDEVICE8  dInputKeyboardDevice;
-LPDIRECTINPUTDEVICE8 dInputMouseDevice;
-DIMOUSESTATE mouseState;
-
-//Default position for mouse
-LONG currentXpos = 500;
-LONG currentYpos = 500;
-//Variable to show mouse position text
-string strCurrentXpos;
-string strCurrentYpos;
-char posText[9];
-
-//Timer Stuff
-int waveSec;
-int waveMin;
-//Variable to show timer text
-string strWaveSec;
-string strWaveMin;
-char timerText[15];
-
-//Spaceship Live
-int lives = 3;
-//Variable to show lives text
-string strLivesPrefix = "Lives: ";
-string strLivesPostfix;
-char livesText[15];
-
-//Scores
-int scores = 0;
-int highScores = 0;
-//Variable to show score text
-string strScoresPrefix = "Scores: ";
-string strScoresPostfix;
-char scoresText[15];
-string strHighScoresPrefix = "High Scores: ";
-string strHighScoresPostfix;
-char highScoresText[15];
-
-//	Key input buffer
-BYTE  diKeys[256];
-
-// FrameTimer Object
-FrameTimer* gameTimer = new FrameTimer();
-FrameTimer* bulletTimer = new FrameTimer();
-FrameTimer* thrustTimer = new FrameTimer();
-FrameTimer* asteroidTimer = new FrameTimer();
-FrameTimer* waveTimer = new FrameTimer();
-FrameTimer* splashTimer = new FrameTimer();
-FrameTimer* transitionTimer = new FrameTimer();
-// Audio Object
-AudioManager* myAudioManager = new AudioManager();
-
-//PI
-float static PI = 3.142;
-
-//Friction
-float friction = 0.01; //1 = no friction
-float asteroidFriction = 0.3;
-
-//Spaceship position
-D3DXVECTOR2 spaceshipPosition(600, 600);
-//Spaceship rotation
-float spaceshipRotation = 0;
-//Spaceship Physics
-D3DXVECTOR2 spaceshipVelocity;
-D3DXVECTOR2 spaceshipAcceleration;
-D3DXVECTOR2 spaceshipEngineForce;
-float spaceshipEnginePower = 30;
-float spaceshipMass = 100;
-
-// Turret
-D3DXVECTOR2 turretPosition;
-float turretRotation;
-float pointerCenterX;
-float pointerCenterY;
-float turretCenterX;
-float turretCenterY;
-
-// Bullet
-boolean toggleShoot = false;
-D3DXVECTOR2 bulletStartPosition;
-D3DXVECTOR2 bulletPos;
-int defaultBulletInterval = 5;
-int bulletInterval = defaultBulletInterval;
-int bulletEntry = 0;
-D3DXVECTOR2 bulletVelocity;
-float bulletPower = 10;
-float bulletMass = 100;
-
-// Asteroid
-int asteroidEntry = 0;
-D3DXVECTOR2 asteroidVelocity;
-float asteroidMass;
-float asteroidPower;
-float asteroidRotation;
-float asteroidRotationRate = 0.05;
-float asteroidStartRotation;
-int smallAsteroidHp = 1;
-int mediumAsteroidHp = 3;
-int largeAsteroidHp = 5;
-float smallAsteroidMass = 10;
-float mediumAsteroidMass = 20;
-float largeAsteroidMass = 50;
-float smallAsteroidPower = 10;
-float mediumAsteroidPower = 8;
-float largeAsteroidPower = 5;
-D3DXVECTOR2 asteroidStartPosition(500, -100);
-D3DXVECTOR2 asteroidPosition;
-D3DXVECTOR2 asteroidScaling;
-int chosenAsteroid;
-int chosenAsteroidHp;
-
-//Power Up
-boolean timeStop;
-int timeStopDuration = 10;
-int timeStopDurationLeft = timeStopDuration;
-boolean bulletPowerUpPicked;
-int bulletPowerUpDuration = 10;
-int bulletPowerUpDurationLeft = bulletPowerUpDuration;
-int bulletPowerUpSpeed = 15;
-int powerUpEntry = 0;
-D3DXVECTOR2 powerUpPosition;
-int powerUpSpawnRate = 5;
-int powerUpSpawnRateLeft = powerUpSpawnRate;
-int powerUpChosen;
-
-//Splash Screen
-int splashScreenWidth = 500;
-int splashScreenHeight = 500;
-int splashCount;
-int maxSplashCount = 5;
-
-//UI Controller
-int currentMenu = MainMenu;
-
-//Transition
-float currentTransitionPos = 2000;
-float beforeTransitionPos = 80;
-float afterTransitionPos = 80;
-boolean afterTransition = false;
-
-//Game Over Text
-string strSec = " seconds ";
-string strMin = " minutes ";
-string strSurvived = "You survived for ";
-int totalTextLength;
-char survivedTimerText[50];
-
-//Game Over Button Action
-int gameOverAction;
-
-// Physics calculation
-float massSum;
-D3DXVECTOR2 diffVelocity;
-D3DXVECTOR2 diffPos;
-float dotProduct;
-float magnitude;
-float diffPosX;
-float diffPosY;
-bool collisionDetected;
-
-//Waves
-int currentPhase = FirstPhase;
-int secondPhaseTimer = 10;  //in seconds
-int thirdPhaseTimer = 30;   //in seconds
-
-void render();
-void createDirectInput();
-void resetStage() {
-	cout << "Stage Resetted Successfully" << endl;
-	lives = 3;
-	waveSec = 0;
-	waveMin = 0;
-	asteroidEntry = 0;
-	bulletEntry = 0;
-	powerUpEntry = 0;
-	scores = 0;
-	toggleShoot = false;
-	currentPhase = FirstPhase;
-	myAudioManager->channel->setPaused(false);
-	myAudioManager->channel9->setPaused(true);
-	spaceshipSprite.setCurrentFrame(1);
-	spaceshipPosition = D3DXVECTOR2(600, 600);
-	spaceshipVelocity = D3DXVECTOR2(0, 0);
-	timeStopDurationLeft = 0;
-	bulletPowerUpDurationLeft = 0;
-	powerUpSpawnRateLeft = powerUpSpawnRate;
-}
-
-LRESULT CALLBACK SplashWindowProcedure(HWND hWnd2, UINT message, WPARAM wParam, LPARAM lParam)
-{
-	switch (message)
-	{
-
-	default:
-		return DefWindowProc(hWnd2, message, wParam, lParam);
-	}
-	return 0;
-}
-
-LRESULT CALLBACK WindowProcedure(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
-{
-	switch (message)
-	{
-	case WM_DESTROY:
-		PostQuitMessage(0);
-		break;
-	case WM_KEYDOWN:
-		switch (wParam)
-		{
-		case 0x58: //X key
-			if (!toggleShoot) {
-				toggleShoot = true;
-			}
-			else {
-				toggleShoot = false;
-			}
-			break;
-		case 0x56:  //V key
-			if (!timeStop) {
-				timeStopDurationLeft = 10000;
-				timeStop = true;
-				asteroidVelocity = D3DXVECTOR2(0, 0);
-			}
-			else {
-				timeStop = false;
-			}
-			break;
-		default:
-			break;
-		}
-		break;
-	default:
-		return DefWindowProc(hWnd, message, wParam, lParam);
-	}
-	return 0;
-}
-
-void removeBulletGap(int removedIndex) {
-	for (int i = removedIndex; i < bulletEntry - 1; i++) {
-		bulletTrans[i] = bulletTrans[i + 1];
-	}
-	bulletEntry--;
-}
-
-void removeAsteroidGap(int removedIndex) {
-	for (int i = removedIndex; i < asteroidEntry - 1; i++) {
-		asteroidTrans[i] = asteroidTrans[i + 1];
-	}
-	asteroidEntry--;
-}
-
-void removePowerUpGap(int removedIndex) {
-	for (int i = removedIndex; i < powerUpEntry - 1; i++) {
-		powerUpTrans[i] = powerUpTrans[i + 1];
-	}
-	powerUpEntry--;
-}
-
-void createSplashWindow() {
-	ZeroMemory(&wndStruct.splashWndClass, sizeof(wndStruct.splashWndClass));
-
-	wndStruct.splashWndClass.hbrBackground = (HBRUSH)GetStockObject(BLACK_BRUSH);
-	wndStruct.splashWndClass.hCursor = LoadCursor(NULL, IDC_ARROW);
-	wndStruct.splashWndClass.hInstance = GetModuleHandle(NULL);
-	wndStruct.splashWndClass.lpfnWndProc = SplashWindowProcedure;
-	wndStruct.splashWndClass.lpszClassName = "Splash Window";
-	wndStruct.splashWndClass.style = CS_HREDRAW | CS_VREDRAW;
-
-	RegisterClass(&wndStruct.splashWndClass);
-
-	wndStruct.g_hWnd2 = CreateWindowEx(0, wndStruct.splashWndClass.lpszClassName, "SplashScreen", WS_DISABLED | WS_POPUP, 300, 300, splashScreenWidth, splashScreenHeight, NULL, NULL, GetModuleHandle(NULL), NULL);
-
-	ShowWindow(wndStruct.g_hWnd2, 1);
-	ShowCursor(true);
-}
-
-void createWindow() {
-
-	ZeroMemory(&wndStruct.wndClass, sizeof(wndStruct.wndClass));
-
-	wndStruct.wndClass.hbrBackground = (HBRUSH)GetStockObject(BLACK_BRUSH);
-	wndStruct.wndClass.hCursor = LoadCursor(NULL, IDC_ARROW);
-	wndStruct.wndClass.hInstance = GetModuleHandle(NULL);
-	wndStruct.wndClass.lpfnWndProc = WindowProcedure;
-	wndStruct.wndClass.lpszClassName = "Game Window";
-	wndStruct.wndClass.style = CS_HREDRAW | CS_VREDRAW;
-
-	RegisterClass(&wndStruct.wndClass);
-
-	wndStruct.g_hWnd = CreateWindowEx(0, wndStruct.wndClass.lpszClassName, "Spaceship Xtreme 2.0 (PRESS ESC TO EXIT THE PROGRAM)", WS_OVERLAPPEDWINDOW, 0, 100, screenWidth, screenHeight, NULL, NULL, GetModuleHandle(NULL), NULL);
-
-	ShowWindow(wndStruct.g_hWnd, 1);
-	ShowCursor(false);
-	ShowCursor(false);
-}
-
-bool windowIsRunning() {
-	if (PeekMessage(&wndStruct.msg, NULL, 0, 0, PM_REMOVE))
-	{
-		if (wndStruct.msg.message == WM_QUIT)
-			return false;
-		TranslateMessage(&wndStruct.msg);
-		DispatchMessage(&wndStruct.msg);
-	}
-	return true;
-}
-
-void cleanupWindow() {
-	UnregisterClass(wndStruct.wndClass.lpszClassName, GetModuleHandle(NULL));
-}
-
-void cleanupSplashWindow() {
-	UnregisterClass(wndStruct.splashWndClass.lpszClassName, GetModuleHandle(NULL));
-}
-
-void createDirectX() {
-
-	ZeroMemory(&directStruct.d3dPP, sizeof(directStruct.d3dPP));
-
-	directStruct.d3dPP.Windowed = true;
-	directStruct.d3dPP.SwapEffect = D3DSWAPEFFECT_DISCARD;
-	directStruct.d3dPP.BackBufferFormat = D3DFMT_X8R8G8B8;
-	directStruct.d3dPP.BackBufferCount = 1;
-	directStruct.d3dPP.BackBufferWidth = screenWidth;
-	directStruct.d3dPP.BackBufferHeight = screenHeight;
-	directStruct.d3dPP.hDeviceWindow = wndStruct.g_hWnd;
-
-	HRESULT hr = directStruct.direct3D9->CreateDevice(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, wndStruct.g_hWnd, D3DCREATE_SOFTWARE_VERTEXPROCESSING, &directStruct.d3dPP, &directStruct.d3dDevice);
-
-	if (FAILED(hr))
-		cout << "Creating Directx Failed !!!";
-}
-
-void createSplashDirectX() {
-
-	ZeroMemory(&directStruct.splashD3dPP, sizeof(directStruct.splashD3dPP));
-
-	directStruct.splashD3dPP.Windowed = true;
-	directStruct.splashD3dPP.SwapEffect = D3DSWAPEFFECT_DISCARD;
-	directStruct.splashD3dPP.BackBufferFormat = D3DFMT_X8R8G8B8;
-	directStruct.splashD3dPP.BackBufferCount = 1;
-	directStruct.splashD3dPP.BackBufferWidth = splashScreenWidth;
-	directStruct.splashD3dPP.BackBufferHeight = splashScreenHeight;
-	directStruct.splashD3dPP.hDeviceWindow = wndStruct.g_hWnd2;
-
-	HRESULT hr = directStruct.splashDirect3D9->CreateDevice(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, wndStruct.g_hWnd2, D3DCREATE_SOFTWARE_VERTEXPROCESSING, &directStruct.splashD3dPP, &directStruct.splashD3dDevice);
-
-	if (FAILED(hr))
-		cout << "Creating Directx Failed !!!";
-}
-
-void spriteRender() {
-	sprite->Begin(D3DXSPRITE_ALPHABLEND);
-	//Sprite Transform Object - (scalingCenter, scalingRotation, scaling, rotationCenter, rotation, trans)
-	pointerTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(currentXpos, currentYpos));
-	spaceshipTrans = SpriteTransform(D3DXVECTOR2(spaceshipSprite.getSpriteWidth() / 2, spaceshipSprite.getSpriteHeight() / 2), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(spaceshipSprite.getSpriteWidth() / 2, spaceshipSprite.getSpriteHeight() / 2), spaceshipRotation, spaceshipPosition);
-	thrustTrans = SpriteTransform(D3DXVECTOR2(thrustSprite.getSpriteWidth() / 2, thrustSprite.getSpriteHeight() / 2), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(thrustSprite.getSpriteWidth() / 2, thrustSprite.getSpriteHeight() / 2), spaceshipRotation, spaceshipPosition + D3DXVECTOR2(spaceshipSprite.getSpriteWidth() / 2 - 4, spaceshipSprite.getSpriteHeight()));
-	turretTrans = SpriteTransform(D3DXVECTOR2(turretSprite.getSpriteWidth() / 2, turretSprite.getSpriteHeight() / 2), 0, D3DXVECTOR2(0.35, 0.35), D3DXVECTOR2(turretSprite.getSpriteWidth() / 2, turretSprite.getSpriteHeight() / 2), turretRotation, turretPosition);
-
-	textTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(800, 100));
-	timerTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(520, 35));
-	livesTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1000, 35));
-	helpTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 35));
-	helpText2Trans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 70));
-	scoresTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 105));
-	highScoresTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 140));
-
-	//Text
-	textRect.left = 0;
-	textRect.top = 0;
-	textRect.right = 300;
-	textRect.bottom = 125;
-
-	//Scores Text
-	scoresTextRect.left = 0;
-	scoresTextRect.top = 0;
-	scoresTextRect.right = 200;
-	scoresTextRect.bottom = 125;
-	//Timer Text
-	timerTextRect.left = 0;
-	timerTextRect.top = 0;
-	timerTextRect.right = 100;
-	timerTextRect.bottom = 125;
-	//Lives Text
-	livesTextRect.left = 0;
-	livesTextRect.top = 0;
-	livesTextRect.right = 100;
-	livesTextRect.bottom = 125;
-
-	//Draw Sprite
-
-	thrustTrans.transform();
-	sprite->SetTransform(&thrustTrans.getMat());
-	sprite->Draw(thrustTexture.getTexture(), &thrustSprite.crop(), NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	spaceshipTrans.transform();
-	sprite->SetTransform(&spaceshipTrans.getMat());
-	sprite->Draw(currentSpaceshipTexture.getTexture(), &spaceshipSprite.crop(), NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	turretTrans.transform();
-	sprite->SetTransform(&turretTrans.getMat());
-	sprite->Draw(turretTexture.getTexture(), &turretSprite.crop(), NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	for (int i = 0; i < bulletEntry; i++) {
-		bulletTrans[i].transform();
-		sprite->SetTransform(&bulletTrans[i].getMat());
-		sprite->Draw(bulletTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-	}
-	for (int i = 0; i < asteroidEntry; i++) {
-		asteroidTrans[i].transform();
-		sprite->SetTransform(&asteroidTrans[i].getMat());
-		sprite->Draw(asteroidTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-	}
-	for (int i = 0; i < powerUpEntry; i++) {
-		powerUpTrans[i].transform();
-		sprite->SetTransform(&powerUpTrans[i].getMat());
-		if (powerUpTrans[i].getPowerUpChosen() == hpPowerUp) {
-			powerUpTexture = hpPowerUpTexture;
-		}
-		else if (powerUpTrans[i].getPowerUpChosen() == bulletPowerUp) {
-			powerUpTexture = bulletPowerUpTexture;
-		}
-		else if (powerUpTrans[i].getPowerUpChosen() == timePowerUp) {
-			powerUpTexture = timePowerUpTexture;
-		}
-		sprite->Draw(powerUpTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-	}
-
-
-	pointerTrans.transform();
-	sprite->SetTransform(&pointerTrans.getMat());
-	sprite->Draw(pointerTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	//Draw Mouse Position Font
-	//textTrans.transform();
-
-	//sprite->SetTransform(&textTrans.getMat());
-	//strCurrentXpos = to_string(currentXpos);
-	//strCurrentYpos = to_string(currentYpos);
-	//for (int i = 0; i < strCurrentXpos.length(); i++) {
-	//	posText[i] = strCurrentXpos[i];
-	//}
-	//posText[4] = ',';
-	//for (int i = 0; i < strCurrentYpos.length(); i++) {
-	//	posText[i + 5] = strCurrentYpos[i];
-	//}
-
-	//font->DrawText(sprite, posText, -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	//for (int i = 0; i < sizeof(posText); i++) {
-	//	posText[i] = ' ';
-	//}
-	//Draw Timer Font
-	timerTextTrans.transform();
-
-	sprite->SetTransform(&timerTextTrans.getMat());
-	strWaveSec = to_string(waveSec);
-	strWaveMin = to_string(waveMin);
-	for (int i = 0; i < strWaveMin.length(); i++) {
-		timerText[i] = strWaveMin[i];
-	}
-	timerText[strWaveMin.length()] = ':';
-	for (int i = 0; i < strWaveSec.length(); i++) {
-		timerText[i + strWaveMin.length() + 1] = strWaveSec[i];
-	}
-	font->DrawText(sprite, timerText, -1, &timerTextRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	for (int i = 0; i < sizeof(timerText); i++) {
-		timerText[i] = ' ';
-	}
-	//Draw Lives Font
-	livesTextTrans.transform();
-
-	sprite->SetTransform(&livesTextTrans.getMat());
-	strLivesPostfix = to_string(lives);
-	for (int i = 0; i < strLivesPrefix.length(); i++) {
-		livesText[i] = strLivesPrefix[i];
-	}
-	for (int i = 0; i < strLivesPostfix.length(); i++) {
-		livesText[i + strLivesPrefix.length()] = strLivesPostfix[i];
-	}
-	font->DrawText(sprite, livesText, -1, &livesTextRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	for (int i = 0; i < sizeof(livesText); i++) {
-		livesText[i] = ' ';
-	}
-	//Draw Help Font
-	helpTextTrans.transform();
-
-	sprite->SetTransform(&helpTextTrans.getMat());
-	font->DrawText(sprite, "Left click to shoot", -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	//Draw Help Font 2
-	helpText2Trans.transform();
-
-	sprite->SetTransform(&helpText2Trans.getMat());
-	font->DrawText(sprite, "Press X to toggle the shooting", -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	//Draw Scores Font
-	scoresTextTrans.transform();
-
-	sprite->SetTransform(&scoresTextTrans.getMat());
-	strScoresPostfix = to_string(scores);
-	for (int i = 0; i < strScoresPrefix.length(); i++) {
-		scoresText[i] = strScoresPrefix[i];
-	}
-	for (int i = 0; i < strScoresPostfix.length(); i++) {
-		scoresText[i + strScoresPrefix.length()] = strScoresPostfix[i];
-	}
-	font->DrawText(sprite, scoresText, -1, &scoresTextRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	for (int i = 0; i < sizeof(scoresText); i++) {
-		scoresText[i] = ' ';
-	}
-	//Draw High Scores Font
-	highScoresTextTrans.transform();
-
-	sprite->SetTransform(&highScoresTextTrans.getMat());
-	strHighScoresPostfix = to_string(highScores);
-	for (int i = 0; i < strHighScoresPrefix.length(); i++) {
-		highScoresText[i] = strHighScoresPrefix[i];
-	}
-	for (int i = 0; i < strHighScoresPostfix.length(); i++) {
-		highScoresText[i + strHighScoresPrefix.length()] = strHighScoresPostfix[i];
-	}
-	font->DrawText(sprite, highScoresText, -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	for (int i = 0; i < sizeof(highScoresText); i++) {
-		highScoresText[i] = ' ';
-	}
-	sprite->End();
-}
-
-void render() {
-
-	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
-
-	directStruct.d3dDevice->BeginScene();
-
-	spriteRender();
-
-	directStruct.d3dDevice->EndScene();
-
-	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
-}
-
-void splashRender() {
-	directStruct.splashD3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
-
-	directStruct.splashD3dDevice->BeginScene();
-
-	sprite->Begin(D3DXSPRITE_ALPHABLEND);
-
-	sprite->Draw(splashTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	sprite->End();
-
-	directStruct.splashD3dDevice->EndScene();
-
-	directStruct.splashD3dDevice->Present(NULL, NULL, NULL, NULL);
-
-}
-
-void cleanupDirectX() {
-	directStruct.d3dDevice->Release();
-	directStruct.d3dDevice = NULL;
-}
-
-void cleanupSplashDirectX() {
-	directStruct.splashD3dDevice->Release();
-	directStruct.splashD3dDevice = NULL;
-}
-
-void createSplashSprite() {
-	HRESULT hr = D3DXCreateSprite(directStruct.splashD3dDevice, &sprite);
-
-	if (FAILED(hr)) {
-		cout << "Create Sprite Failed!!!";
-	}
-
-	hr = splashTexture.createSplashTextureFromFile();
-
-	if (FAILED(hr)) {
-		cout << "Create Texture from File Failed!!!";
-	}
-}
-
-void createSprite() {
-	HRESULT hr = D3DXCreateSprite(directStruct.d3dDevice, &sprite);
-
-	if (FAILED(hr)) {
-		cout << "Create Sprite Failed!!!";
-	}
-
-	hr = D3DXCreateFont(directStruct.d3dDevice, 25, 0, 0, 1, false,
-		DEFAULT_CHARSET, OUT_TT_ONLY_PRECIS, DEFAULT_QUALITY,
-		DEFAULT_PITCH | FF_DONTCARE, "Arial", &font);
-
-	if (FAILED(hr)) {
-		cout << "Create Font Failed!!!";
-	}
-
-	hr = thrustTexture.createTextureFromFile();
-	hr = spaceshipTexture.createTextureFromFile();
-	hr = turretTexture.createTextureFromFile();
-	hr = asteroidTexture.createTextureFromFile();
-	hr = bulletTexture.createTextureFromFile();
-	hr = hpPowerUpTexture.createTextureFromFile();
-	hr = bulletPowerUpTexture.createTextureFromFile();
-	hr = timePowerUpTexture.createTextureFromFile();
-	hr = cursorTexture.createTextureFromFile();
-	hr = buttonBgTexture.createTextureFromFile();
-	hr = bgTexture.createTextureFromFile();
-	hr = spaceship2Texture.createTextureFromFile();
-	hr = crosshairTexture.createTextureFromFile();
-	hr = crosshair2Texture.createTextureFromFile();
-	hr = crosshair3Texture.createTextureFromFile();
-
-	if (FAILED(hr)) {
-		cout << "Create Texture from File Failed!!!";
-	}
-}
-
-void cleanupSprite() {
-	sprite->Release();
-	sprite = NULL;
-
-	pointerTexture.releaseTexture();
-
-	thrustTexture.releaseTexture();
-
-	spaceshipTexture.releaseTexture();
-
-	turretTexture.releaseTexture();
-
-	asteroidTexture.releaseTexture();
-
-	bulletTexture.releaseTexture();
-
-	hpPowerUpTexture.releaseTexture();
-
-	bulletPowerUpTexture.releaseTexture();
-
-	timePowerUpTexture.releaseTexture();
-
-	powerUpTexture.releaseTexture();
-
-	cursorTexture.releaseTexture();
-
-	buttonBgTexture.releaseTexture();
-
-	bgTexture.releaseTexture();
-
-	spaceship2Texture.releaseTexture();
-
-	currentSpaceshipTexture.releaseTexture();
-
-	crosshairTexture.releaseTexture();
-
-	crosshair2Texture.releaseTexture();
-
-	crosshair3Texture.releaseTexture();
-
-	font->Release();
-	font = NULL;
-}
-
-void cleanupSplashSprite() {
-	splashTexture.releaseTexture();
-	splashTexture.setTexture(NULL);
-}
-
-void createDirectInput() {
-
-	HRESULT hr = DirectInput8Create(GetModuleHandle(NULL), 0x0800, IID_IDirectInput8, (void**)&dInput, NULL);
-
-	hr = dInput->CreateDevice(GUID_SysKeyboard, &dInputKeyboardDevice, NULL);
-
-	dInputKeyboardDevice->SetDataFormat(&c_dfDIKeyboard);
-
-	dInputKeyboardDevice->SetCooperativeLevel(wndStruct.g_hWnd, DISCL_FOREGROUND | DISCL_NONEXCLUSIVE);
-
-	hr = dInput->CreateDevice(GUID_SysMouse, &dInputMouseDevice, NULL);
-
-	dInputMouseDevice->SetDataFormat(&c_dfDIMouse);
-
-	dInputMouseDevice->SetCooperativeLevel(wndStruct.g_hWnd, DISCL_FOREGROUND | DISCL_EXCLUSIVE);
-}
-
-void getInput() {
-	dInputKeyboardDevice->Acquire();
-	dInputMouseDevice->Acquire();
-	dInputKeyboardDevice->GetDeviceState(256, diKeys);
-
-	dInputMouseDevice->GetDeviceState(sizeof(mouseState), (LPVOID)&mouseState);
-}
-
-void cleanupInput() {
-	//	Release keyboard device.
-	dInputKeyboardDevice->Unacquire();
-	dInputKeyboardDevice->Release();
-	dInputKeyboardDevice = NULL;
-
-	//	Release mouse device.
-	dInputMouseDevice->Unacquire();
-	dInputMouseDevice->Release();
-	dInputMouseDevice = NULL;
-
-	//	Release DirectInput.
-	dInput->Release();
-	dInput = NULL;
-}
-
-void collisionDetection() {
-
-	// Collision Between Bullet and Wall
-	for (int i = 0; i < bulletEntry; i++) {
-		if (bulletTrans[i].getTrans().x > screenWidth - bulletSprite.getTotalSpriteWidth() || bulletTrans[i].getTrans().x < 0 || bulletTrans[i].getTrans().y < 0 || bulletTrans[i].getTrans().y > screenHeight - bulletSprite.getTotalSpriteHeight()) {
-			removeBulletGap(i);
-			break;
-		}
-	}
-	// Collision Between Asteroid and Wall
-	for (int i = 0; i < asteroidEntry; i++) {
-		if (asteroidTrans[i].getTrans().x > screenWidth || asteroidTrans[i].getTrans().x < 0 - asteroidSprite.getTotalSpriteWidth() * asteroidTrans[i].getScaling().x || asteroidTrans[i].getTrans().y > screenHeight) {
-			removeAsteroidGap(i);
-			break;
-		}
-	}
-
-	// Collision Between Asteroid and Spaceship
-	for (int i = 0; i < asteroidEntry; i++) {
-		if (spaceshipPosition.x + spaceshipSprite.getSpriteWidth() >= asteroidTrans[i].getTrans().x && spaceshipPosition.x <= asteroidTrans[i].getTrans().x + asteroidSprite.getTotalSpriteWidth() * asteroidTrans[i].getScaling().x && spaceshipPosition.y <= asteroidTrans[i].getTrans().y + asteroidSprite.getTotalSpriteHeight() * asteroidTrans[i].getScaling().y && spaceshipPosition.y + spaceshipSprite.getSpriteHeight() >= asteroidTrans[i].getTrans().y) {
-			if (lives > 0) {
-				myAudioManager->PlayHit();
-				lives--;
-			}
-			if (lives <= 0) {
-				//MessageBox(NULL, TEXT("YOU DIED\n"), TEXT("GIT GUD"), MB_OK | MB_ICONWARNING);
-				currentMenu = GameOverMenu;
-				myAudioManager->PlayBoom();
-				if (scores > highScores) {
-					highScores = scores;
-				}
-			}
-			removeAsteroidGap(i);
-			break;
-		}
-	}
-	collisionDetected = false;
-	// Collision Between Bullet and Asteroid
-	for (int i = 0; i < bulletEntry; i++) {
-		for (int j = 0; j < asteroidEntry; j++) {
-			if (bulletTrans[i].getTrans().x + bulletSprite.getTotalSpriteWidth() >= asteroidTrans[j].getTrans().x && bulletTrans[i].getTrans().x <= asteroidTrans[j].getTrans().x + asteroidSprite.getTotalSpriteWidth() * asteroidTrans[j].getScaling().x && bulletTrans[i].getTrans().y <= asteroidTrans[j].getTrans().y + asteroidSprite.getTotalSpriteHeight() * asteroidTrans[j].getScaling().y && bulletTrans[i].getTrans().y + bulletSprite.getTotalSpriteHeight() >= asteroidTrans[j].getTrans().y) {
-				scores++;
-				    //PHYSICS 
-					// DONT READ, YOU NEVER UNDERSTAND
-					// HERE IS THE LINK FOR THE PHYSICS
-					// https://en.wikipedia.org/wiki/Elastic_collision
-				if (asteroidTrans[j].getAsteroidHp() > 0) {
-					if (asteroidTrans[j].getAsteroidChosen() == smallAsteroid) {
-						asteroidPower = smallAsteroidPower;
-						asteroidMass = smallAsteroidMass;
-					}
-					else if (asteroidTrans[j].getAsteroidChosen() == mediumAsteroid) {
-						asteroidPower = mediumAsteroidPower;
-						asteroidMass = mediumAsteroidMass;
-					}
-					else if (asteroidTrans[j].getAsteroidChosen() == largeAsteroid) {
-						asteroidPower = largeAsteroidPower;
-						asteroidMass = largeAsteroidMass;
-					}
-					asteroidVelocity.x = sin(180 * PI / 180) * asteroidPower;
-					asteroidVelocity.y = -cos(180 * PI / 180) * asteroidPower;
-					bulletVelocity.x = sin(bulletTrans[i].getRotation()) * bulletPower;
-					bulletVelocity.y = -cos(bulletTrans[i].getRotation()) * bulletPower;
-					massSum = bulletMass + asteroidMass;
-					diffVelocity = asteroidVelocity - bulletVelocity;
-					diffPos = asteroidTrans[j].getTrans() - bulletTrans[i].getTrans();
-					dotProduct = D3DXVec2Dot(&diffVelocity, &diffPos);
-					magnitude = D3DXVec2Length(&diffPos);
-					diffPosX = asteroidTrans[j].getTrans().x - bulletTrans[i].getTrans().x;
-					diffPosY = asteroidTrans[j].getTrans().y - bulletTrans[i].getTrans().y;
-					asteroidVelocity.x = asteroidVelocity.x - (2*bulletMass/massSum) * dotProduct/pow(magnitude,2) * diffPosX;
-					asteroidVelocity.y = asteroidVelocity.y - (2 * bulletMass / massSum) * dotProduct / pow(magnitude, 2) * diffPosY;
-					asteroidPosition = asteroidTrans[j].getTrans() + asteroidVelocity;
-					asteroidTrans[j].setTrans(asteroidPosition);
-					asteroidTrans[j].setAsteroidVelocity(asteroidVelocity);
-					asteroidTrans[j].reduceAsteroidHp();
-				}
-				if(asteroidTrans[j].getAsteroidHp() <= 0) {
-					removeAsteroidGap(j);
-				}
-				removeBulletGap(i);
-				collisionDetected = true;
-				break;
-			}
-		}
-		if (collisionDetected) {
-			break;
-		}
-	}
-	// Collision Between Spaceship and Powerup
-	for (int i = 0; i < powerUpEntry; i++) {
-		if (spaceshipPosition.x + spaceshipSprite.getSpriteWidth() >= powerUpTrans[i].getTrans().x && spaceshipPosition.x <= powerUpTrans[i].getTrans().x + hpPowerUpSprite.getTotalSpriteWidth() && spaceshipPosition.y <= powerUpTrans[i].getTrans().y + hpPowerUpSprite.getTotalSpriteHeight() && spaceshipPosition.y + spaceshipSprite.getSpriteHeight() >= powerUpTrans[i].getTrans().y) {
-			if (powerUpTrans[i].getPowerUpChosen() == hpPowerUp) {
-				cout << "HP PICKED" << endl;
-				myAudioManager->PlayPickUp();
-				if (lives < 3) {
-					lives++;
-				}
-			}
-			if (powerUpTrans[i].getPowerUpChosen() == bulletPowerUp) {
-				cout << "BULLET PICKED" << endl;
-				myAudioManager->PlayPickUp();
-				bulletTimer->init(bulletPowerUpSpeed);
-				bulletPowerUpPicked = true;
-				bulletPowerUpDurationLeft = bulletPowerUpDuration;
-			}
-			if (powerUpTrans[i].getPowerUpChosen() == timePowerUp) {
-				cout << "TIMESTOP PICKED" << endl;
-				myAudioManager->PlayTheWorld();
-				timeStop = true;
-				asteroidVelocity = D3DXVECTOR2(0, 0);
-				timeStopDurationLeft = timeStopDuration;
-			}
-			removePowerUpGap(i);
-			break;
-		}
-	}
-}
-
-void update(int frames) {
-	turretPosition = spaceshipPosition - D3DXVECTOR2(spaceshipSprite.getSpriteWidth() / 2 + 10, spaceshipSprite.getSpriteHeight() / 2 + 5);
-	if (frames > 1) {
-		frames = 1;
-	}
-	for (int i = 0; i < frames; i++)
-	{
-		// Bullet Movement
-		for (int i = 0; i < bulletEntry; i++) {
-			bulletVelocity.x = sin(bulletTrans[i].getRotation()) * bulletPower;
-			bulletVelocity.y = -cos(bulletTrans[i].getRotation()) * bulletPower;
-			bulletPos = bulletTrans[i].getTrans() + bulletVelocity;
-			bulletTrans[i] = SpriteTransform(D3DXVECTOR2(bulletSprite.getTotalSpriteWidth() / 2, bulletSprite.getTotalSpriteHeight() / 2), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(bulletSprite.getTotalSpriteWidth() / 2, bulletSprite.getTotalSpriteHeight() / 2), bulletTrans[i].getRotation(), bulletPos);
-		}
-
-		// Asteroid Movement
-		if (!timeStop) {
-			for (int i = 0; i < asteroidEntry; i++) {
-				asteroidRotation = asteroidTrans[i].getRotation() + asteroidRotationRate;
-				if (asteroidTrans[i].getAsteroidChosen() == smallAsteroid) {
-					asteroidPower = smallAsteroidPower;
-				}
-				else if (asteroidTrans[i].getAsteroidChosen() == mediumAsteroid) {
-					asteroidPower = mediumAsteroidPower;
-				}
-				else if (asteroidTrans[i].getAsteroidChosen() == largeAsteroid) {
-					asteroidPower = largeAsteroidPower;
-				}
-				asteroidVelocity.x = sin(180 * PI / 180) * asteroidPower;
-				asteroidVelocity.y = -cos(180 * PI / 180) * asteroidPower;
-				asteroidPosition = asteroidTrans[i].getTrans() + asteroidVelocity;
-				asteroidTrans[i].setTrans(asteroidPosition);
-				asteroidTrans[i].setRotation(asteroidRotation);
-			}
-		}
-		if (timeStop) {
-			for (int i = 0; i < asteroidEntry; i++) {
-				asteroidPosition = asteroidTrans[i].getTrans() + asteroidTrans[i].getAsteroidVelocity();
-				asteroidTrans[i].setAsteroidVelocity(asteroidTrans[i].getAsteroidVelocity() *= (1-asteroidFriction));
-				asteroidTrans[i].setTrans(asteroidPosition);
-			}
-		}
-
-		// Spaceship Movement
-		if ((int)spaceshipVelocity.x == 0 && (int)spaceshipVelocity.y == 0) {
-			spaceshipSprite.staticFrame();
-		}
-		if (diKeys[DIK_A] & 0x80) {
-			spaceshipEngineForce.x += sin(270 * PI / 180) * spaceshipEnginePower;
-			spaceshipEngineForce.y += -cos(270 * PI / 180) * spaceshipEnginePower;
-			spaceshipAcceleration = spaceshipEngineForce / spaceshipMass;
-			spaceshipSprite.leftFrame();
-		}
-		if (diKeys[DIK_D] & 0x80) {
-			spaceshipEngineForce.x += sin(90 * PI / 180) * spaceshipEnginePower;
-			spaceshipEngineForce.y += -cos(90 * PI / 180) * spaceshipEnginePower;
-			spaceshipAcceleration = spaceshipEngineForce / spaceshipMass;
-			spaceshipSprite.rightFrame();
-		}
-		if (diKeys[DIK_W] & 0x80) {
-			spaceshipEngineForce.x += sin(0) * spaceshipEnginePower;
-			spaceshipEngineForce.y += -cos(0) * spaceshipEnginePower;
-			spaceshipAcceleration = spaceshipEngineForce / spaceshipMass;
-			spaceshipSprite.staticFrame();
-		}
-		if (diKeys[DIK_S] & 0x80) {
-			spaceshipEngineForce.x += sin(180 * PI / 180) * spaceshipEnginePower;
-			spaceshipEngineForce.y += -cos(180 * PI / 180) * spaceshipEnginePower;
-			spaceshipAcceleration = spaceshipEngineForce / spaceshipMass;
-			spaceshipSprite.staticFrame();
-		}
-		if ((diKeys[DIK_A] & 0x80) && (diKeys[DIK_W] & 0x80)) {
-			spaceshipSprite.leftFrame();
-		}
-		if ((diKeys[DIK_W] & 0x80) && (diKeys[DIK_D] & 0x80)) {
-			spaceshipSprite.rightFrame();
-		}
-		if ((diKeys[DIK_S] & 0x80) && (diKeys[DIK_A] & 0x80)) {
-			spaceshipSprite.leftFrame();
-		}
-		if ((diKeys[DIK_S] & 0x80) && (diKeys[DIK_D] & 0x80)) {
-			spaceshipSprite.rightFrame();
-		}
-
-		spaceshipVelocity += spaceshipAcceleration;
-		spaceshipVelocity *= (1 - friction);
-		spaceshipPosition += spaceshipVelocity;
-
-
-		//Spaceship right checking
-		if (spaceshipPosition.x > screenWidth - spaceshipSprite.getSpriteWidth()) {
-			spaceshipPosition.x = screenWidth - spaceshipSprite.getSpriteWidth();
-			spaceshipVelocity.x *= -1;
-		}
-		//Spaceship left checking
-		if (spaceshipPosition.x < 0) {
-			spaceshipPosition.x = 0;
-			spaceshipVelocity.x *= -1;
-		}
-		//Spaceship top checking
-		if (spaceshipPosition.y < 0) {
-			spaceshipPosition.y = 0;
-			spaceshipVelocity.y *= -1;
-		}
-		//Spaceship bottom checking
-		if (spaceshipPosition.y > screenHeight - spaceshipSprite.getSpriteHeight()) {
-			spaceshipPosition.y = screenHeight - spaceshipSprite.getSpriteHeight();
-			spaceshipVelocity.y *= -1;
-		}
-
-		collisionDetection();
-
-		spaceshipAcceleration = D3DXVECTOR2(0, 0);
-		spaceshipEngineForce = D3DXVECTOR2(0, 0);
-	}
-
-	pointerCenterX = currentXpos + pointerSprite.getTotalSpriteWidth() / 2;
-	pointerCenterY = currentYpos + pointerSprite.getTotalSpriteHeight() / 2;
-	turretCenterX = turretPosition.x + turretSprite.getSpriteWidth() / 2;
-	turretCenterY = turretPosition.y + turretSprite.getSpriteHeight() / 2;
-
-	if (pointerCenterY > turretCenterY) {
-		turretRotation = PI - asin((pointerCenterX - turretCenterX) / sqrt(pow(pointerCenterX - turretCenterX, 2) + pow(turretCenterY - pointerCenterY, 2)));
-	}
-	else {
-		turretRotation = asin((pointerCenterX - turretCenterX) / sqrt(pow(pointerCenterX - turretCenterX, 2) + pow(turretCenterY - pointerCenterY, 2)));
-	}
-
-	//Left click
-	if (mouseState.rgbButtons[0] & 0x80) {
-		//do something
-	}
-	//Right click
-	if (mouseState.rgbButtons[1] & 0x80) {
-		//do something
-	}
-	if (diKeys[DIK_ESCAPE] & 0x80) {
-		PostQuitMessage(0);
-	}
-	//Mouse position
-	if (currentYpos >= 0 && currentYpos <= screenHeight - pointerSprite.getTotalSpriteHeight()) {
-		currentYpos += mouseState.lY;
-	}
-	if (currentYpos < 0 || currentYpos > screenHeight - pointerSprite.getTotalSpriteHeight()) {
-		currentYpos -= mouseState.lY;
-	}
-	if (currentXpos >= 0 && currentXpos <= screenWidth - pointerSprite.getTotalSpriteWidth()) {
-		currentXpos += mouseState.lX;
-	}
-	if (currentXpos < 0 || currentXpos > screenWidth - pointerSprite.getTotalSpriteWidth()) {
-		currentXpos -= mouseState.lX;
-	}
-}
-
-void updateBullet(int frames) {
-	bulletStartPosition = D3DXVECTOR2(spaceshipPosition.x + spaceshipSprite.getSpriteWidth() / 2 - 5, spaceshipPosition.y + spaceshipSprite.getSpriteHeight() / 2 - 5);
-	if (frames > 1) {
-		frames = 1;
-	}
-	for (int i = 0; i < frames; i++) {
-		//Left click
-		if (mouseState.rgbButtons[0] & 0x80 || toggleShoot == true) {
-			bulletTrans[bulletEntry] = SpriteTransform(D3DXVECTOR2(bulletSprite.getTotalSpriteWidth() / 2, bulletSprite.getTotalSpriteHeight() / 2), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(bulletSprite.getTotalSpriteWidth() / 2, bulletSprite.getTotalSpriteHeight() / 2), turretRotation, bulletStartPosition);
-			bulletEntry++;
-			myAudioManager->PlayShoot(screenWidth, spaceshipPosition.x);
-		}
-	}
-
-}
-void updateThrust(int frames) {
-	if (frames > 1) {
-		frames = 1;
-	}
-	for (int i = 0; i < frames; i++) {
-		thrustSprite.nextThrustFrame();
-	}
-}
-void updateAsteroid(int frames) {
-	if (frames > 1) {
-		frames = 1;
-	}
-	if (!timeStop) {
-		for (int i = 0; i < frames; i++) {
-			asteroidStartPosition.x = 50 + (rand() % 1100);
-			asteroidStartRotation = rand() % 360;
-			if(currentPhase== FirstPhase){
-				chosenAsteroid = rand() % 1;
-			} 
-			if (currentPhase == SecondPhase) {
-				chosenAsteroid = rand() % 2;
-			}
-			if (currentPhase == ThirdPhase) {
-				chosenAsteroid = rand() % 3;
-			}
-
-			if (chosenAsteroid == smallAsteroid) {
-				chosenAsteroidHp = smallAsteroidHp;
-				asteroidScaling = D3DXVECTOR2(1, 1);
-			}
-			if (chosenAsteroid == mediumAsteroid) {
-				chosenAsteroidHp = mediumAsteroidHp;
-				asteroidScaling = D3DXVECTOR2(1.5, 1.5);
-			}
-			if (chosenAsteroid == largeAsteroid) {
-				chosenAsteroidHp = largeAsteroidHp;
-				asteroidScaling = D3DXVECTOR2(2, 2);
-			}
-			asteroidTrans[asteroidEntry] = SpriteTransform(D3DXVECTOR2(35, 35), 0, asteroidScaling, D3DXVECTOR2(35, 35), asteroidStartRotation, asteroidStartPosition, chosenAsteroidHp, chosenAsteroid);
-			asteroidEntry++;
-		}
-	}
-}
-
-void updateWave(int frames) {
-	if (frames > 1) {
-		frames = 1;
-	}
-	powerUpPosition.x = 50 + (rand() % 1200);
-	powerUpPosition.y = 600;
-	powerUpChosen = (rand() % 3);
-	for (int i = 0; i < frames; i++) {
-		waveSec++;
-		powerUpSpawnRateLeft--;
-		if (waveSec == 60) {
-			waveSec = 0;
-			waveMin++;
-		}
-		if (timeStop) {
-			timeStopDurationLeft--;
-			if (timeStopDurationLeft <= 0) {
-				timeStop = false;
-				timeStopDurationLeft = timeStopDuration;
-			}
-		}
-		if (bulletPowerUpPicked) {
-			bulletPowerUpDurationLeft--;
-			if (bulletPowerUpDurationLeft <= 0) {
-				bulletPowerUpPicked = false;
-				bulletPowerUpDurationLeft = bulletPowerUpDuration;
-				bulletTimer->init(defaultBulletInterval);
-			}
-		}
-		if (powerUpSpawnRateLeft <= 0) {
-			powerUpSpawnRateLeft = powerUpSpawnRate;
-			powerUpTrans[powerUpEntry] = SpriteTransform(D3DXVECTOR2(35, 35), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(35, 35), 0, powerUpPosition, powerUpChosen);
-			powerUpEntry++;
-			if (powerUpEntry > 3) {
-				removePowerUpGap(0);
-			}
-		}
-		if (waveSec == secondPhaseTimer && waveMin < 1) {
-			currentPhase = SecondPhase;
-		}
-		if (waveSec == thirdPhaseTimer && waveMin < 1) {
-			currentPhase = ThirdPhase;
-			myAudioManager->channel->setPaused(true);
-			myAudioManager->PlayDoom();
-		}
-	}
-}
-
-void Sound() {
-	myAudioManager->UpdateSound();
-}
-
-void updateSplash(int frames) {
-	if (frames > 1) {
-		frames = 1;
-	}
-	for (int i = 0; i < frames; i++) {
-		splashCount++;
-	}
-}
-
-void mainMenuUpdate() {
-
-	if (currentYpos >= 0 && currentYpos <= screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos += mouseState.lY;
-	}
-	if (currentYpos < 0 || currentYpos > screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos -= mouseState.lY;
-	}
-	if (currentXpos >= 0 && currentXpos <= screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos += mouseState.lX;
-	}
-	if (currentXpos < 0 || currentXpos > screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos -= mouseState.lX;
-	}
-	if (mouseState.rgbButtons[0] & 0x80) {
-		if (cursorTrans.getTrans().x  >= buttonBgTrans.getTrans().x && cursorTrans.getTrans().x <= buttonBgTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= buttonBgTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y  >= buttonBgTrans.getTrans().y) {
-			myAudioManager->PlayButtonClick();
-			currentMenu = SpaceshipSelectionMenu;
-		}
-
-	}
-
-	if (diKeys[DIK_ESCAPE] & 0x80) {
-		PostQuitMessage(0);
-	}
-}
-
-void mainMenuSpriteRender() {
-	sprite->Begin(D3DXSPRITE_ALPHABLEND);
-
-	//Sprite Transform Object - (scalingCenter, scalingRotation, scaling, rotationCenter, rotation, trans)
-	cursorTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(currentXpos, currentYpos));
-	buttonBgTrans = SpriteTransform(D3DXVECTOR2(buttonBgSprite.getTotalSpriteWidth()/2, buttonBgSprite.getTotalSpriteHeight()/2), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(300, 300));
-
-	textTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(380, 340));
-	titleTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(250, 200));
-
-	//Text
-	textRect.left = 0;
-	textRect.top = 0;
-	textRect.right = 350;
-	textRect.bottom = 125;
-
-	//Draw Sprite
-
-	buttonBgTrans.transform();
-	sprite->SetTransform(&buttonBgTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	titleTextTrans.transform();
-	sprite->SetTransform(&titleTextTrans.getMat());
-	font->DrawText(sprite, "Welcome to Spaceship Xtreme 2.0", -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	textTrans.transform();
-	sprite->SetTransform(&textTrans.getMat());
-	font->DrawText(sprite, "Start", -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
-
-	cursorTrans.transform();
-	sprite->SetTransform(&cursorTrans.getMat());
-	sprite->Draw(cursorTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	sprite->End();
-}
-
-void mainMenuRender() {
-	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
-
-	directStruct.d3dDevice->BeginScene();
-
-	mainMenuSpriteRender();
-
-	directStruct.d3dDevice->EndScene();
-
-	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
-}
-
-void spaceshipSelectionMenuUpdate() {
-	if (currentYpos >= 0 && currentYpos <= screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos += mouseState.lY;
-	}
-	if (currentYpos < 0 || currentYpos > screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos -= mouseState.lY;
-	}
-	if (currentXpos >= 0 && currentXpos <= screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos += mouseState.lX;
-	}
-	if (currentXpos < 0 || currentXpos > screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos -= mouseState.lX;
-	}
-	if (currentTransitionPos == 0 && afterTransition == false) {
-		if (mouseState.rgbButtons[0] & 0x80) {
-			if (cursorTrans.getTrans().x >= spaceshipSelectionTrans.getTrans().x && cursorTrans.getTrans().x <= spaceshipSelectionTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= spaceshipSelectionTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y >= spaceshipSelectionTrans.getTrans().y) {
-				currentSpaceshipTexture = spaceshipTexture;
-				myAudioManager->PlayButtonClick();
-				afterTransition = true;
-			}
-		}
-		if (mouseState.rgbButtons[0] & 0x80) {
-			if (cursorTrans.getTrans().x >= spaceship2SelectionTrans.getTrans().x && cursorTrans.getTrans().x <= spaceship2SelectionTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= spaceship2SelectionTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y >= spaceship2SelectionTrans.getTrans().y) {
-				currentSpaceshipTexture = spaceship2Texture;
-				myAudioManager->PlayButtonClick();
-				afterTransition = true;
-			}
-		}
-	}
-	if (diKeys[DIK_ESCAPE] & 0x80) {
-		PostQuitMessage(0);
-	}
-}
-
-void spaceshipSelectionMenuSpriteRender(int frames) {
-	if (frames > 1) {
-		frames = 1;
-	}
-	
-	for (int i = 0; i < frames; i++) {
-		if (currentTransitionPos > 0) {
-			currentTransitionPos -= beforeTransitionPos;
-		}
-		if (afterTransition) {
-			currentTransitionPos -= afterTransitionPos;
-		}
-		if (currentTransitionPos <= -3000) {
-			afterTransition = false;
-			currentTransitionPos = 2000;
-			currentMenu = CrosshairSelectionMenu;
-		}
-	}
-
-	sprite->Begin(D3DXSPRITE_ALPHABLEND);
-
-	//Sprite Transform Object - (scalingCenter, scalingRotation, scaling, rotationCenter, rotation, trans)
-	cursorTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(currentXpos, currentYpos));
-	bgTrans = SpriteTransform(D3DXVECTOR2(350, 256), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50+ currentTransitionPos, 50));
-	spaceshipTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(280+ currentTransitionPos, 180));
-	spaceship2Trans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(750+ currentTransitionPos, 180));
-	spaceshipSelectionTrans = SpriteTransform(D3DXVECTOR2(100, 57.5), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(220+ currentTransitionPos, 300));
-    spaceship2SelectionTrans = SpriteTransform(D3DXVECTOR2(100, 57.5), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(680+ currentTransitionPos, 300));
-
-	textTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(350+ currentTransitionPos, 100));
-	spaceshipSelectionTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(270+ currentTransitionPos, 330));
-	spaceship2SelectionTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(730+ currentTransitionPos, 330));
-
-	//Text
-	textRect.left = 0;
-	textRect.top = 0;
-	textRect.right = 300;
-	textRect.bottom = 125;
-
-	bgTrans.transform();
-	sprite->SetTransform(&bgTrans.getMat());
-	sprite->Draw(bgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	textTrans.transform();
-	sprite->SetTransform(&textTrans.getMat());
-	font->DrawText(sprite, "Choose your spaceship", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	spaceshipTrans.transform();
-	sprite->SetTransform(&spaceshipTrans.getMat());
-	sprite->Draw(spaceshipTexture.getTexture(), &spaceshipSprite.crop(), NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	spaceship2Trans.transform();
-	sprite->SetTransform(&spaceship2Trans.getMat());
-	sprite->Draw(spaceship2Texture.getTexture(), &spaceshipSprite.crop(), NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	spaceshipSelectionTrans.transform();
-	sprite->SetTransform(&spaceshipSelectionTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	spaceship2SelectionTrans.transform();
-	sprite->SetTransform(&spaceship2SelectionTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	spaceshipSelectionTextTrans.transform();
-	sprite->SetTransform(&spaceshipSelectionTextTrans.getMat());
-	font->DrawText(sprite, "SELECT", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	spaceship2SelectionTextTrans.transform();
-	sprite->SetTransform(&spaceship2SelectionTextTrans.getMat());
-	font->DrawText(sprite, "SELECT", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	cursorTrans.transform();
-	sprite->SetTransform(&cursorTrans.getMat());
-	sprite->Draw(cursorTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	sprite->End();
-}
-
-void spaceshipSelectionMenuRender(int frames) {
-	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
-
-	directStruct.d3dDevice->BeginScene();
-
-	spaceshipSelectionMenuSpriteRender(frames);
-
-	directStruct.d3dDevice->EndScene();
-
-	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
-}
-
-void crosshairSelectionMenuUpdate() {
-	if (currentYpos >= 0 && currentYpos <= screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos += mouseState.lY;
-	}
-	if (currentYpos < 0 || currentYpos > screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos -= mouseState.lY;
-	}
-	if (currentXpos >= 0 && currentXpos <= screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos += mouseState.lX;
-	}
-	if (currentXpos < 0 || currentXpos > screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos -= mouseState.lX;
-	}
-	if (currentTransitionPos == 0 && afterTransition == false) {
-		if (mouseState.rgbButtons[0] & 0x80) {
-			if (cursorTrans.getTrans().x >= crosshairSelectionTrans.getTrans().x && cursorTrans.getTrans().x <= crosshairSelectionTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= crosshairSelectionTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y >= crosshairSelectionTrans.getTrans().y) {
-				pointerTexture = crosshairTexture;
-				myAudioManager->PlayButtonClick();
-				afterTransition = true;
-			}
-		}
-		if (mouseState.rgbButtons[0] & 0x80) {
-			if (cursorTrans.getTrans().x >= crosshair2SelectionTrans.getTrans().x && cursorTrans.getTrans().x <= crosshair2SelectionTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= crosshair2SelectionTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y >= crosshair2SelectionTrans.getTrans().y) {
-				pointerTexture = crosshair2Texture;
-				myAudioManager->PlayButtonClick();
-				afterTransition = true;
-			}
-		}
-		if (mouseState.rgbButtons[0] & 0x80) {
-			if (cursorTrans.getTrans().x >= crosshair3SelectionTrans.getTrans().x && cursorTrans.getTrans().x <= crosshair3SelectionTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= crosshair3SelectionTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y >= crosshair3SelectionTrans.getTrans().y) {
-				pointerTexture = crosshair3Texture;
-				myAudioManager->PlayButtonClick();
-				afterTransition = true;
-			}
-		}
-	}
-	if (diKeys[DIK_ESCAPE] & 0x80) {
-		PostQuitMessage(0);
-	}
-}
-
-void crosshairSelectionMenuSpriteRender(int frames) {
-	if (frames > 1) {
-		frames = 1;
-	}
-
-	for (int i = 0; i < frames; i++) {
-		if (currentTransitionPos > 0) {
-			currentTransitionPos -= beforeTransitionPos;
-		}
-		if (afterTransition) {
-			currentTransitionPos -= afterTransitionPos;
-		}
-		if (currentTransitionPos <= -3000) {
-			afterTransition = false;
-			currentTransitionPos = 2000;
-			currentMenu = GameMenu;
-		}
-	}
-
-	sprite->Begin(D3DXSPRITE_ALPHABLEND);
-
-	//Sprite Transform Object - (scalingCenter, scalingRotation, scaling, rotationCenter, rotation, trans)
-	cursorTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(currentXpos, currentYpos));
-	bgTrans = SpriteTransform(D3DXVECTOR2(350, 256), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50 + currentTransitionPos, 50));
-	crosshairTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(240 + currentTransitionPos, 180));
-	crosshair2Trans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(515 + currentTransitionPos, 180));
-	crosshair3Trans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(790 + currentTransitionPos, 180));
-	crosshairSelectionTrans = SpriteTransform(D3DXVECTOR2(100, 57.5), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(180 + currentTransitionPos, 300));
-	crosshair2SelectionTrans = SpriteTransform(D3DXVECTOR2(100, 57.5), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(455 + currentTransitionPos, 300));
-	crosshair3SelectionTrans = SpriteTransform(D3DXVECTOR2(100, 57.5), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(730 + currentTransitionPos, 300));
-
-	textTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(350 + currentTransitionPos, 100));
-	crosshairSelectionTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(230 + currentTransitionPos, 330));
-	crosshair2SelectionTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(505 + currentTransitionPos, 330));
-	crosshair3SelectionTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(780 + currentTransitionPos, 330));
-
-	//Text
-	textRect.left = 0;
-	textRect.top = 0;
-	textRect.right = 300;
-	textRect.bottom = 125;
-
-	bgTrans.transform();
-	sprite->SetTransform(&bgTrans.getMat());
-	sprite->Draw(bgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	textTrans.transform();
-	sprite->SetTransform(&textTrans.getMat());
-	font->DrawText(sprite, "Choose your crosshair", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	crosshairTrans.transform();
-	sprite->SetTransform(&crosshairTrans.getMat());
-	sprite->Draw(crosshairTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	crosshair2Trans.transform();
-	sprite->SetTransform(&crosshair2Trans.getMat());
-	sprite->Draw(crosshair2Texture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	crosshair3Trans.transform();
-	sprite->SetTransform(&crosshair3Trans.getMat());
-	sprite->Draw(crosshair3Texture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	crosshairSelectionTrans.transform();
-	sprite->SetTransform(&crosshairSelectionTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	crosshair2SelectionTrans.transform();
-	sprite->SetTransform(&crosshair2SelectionTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	crosshair3SelectionTrans.transform();
-	sprite->SetTransform(&crosshair3SelectionTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	crosshairSelectionTextTrans.transform();
-	sprite->SetTransform(&crosshairSelectionTextTrans.getMat());
-	font->DrawText(sprite, "SELECT", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	crosshair2SelectionTextTrans.transform();
-	sprite->SetTransform(&crosshair2SelectionTextTrans.getMat());
-	font->DrawText(sprite, "SELECT", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	crosshair3SelectionTextTrans.transform();
-	sprite->SetTransform(&crosshair3SelectionTextTrans.getMat());
-	font->DrawText(sprite, "SELECT", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	cursorTrans.transform();
-	sprite->SetTransform(&cursorTrans.getMat());
-	sprite->Draw(cursorTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	sprite->End();
-}
-
-
-void crosshairSelectionMenuRender(int frames) {
-	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
-
-	directStruct.d3dDevice->BeginScene();
-
-	crosshairSelectionMenuSpriteRender(frames);
-
-	directStruct.d3dDevice->EndScene();
-
-	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
-}
-
-void gameOverMenuUpdate() {
-	if (currentYpos >= 0 && currentYpos <= screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos += mouseState.lY;
-	}
-	if (currentYpos < 0 || currentYpos > screenHeight - cursorSprite.getTotalSpriteHeight()) {
-		currentYpos -= mouseState.lY;
-	}
-	if (currentXpos >= 0 && currentXpos <= screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos += mouseState.lX;
-	}
-	if (currentXpos < 0 || currentXpos > screenWidth - cursorSprite.getTotalSpriteWidth()) {
-		currentXpos -= mouseState.lX;
-	}
-	if (currentTransitionPos == 0 && afterTransition == false) {
-		if (mouseState.rgbButtons[0] & 0x80) {
-			if (cursorTrans.getTrans().x >= continueButtonTrans.getTrans().x && cursorTrans.getTrans().x <= continueButtonTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= continueButtonTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y >= continueButtonTrans.getTrans().y) {
-				gameOverAction = Retry;
-				myAudioManager->PlayButtonClick();
-				afterTransition = true;
-			}
-		}
-		if (mouseState.rgbButtons[0] & 0x80) {
-			if (cursorTrans.getTrans().x >= exitButtonTrans.getTrans().x && cursorTrans.getTrans().x <= exitButtonTrans.getTrans().x + buttonBgSprite.getTotalSpriteWidth() && cursorTrans.getTrans().y <= exitButtonTrans.getTrans().y + buttonBgSprite.getTotalSpriteHeight() && cursorTrans.getTrans().y >= exitButtonTrans.getTrans().y) {
-				gameOverAction = Exit;
-				myAudioManager->PlayButtonClick();
-				afterTransition = true;
-			}
-		}
-	}
-	if (diKeys[DIK_ESCAPE] & 0x80) {
-		PostQuitMessage(0);
-	}
-}
-
-void gameOverMenuSpriteRender(int frames) {
-	if (frames > 1) {
-		frames = 1;
-	}
-	for (int i = 0; i < frames; i++) {
-		if (currentTransitionPos > 0) {
-			currentTransitionPos -= beforeTransitionPos;
-		}
-		if (afterTransition) {
-			currentTransitionPos -= afterTransitionPos;
-		}
-		if (currentTransitionPos <= -3000) {
-			afterTransition = false;
-			currentTransitionPos = 2000;
-			if (gameOverAction == Retry) {
-				resetStage();
-				currentMenu = GameMenu;
-			}
-			if (gameOverAction == Exit) {
-				resetStage();
-				currentMenu = MainMenu;
-			}
-		}
-	}
-	sprite->Begin(D3DXSPRITE_ALPHABLEND);
-
-	bgTrans = SpriteTransform(D3DXVECTOR2(350, 256), 0, D3DXVECTOR2(0.7, 0.8), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(150 + currentTransitionPos, 150));
-	textTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(3, 3), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(400 + currentTransitionPos, 270));
-	continueButtonTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(340 + currentTransitionPos, 400));
-	exitButtonTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(615 + currentTransitionPos, 400));
-	cursorTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(currentXpos, currentYpos));
-
-	continueTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(390 + currentTransitionPos, 430));
-	exitTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1.5, 1.5), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(645 + currentTransitionPos, 440));
-	scoresTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(390 + currentTransitionPos, 350));
-	timerTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(530 + currentTransitionPos, 350));
-
-	//Text
-	textRect.left = 0;
-	textRect.top = 0;
-	textRect.right = 200;
-	textRect.bottom = 125;
-
-	bgTrans.transform();
-	sprite->SetTransform(&bgTrans.getMat());
-	sprite->Draw(bgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	continueButtonTrans.transform();
-	sprite->SetTransform(&continueButtonTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	exitButtonTrans.transform();
-	sprite->SetTransform(&exitButtonTrans.getMat());
-	sprite->Draw(buttonBgTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	continueTextTrans.transform();
-	sprite->SetTransform(&continueTextTrans.getMat());
-	font->DrawText(sprite, "RETRY", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	exitTextTrans.transform();
-	sprite->SetTransform(&exitTextTrans.getMat());
-	font->DrawText(sprite, "MAIN MENU", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	textTrans.transform();
-	sprite->SetTransform(&textTrans.getMat());
-	font->DrawText(sprite, "YOU DIED", -1, &textRect, 0, D3DCOLOR_XRGB(0, 255, 255));
-
-	//Draw Scores Font
-	scoresTextTrans.transform();
-
-	sprite->SetTransform(&scoresTextTrans.getMat());
-	strScoresPostfix = to_string(scores);
-	for (int i = 0; i < strScoresPrefix.length(); i++) {
-		scoresText[i] = strScoresPrefix[i];
-	}
-	for (int i = 0; i < strScoresPostfix.length(); i++) {
-		scoresText[i + strScoresPrefix.length()] = strScoresPostfix[i];
-	}
-	font->DrawText(sprite, scoresText, -1, &textRect, 0, D3DCOLOR_XRGB(255, 0, 255));
-
-	for (int i = 0; i < sizeof(scoresText); i++) {
-		scoresText[i] = ' ';
-	}
-
-	//Text
-	textRect.left = 0;
-	textRect.top = 0;
-	textRect.right = 500;
-	textRect.bottom = 125;
-	//Draw Timer Font
-	timerTextTrans.transform();
-
-	sprite->SetTransform(&timerTextTrans.getMat());
-	strWaveSec = to_string(waveSec);
-	strWaveMin = to_string(waveMin);
-	for (int i = 0; i < strSurvived.length(); i++) {
-		survivedTimerText[i] = strSurvived[i];
-	}
-	totalTextLength += strSurvived.length();
-	for (int i = 0; i < strWaveMin.length(); i++) {
-		survivedTimerText[i + totalTextLength] = strWaveMin[i];
-	}
-	totalTextLength += strWaveMin.length();
-	for (int i = 0; i < strMin.length(); i++) {
-		survivedTimerText[i + totalTextLength] = strMin[i];
-	}
-	totalTextLength += strMin.length();
-	for (int i = 0; i < strWaveSec.length(); i++) {
-		survivedTimerText[i + totalTextLength] = strWaveSec[i];
-	}
-	totalTextLength += strWaveSec.length();
-	for (int i = 0; i < strSec.length(); i++) {
-		survivedTimerText[i + totalTextLength] = strSec[i];
-	}
-	font->DrawText(sprite, survivedTimerText, -1, &textRect, 0, D3DCOLOR_XRGB(255, 0, 255));
-
-	totalTextLength = 0;
-
-	for (int i = 0; i < sizeof(survivedTimerText); i++) {
-		survivedTimerText[i] = ' ';
-	}
-
-	cursorTrans.transform();
-	sprite->SetTransform(&cursorTrans.getMat());
-	sprite->Draw(cursorTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
-
-	sprite->End();
-}
-
-void gameOverMenuRender(int frames) {
-	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
-
-	directStruct.d3dDevice->BeginScene();
-
-	gameOverMenuSpriteRender(frames);
-
-	directStruct.d3dDevice->EndScene();
-
-	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
-}
-
-int main()  //int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nShowCmd)
-{
-	srand(time(0));
-
-	gameTimer->init(50);
-
-	asteroidTimer->init(10);
-
-	bulletTimer->init(bulletInterval);
-
-	thrustTimer->init(4);
-
-	waveTimer->init(1);
-
-	splashTimer->init(1);
-
-	transitionTimer->init(50);
-	
-	createSplashWindow();
-
-	createSplashDirectX();
-
-	createSplashSprite();
-
-	while (splashCount < maxSplashCount && windowIsRunning()) {
-		splashRender();
-		updateSplash(splashTimer->FramesToUpdate());
-	}
-
-	DestroyWindow(wndStruct.g_hWnd2);
-	cleanupSplashSprite();
-	cleanupSplashDirectX();
-	cleanupSplashWindow();
-	
-	createWindow();
-
-	createDirectX();
-
-	createSprite();
-
-	createDirectInput();
-
-	myAudioManager->InitializeAudio();
-	myAudioManager->LoadSounds();
-	myAudioManager->PlaySound1();
-
-	while (windowIsRunning())
-	{
-
-		if (currentMenu == MainMenu) {
-			getInput();
-			mainMenuUpdate();
-			Sound();
-			mainMenuRender();
-		}
-		if (currentMenu == SpaceshipSelectionMenu) {
-			getInput();
-			spaceshipSelectionMenuUpdate();
-			Sound();
-			spaceshipSelectionMenuRender(transitionTimer->FramesToUpdate());
-		}
-		if (currentMenu == CrosshairSelectionMenu) {
-			getInput();
-			crosshairSelectionMenuUpdate();
-			Sound();
-			crosshairSelectionMenuRender(transitionTimer->FramesToUpdate());
-		}
-		if (currentMenu == GameOverMenu) {
-			getInput();
-			gameOverMenuUpdate();
-			Sound();
-			gameOverMenuRender(transitionTimer->FramesToUpdate());
-		}
-		if (currentMenu == GameMenu) {
-			getInput();
-			updateBullet(bulletTimer->FramesToUpdate());
-			updateThrust(thrustTimer->FramesToUpdate());
-			updateAsteroid(asteroidTimer->FramesToUpdate());
-			updateWave(waveTimer->FramesToUpdate());
-			update(gameTimer->FramesToUpdate());
-			Sound();
-			render();
-		}
-	}
-
-	cleanupSprite();
-
-	cleanupDirectX();
-
-	cleanupWindow();
-
-	cleanupInput();
-
-	return 0;
-}
+//	Refer to Direct3D 9 documentation for the meaning of the members.
+//https://learn.microsoft.com/en-us/windows/win32/direct3d9/dx9-graphics
+//https://learn.microsoft.com/en-us/windows/win32/api/_direct3d9/
+
+#include <d3d9.h>
+#include <d3dx9.h>
+#include <Windows.h>
+#include <iostream>
+#include <dinput.h>
+#include <string>
+#include <D3dx9math.h>
+#include <cmath>
+#include <ctime>
+#include <cstdlib>
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include "FramePacer.h"
+#include "AudioManager.h"
+#include "LatencyTracker.h"
+#include "TripleBuffer.h"
+#include "JobSystem.h"
+#include "ECS.h"
+#include "RandomStream.h"
+#include "ImpulseSolver.h"
+#include "CollisionMask.h"
+#include "ParticleSystem.h"
+#include "StateBuffer.h"
+#include "RollbackSession.h"
+#include "InputTransport.h"
+#include "MenuLayout.h"
+#include "TweenSystem.h"
+#include "GameTuning.h"
+#include "FileWatcher.h"
+#include "FrameArena.h"
+#include "Telemetry.h"
+#include "StressMode.h"
+#include "Math2D.h"
+#include "Simulation.h"
+#include "RenderSnapshot.h"
+#include "TextureCache.h"
+#define WIN32_LEAN_AND_MEAN
+
+using namespace std;
+enum UIController { MainMenu, GameMenu, GameOverMenu, SpaceshipSelectionMenu, CrosshairSelectionMenu };
+enum gameOver {Retry, Exit};
+enum keyToggle { ToggleShootKey = 1, TimeStopKey = 2, QuickSaveKey = 4, QuickLoadKey = 8 };
+enum playModeList { SinglePlayer, LocalTwoPlayer, NetworkTwoPlayer };
+
+//Window Structure
+struct {
+	WNDCLASS wndClass;
+	HWND g_hWnd = NULL;
+	MSG msg;
+} wndStruct;
+
+//Direct3D Structure
+struct {
+	D3DPRESENT_PARAMETERS d3dPP;
+	IDirect3D9* direct3D9 = Direct3DCreate9(D3D_SDK_VERSION);
+	IDirect3DDevice9* d3dDevice;
+} directStruct;
+
+//D3DX types meet Math2D only here and in the renderer
+Vec2 toVec2(const D3DXVECTOR2& vector) {
+	return Vec2{ vector.x, vector.y };
+}
+D3DXVECTOR2 toD3DXVector(const Vec2& vector) {
+	return D3DXVECTOR2(vector.x, vector.y);
+}
+RECT toRECT(const SpriteRect& rect) {
+	RECT out = { (LONG)rect.left, (LONG)rect.top, (LONG)rect.right, (LONG)rect.bottom };
+	return out;
+}
+
+//ID3DXSprite takes a 4x4 matrix, the 2D affine part goes in the top two columns
+void toD3DXMatrix(const Mat3x2& matrix, D3DXMATRIX& out) {
+	out._11 = matrix.m11; out._12 = matrix.m12; out._13 = 0; out._14 = 0;
+	out._21 = matrix.m21; out._22 = matrix.m22; out._23 = 0; out._24 = 0;
+	out._31 = 0; out._32 = 0; out._33 = 1; out._34 = 0;
+	out._41 = matrix.dx; out._42 = matrix.dy; out._43 = 0; out._44 = 1;
+}
+
+//Sprite Transformation Class
+class SpriteTransform {
+private:
+	D3DXMATRIX mat;
+	D3DXVECTOR2 scalingCenter;
+	float scalingRotation;
+	D3DXVECTOR2 scaling;
+	D3DXVECTOR2 rotationCenter;
+	float rotation;
+	D3DXVECTOR2 trans;
+public:
+	SpriteTransform(D3DXVECTOR2 scalingCenter, float scalingRotation, D3DXVECTOR2 scaling, D3DXVECTOR2 rotationCenter, float rotation, D3DXVECTOR2 trans) {
+		this->scalingCenter = scalingCenter;
+		this->scalingRotation = scalingRotation;
+		this->scaling = scaling;
+		this->rotationCenter = rotationCenter;
+		this->rotation = rotation;
+		this->trans = trans;
+	}
+	SpriteTransform() {
+
+	}
+
+	D3DXMATRIX& getMat() {
+		return mat;
+	}
+	const D3DXMATRIX& getMat() const {
+		return mat;
+	}
+	D3DXVECTOR2& getScalingCenter() {
+		return scalingCenter;
+	}
+	float getScalingRotation() {
+		return scalingRotation;
+	}
+	D3DXVECTOR2& getScaling() {
+		return scaling;
+	}
+	D3DXVECTOR2& getRotationCenter() {
+		return rotationCenter;
+	}
+	float getRotation() {
+		return rotation;
+	}
+	D3DXVECTOR2& getTrans() {
+		return trans;
+	}
+	void setMat(D3DXMATRIX mat) {
+		this->mat = mat;
+	}
+	void setScalingCenter(D3DXVECTOR2 scalingCenter) {
+		this->scalingCenter = scalingCenter;
+	}
+	void setScalingRotation(float scalingRotation) {
+		this->scalingRotation = scalingRotation;
+	}
+	void setScaling(D3DXVECTOR2 scaling) {
+		this->scaling = scaling;
+	}
+	void setRotationCenter(D3DXVECTOR2 rotationCenter) {
+		this->rotationCenter = rotationCenter;
+	}
+	void setRotation(float rotation) {
+		this->rotation = rotation;
+	}
+	void setTrans(D3DXVECTOR2 trans) {
+		this->trans = trans;
+	}
+	void transform() {
+		toD3DXMatrix(transformation2D(toVec2(scalingCenter), scalingRotation, toVec2(scaling), toVec2(rotationCenter), rotation, toVec2(trans)), mat);
+	}
+};
+
+//Loads Assets/name.dds made by the texture tool instead of the image when it exists, it is block compressed with mips
+//and already a power of two in size, so it loads as it is. NULL if neither loads
+LPDIRECT3DTEXTURE9 createTextureFromFile(LPCTSTR fileLocation) {
+	LPDIRECT3DTEXTURE9 texture = NULL;
+	string compressedLocation = fileLocation;
+	compressedLocation = compressedLocation.substr(0, compressedLocation.find_last_of('.')) + ".dds";
+	if (GetFileAttributes(compressedLocation.c_str()) != INVALID_FILE_ATTRIBUTES) {
+		HRESULT result = D3DXCreateTextureFromFileEx(directStruct.d3dDevice, compressedLocation.c_str(), D3DX_DEFAULT, D3DX_DEFAULT,
+			D3DX_FROM_FILE, 0, D3DFMT_FROM_FILE, D3DPOOL_MANAGED, D3DX_FILTER_NONE, D3DX_FILTER_NONE, 0, NULL, NULL, &texture);
+		if (SUCCEEDED(result)) {
+			return texture;
+		}
+		cout << "Compressed Texture Failed, Loading " << fileLocation << endl;
+	}
+	if (FAILED(D3DXCreateTextureFromFile(directStruct.d3dDevice, fileLocation, &texture))) {
+		cout << "Create Texture from File Failed!!! " << fileLocation << endl;
+		return NULL;
+	}
+	return texture;
+}
+
+//Video memory of every mip level
+long long textureBytes(LPDIRECT3DTEXTURE9 texture) {
+	long long bytes = 0;
+	for (DWORD level = 0; level < texture->GetLevelCount(); level++) {
+		D3DSURFACE_DESC description;
+		texture->GetLevelDesc(level, &description);
+		long long blocks = (long long)((description.Width + 3) / 4) * ((description.Height + 3) / 4);
+		if (description.Format == D3DFMT_DXT1) {
+			bytes += blocks * 8;
+		}
+		else if (description.Format == D3DFMT_DXT5) {
+			bytes += blocks * 16;
+		}
+		else {
+			bytes += (long long)description.Width * description.Height * 4;
+		}
+	}
+	return bytes;
+}
+
+//Solid white texture for sprites that are tinted entirely by the draw colour
+HRESULT createWhiteTexture(int width, int height, LPDIRECT3DTEXTURE9& texture) {
+	HRESULT result = D3DXCreateTexture(directStruct.d3dDevice, width, height, 1, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &texture);
+	if (FAILED(result)) {
+		return result;
+	}
+	D3DLOCKED_RECT lockedRect;
+	result = texture->LockRect(0, &lockedRect, NULL, 0);
+	if (FAILED(result)) {
+		return result;
+	}
+	for (int y = 0; y < height; y++) {
+		DWORD* row = (DWORD*)((unsigned char*)lockedRect.pBits + y * lockedRect.Pitch);
+		for (int x = 0; x < width; x++) {
+			row[x] = D3DCOLOR_ARGB(255, 255, 255, 255);
+		}
+	}
+	return texture->UnlockRect(0);
+}
+
+//Texture Cache, owns every texture loaded from Assets. Once the resident textures pass the budget, the ones the
+//current screen does not draw are released, least recently drawn first. All of them take about 3.8MB as A8R8G8B8,
+//the menus about 3MB (mostly the background) and the game under 1MB, so with the default the menu textures are
+//released while playing. With the texture tool's DDS files everything fits. -textureBudget sets it in MB.
+TextureCache* textureCache = new TextureCache();
+long long textureBudgetBytes = 3 << 20;
+const char* textureReportFile = "textures.csv";
+int textureScene = -1; //menu the cache's current scene belongs to
+
+void* loadTextureFile(const char* fileName, long long& bytes) {
+	LPDIRECT3DTEXTURE9 texture = createTextureFromFile(fileName);
+	if (texture != NULL) {
+		bytes = textureBytes(texture);
+	}
+	return texture;
+}
+void releaseTextureFile(void* texture) {
+	((LPDIRECT3DTEXTURE9)texture)->Release();
+}
+
+//Texture Class, names a texture of textureCache. Copies name the same texture and none of them releases it
+class Texture {
+private:
+	int asset = -1;
+public:
+	Texture(LPCTSTR fileLocation) {
+		if (fileLocation != NULL) {
+			asset = textureCache->add(fileLocation);
+		}
+	}
+	int getAsset() {
+		return asset;
+	}
+	//Marks it drawn in the current scene, an evicted texture is loaded again first. NULL without a file
+	LPDIRECT3DTEXTURE9 getTexture() {
+		return (LPDIRECT3DTEXTURE9)textureCache->get(asset);
+	}
+	void load() {
+		textureCache->load(asset);
+	}
+};
+
+//Textures
+Texture pointerTexture(NULL);
+Texture crosshairTexture("Assets/crosshair.png");
+Texture crosshair2Texture("Assets/crosshair2.png");
+Texture crosshair3Texture("Assets/crosshair3.png");
+Texture spaceshipTexture("Assets/ship.png");
+Texture spaceship2Texture("Assets/ship2.png");
+Texture thrustTexture("Assets/thrust.png");
+Texture turretTexture("Assets/turret.png");
+Texture asteroidTexture("Assets/asteroid.png");
+Texture bulletTexture("Assets/bullet.png");
+Texture hpPowerUpTexture("Assets/powerup1.png");
+Texture bulletPowerUpTexture("Assets/powerup2.png");
+Texture timePowerUpTexture("Assets/powerup3.png");
+Texture powerUpTexture(NULL);
+Texture cursorTexture("Assets/cursor.png");
+Texture buttonBgTexture("Assets/buttonBg.png");
+Texture bgTexture("Assets/bg.png");
+LPDIRECT3DTEXTURE9 particleTexture = NULL; //plain white square made at startup, tinted per particle
+LPDIRECT3DTEXTURE9 splashTexture = NULL;   //only shown once, released when the menu is up
+
+//Sprite Sheet
+//Sprite Sheet Object - (totalWidth, totalHeight, row, col, currentFrame, maxFrame)
+//                    - (totalWidth, totalHeight)
+//The sheets of the ships, bullets, asteroids and the pointer belong to the simulation, they set the hit boxes
+SpriteSheet cursorSprite(30, 30);
+SpriteSheet buttonBgSprite(250, 120);
+SpriteSheet bulletPowerUpSprite(35, 35);
+SpriteSheet timePowerUpSprite(35, 35);
+
+//Sprite Transformation
+SpriteTransform pointerTrans;
+SpriteTransform cursorTrans;
+SpriteTransform spaceshipTrans;
+SpriteTransform thrustTrans;
+SpriteTransform turretTrans;
+SpriteTransform textTrans;
+SpriteTransform timerTextTrans;
+SpriteTransform livesTextTrans;
+SpriteTransform helpTextTrans;
+SpriteTransform scoresTextTrans;
+SpriteTransform highScoresTextTrans;
+SpriteTransform helpText2Trans;
+SpriteTransform latencyTextTrans;
+SpriteTransform threadTextTrans;
+SpriteTransform pacingTextTrans;
+SpriteTransform telemetryTextTrans;
+SpriteTransform textureTextTrans;
+SpriteTransform particleTrans;
+
+//Default value for rgb color
+int red = 0;
+int green = 0;
+int blue = 0;
+
+//pointer to a sprite interface 
+LPD3DXSPRITE sprite = NULL;
+
+//pointer to font interface
+LPD3DXFONT font = NULL;
+//Rect for text
+RECT textRect;
+RECT timerTextRect;
+RECT scoresTextRect;
+RECT livesTextRect;
+RECT latencyTextRect;
+
+//Input 
+LPDIRECTINPUT8 dInput;
+LPDIRECTINPUTDEVICE8  dInputKeyboardDevice;
+LPDIRECTINPUTDEVICE8 dInputMouseDevice;
+DIMOUSESTATE mouseState;
+
+//Default position for mouse
+LONG currentXpos = 500;
+LONG currentYpos = 500;
+//Variable to show mouse position text
+string strCurrentXpos;
+string strCurrentYpos;
+char posText[9];
+
+//Variable to show lives text
+string strLivesPrefix = "Lives: ";
+
+//Variable to show score text
+string strScoresPrefix = "Scores: ";
+string strHighScoresPrefix = "High Scores: ";
+
+//	Key input buffer
+BYTE  diKeys[256];
+//	Previous poll, used to detect input events
+BYTE  previousDiKeys[256];
+BYTE  previousMouseButtons;
+
+// Frame Pacers, the render loop and the simulation thread sleep between frames instead of polling
+FramePacer* renderPacer = new FramePacer();
+FramePacer* simulationPacer = new FramePacer();
+int targetFrameRate = 60;
+int idleFrameRate = 20;      //window in the background, or a menu where nothing has moved for a while
+int menuIdleFrames = 30;     //frames without a change before a menu counts as idle
+int staticMenuFrames = 0;
+// Audio Object
+AudioManager* myAudioManager = new AudioManager();
+// Input Latency Object
+LatencyTracker* latencyTracker = new LatencyTracker();
+boolean showLatencyOverlay = false;
+char latencyText[128];
+char threadText[128];
+char pacingText[128];
+//Scratch memory of the render thread, everything in it is released at the end of each frame
+FrameArena* frameArena = new FrameArena();
+size_t frameArenaCapacity = 64 * 1024;
+// Telemetry Object, rows are written to telemetryFile by its own thread
+Telemetry* telemetry = new Telemetry();
+boolean showTelemetryOverlay = false;
+char telemetryText[192];
+char textureText[128];
+const char* telemetryFile = "telemetry.csv";
+int telemetryFlushMilliseconds = 1000;
+int frameDrawCalls = 0;
+long long soundsPlayedBefore = 0;
+// Stress Mode (-stress [budget ms]), see StressMode.h
+bool stressMode = false;
+
+//Tuning, the balance values (in the simulation). Read from tuningFileName at startup and again whenever the file is saved,
+//the simulation thread swaps in the new values between two ticks.
+TuningFile* tuningFile = new TuningFile();
+FileWatcher* tuningWatcher = new FileWatcher();
+const char* tuningFileName = "Assets/tuning.cfg";
+
+// Bullet
+boolean toggleShoot = false;
+
+//Splash Screen, shown in the game window while the assets load
+int splashScreenWidth = 500;
+int splashScreenHeight = 500;
+float minSplashSeconds = 2;
+atomic<bool> texturesLoaded(false);
+atomic<bool> soundsLoaded(false);
+thread textureLoader;
+thread soundLoader;
+//Startup times, from launch
+chrono::steady_clock::time_point launchTime;
+long long firstFrameMs;
+long long texturesLoadedMs; //written by the loaders before they set their loaded flag
+long long soundsLoadedMs;
+long long menuReadyMs;
+
+//UI Controller (the simulation thread only runs while this is GameMenu)
+atomic<int> currentMenu(MainMenu);
+
+//Transition, menu screens slide in from the right and out to the left
+TweenSystem* tweens = new TweenSystem();
+chrono::steady_clock::time_point lastTweenUpdate = chrono::steady_clock::now();
+float maxTweenStep = 0.1;        //seconds, a long stall skips ahead at most this much
+float menuSlideX = 2000;         //offset of the menu screen being shown
+float menuSlideInFrom = 2000;
+float menuSlideOutTo = -3000;
+float menuPullBack = 40;         //the screen backs off this far before sliding out
+float menuSlideInDuration = 0.5; //seconds
+float menuPullBackDuration = 0.1;
+float menuSlideOutDuration = 0.75;
+TweenHandle menuSlide;
+bool menuLeaving = false;
+
+//Game Over Text
+string strSec = " seconds ";
+string strMin = " minutes ";
+string strSurvived = "You survived for ";
+
+//Menus, laid out by Assets/menus.layout
+MenuLayout menuLayout;
+MenuScreen* mainMenuScreen = NULL;
+MenuScreen* spaceshipSelectionScreen = NULL;
+MenuScreen* crosshairSelectionScreen = NULL;
+MenuScreen* gameOverScreen = NULL;
+int gameOverScoresText;
+int gameOverSurvivedText;
+//Matrices, textures and crop rects of the screen drawn last, rebuilt when its draw list changes
+MenuScreen* drawnMenuScreen = NULL;
+int drawnMenuVersion = -1;
+float drawnCursorX = -1;
+float drawnCursorY = -1;
+atomic<bool> menuRedrawPending(true); //set when the window has to be painted again
+vector<D3DXMATRIX> menuMatrices;
+vector<Texture*> menuTextures;
+vector<RECT> menuRects;
+
+// Collision Masks are built with these, the masks themselves are in the simulation
+int maskRotationBuckets = 32;
+unsigned char maskAlphaThreshold = 128;
+
+//Two Player
+//Co-op with a second ship whose input comes through a transport. Ticks never wait for the other player,
+//the rollback session predicts their input and replays the ticks it got wrong.
+int playMode = SinglePlayer;
+RollbackSession rollbackSession;
+int rollbackWindow = 8;     //ticks
+int rollbackInputDelay = 2; //ticks
+UdpTransport networkTransport;
+//Local two player shares the keyboard, player two's input goes through a loopback with a simulated network
+LoopbackTransport localTransport;
+LoopbackTransport secondPlayerTransport;
+RollbackSession secondPlayerSession;
+int localLatency = 60; //ms
+int localJitter = 20;  //ms
+float localLoss = 0.05;
+
+//Simulation / Render Threads
+TripleBuffer<RenderSnapshot> renderSnapshots;
+thread simulationThread;
+atomic<bool> simulationRunning(false);
+long long simulationTick = 0;
+atomic<int> pendingKeyToggles(0); //set by the window procedure, applied by the next tick
+
+//Game State Snapshots
+//Everything the simulation needs to carry on from a tick, written into one reusable buffer (quick save, post mortem)
+StateWriter gameStateWriter;
+vector<unsigned char> quickSave;
+const char* postMortemFile = "postmortem.state";
+
+//Metrics
+LatencyHistogram snapshotAge;
+atomic<long long> droppedSnapshots(0);
+atomic<long long> duplicatedSnapshots(0);
+
+void render();
+void createDirectInput();
+
+//Simulation callback, the sounds of the game
+void playGameSound(int sound, float x) {
+	switch (sound) {
+	case ShootSound:
+		myAudioManager->PlayShoot(screenWidth, x);
+		break;
+	case HitSound:
+		myAudioManager->PlayHit();
+		break;
+	case BoomSound:
+		myAudioManager->PlayBoom();
+		break;
+	case PickUpSound:
+		myAudioManager->PlayPickUp();
+		break;
+	case TimeStopSound:
+		myAudioManager->PlayTheWorld();
+		break;
+	case ThirdPhaseSound:
+		myAudioManager->channel->setPaused(true);
+		myAudioManager->PlayDoom();
+		break;
+	default:
+		break;
+	}
+}
+
+void resetStage() {
+	cout << "Stage Resetted Successfully" << endl;
+	resetSimulation();
+	toggleShoot = false;
+	myAudioManager->channel->setPaused(false);
+	myAudioManager->channel9->setPaused(true);
+	if (playMode != SinglePlayer) {
+		rollbackSession.restart();
+		secondPlayerSession.restart();
+	}
+}
+
+LRESULT CALLBACK WindowProcedure(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
+{
+	switch (message)
+	{
+	case WM_DESTROY:
+		PostQuitMessage(0);
+		break;
+	case WM_PAINT:
+		//menus only present when something changes, so repaint them when Windows asks
+		menuRedrawPending = true;
+		return DefWindowProc(hWnd, message, wParam, lParam);
+	case WM_KEYDOWN:
+		switch (wParam)
+		{
+		case 0x58: //X key
+			pendingKeyToggles |= ToggleShootKey;
+			break;
+		case 0x72:  //F3 key
+			showLatencyOverlay = !showLatencyOverlay;
+			break;
+		case 0x73:  //F4 key
+			showTelemetryOverlay = !showTelemetryOverlay;
+			break;
+		case 0x56:  //V key
+			pendingKeyToggles |= TimeStopKey;
+			break;
+		case 0x74:  //F5 key
+			pendingKeyToggles |= QuickSaveKey;
+			break;
+		case 0x78:  //F9 key
+			pendingKeyToggles |= QuickLoadKey;
+			break;
+		default:
+			break;
+		}
+		break;
+	default:
+		return DefWindowProc(hWnd, message, wParam, lParam);
+	}
+	return 0;
+}
+
+void createWindow() {
+
+	ZeroMemory(&wndStruct.wndClass, sizeof(wndStruct.wndClass));
+
+	wndStruct.wndClass.hbrBackground = (HBRUSH)GetStockObject(BLACK_BRUSH);
+	wndStruct.wndClass.hCursor = LoadCursor(NULL, IDC_ARROW);
+	wndStruct.wndClass.hInstance = GetModuleHandle(NULL);
+	wndStruct.wndClass.lpfnWndProc = WindowProcedure;
+	wndStruct.wndClass.lpszClassName = "Game Window";
+	wndStruct.wndClass.style = CS_HREDRAW | CS_VREDRAW;
+
+	RegisterClass(&wndStruct.wndClass);
+
+	wndStruct.g_hWnd = CreateWindowEx(0, wndStruct.wndClass.lpszClassName, "Spaceship Xtreme 2.0 (PRESS ESC TO EXIT THE PROGRAM)", WS_OVERLAPPEDWINDOW, 0, 100, screenWidth, screenHeight, NULL, NULL, GetModuleHandle(NULL), NULL);
+
+	ShowWindow(wndStruct.g_hWnd, stressMode ? SW_HIDE : 1);
+	ShowCursor(false);
+	ShowCursor(false);
+}
+
+//Handles every waiting message, a frame now waits between calls so one message per call would let them pile up
+bool windowIsRunning() {
+	while (PeekMessage(&wndStruct.msg, NULL, 0, 0, PM_REMOVE))
+	{
+		if (wndStruct.msg.message == WM_QUIT)
+			return false;
+		TranslateMessage(&wndStruct.msg);
+		DispatchMessage(&wndStruct.msg);
+	}
+	return true;
+}
+
+void cleanupWindow() {
+	UnregisterClass(wndStruct.wndClass.lpszClassName, GetModuleHandle(NULL));
+}
+
+void createDirectX() {
+
+	ZeroMemory(&directStruct.d3dPP, sizeof(directStruct.d3dPP));
+
+	directStruct.d3dPP.Windowed = true;
+	directStruct.d3dPP.SwapEffect = D3DSWAPEFFECT_DISCARD;
+	directStruct.d3dPP.BackBufferFormat = D3DFMT_X8R8G8B8;
+	directStruct.d3dPP.BackBufferCount = 1;
+	directStruct.d3dPP.BackBufferWidth = screenWidth;
+	directStruct.d3dPP.BackBufferHeight = screenHeight;
+	directStruct.d3dPP.hDeviceWindow = wndStruct.g_hWnd;
+
+	//Multithreaded so the textures can load on textureLoader while the splash is drawn
+	HRESULT hr = directStruct.direct3D9->CreateDevice(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, wndStruct.g_hWnd, D3DCREATE_SOFTWARE_VERTEXPROCESSING | D3DCREATE_MULTITHREADED, &directStruct.d3dPP, &directStruct.d3dDevice);
+
+	if (FAILED(hr))
+		cout << "Creating Directx Failed !!!";
+}
+
+void spriteRender(const RenderSnapshot& snapshot) {
+	sprite->Begin(D3DXSPRITE_ALPHABLEND);
+	//Sprite Transform Object - (scalingCenter, scalingRotation, scaling, rotationCenter, rotation, trans)
+	pointerTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(snapshot.pointerX, snapshot.pointerY));
+
+	textTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(800, 100));
+	timerTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(520, 35));
+	livesTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(2, 2), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1000, 35));
+	helpTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 35));
+	helpText2Trans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 70));
+	scoresTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 105));
+	highScoresTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 140));
+	latencyTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 620));
+	threadTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 580));
+	pacingTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 540));
+	telemetryTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 480));
+	textureTextTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(50, 440));
+
+	//Text
+	textRect.left = 0;
+	textRect.top = 0;
+	textRect.right = 300;
+	textRect.bottom = 125;
+
+	//Scores Text
+	scoresTextRect.left = 0;
+	scoresTextRect.top = 0;
+	scoresTextRect.right = 200;
+	scoresTextRect.bottom = 125;
+	//Timer Text
+	timerTextRect.left = 0;
+	timerTextRect.top = 0;
+	timerTextRect.right = 100;
+	timerTextRect.bottom = 125;
+	//Lives Text
+	livesTextRect.left = 0;
+	livesTextRect.top = 0;
+	livesTextRect.right = 100;
+	livesTextRect.bottom = 125;
+	//Latency Text
+	latencyTextRect.left = 0;
+	latencyTextRect.top = 0;
+	latencyTextRect.right = 700;
+	latencyTextRect.bottom = 60;
+
+	//Draw Sprite
+
+	for (int player = 0; player < snapshot.spaceshipCount; player++) {
+		thrustTrans = SpriteTransform(D3DXVECTOR2(thrustSprite.getSpriteWidth() / 2, thrustSprite.getSpriteHeight() / 2), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(thrustSprite.getSpriteWidth() / 2, thrustSprite.getSpriteHeight() / 2), snapshot.spaceshipRotation[player], toD3DXVector(snapshot.spaceshipPosition[player] + Vec2(spaceshipSprite.getSpriteWidth() / 2 - 4, spaceshipSprite.getSpriteHeight())));
+		spaceshipTrans = SpriteTransform(D3DXVECTOR2(spaceshipSprite.getSpriteWidth() / 2, spaceshipSprite.getSpriteHeight() / 2), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(spaceshipSprite.getSpriteWidth() / 2, spaceshipSprite.getSpriteHeight() / 2), snapshot.spaceshipRotation[player], toD3DXVector(snapshot.spaceshipPosition[player]));
+		turretTrans = SpriteTransform(D3DXVECTOR2(turretSprite.getSpriteWidth() / 2, turretSprite.getSpriteHeight() / 2), 0, D3DXVECTOR2(0.35, 0.35), D3DXVECTOR2(turretSprite.getSpriteWidth() / 2, turretSprite.getSpriteHeight() / 2), snapshot.turretRotation[player], toD3DXVector(snapshot.turretPosition[player]));
+
+		RECT thrustRect = toRECT(thrustSprite.getFrameRect(snapshot.thrustFrame[player]));
+		thrustTrans.transform();
+		sprite->SetTransform(&thrustTrans.getMat());
+		sprite->Draw(thrustTexture.getTexture(), &thrustRect, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+		frameDrawCalls++;
+
+		RECT spaceshipRect = toRECT(spaceshipSprite.getFrameRect(snapshot.spaceshipFrame[player]));
+		spaceshipTrans.transform();
+		sprite->SetTransform(&spaceshipTrans.getMat());
+		sprite->Draw(snapshot.spaceshipHull[player] == 1 ? spaceship2Texture.getTexture() : spaceshipTexture.getTexture(), &spaceshipRect, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+		frameDrawCalls++;
+
+		RECT turretRect = toRECT(turretSprite.getFrameRect(snapshot.turretFrame[player]));
+		turretTrans.transform();
+		sprite->SetTransform(&turretTrans.getMat());
+		sprite->Draw(turretTexture.getTexture(), &turretRect, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+		frameDrawCalls++;
+	}
+
+	//Entity matrices were already built by the simulation thread
+	D3DXMATRIX entityMatrix;
+	for (int i = 0; i < snapshot.bulletEntry; i++) {
+		toD3DXMatrix(snapshot.bulletMatrices[i], entityMatrix);
+		sprite->SetTransform(&entityMatrix);
+		sprite->Draw(bulletTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+		frameDrawCalls++;
+	}
+	for (int i = 0; i < snapshot.asteroidEntry; i++) {
+		toD3DXMatrix(snapshot.asteroidMatrices[i], entityMatrix);
+		sprite->SetTransform(&entityMatrix);
+		sprite->Draw(asteroidTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+		frameDrawCalls++;
+	}
+	for (int i = 0; i < snapshot.powerUpEntry; i++) {
+		toD3DXMatrix(snapshot.powerUpMatrices[i], entityMatrix);
+		sprite->SetTransform(&entityMatrix);
+		if (snapshot.powerUpType[i] == hpPowerUp) {
+			powerUpTexture = hpPowerUpTexture;
+		}
+		else if (snapshot.powerUpType[i] == bulletPowerUp) {
+			powerUpTexture = bulletPowerUpTexture;
+		}
+		else if (snapshot.powerUpType[i] == timePowerUp) {
+			powerUpTexture = timePowerUpTexture;
+		}
+		sprite->Draw(powerUpTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+		frameDrawCalls++;
+	}
+	for (int i = 0; i < snapshot.particleEntry; i++) {
+		const ParticleSprite& particle = snapshot.particles[i];
+		//the texture is 4x4
+		particleTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(particle.size / 4, particle.size / 4), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(particle.x - particle.size / 2, particle.y - particle.size / 2));
+		particleTrans.transform();
+		sprite->SetTransform(&particleTrans.getMat());
+		sprite->Draw(particleTexture, NULL, NULL, NULL, particle.color);
+		frameDrawCalls++;
+	}
+
+
+	pointerTrans.transform();
+	sprite->SetTransform(&pointerTrans.getMat());
+	sprite->Draw(pointerTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+	frameDrawCalls++;
+
+	//Draw Mouse Position Font
+	//textTrans.transform();
+
+	//sprite->SetTransform(&textTrans.getMat());
+	//strCurrentXpos = to_string(currentXpos);
+	//strCurrentYpos = to_string(currentYpos);
+	//for (int i = 0; i < strCurrentXpos.length(); i++) {
+	//	posText[i] = strCurrentXpos[i];
+	//}
+	//posText[4] = ',';
+	//for (int i = 0; i < strCurrentYpos.length(); i++) {
+	//	posText[i + 5] = strCurrentYpos[i];
+	//}
+
+	//font->DrawText(sprite, posText, -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
+
+	//for (int i = 0; i < sizeof(posText); i++) {
+	//	posText[i] = ' ';
+	//}
+	//Draw Timer Font
+	timerTextTrans.transform();
+
+	sprite->SetTransform(&timerTextTrans.getMat());
+	char* timerText = frameArena->format("%d:%d", snapshot.waveMin, snapshot.waveSec);
+	font->DrawText(sprite, timerText, -1, &timerTextRect, 0, D3DCOLOR_XRGB(255, 255, 255));
+	frameDrawCalls++;
+
+	//Draw Lives Font
+	livesTextTrans.transform();
+
+	sprite->SetTransform(&livesTextTrans.getMat());
+	char* livesText = frameArena->format("%s%d", strLivesPrefix.c_str(), snapshot.lives);
+	font->DrawText(sprite, livesText, -1, &livesTextRect, 0, D3DCOLOR_XRGB(255, 255, 255));
+	frameDrawCalls++;
+
+	//Draw Help Font
+	helpTextTrans.transform();
+
+	sprite->SetTransform(&helpTextTrans.getMat());
+	font->DrawText(sprite, "Left click to shoot", -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
+	frameDrawCalls++;
+
+	//Draw Help Font 2
+	helpText2Trans.transform();
+
+	sprite->SetTransform(&helpText2Trans.getMat());
+	font->DrawText(sprite, "Press X to toggle the shooting", -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
+	frameDrawCalls++;
+
+	//Draw Scores Font
+	scoresTextTrans.transform();
+
+	sprite->SetTransform(&scoresTextTrans.getMat());
+	char* scoresText = frameArena->format("%s%d", strScoresPrefix.c_str(), snapshot.scores);
+	font->DrawText(sprite, scoresText, -1, &scoresTextRect, 0, D3DCOLOR_XRGB(255, 255, 255));
+	frameDrawCalls++;
+
+	//Draw High Scores Font
+	highScoresTextTrans.transform();
+
+	sprite->SetTransform(&highScoresTextTrans.getMat());
+	char* highScoresText = frameArena->format("%s%d", strHighScoresPrefix.c_str(), snapshot.highScores);
+	font->DrawText(sprite, highScoresText, -1, &textRect, 0, D3DCOLOR_XRGB(255, 255, 255));
+	frameDrawCalls++;
+
+	//Draw Latency Overlay (F3)
+	if (showLatencyOverlay) {
+		latencyTextTrans.transform();
+
+		sprite->SetTransform(&latencyTextTrans.getMat());
+		latencyTracker->formatOverlay(latencyText, sizeof(latencyText));
+		font->DrawText(sprite, latencyText, -1, &latencyTextRect, 0, D3DCOLOR_XRGB(255, 255, 0));
+		frameDrawCalls++;
+
+		threadTextTrans.transform();
+
+		sprite->SetTransform(&threadTextTrans.getMat());
+		if (playMode == SinglePlayer) {
+			snprintf(threadText, sizeof(threadText), "Snapshot age p50 %.1fms  p99 %.1fms  dropped %lld  duplicated %lld",
+				snapshotAge.percentile(50), snapshotAge.percentile(99), droppedSnapshots.load(), duplicatedSnapshots.load());
+		}
+		else {
+			snprintf(threadText, sizeof(threadText), "Snapshot age p50 %.1fms  p99 %.1fms  rollbacks %lld  unconfirmed ticks %d",
+				snapshotAge.percentile(50), snapshotAge.percentile(99), snapshot.rollbackCount, snapshot.unconfirmedTicks);
+		}
+		font->DrawText(sprite, threadText, -1, &latencyTextRect, 0, D3DCOLOR_XRGB(255, 255, 0));
+		frameDrawCalls++;
+
+		pacingTextTrans.transform();
+
+		sprite->SetTransform(&pacingTextTrans.getMat());
+		snprintf(pacingText, sizeof(pacingText), "Frame jitter p99 %.1fms  max %.1fms  tick jitter p99 %.1fms  CPU %.0f%%",
+			renderPacer->getJitter().percentile(99), renderPacer->getMaxJitter(), simulationPacer->getJitter().percentile(99), renderPacer->getCpuUtilisation());
+		font->DrawText(sprite, pacingText, -1, &latencyTextRect, 0, D3DCOLOR_XRGB(255, 255, 0));
+		frameDrawCalls++;
+	}
+
+	//Draw Telemetry Overlay (F4)
+	if (showTelemetryOverlay) {
+		telemetryTextTrans.transform();
+
+		sprite->SetTransform(&telemetryTextTrans.getMat());
+		telemetry->formatOverlay(telemetryText, sizeof(telemetryText));
+		font->DrawText(sprite, telemetryText, -1, &latencyTextRect, 0, D3DCOLOR_XRGB(0, 255, 255));
+		frameDrawCalls++;
+
+		textureTextTrans.transform();
+
+		sprite->SetTransform(&textureTextTrans.getMat());
+		textureCache->formatOverlay(textureText, sizeof(textureText));
+		font->DrawText(sprite, textureText, -1, &latencyTextRect, 0, D3DCOLOR_XRGB(0, 255, 255));
+		frameDrawCalls++;
+	}
+	sprite->End();
+}
+
+void render() {
+	//Take the latest completed snapshot, if the simulation has not finished a new one the last one is drawn again
+	if (!renderSnapshots.consume()) {
+		duplicatedSnapshots++;
+	}
+	const RenderSnapshot& snapshot = renderSnapshots.getReadBuffer();
+
+	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
+
+	directStruct.d3dDevice->BeginScene();
+
+	frameDrawCalls = 0;
+	if (snapshot.tick != 0) {
+		spriteRender(snapshot);
+	}
+	telemetry->setGauge(DrawCallGauge, frameDrawCalls);
+
+	directStruct.d3dDevice->EndScene();
+
+	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
+	latencyTracker->framePresented(snapshot.tick);
+	if (snapshot.tick != 0) {
+		snapshotAge.record(chrono::duration_cast<chrono::microseconds>(LatencyTracker::Clock::now() - snapshot.publishTime).count());
+	}
+}
+
+void splashRender() {
+	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
+
+	directStruct.d3dDevice->BeginScene();
+
+	sprite->Begin(D3DXSPRITE_ALPHABLEND);
+
+	D3DXVECTOR3 splashPosition((screenWidth - splashScreenWidth) / 2.0f, (screenHeight - splashScreenHeight) / 2.0f, 0);
+	sprite->Draw(splashTexture, NULL, NULL, &splashPosition, D3DCOLOR_XRGB(255, 255, 255));
+
+	sprite->End();
+
+	directStruct.d3dDevice->EndScene();
+
+	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
+
+}
+
+void cleanupDirectX() {
+	directStruct.d3dDevice->Release();
+	directStruct.d3dDevice = NULL;
+}
+
+//Only what the splash needs, everything else is loaded by loadTextures() behind it
+void createSprite() {
+	HRESULT hr = D3DXCreateSprite(directStruct.d3dDevice, &sprite);
+
+	if (FAILED(hr)) {
+		cout << "Create Sprite Failed!!!";
+	}
+
+	splashTexture = createTextureFromFile("Assets/splash.jpg");
+}
+
+//Alpha channel of an image at the size it is drawn (D3DX rounds the images createTextureFromFile loads up to powers of two)
+//Always read from the image, not its DDS, so hit boxes are the same on machines with and without compressed textures
+bool loadAlphaMap(LPCTSTR fileLocation, vector<unsigned char>& alpha, int& width, int& height) {
+	LPDIRECT3DTEXTURE9 texture = NULL;
+	HRESULT hr = D3DXCreateTextureFromFileEx(directStruct.d3dDevice, fileLocation, D3DX_DEFAULT, D3DX_DEFAULT, 1, 0, D3DFMT_A8R8G8B8, D3DPOOL_SCRATCH, D3DX_DEFAULT, D3DX_DEFAULT, 0, NULL, NULL, &texture);
+	if (FAILED(hr)) {
+		return false;
+	}
+	D3DSURFACE_DESC description;
+	D3DLOCKED_RECT lockedRect;
+	texture->GetLevelDesc(0, &description);
+	if (FAILED(texture->LockRect(0, &lockedRect, NULL, D3DLOCK_READONLY))) {
+		texture->Release();
+		return false;
+	}
+	width = description.Width;
+	height = description.Height;
+	alpha.resize(width * height);
+	for (int y = 0; y < height; y++) {
+		unsigned char* row = (unsigned char*)lockedRect.pBits + y * lockedRect.Pitch;
+		for (int x = 0; x < width; x++) {
+			alpha[y * width + x] = row[x * 4 + 3];
+		}
+	}
+	texture->UnlockRect(0);
+	texture->Release();
+	return true;
+}
+
+void buildSpaceshipMasks(LPCTSTR fileLocation, CollisionMaskSet* masks) {
+	vector<unsigned char> alpha;
+	int width, height;
+	if (!loadAlphaMap(fileLocation, alpha, width, height)) {
+		cout << "Load Collision Mask Failed!!!";
+		return;
+	}
+	float scale = 1;
+	for (int frame = 0; frame < spaceshipSprite.getFrameCount(); frame++) {
+		SpriteRect frameRect = spaceshipSprite.getFrameRect(frame);
+		frameRect.right = min(frameRect.right, (LONG)width);
+		frameRect.bottom = min(frameRect.bottom, (LONG)height);
+		masks[frame].build(alpha.data(), width, frameRect.left, frameRect.top, frameRect.right - frameRect.left, frameRect.bottom - frameRect.top, &scale, 1, maskRotationBuckets, spaceshipSprite.getSpriteWidth() / 2, spaceshipSprite.getSpriteHeight() / 2, maskAlphaThreshold);
+	}
+}
+
+void buildCollisionMasks() {
+	vector<unsigned char> alpha;
+	int width, height;
+	float asteroidScales[] = { 1, 1.5, 2 };
+	if (loadAlphaMap("Assets/asteroid.png", alpha, width, height)) {
+		asteroidMasks.build(alpha.data(), width, 0, 0, width, height, asteroidScales, 3, maskRotationBuckets, 35, 35, maskAlphaThreshold);
+	}
+	float bulletScale = 1;
+	if (loadAlphaMap("Assets/bullet.png", alpha, width, height)) {
+		bulletMasks.build(alpha.data(), width, 0, 0, width, height, &bulletScale, 1, maskRotationBuckets, bulletSprite.getTotalSpriteWidth() / 2, bulletSprite.getTotalSpriteHeight() / 2, maskAlphaThreshold);
+	}
+	buildSpaceshipMasks("Assets/ship.png", spaceshipMasks);
+	buildSpaceshipMasks("Assets/ship2.png", spaceship2Masks);
+}
+
+long long millisecondsSinceLaunch() {
+	return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - launchTime).count();
+}
+
+//Runs on textureLoader while the main thread draws the splash
+void loadTextures() {
+	HRESULT hr = D3DXCreateFont(directStruct.d3dDevice, 25, 0, 0, 1, false,
+		DEFAULT_CHARSET, OUT_TT_ONLY_PRECIS, DEFAULT_QUALITY,
+		DEFAULT_PITCH | FF_DONTCARE, "Arial", &font);
+
+	if (FAILED(hr)) {
+		cout << "Create Font Failed!!!";
+	}
+
+	Texture* textures[] = { &thrustTexture, &spaceshipTexture, &turretTexture, &asteroidTexture, &bulletTexture, &hpPowerUpTexture,
+		&bulletPowerUpTexture, &timePowerUpTexture, &cursorTexture, &buttonBgTexture, &bgTexture, &spaceship2Texture,
+		&crosshairTexture, &crosshair2Texture, &crosshair3Texture };
+	for (Texture* texture : textures) {
+		texture->load();
+	}
+	buildCollisionMasks();
+	if (FAILED(createWhiteTexture(4, 4, particleTexture))) {
+		cout << "Create Particle Texture Failed!!!";
+	}
+	texturesLoadedMs = millisecondsSinceLaunch();
+	texturesLoaded = true;
+}
+
+//Runs on soundLoader, the FMOD system itself is created on the main thread
+void loadSounds() {
+	myAudioManager->LoadSounds();
+	soundsLoadedMs = millisecondsSinceLaunch();
+	soundsLoaded = true;
+}
+
+void releaseSplash() {
+	if (splashTexture != NULL) {
+		splashTexture->Release();
+		splashTexture = NULL;
+	}
+}
+
+void cleanupSprite() {
+	sprite->Release();
+	sprite = NULL;
+
+	textureCache->shutdown();
+
+	if (particleTexture != NULL) {
+		particleTexture->Release();
+		particleTexture = NULL;
+	}
+	releaseSplash();
+
+	font->Release();
+	font = NULL;
+}
+
+void createDirectInput() {
+
+	HRESULT hr = DirectInput8Create(GetModuleHandle(NULL), 0x0800, IID_IDirectInput8, (void**)&dInput, NULL);
+
+	hr = dInput->CreateDevice(GUID_SysKeyboard, &dInputKeyboardDevice, NULL);
+
+	dInputKeyboardDevice->SetDataFormat(&c_dfDIKeyboard);
+
+	dInputKeyboardDevice->SetCooperativeLevel(wndStruct.g_hWnd, DISCL_FOREGROUND | DISCL_NONEXCLUSIVE);
+
+	hr = dInput->CreateDevice(GUID_SysMouse, &dInputMouseDevice, NULL);
+
+	dInputMouseDevice->SetDataFormat(&c_dfDIMouse);
+
+	dInputMouseDevice->SetCooperativeLevel(wndStruct.g_hWnd, DISCL_FOREGROUND | DISCL_EXCLUSIVE);
+}
+
+void getInput() {
+	dInputKeyboardDevice->Acquire();
+	dInputMouseDevice->Acquire();
+	dInputKeyboardDevice->GetDeviceState(256, diKeys);
+
+	dInputMouseDevice->GetDeviceState(sizeof(mouseState), (LPVOID)&mouseState);
+
+	//Tag this poll as an input event if a key or button changed state or the mouse moved
+	int inputSources = 0;
+	for (int i = 0; i < 256; i++) {
+		if ((diKeys[i] & 0x80) != (previousDiKeys[i] & 0x80)) {
+			inputSources |= KeyboardInput;
+		}
+		previousDiKeys[i] = diKeys[i];
+	}
+	if (mouseState.lX != 0 || mouseState.lY != 0 || (mouseState.rgbButtons[0] & 0x80) != (previousMouseButtons & 0x80)) {
+		inputSources |= MouseInput;
+	}
+	previousMouseButtons = mouseState.rgbButtons[0];
+	latencyTracker->captureInput(inputSources);
+}
+
+void cleanupInput() {
+	//	Release keyboard device.
+	dInputKeyboardDevice->Unacquire();
+	dInputKeyboardDevice->Release();
+	dInputKeyboardDevice = NULL;
+
+	//	Release mouse device.
+	dInputMouseDevice->Unacquire();
+	dInputMouseDevice->Release();
+	dInputMouseDevice = NULL;
+
+	//	Release DirectInput.
+	dInput->Release();
+	dInput = NULL;
+}
+
+//Turns this machine's devices into a player input
+PlayerInput readLocalInput() {
+	PlayerInput input = PlayerInput();
+	if (diKeys[DIK_A] & 0x80) {
+		input.buttons |= MoveLeftButton;
+	}
+	if (diKeys[DIK_D] & 0x80) {
+		input.buttons |= MoveRightButton;
+	}
+	if (diKeys[DIK_W] & 0x80) {
+		input.buttons |= MoveUpButton;
+	}
+	if (diKeys[DIK_S] & 0x80) {
+		input.buttons |= MoveDownButton;
+	}
+	//Left click
+	if (mouseState.rgbButtons[0] & 0x80 || toggleShoot == true) {
+		input.buttons |= FireButton;
+	}
+	input.aimX = (int16_t)currentXpos;
+	input.aimY = (int16_t)currentYpos;
+	return input;
+}
+
+//Player two in local two player: arrow keys and right control, the turret points straight up
+PlayerInput readSecondLocalInput() {
+	PlayerInput input = PlayerInput();
+	if (diKeys[DIK_LEFT] & 0x80) {
+		input.buttons |= MoveLeftButton;
+	}
+	if (diKeys[DIK_RIGHT] & 0x80) {
+		input.buttons |= MoveRightButton;
+	}
+	if (diKeys[DIK_UP] & 0x80) {
+		input.buttons |= MoveUpButton;
+	}
+	if (diKeys[DIK_DOWN] & 0x80) {
+		input.buttons |= MoveDownButton;
+	}
+	if (diKeys[DIK_RCONTROL] & 0x80) {
+		input.buttons |= FireButton;
+	}
+	input.aimX = (int16_t)(spaceships[1].turretPosition.x + turretSprite.getSpriteWidth() / 2 - pointerSprite.getTotalSpriteWidth() / 2);
+	input.aimY = 0;
+	return input;
+}
+
+//Pointer and escape key, they only concern this machine and stay out of the simulation
+void updateLocalControls() {
+	//Left click
+	if (mouseState.rgbButtons[0] & 0x80) {
+		//do something
+	}
+	//Right click
+	if (mouseState.rgbButtons[1] & 0x80) {
+		//do something
+	}
+	if (diKeys[DIK_ESCAPE] & 0x80) {
+		PostMessage(wndStruct.g_hWnd, WM_CLOSE, 0, 0); //runs on the simulation thread, which has no message queue
+	}
+	//Mouse position
+	if (currentYpos >= 0 && currentYpos <= screenHeight - pointerSprite.getTotalSpriteHeight()) {
+		currentYpos += mouseState.lY;
+	}
+	if (currentYpos < 0 || currentYpos > screenHeight - pointerSprite.getTotalSpriteHeight()) {
+		currentYpos -= mouseState.lY;
+	}
+	if (currentXpos >= 0 && currentXpos <= screenWidth - pointerSprite.getTotalSpriteWidth()) {
+		currentXpos += mouseState.lX;
+	}
+	if (currentXpos < 0 || currentXpos > screenWidth - pointerSprite.getTotalSpriteWidth()) {
+		currentXpos -= mouseState.lX;
+	}
+	latencyTracker->consumeInput(MouseInput, simulationTick + 1);
+}
+
+void Sound() {
+	myAudioManager->UpdateSound();
+}
+
+void applyKeyToggles() {
+	int toggles = pendingKeyToggles.exchange(0);
+	if (toggles & ToggleShootKey) {
+		toggleShoot = !toggleShoot;
+	}
+	//the rest change the game outside of player input, which the other player would never see
+	if (playMode != SinglePlayer) {
+		return;
+	}
+	if (toggles & TimeStopKey) {
+		if (!timeStop) {
+			timeStopDurationLeft = 10000;
+			timeStop = true;
+		}
+		else {
+			timeStop = false;
+		}
+	}
+	if (toggles & QuickSaveKey) {
+		saveGameState(gameStateWriter);
+		quickSave.assign(gameStateWriter.getData(), gameStateWriter.getData() + gameStateWriter.getSize());
+		cout << "Quick Saved (" << quickSave.size() << " bytes)" << endl;
+	}
+	if (toggles & QuickLoadKey) {
+		//without a quick save the last post mortem is loaded, so a lost run can be looked at again
+		vector<unsigned char> postMortem;
+		bool loaded = false;
+		if (!quickSave.empty()) {
+			loaded = loadGameState(quickSave.data(), quickSave.size(), true);
+		}
+		else if (loadStateFile(postMortemFile, postMortem)) {
+			loaded = loadGameState(postMortem.data(), postMortem.size(), false);
+		}
+		//a state that failed to load leaves the stage running as it was
+		if (loaded) {
+			particleSystem->clear();
+		}
+	}
+}
+
+void publishSnapshot() {
+	RenderSnapshot& snapshot = renderSnapshots.getWriteBuffer();
+	simulationTick++;
+	snapshot.tick = simulationTick;
+	snapshot.spaceshipCount = playerCount;
+	for (int player = 0; player < playerCount; player++) {
+		snapshot.spaceshipPosition[player] = spaceships[player].position;
+		snapshot.spaceshipRotation[player] = spaceships[player].rotation;
+		snapshot.spaceshipFrame[player] = spaceshipAnimations[player].frame;
+		snapshot.spaceshipHull[player] = spaceships[player].hull;
+		snapshot.turretPosition[player] = spaceships[player].turretPosition;
+		snapshot.turretRotation[player] = spaceships[player].turretRotation;
+		snapshot.thrustFrame[player] = thrustAnimations[player].frame;
+		snapshot.turretFrame[player] = turretAnimations[player].frame;
+	}
+	snapshot.pointerX = currentXpos;
+	snapshot.pointerY = currentYpos;
+	buildEntitySprites(snapshot);
+	snapshot.waveSec = waveSec;
+	snapshot.waveMin = waveMin;
+	snapshot.lives = lives;
+	snapshot.scores = scores;
+	snapshot.highScores = highScores;
+	snapshot.rollbackCount = rollbackSession.getRollbackCount();
+	snapshot.unconfirmedTicks = (int)(rollbackSession.getTick() - rollbackSession.getConfirmedTick());
+	snapshot.publishTime = LatencyTracker::Clock::now();
+	if (renderSnapshots.publish()) {
+		droppedSnapshots++;
+	}
+}
+
+//One two player tick, called by the rollback session (again for ticks it replays)
+void advanceTwoPlayerTick(const PlayerInput* inputs) {
+	replayingTicks = rollbackSession.isResimulating();
+	advanceTick(inputs);
+	latencyTracker->consumeInput(KeyboardInput, simulationTick + 1);
+}
+bool loadRollbackState(const unsigned char* data, size_t size) {
+	return loadGameState(data, size, true);
+}
+//Player two's session in local two player only sends input, the game is simulated by player one's session
+void saveNoState(StateWriter&) {
+}
+bool loadNoState(const unsigned char*, size_t) {
+	return true;
+}
+void advanceNoTick(const PlayerInput*) {
+}
+
+//Returns false if the transport could not be opened
+bool startTwoPlayer(int mode, int localPlayer, int localPort, const char* remoteAddress, int remotePort) {
+	playMode = mode;
+	playerCount = 2;
+	placeSpaceships();
+	RollbackCallbacks callbacks = { saveGameState, loadRollbackState, advanceTwoPlayerTick };
+	if (mode == LocalTwoPlayer) {
+		LoopbackTransport::connect(localTransport, secondPlayerTransport);
+		localTransport.setConditions(localLatency, localJitter, localLoss, 1);
+		secondPlayerTransport.setConditions(localLatency, localJitter, localLoss, 2);
+		RollbackCallbacks noCallbacks = { saveNoState, loadNoState, advanceNoTick };
+		secondPlayerSession.init(1, rollbackWindow, rollbackInputDelay, &secondPlayerTransport, noCallbacks);
+		rollbackSession.init(0, rollbackWindow, rollbackInputDelay, &localTransport, callbacks);
+		return true;
+	}
+	if (!networkTransport.open(localPort, remoteAddress, remotePort)) {
+		cout << "Opening UDP Port " << localPort << " Failed!!!" << endl;
+		return false;
+	}
+	rollbackSession.init(localPlayer, rollbackWindow, rollbackInputDelay, &networkTransport, callbacks);
+	return true;
+}
+
+//Publishes what changed and switches to the game over menu at the end of a step
+//A two player game over is predicted until the peer's input for that tick arrives, a late input may still save the ship
+bool isGameOverConfirmed() {
+	return gameOver && (playMode == SinglePlayer || gameOverTick < rollbackSession.getConfirmedTick());
+}
+
+void finishSimulationStep(bool changed) {
+	bool ended = isGameOverConfirmed();
+	//Only publish when something visible changed, otherwise the render thread keeps the last snapshot
+	if (changed || mouseState.lX != 0 || mouseState.lY != 0 || ended) {
+		publishSnapshot();
+	}
+	if (ended) {
+		//the final state is kept so a bad run can be loaded and inspected later
+		saveGameState(gameStateWriter);
+		gameStateWriter.saveToFile(postMortemFile);
+		gameOver = false;
+		currentMenu = GameOverMenu;
+	}
+}
+
+//Every wake of the simulation thread is one tick of the rollback session, this machine's input is always sent as its own player
+void twoPlayerStep() {
+	PlayerInput localInput = readLocalInput();
+	if (playMode == LocalTwoPlayer) {
+		secondPlayerSession.advance(readSecondLocalInput());
+	}
+	bool advanced = rollbackSession.advance(localInput);
+	updateLocalControls();
+	finishSimulationStep(advanced);
+}
+
+void simulationStep() {
+	getInput();
+	applyKeyToggles();
+	if (playMode != SinglePlayer) {
+		twoPlayerStep();
+		return;
+	}
+	//one tick per wake, a late wake slows the game down instead of skipping ticks
+	PlayerInput inputs[maxPlayers] = { readLocalInput() };
+	advanceTick(inputs);
+	latencyTracker->consumeInput(KeyboardInput, simulationTick + 1);
+	updateLocalControls();
+	finishSimulationStep(true);
+}
+
+//A file with an error is reported and the values in use stay as they are
+void loadTuning() {
+	if (!tuningFile->loadFromFile(tuningFileName, tuning)) {
+		cout << "Tuning not applied, " << tuningFile->getError() << endl;
+	}
+}
+
+//One telemetry row per simulation step
+void recordTelemetry(long long tickMicroseconds) {
+	telemetry->recordTick(tickMicroseconds);
+	telemetry->setGauge(BulletGauge, bulletQuery.count());
+	telemetry->setGauge(AsteroidGauge, asteroidQuery.count());
+	telemetry->setGauge(PowerUpGauge, powerUpQuery.count());
+	telemetry->setGauge(CollisionGauge, tickCollisions);
+	long long soundsPlayed = myAudioManager->getPlayCount();
+	telemetry->setGauge(SoundGauge, (int)(soundsPlayed - soundsPlayedBefore));
+	soundsPlayedBefore = soundsPlayed;
+	telemetry->endTick();
+}
+
+//Simulation thread, runs the game while the render thread (main) draws the latest snapshot
+//Wakes once per game tick and runs exactly one, the slower rates are counted in ticks
+void simulationLoop() {
+	simulationPacer->init(gameUpdateRate, gameUpdateRate);
+	while (simulationRunning) {
+		simulationPacer->waitForNextFrame();
+		//only read between ticks, so no tick sees part of an edit
+		if (tuningWatcher->hasChanged()) {
+			loadTuning();
+		}
+		if (currentMenu == GameMenu) {
+			LatencyTracker::Clock::time_point tickStart = LatencyTracker::Clock::now();
+			tickCollisions = 0;
+			simulationStep();
+			recordTelemetry(chrono::duration_cast<chrono::microseconds>(LatencyTracker::Clock::now() - tickStart).count());
+		}
+		//the peer may not have seen the game end yet, and cannot without our last inputs
+		else if (currentMenu == GameOverMenu && playMode != SinglePlayer) {
+			rollbackSession.flushInputs();
+		}
+	}
+}
+
+//Draws the splash until the assets are in and it has been up for minSplashSeconds. Returns false if the window was closed.
+bool showSplash() {
+	bool windowOpen = true;
+	splashRender();
+	firstFrameMs = millisecondsSinceLaunch();
+	while (!(texturesLoaded && soundsLoaded) || millisecondsSinceLaunch() - firstFrameMs < minSplashSeconds * 1000) {
+		if (!windowIsRunning()) {
+			windowOpen = false;
+			break;
+		}
+		//the splash never changes, so it is only redrawn when Windows asks
+		if (menuRedrawPending.exchange(false)) {
+			splashRender();
+		}
+		this_thread::sleep_for(chrono::milliseconds(5));
+	}
+	//the loaders finish even if the window was closed, so the cleanup never releases a texture being created
+	textureLoader.join();
+	soundLoader.join();
+	return windowOpen;
+}
+
+//Menu Images, names used by the layout file
+struct MenuImageSource {
+	const char* name;
+	Texture* texture;
+	SpriteSheet* sheet; //for widgets that draw one frame
+};
+MenuImageSource menuImages[] = {
+	{ "bg", &bgTexture, NULL },
+	{ "buttonBg", &buttonBgTexture, NULL },
+	{ "ship", &spaceshipTexture, &spaceshipSprite },
+	{ "ship2", &spaceship2Texture, &spaceshipSprite },
+	{ "crosshair", &crosshairTexture, NULL },
+	{ "crosshair2", &crosshair2Texture, NULL },
+	{ "crosshair3", &crosshair3Texture, NULL },
+};
+
+//Menu Transitions
+void updateTweens() {
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+	float seconds = chrono::duration<float>(now - lastTweenUpdate).count();
+	lastTweenUpdate = now;
+	if (seconds > maxTweenStep) {
+		seconds = maxTweenStep;
+	}
+	tweens->update(seconds);
+}
+
+//A screen that is not in place yet slides in, clicks only count once it has stopped
+void slideMenuIn(MenuScreen* screen) {
+	if (!menuLeaving && !tweens->isActive(menuSlide) && menuSlideX != 0) {
+		menuSlide = tweens->start(&menuSlideX, menuSlideX, 0, menuSlideInDuration, EaseOutCubic);
+	}
+	screen->setOffset(menuSlideX, 0);
+}
+bool menuInPlace() {
+	return !menuLeaving && menuSlideX == 0;
+}
+
+//Backs off a little, then slides out and calls onFinished(argument)
+void slideMenuOut(TweenCallback onFinished, int argument) {
+	menuLeaving = true;
+	tweens->stop(menuSlide);
+	TweenHandle pullBack = tweens->start(&menuSlideX, menuSlideX, menuSlideX + menuPullBack, menuPullBackDuration, EaseOutQuad);
+	menuSlide = tweens->then(pullBack, &menuSlideX, menuSlideX + menuPullBack, menuSlideOutTo, menuSlideOutDuration, EaseInCubic);
+	tweens->setOnComplete(menuSlide, onFinished, argument);
+}
+//The next screen starts off to the right
+void finishMenuSlide() {
+	menuLeaving = false;
+	menuSlideX = menuSlideInFrom;
+}
+
+void showCrosshairSelection(int) {
+	finishMenuSlide();
+	currentMenu = CrosshairSelectionMenu;
+}
+void startGame(int) {
+	finishMenuSlide();
+	placeSpaceships();
+	currentMenu = GameMenu;
+}
+void leaveGameOver(int action) {
+	finishMenuSlide();
+	resetStage();
+	currentMenu = action == Retry ? GameMenu : MainMenu;
+}
+
+//Menu Actions, bound to the button actions of the layout file
+void startAction(int) {
+	currentMenu = SpaceshipSelectionMenu;
+}
+void selectSpaceshipAction(int spaceship) {
+	selectedHull = spaceship == 1 ? 1 : 0;
+	slideMenuOut(showCrosshairSelection, 0);
+}
+void selectCrosshairAction(int crosshair) {
+	Texture* crosshairs[] = { &crosshairTexture, &crosshair2Texture, &crosshair3Texture };
+	if (crosshair < 0 || crosshair > 2) {
+		return;
+	}
+	//held for the whole game, the pointer is the one texture drawn on every game frame
+	textureCache->release(pointerTexture.getAsset());
+	pointerTexture = *crosshairs[crosshair];
+	textureCache->acquire(pointerTexture.getAsset());
+	slideMenuOut(startGame, 0);
+}
+void gameOverButtonAction(int action) {
+	slideMenuOut(leaveGameOver, action);
+}
+
+//Returns false if the layout file is missing or a screen the game needs is not in it
+bool createMenus() {
+	if (!menuLayout.loadFromFile("Assets/menus.layout")) {
+		cout << "Loading Menu Layout Failed!!! " << menuLayout.getError() << endl;
+		return false;
+	}
+	mainMenuScreen = menuLayout.getScreen("main");
+	spaceshipSelectionScreen = menuLayout.getScreen("spaceshipSelection");
+	crosshairSelectionScreen = menuLayout.getScreen("crosshairSelection");
+	gameOverScreen = menuLayout.getScreen("gameOver");
+	if (mainMenuScreen == NULL || spaceshipSelectionScreen == NULL || crosshairSelectionScreen == NULL || gameOverScreen == NULL) {
+		cout << "Menu Layout Is Missing A Screen!!!" << endl;
+		return false;
+	}
+	gameOverScoresText = gameOverScreen->findWidget("scores");
+	gameOverSurvivedText = gameOverScreen->findWidget("survived");
+	if (gameOverScoresText < 0 || gameOverSurvivedText < 0) {
+		cout << "Menu Layout Is Missing The Game Over Texts!!!" << endl;
+		return false;
+	}
+	mainMenuScreen->bindAction("start", startAction);
+	spaceshipSelectionScreen->bindAction("selectSpaceship", selectSpaceshipAction);
+	crosshairSelectionScreen->bindAction("selectCrosshair", selectCrosshairAction);
+	gameOverScreen->bindAction("gameOver", gameOverButtonAction);
+	return true;
+}
+
+//Moves the menu cursor with the mouse, kept on screen
+void updateMenuCursor() {
+	if (currentYpos >= 0 && currentYpos <= screenHeight - cursorSprite.getTotalSpriteHeight()) {
+		currentYpos += mouseState.lY;
+	}
+	if (currentYpos < 0 || currentYpos > screenHeight - cursorSprite.getTotalSpriteHeight()) {
+		currentYpos -= mouseState.lY;
+	}
+	if (currentXpos >= 0 && currentXpos <= screenWidth - cursorSprite.getTotalSpriteWidth()) {
+		currentXpos += mouseState.lX;
+	}
+	if (currentXpos < 0 || currentXpos > screenWidth - cursorSprite.getTotalSpriteWidth()) {
+		currentXpos -= mouseState.lX;
+	}
+}
+
+//Left click runs the action of the button under the cursor
+void clickMenu(MenuScreen* screen) {
+	if (mouseState.rgbButtons[0] & 0x80) {
+		if (screen->click(currentXpos, currentYpos) >= 0) {
+			myAudioManager->PlayButtonClick();
+		}
+	}
+}
+
+void mainMenuUpdate() {
+	updateMenuCursor();
+	clickMenu(mainMenuScreen);
+
+	if (diKeys[DIK_ESCAPE] & 0x80) {
+		PostQuitMessage(0);
+	}
+}
+
+void spaceshipSelectionMenuUpdate() {
+	updateMenuCursor();
+	if (menuInPlace()) {
+		clickMenu(spaceshipSelectionScreen);
+	}
+	if (diKeys[DIK_ESCAPE] & 0x80) {
+		PostQuitMessage(0);
+	}
+}
+
+void crosshairSelectionMenuUpdate() {
+	updateMenuCursor();
+	if (menuInPlace()) {
+		clickMenu(crosshairSelectionScreen);
+	}
+	if (diKeys[DIK_ESCAPE] & 0x80) {
+		PostQuitMessage(0);
+	}
+}
+
+void gameOverMenuUpdate() {
+	updateMenuCursor();
+	if (menuInPlace()) {
+		clickMenu(gameOverScreen);
+	}
+	if (diKeys[DIK_ESCAPE] & 0x80) {
+		PostQuitMessage(0);
+	}
+}
+
+//Turns the screen's draw list into matrices, textures and rects, only called when the draw list changed
+void cacheMenuDrawList(MenuScreen* screen) {
+	const vector<MenuDrawItem>& items = screen->getDrawList();
+	menuMatrices.resize(items.size());
+	menuTextures.resize(items.size());
+	menuRects.resize(items.size());
+	for (int i = 0; i < (int)items.size(); i++) {
+		MenuWidget& widget = screen->getWidget(items[i].widget);
+		toD3DXMatrix(scaling2D(items[i].scaleX, items[i].scaleY) * translation2D(items[i].x, items[i].y), menuMatrices[i]);
+		menuTextures[i] = NULL;
+		RECT rect = { 0, 0, (LONG)widget.width, (LONG)widget.height };
+		for (int j = 0; j < sizeof(menuImages) / sizeof(menuImages[0]); j++) {
+			if (widget.image == menuImages[j].name) {
+				menuTextures[i] = menuImages[j].texture;
+				if (widget.frame >= 0 && menuImages[j].sheet != NULL && widget.frame < menuImages[j].sheet->getFrameCount()) {
+					rect = toRECT(menuImages[j].sheet->getFrameRect(widget.frame));
+				}
+			}
+		}
+		menuRects[i] = rect;
+	}
+	drawnMenuScreen = screen;
+	drawnMenuVersion = screen->getVersion();
+}
+
+void menuSpriteRender(MenuScreen* screen) {
+	if (screen != drawnMenuScreen || screen->getVersion() != drawnMenuVersion) {
+		cacheMenuDrawList(screen);
+	}
+	sprite->Begin(D3DXSPRITE_ALPHABLEND);
+
+	const vector<MenuDrawItem>& items = screen->getDrawList();
+	for (int i = 0; i < (int)items.size(); i++) {
+		MenuWidget& widget = screen->getWidget(items[i].widget);
+		sprite->SetTransform(&menuMatrices[i]);
+		if (widget.type == MenuText) {
+			font->DrawText(sprite, widget.text.c_str(), -1, &menuRects[i], 0, widget.color);
+		}
+		else if (menuTextures[i] != NULL) {
+			sprite->Draw(menuTextures[i]->getTexture(), widget.frame >= 0 ? &menuRects[i] : NULL, NULL, NULL, widget.color);
+		}
+	}
+
+	//Sprite Transform Object - (scalingCenter, scalingRotation, scaling, rotationCenter, rotation, trans)
+	cursorTrans = SpriteTransform(D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(1, 1), D3DXVECTOR2(0, 0), 0, D3DXVECTOR2(currentXpos, currentYpos));
+	cursorTrans.transform();
+	sprite->SetTransform(&cursorTrans.getMat());
+	sprite->Draw(cursorTexture.getTexture(), NULL, NULL, NULL, D3DCOLOR_XRGB(255, 255, 255));
+
+	sprite->End();
+}
+
+//Menus are only drawn when the screen, its layout or the cursor changed, an idle menu just waits
+void menuRender(MenuScreen* screen) {
+	bool changed = screen != drawnMenuScreen || screen->getVersion() != drawnMenuVersion;
+	if (!changed && !menuRedrawPending.exchange(false) && currentXpos == drawnCursorX && currentYpos == drawnCursorY) {
+		staticMenuFrames++;
+		return;
+	}
+	staticMenuFrames = 0;
+	drawnCursorX = currentXpos;
+	drawnCursorY = currentYpos;
+
+	directStruct.d3dDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(red, green, blue), 1.0f, 0);
+
+	directStruct.d3dDevice->BeginScene();
+
+	menuSpriteRender(screen);
+
+	directStruct.d3dDevice->EndScene();
+
+	directStruct.d3dDevice->Present(NULL, NULL, NULL, NULL);
+	latencyTracker->framePresented();
+}
+
+void mainMenuRender() {
+	menuRender(mainMenuScreen);
+}
+
+void spaceshipSelectionMenuRender() {
+	slideMenuIn(spaceshipSelectionScreen);
+	menuRender(spaceshipSelectionScreen);
+}
+
+void crosshairSelectionMenuRender() {
+	slideMenuIn(crosshairSelectionScreen);
+	menuRender(crosshairSelectionScreen);
+}
+
+void gameOverMenuRender() {
+	slideMenuIn(gameOverScreen);
+	//the simulation thread is idle on this screen
+	gameOverScreen->setText(gameOverScoresText, frameArena->format("%s%d", strScoresPrefix.c_str(), scores));
+	gameOverScreen->setText(gameOverSurvivedText, frameArena->format("%s%d%s%d%s", strSurvived.c_str(), waveMin, strMin.c_str(), waveSec, strSec.c_str()));
+	menuRender(gameOverScreen);
+}
+
+//Each menu is a scene of the texture cache, a new one starts when the menu changes
+const char* textureSceneName(int menu) {
+	switch (menu) {
+	case MainMenu: return "main";
+	case GameMenu: return "game";
+	case GameOverMenu: return "gameOver";
+	case SpaceshipSelectionMenu: return "spaceshipSelection";
+	case CrosshairSelectionMenu: return "crosshairSelection";
+	}
+	return "unknown";
+}
+void updateTextureScene() {
+	int menu = currentMenu;
+	if (menu != textureScene) {
+		textureScene = menu;
+		textureCache->beginScene(textureSceneName(menu));
+	}
+}
+
+//No arguments plays alone.
+//  -local                                        two players on one keyboard, player two's input goes through a simulated network
+//  -udp localPort remoteAddress remotePort player  two machines (or two copies on localhost), player is 1 or 2
+//Any of them can be followed by -textureBudget MB.
+int main(int argc, char* argv[])  //int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nShowCmd)
+{
+	launchTime = chrono::steady_clock::now();
+	if (!createMenus()) {
+		return 1;
+	}
+	unsigned long long randomSeed = time(0);
+	if (argc >= 2 && string(argv[1]) == "-stress") {
+		stressMode = true;
+		if (argc >= 3) {
+			stressBudgetMs = (float)atof(argv[2]);
+		}
+		//every run gets the same asteroids so runs can be compared
+		randomSeed = 1;
+	}
+	if (argc >= 2 && string(argv[1]) == "-local") {
+		startTwoPlayer(LocalTwoPlayer, 0, 0, NULL, 0);
+	}
+	if (argc >= 6 && string(argv[1]) == "-udp") {
+		int localPort = atoi(argv[2]);
+		int remotePort = atoi(argv[4]);
+		if (!startTwoPlayer(NetworkTwoPlayer, atoi(argv[5]) == 2 ? 1 : 0, localPort, argv[3], remotePort)) {
+			return 1;
+		}
+		//both machines need the same asteroids without talking first
+		randomSeed = (unsigned long long)localPort + remotePort;
+	}
+	for (int i = 1; i + 1 < argc; i++) {
+		if (string(argv[i]) == "-textureBudget") {
+			textureBudgetBytes = (long long)(atof(argv[i + 1]) * 1048576);
+		}
+	}
+	SimulationCallbacks callbacks = { playGameSound };
+	simulationCallbacks = callbacks;
+	seedSimulation(randomSeed);
+
+	loadTuning();
+	//a network match keeps the values it started with, the other machine would not see the change
+	if (playMode != NetworkTwoPlayer && !stressMode && !tuningWatcher->init(tuningFileName)) {
+		cout << "Cannot watch " << tuningFileName << " for changes" << endl;
+	}
+
+	particleSystem->init(maxParticles);
+	asteroidSolver->reserve(asteroidSolverBodies, asteroidSolverContacts, asteroidSolverCells);
+
+	createWindow();
+
+	createDirectX();
+
+	TextureCallbacks textureCallbacks = { loadTextureFile, releaseTextureFile };
+	textureCache->init(textureCallbacks, textureBudgetBytes);
+
+	createSprite();
+
+	createDirectInput();
+
+	myAudioManager->InitializeAudio();
+
+	if (stressMode) {
+		//no splash and no menus, the window stays hidden and the device is only used to load the textures
+		loadTextures();
+		loadSounds();
+		jobSystem->init(0);
+		StressCallbacks stressCallbacks = { publishSnapshot };
+		runStressTest(stressCallbacks);
+		jobSystem->shutdown();
+		cleanupSprite();
+		cleanupDirectX();
+		cleanupWindow();
+		cleanupInput();
+		return 0;
+	}
+
+	textureLoader = thread(loadTextures);
+	soundLoader = thread(loadSounds);
+
+	bool windowOpen = showSplash();
+	menuReadyMs = millisecondsSinceLaunch();
+	releaseSplash();
+
+	myAudioManager->PlaySound1();
+
+	jobSystem->init(0);
+
+	simulationRunning = true;
+	simulationThread = thread(simulationLoop);
+
+	renderPacer->init(targetFrameRate, idleFrameRate);
+	frameArena->init(frameArenaCapacity);
+	if (!telemetry->init(telemetryFile, telemetryFlushMilliseconds)) {
+		cout << "Cannot write " << telemetryFile << endl;
+	}
+
+	while (windowOpen && windowIsRunning())
+	{
+		LatencyTracker::Clock::time_point frameStart = LatencyTracker::Clock::now();
+		updateTweens();
+		updateTextureScene();
+
+		if (currentMenu == MainMenu) {
+			getInput();
+			mainMenuUpdate();
+			latencyTracker->consumeInput(KeyboardInput | MouseInput);
+			Sound();
+			mainMenuRender();
+		}
+		if (currentMenu == SpaceshipSelectionMenu) {
+			getInput();
+			spaceshipSelectionMenuUpdate();
+			latencyTracker->consumeInput(KeyboardInput | MouseInput);
+			Sound();
+			spaceshipSelectionMenuRender();
+		}
+		if (currentMenu == CrosshairSelectionMenu) {
+			getInput();
+			crosshairSelectionMenuUpdate();
+			latencyTracker->consumeInput(KeyboardInput | MouseInput);
+			Sound();
+			crosshairSelectionMenuRender();
+		}
+		if (currentMenu == GameOverMenu) {
+			getInput();
+			gameOverMenuUpdate();
+			latencyTracker->consumeInput(KeyboardInput | MouseInput);
+			Sound();
+			gameOverMenuRender();
+		}
+		if (currentMenu == GameMenu) {
+			//Simulation runs on simulationThread
+			Sound();
+			render();
+			staticMenuFrames = 0;
+		}
+
+		telemetry->recordFrame(chrono::duration_cast<chrono::microseconds>(LatencyTracker::Clock::now() - frameStart).count());
+		frameArena->reset();
+		textureCache->endFrame();
+
+		renderPacer->setIdle(GetForegroundWindow() != wndStruct.g_hWnd || staticMenuFrames > menuIdleFrames);
+		renderPacer->waitForNextFrame();
+	}
+
+	simulationRunning = false;
+	simulationThread.join();
+	jobSystem->shutdown();
+	telemetry->shutdown();
+
+	cout << "Startup: first frame " << firstFrameMs << "ms, textures loaded " << texturesLoadedMs << "ms, sounds loaded " << soundsLoadedMs << "ms, menu ready " << menuReadyMs << "ms" << endl;
+	cout << "Frame jitter p50 " << renderPacer->getJitter().percentile(50) << "ms p99 " << renderPacer->getJitter().percentile(99) << "ms max " << renderPacer->getMaxJitter()
+		<< "ms, tick jitter p99 " << simulationPacer->getJitter().percentile(99) << "ms max " << simulationPacer->getMaxJitter()
+		<< "ms, CPU " << renderPacer->getAverageCpuUtilisation() << "% of one core" << endl;
+	cout << "Frame time p50 " << telemetry->getFrameTime().percentile(50) << "ms p99 " << telemetry->getFrameTime().percentile(99) << "ms, tick time p50 " << telemetry->getTickTime().percentile(50)
+		<< "ms p99 " << telemetry->getTickTime().percentile(99) << "ms max " << telemetry->getTickTime().getMax() << "ms, " << telemetry->getWrittenRows() << " rows written to " << telemetryFile
+		<< ", " << telemetry->getDroppedRows() << " dropped" << endl;
+	cout << "Frame arena high water " << frameArena->getHighWaterMark() << " of " << frameArena->getCapacity() << " bytes, overflowed " << frameArena->getOverflowCount() << " times" << endl;
+	cout << "Snapshot age p50 " << snapshotAge.percentile(50) << "ms p99 " << snapshotAge.percentile(99) << "ms, dropped " << droppedSnapshots << ", duplicated " << duplicatedSnapshots << endl;
+	if (playMode != SinglePlayer) {
+		cout << "Rollbacks " << rollbackSession.getRollbackCount() << ", resimulated ticks " << rollbackSession.getResimulatedTicks()
+			<< ", resimulation p50 " << rollbackSession.getResimulationTime().percentile(50) << "ms p99 " << rollbackSession.getResimulationTime().percentile(99) << "ms" << endl;
+	}
+	if (latencyTracker->exportToFile("latency.csv")) {
+		cout << "Input latency exported to latency.csv" << endl;
+	}
+	cout << "Textures " << textureCache->getResidentBytes() << " of " << textureCache->getBudget() << " bytes resident, loaded " << textureCache->getLoadCount()
+		<< " times, evicted " << textureCache->getEvictionCount() << " times" << endl;
+	if (textureCache->writeReport(textureReportFile)) {
+		cout << "Texture residency per scene written to " << textureReportFile << endl;
+	}
+
+	cleanupSprite();
+
+	cleanupDirectX();
+
+	cleanupWindow();
+
+	cleanupInput();
+
+	return 0;
+}
@@ -0,0 +1,586 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLOCK_SSE2
+#endif
+
+void Image::resize(int width, int height)
+{
+	this->width = width;
+	this->height = height;
+	pixels.assign(width * height * 4, 0);
+}
+
+bool Image::isOpaque() const
+{
+	for (size_t i = 3; i < pixels.size(); i += 4) {
+		if (pixels[i] != 255) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static int nextPowerOfTwo(int value)
+{
+	int power = 1;
+	while (power < value) {
+		power *= 2;
+	}
+	return power;
+}
+
+//Sums texels weighted by their alpha so the colour of invisible texels is ignored
+struct TexelSum {
+	float weight = 0;
+	float alphaWeight = 0;
+	float color[3] = {};
+	float plainColor[3] = {}; //for when every texel is invisible
+	float alpha = 0;
+
+	void add(const unsigned char* texel, float texelWeight) {
+		float visible = texelWeight * texel[3];
+		for (int c = 0; c < 3; c++) {
+			color[c] += visible * texel[c];
+			plainColor[c] += texelWeight * texel[c];
+		}
+		alpha += visible;
+		alphaWeight += visible;
+		weight += texelWeight;
+	}
+	void store(unsigned char* texel) {
+		for (int c = 0; c < 3; c++) {
+			float value = alphaWeight > 0 ? color[c] / alphaWeight : plainColor[c] / weight;
+			texel[c] = (unsigned char)std::min(255.0f, value + 0.5f);
+		}
+		texel[3] = (unsigned char)std::min(255.0f, alpha / weight + 0.5f);
+	}
+};
+
+Image resizeToPowerOfTwo(const Image& source)
+{
+	Image result;
+	result.resize(nextPowerOfTwo(source.width), nextPowerOfTwo(source.height));
+	if (result.width == source.width && result.height == source.height) {
+		result.pixels = source.pixels;
+		return result;
+	}
+	//Bilinear, texel centres line up with the source ones
+	float stepX = (float)source.width / result.width;
+	float stepY = (float)source.height / result.height;
+	for (int y = 0; y < result.height; y++) {
+		float sourceY = std::min(std::max((y + 0.5f) * stepY - 0.5f, 0.0f), (float)(source.height - 1));
+		int y0 = (int)sourceY;
+		int y1 = std::min(y0 + 1, source.height - 1);
+		float fractionY = sourceY - y0;
+		for (int x = 0; x < result.width; x++) {
+			float sourceX = std::min(std::max((x + 0.5f) * stepX - 0.5f, 0.0f), (float)(source.width - 1));
+			int x0 = (int)sourceX;
+			int x1 = std::min(x0 + 1, source.width - 1);
+			float fractionX = sourceX - x0;
+			TexelSum sum;
+			sum.add(source.pixel(x0, y0), (1 - fractionX) * (1 - fractionY));
+			sum.add(source.pixel(x1, y0), fractionX * (1 - fractionY));
+			sum.add(source.pixel(x0, y1), (1 - fractionX) * fractionY);
+			sum.add(source.pixel(x1, y1), fractionX * fractionY);
+			sum.store(result.pixel(x, y));
+		}
+	}
+	return result;
+}
+
+Image nextMip(const Image& source)
+{
+	Image result;
+	result.resize(std::max(1, source.width / 2), std::max(1, source.height / 2));
+	int spanX = source.width > 1 ? 2 : 1;
+	int spanY = source.height > 1 ? 2 : 1;
+	for (int y = 0; y < result.height; y++) {
+		for (int x = 0; x < result.width; x++) {
+			TexelSum sum;
+			for (int dy = 0; dy < spanY; dy++) {
+				for (int dx = 0; dx < spanX; dx++) {
+					sum.add(source.pixel(x * spanX + dx, y * spanY + dy), 1);
+				}
+			}
+			sum.store(result.pixel(x, y));
+		}
+	}
+	return result;
+}
+
+int blockBytes(BlockFormat format)
+{
+	return format == BC1Format ? 8 : 16;
+}
+
+int levelBytes(BlockFormat format, int width, int height)
+{
+	return std::max(1, (width + 3) / 4) * std::max(1, (height + 3) / 4) * blockBytes(format);
+}
+
+//Colour Endpoints
+
+static int to565(const float* color)
+{
+	int r = (int)(std::min(std::max(color[0], 0.0f), 255.0f) * 31 / 255 + 0.5f);
+	int g = (int)(std::min(std::max(color[1], 0.0f), 255.0f) * 63 / 255 + 0.5f);
+	int b = (int)(std::min(std::max(color[2], 0.0f), 255.0f) * 31 / 255 + 0.5f);
+	return (r << 11) | (g << 5) | b;
+}
+
+static void from565(int packed, int* color)
+{
+	int r = (packed >> 11) & 31;
+	int g = (packed >> 5) & 63;
+	int b = packed & 31;
+	color[0] = (r << 3) | (r >> 2);
+	color[1] = (g << 2) | (g >> 4);
+	color[2] = (b << 3) | (b >> 2);
+}
+
+//The four colours a block can pick from when endpoint0 > endpoint1 (and always in BC3)
+static void fourColorPalette(int endpoint0, int endpoint1, int palette[4][3])
+{
+	from565(endpoint0, palette[0]);
+	from565(endpoint1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+}
+
+//Texels of one block as planes of floats. In BC3 each texel counts as much as it can be seen (its alpha),
+//so the colour of faint edge texels does not pull the endpoints away from the solid ones
+struct ColorBlock {
+	alignas(16) float r[16];
+	alignas(16) float g[16];
+	alignas(16) float b[16];
+	alignas(16) float weight[16];
+};
+
+static void loadColorBlock(const unsigned char* texels, bool weightByAlpha, ColorBlock& block)
+{
+#ifdef BLOCK_SSE2
+	__m128i byteMask = _mm_set1_epi32(0xff);
+	for (int i = 0; i < 16; i += 4) {
+		__m128i packed = _mm_loadu_si128((const __m128i*)(texels + i * 4));
+		_mm_store_ps(block.r + i, _mm_cvtepi32_ps(_mm_and_si128(packed, byteMask)));
+		_mm_store_ps(block.g + i, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 8), byteMask)));
+		_mm_store_ps(block.b + i, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 16), byteMask)));
+		__m128 alpha = _mm_cvtepi32_ps(_mm_srli_epi32(packed, 24));
+		__m128 weight = weightByAlpha ? _mm_mul_ps(alpha, _mm_set1_ps(1.0f / 255)) : _mm_set1_ps(1);
+		_mm_store_ps(block.weight + i, weight);
+	}
+#else
+	for (int i = 0; i < 16; i++) {
+		block.r[i] = texels[i * 4];
+		block.g[i] = texels[i * 4 + 1];
+		block.b[i] = texels[i * 4 + 2];
+		block.weight[i] = weightByAlpha ? texels[i * 4 + 3] / 255.0f : 1.0f;
+	}
+#endif
+}
+
+//Picks the nearest palette colour for every texel, returns the weighted squared error
+static float chooseColorIndices(const ColorBlock& block, int endpoint0, int endpoint1, int* indices)
+{
+	int palette[4][3];
+	fourColorPalette(endpoint0, endpoint1, palette);
+#ifdef BLOCK_SSE2
+	__m128 total = _mm_setzero_ps();
+	for (int i = 0; i < 16; i += 4) {
+		__m128 r = _mm_load_ps(block.r + i);
+		__m128 g = _mm_load_ps(block.g + i);
+		__m128 b = _mm_load_ps(block.b + i);
+		__m128 best = _mm_set1_ps(1e30f);
+		__m128 bestIndex = _mm_setzero_ps();
+		for (int p = 0; p < 4; p++) {
+			__m128 dr = _mm_sub_ps(r, _mm_set1_ps((float)palette[p][0]));
+			__m128 dg = _mm_sub_ps(g, _mm_set1_ps((float)palette[p][1]));
+			__m128 db = _mm_sub_ps(b, _mm_set1_ps((float)palette[p][2]));
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+			__m128 closer = _mm_cmplt_ps(distance, best);
+			best = _mm_min_ps(distance, best);
+			bestIndex = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps((float)p)), _mm_andnot_ps(closer, bestIndex));
+		}
+		total = _mm_add_ps(total, _mm_mul_ps(best, _mm_load_ps(block.weight + i)));
+		_mm_storeu_si128((__m128i*)(indices + i), _mm_cvttps_epi32(bestIndex));
+	}
+	alignas(16) float lanes[4];
+	_mm_store_ps(lanes, total);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#else
+	float total = 0;
+	for (int i = 0; i < 16; i++) {
+		float best = 1e30f;
+		for (int p = 0; p < 4; p++) {
+			float dr = block.r[i] - palette[p][0];
+			float dg = block.g[i] - palette[p][1];
+			float db = block.b[i] - palette[p][2];
+			float distance = dr * dr + dg * dg + db * db;
+			if (distance < best) {
+				best = distance;
+				indices[i] = p;
+			}
+		}
+		total += best * block.weight[i];
+	}
+	return total;
+#endif
+}
+
+//Endpoints along the principal axis of the texels, then refined by least squares on the chosen indices
+static void encodeColor(const unsigned char* texels, bool weightByAlpha, unsigned char* output)
+{
+	ColorBlock block;
+	loadColorBlock(texels, weightByAlpha, block);
+
+	float count = 0;
+	float heaviest = 0;
+	float mean[3] = {};
+	for (int i = 0; i < 16; i++) {
+		count += block.weight[i];
+		heaviest = std::max(heaviest, block.weight[i]);
+		mean[0] += block.weight[i] * block.r[i];
+		mean[1] += block.weight[i] * block.g[i];
+		mean[2] += block.weight[i] * block.b[i];
+	}
+	int endpoint0 = 0;
+	int endpoint1 = 0;
+	int indices[16] = {};
+	if (count > 0) {
+		for (int c = 0; c < 3; c++) {
+			mean[c] /= count;
+		}
+		//covariance: rr, rg, rb, gg, gb, bb
+		float covariance[6] = {};
+		for (int i = 0; i < 16; i++) {
+			float r = block.r[i] - mean[0];
+			float g = block.g[i] - mean[1];
+			float b = block.b[i] - mean[2];
+			float weight = block.weight[i];
+			covariance[0] += weight * r * r;
+			covariance[1] += weight * r * g;
+			covariance[2] += weight * r * b;
+			covariance[3] += weight * g * g;
+			covariance[4] += weight * g * b;
+			covariance[5] += weight * b * b;
+		}
+		float axis[3] = { 1, 1, 1 };
+		for (int iteration = 0; iteration < 8; iteration++) {
+			float next[3] = {
+				covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+				covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+				covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+			};
+			float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+			if (length < 1e-6f) {
+				break;
+			}
+			for (int c = 0; c < 3; c++) {
+				axis[c] = next[c] / length;
+			}
+		}
+		//the extremes come from the texels at least half as visible as the most visible one
+		float lowest = 0;
+		float highest = 0;
+		for (int i = 0; i < 16; i++) {
+			if (block.weight[i] < heaviest / 2) {
+				continue;
+			}
+			float t = (block.r[i] - mean[0]) * axis[0] + (block.g[i] - mean[1]) * axis[1] + (block.b[i] - mean[2]) * axis[2];
+			lowest = std::min(lowest, t);
+			highest = std::max(highest, t);
+		}
+		float color0[3], color1[3];
+		for (int c = 0; c < 3; c++) {
+			color0[c] = mean[c] + axis[c] * highest;
+			color1[c] = mean[c] + axis[c] * lowest;
+		}
+		endpoint0 = to565(color0);
+		endpoint1 = to565(color1);
+		float error = chooseColorIndices(block, endpoint0, endpoint1, indices);
+
+		//Index weights of endpoint0: 1, 0, 2/3, 1/3
+		static const float indexWeight[4] = { 1.0f, 0.0f, 2.0f / 3, 1.0f / 3 };
+		for (int iteration = 0; iteration < 2; iteration++) {
+			float aa = 0, ab = 0, bb = 0;
+			float sum0[3] = {}, sum1[3] = {};
+			for (int i = 0; i < 16; i++) {
+				float a = indexWeight[indices[i]];
+				float b = 1 - a;
+				float weight = block.weight[i];
+				aa += weight * a * a;
+				ab += weight * a * b;
+				bb += weight * b * b;
+				float texel[3] = { block.r[i], block.g[i], block.b[i] };
+				for (int c = 0; c < 3; c++) {
+					sum0[c] += weight * a * texel[c];
+					sum1[c] += weight * b * texel[c];
+				}
+			}
+			float determinant = aa * bb - ab * ab;
+			if (std::fabs(determinant) < 1e-6f) {
+				break;
+			}
+			for (int c = 0; c < 3; c++) {
+				color0[c] = (bb * sum0[c] - ab * sum1[c]) / determinant;
+				color1[c] = (aa * sum1[c] - ab * sum0[c]) / determinant;
+			}
+			int refined0 = to565(color0);
+			int refined1 = to565(color1);
+			int refinedIndices[16];
+			float refinedError = chooseColorIndices(block, refined0, refined1, refinedIndices);
+			if (refinedError >= error) {
+				break;
+			}
+			error = refinedError;
+			endpoint0 = refined0;
+			endpoint1 = refined1;
+			memcpy(indices, refinedIndices, sizeof(indices));
+		}
+	}
+
+	//Four colour mode needs endpoint0 > endpoint1, swapping the endpoints swaps indices 0/1 and 2/3
+	if (endpoint0 < endpoint1) {
+		std::swap(endpoint0, endpoint1);
+		for (int i = 0; i < 16; i++) {
+			indices[i] ^= 1;
+		}
+	}
+	if (endpoint0 == endpoint1) {
+		memset(indices, 0, sizeof(indices));
+	}
+	unsigned int packedIndices = 0;
+	for (int i = 0; i < 16; i++) {
+		packedIndices |= (unsigned int)indices[i] << (i * 2);
+	}
+	output[0] = endpoint0 & 0xff;
+	output[1] = endpoint0 >> 8;
+	output[2] = endpoint1 & 0xff;
+	output[3] = endpoint1 >> 8;
+	for (int i = 0; i < 4; i++) {
+		output[4 + i] = (packedIndices >> (i * 8)) & 0xff;
+	}
+}
+
+static void decodeColor(const unsigned char* block, bool alwaysFourColors, unsigned char* texels)
+{
+	int endpoint0 = block[0] | (block[1] << 8);
+	int endpoint1 = block[2] | (block[3] << 8);
+	int palette[4][3];
+	bool transparentBlack = false;
+	fourColorPalette(endpoint0, endpoint1, palette);
+	if (endpoint0 <= endpoint1 && !alwaysFourColors) {
+		for (int c = 0; c < 3; c++) {
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+		transparentBlack = true;
+	}
+	unsigned int packedIndices = block[4] | (block[5] << 8) | (block[6] << 16) | ((unsigned int)block[7] << 24);
+	for (int i = 0; i < 16; i++) {
+		int index = (packedIndices >> (i * 2)) & 3;
+		for (int c = 0; c < 3; c++) {
+			texels[i * 4 + c] = (unsigned char)palette[index][c];
+		}
+		texels[i * 4 + 3] = transparentBlack && index == 3 ? 0 : 255;
+	}
+}
+
+//Alpha
+
+static void alphaPalette(int alpha0, int alpha1, int* palette)
+{
+	palette[0] = alpha0;
+	palette[1] = alpha1;
+	if (alpha0 > alpha1) {
+		for (int i = 2; i < 8; i++) {
+			palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+		}
+	}
+	else {
+		for (int i = 2; i < 6; i++) {
+			palette[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+static int chooseAlphaIndices(const unsigned char* texels, int alpha0, int alpha1, int* indices)
+{
+	int palette[8];
+	alphaPalette(alpha0, alpha1, palette);
+	int total = 0;
+	for (int i = 0; i < 16; i++) {
+		int alpha = texels[i * 4 + 3];
+		int best = 256 * 256;
+		for (int p = 0; p < 8; p++) {
+			int distance = (alpha - palette[p]) * (alpha - palette[p]);
+			if (distance < best) {
+				best = distance;
+				indices[i] = p;
+			}
+		}
+		total += best;
+	}
+	return total;
+}
+
+//Tries the eight value ramp between the extremes and the six value ramp with exact 0 and 255, keeps the closer.
+//Sprite edges are mostly 0 and 255 with a few blended texels, which the six value ramp fits best
+static void encodeAlpha(const unsigned char* texels, unsigned char* output)
+{
+	int lowest = 255, highest = 0;
+	int innerLowest = 255, innerHighest = 0;
+	for (int i = 0; i < 16; i++) {
+		int alpha = texels[i * 4 + 3];
+		lowest = std::min(lowest, alpha);
+		highest = std::max(highest, alpha);
+		if (alpha != 0 && alpha != 255) {
+			innerLowest = std::min(innerLowest, alpha);
+			innerHighest = std::max(innerHighest, alpha);
+		}
+	}
+	if (innerLowest > innerHighest) {
+		innerLowest = innerHighest = 0;
+	}
+	int indices[16], sixIndices[16];
+	int alpha0 = highest, alpha1 = lowest;
+	int error = chooseAlphaIndices(texels, alpha0, alpha1, indices);
+	int sixError = chooseAlphaIndices(texels, innerLowest, innerHighest, sixIndices);
+	if (sixError < error) {
+		alpha0 = innerLowest;
+		alpha1 = innerHighest;
+		memcpy(indices, sixIndices, sizeof(indices));
+	}
+	output[0] = (unsigned char)alpha0;
+	output[1] = (unsigned char)alpha1;
+	unsigned long long packedIndices = 0;
+	for (int i = 0; i < 16; i++) {
+		packedIndices |= (unsigned long long)indices[i] << (i * 3);
+	}
+	for (int i = 0; i < 6; i++) {
+		output[2 + i] = (packedIndices >> (i * 8)) & 0xff;
+	}
+}
+
+static void decodeAlpha(const unsigned char* block, unsigned char* texels)
+{
+	int palette[8];
+	alphaPalette(block[0], block[1], palette);
+	unsigned long long packedIndices = 0;
+	for (int i = 0; i < 6; i++) {
+		packedIndices |= (unsigned long long)block[2 + i] << (i * 8);
+	}
+	for (int i = 0; i < 16; i++) {
+		texels[i * 4 + 3] = (unsigned char)palette[(packedIndices >> (i * 3)) & 7];
+	}
+}
+
+//Blocks
+
+void encodeBC1Block(const unsigned char* texels, unsigned char* block)
+{
+	encodeColor(texels, false, block);
+}
+
+void encodeBC3Block(const unsigned char* texels, unsigned char* block)
+{
+	encodeAlpha(texels, block);
+	encodeColor(texels, true, block + 8);
+}
+
+void decodeBC1Block(const unsigned char* block, unsigned char* texels)
+{
+	decodeColor(block, false, texels);
+}
+
+void decodeBC3Block(const unsigned char* block, unsigned char* texels)
+{
+	decodeColor(block + 8, true, texels);
+	decodeAlpha(block, texels);
+}
+
+void compressLevel(const Image& image, BlockFormat format, unsigned char* blocks)
+{
+	int blocksWide = std::max(1, (image.width + 3) / 4);
+	int blocksHigh = std::max(1, (image.height + 3) / 4);
+	unsigned char texels[16 * 4];
+	for (int blockY = 0; blockY < blocksHigh; blockY++) {
+		for (int blockX = 0; blockX < blocksWide; blockX++) {
+			for (int y = 0; y < 4; y++) {
+				for (int x = 0; x < 4; x++) {
+					const unsigned char* texel = image.pixel(std::min(blockX * 4 + x, image.width - 1), std::min(blockY * 4 + y, image.height - 1));
+					memcpy(texels + (y * 4 + x) * 4, texel, 4);
+				}
+			}
+			unsigned char* block = blocks + (blockY * blocksWide + blockX) * blockBytes(format);
+			if (format == BC1Format) {
+				encodeBC1Block(texels, block);
+			}
+			else {
+				encodeBC3Block(texels, block);
+			}
+		}
+	}
+}
+
+Image decompressLevel(const unsigned char* blocks, BlockFormat format, int width, int height)
+{
+	Image image;
+	image.resize(width, height);
+	int blocksWide = std::max(1, (width + 3) / 4);
+	int blocksHigh = std::max(1, (height + 3) / 4);
+	unsigned char texels[16 * 4];
+	for (int blockY = 0; blockY < blocksHigh; blockY++) {
+		for (int blockX = 0; blockX < blocksWide; blockX++) {
+			const unsigned char* block = blocks + (blockY * blocksWide + blockX) * blockBytes(format);
+			if (format == BC1Format) {
+				decodeBC1Block(block, texels);
+			}
+			else {
+				decodeBC3Block(block, texels);
+			}
+			for (int y = 0; y < 4 && blockY * 4 + y < height; y++) {
+				for (int x = 0; x < 4 && blockX * 4 + x < width; x++) {
+					memcpy(image.pixel(blockX * 4 + x, blockY * 4 + y), texels + (y * 4 + x) * 4, 4);
+				}
+			}
+		}
+	}
+	return image;
+}
+
+static float psnr(double squaredError, double samples)
+{
+	if (samples == 0 || squaredError == 0) {
+		return 99;
+	}
+	return (float)(10 * std::log10(255.0 * 255.0 / (squaredError / samples)));
+}
+
+ImageError compareImages(const Image& original, const Image& compressed)
+{
+	double colorError = 0, alphaError = 0;
+	double colorSamples = 0;
+	for (size_t i = 0; i < original.pixels.size(); i += 4) {
+		double visible = original.pixels[i + 3] / 255.0;
+		for (int c = 0; c < 3; c++) {
+			double difference = (double)original.pixels[i + c] - compressed.pixels[i + c];
+			colorError += visible * difference * difference;
+		}
+		colorSamples += visible * 3;
+		double difference = (double)original.pixels[i + 3] - compressed.pixels[i + 3];
+		alphaError += difference * difference;
+	}
+	ImageError error;
+	error.colorPsnr = psnr(colorError, colorSamples);
+	error.alphaPsnr = psnr(alphaError, (double)(original.pixels.size() / 4));
+	return error;
+}
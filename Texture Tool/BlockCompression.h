@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+
+//Images and the block compression the texture tool writes. Nothing in here touches files or Direct3D.
+
+enum BlockFormat { BC1Format, BC3Format };
+
+//8 bit RGBA, rows top to bottom without padding
+struct Image {
+	int width = 0;
+	int height = 0;
+	std::vector<unsigned char> pixels;
+
+	void resize(int width, int height);
+	unsigned char* pixel(int x, int y) {
+		return &pixels[(y * width + x) * 4];
+	}
+	const unsigned char* pixel(int x, int y) const {
+		return &pixels[(y * width + x) * 4];
+	}
+	bool isOpaque() const;
+};
+
+//Scaled up to the next power of two in each direction, D3DX does the same to every texture it loads with
+//D3DX_DEFAULT sizes, so sprite sheet rects keep meaning the same texels. Colour is filtered weighted by alpha
+//so transparent texels do not bleed dark edges into the sprite.
+Image resizeToPowerOfTwo(const Image& source);
+//Half the size (a side that is already 1 stays 1), each texel the alpha weighted average of the ones it covers
+Image nextMip(const Image& source);
+
+int blockBytes(BlockFormat format);
+int levelBytes(BlockFormat format, int width, int height);
+
+//A 4x4 block is 16 RGBA texels in rows, edge blocks of small levels repeat the last row and column
+void encodeBC1Block(const unsigned char* texels, unsigned char* block);
+void encodeBC3Block(const unsigned char* texels, unsigned char* block);
+void decodeBC1Block(const unsigned char* block, unsigned char* texels);
+void decodeBC3Block(const unsigned char* block, unsigned char* texels);
+
+//Whole mip levels, blocks left to right and top to bottom as DDS stores them
+void compressLevel(const Image& image, BlockFormat format, unsigned char* blocks);
+Image decompressLevel(const unsigned char* blocks, BlockFormat format, int width, int height);
+
+//Peak signal to noise ratio in dB of colour and of alpha. Colour errors count as much as the texel can be seen
+//(its alpha), an invisible texel may be any colour. Identical channels report 99
+struct ImageError {
+	float colorPsnr;
+	float alphaPsnr;
+};
+ImageError compareImages(const Image& original, const Image& compressed);
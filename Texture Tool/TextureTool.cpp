@@ -0,0 +1,275 @@
+//Texture Tool
+//Turns the game's images into DDS files with a full mip chain, BC1 for opaque images and BC3 for the rest, and reports
+//how close each one stays to the original. The game loads Assets/name.dds instead of Assets/name.png when it exists.
+//
+//Build (Linux, needs libpng and libjpeg): the TextureTool target of the CMake build at the top of the repo, or
+//  g++ -std=c++14 -O2 -pthread -I"../Spaceship Game" TextureTool.cpp BlockCompression.cpp "../Spaceship Game/JobSystem.cpp" -lpng -ljpeg -o TextureTool
+//Usage:
+//  TextureTool [-j threads] [-o outputDirectory] images...
+//Images are converted in parallel, one job each. Without -o every DDS is written next to its image.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <jpeglib.h>
+#include <png.h>
+#include "BlockCompression.h"
+#include "JobSystem.h"
+
+using namespace std;
+
+//Image Loading
+
+bool loadPng(const string& fileName, Image& image, string& error) {
+	png_image png;
+	memset(&png, 0, sizeof(png));
+	png.version = PNG_IMAGE_VERSION;
+	if (!png_image_begin_read_from_file(&png, fileName.c_str())) {
+		error = png.message;
+		return false;
+	}
+	png.format = PNG_FORMAT_RGBA;
+	image.resize(png.width, png.height);
+	if (!png_image_finish_read(&png, NULL, image.pixels.data(), 0, NULL)) {
+		error = png.message;
+		png_image_free(&png);
+		return false;
+	}
+	return true;
+}
+
+bool loadJpeg(const string& fileName, Image& image, string& error) {
+	FILE* file = fopen(fileName.c_str(), "rb");
+	if (file == NULL) {
+		error = "cannot be opened";
+		return false;
+	}
+	jpeg_decompress_struct jpeg;
+	jpeg_error_mgr errorManager;
+	jpeg.err = jpeg_std_error(&errorManager);
+	jpeg_create_decompress(&jpeg);
+	jpeg_stdio_src(&jpeg, file);
+	jpeg_read_header(&jpeg, TRUE);
+	jpeg.out_color_space = JCS_RGB;
+	jpeg_start_decompress(&jpeg);
+	image.resize(jpeg.output_width, jpeg.output_height);
+	vector<unsigned char> row(jpeg.output_width * 3);
+	while (jpeg.output_scanline < jpeg.output_height) {
+		int y = jpeg.output_scanline;
+		JSAMPROW rows[1] = { row.data() };
+		jpeg_read_scanlines(&jpeg, rows, 1);
+		for (int x = 0; x < image.width; x++) {
+			unsigned char* pixel = image.pixel(x, y);
+			pixel[0] = row[x * 3];
+			pixel[1] = row[x * 3 + 1];
+			pixel[2] = row[x * 3 + 2];
+			pixel[3] = 255;
+		}
+	}
+	jpeg_finish_decompress(&jpeg);
+	jpeg_destroy_decompress(&jpeg);
+	fclose(file);
+	return true;
+}
+
+bool hasExtension(const string& fileName, const char* extension) {
+	size_t length = strlen(extension);
+	if (fileName.size() < length) {
+		return false;
+	}
+	for (size_t i = 0; i < length; i++) {
+		if (tolower(fileName[fileName.size() - length + i]) != extension[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool loadImage(const string& fileName, Image& image, string& error) {
+	if (hasExtension(fileName, ".png")) {
+		return loadPng(fileName, image, error);
+	}
+	if (hasExtension(fileName, ".jpg") || hasExtension(fileName, ".jpeg")) {
+		return loadJpeg(fileName, image, error);
+	}
+	error = "is not a png or jpeg";
+	return false;
+}
+
+//DDS Writing
+
+void writeUint32(vector<unsigned char>& data, uint32_t value) {
+	for (int i = 0; i < 4; i++) {
+		data.push_back((value >> (i * 8)) & 0xff);
+	}
+}
+
+//Header of a block compressed 2D texture with mips, all the levels follow it largest first
+void writeDdsHeader(vector<unsigned char>& data, BlockFormat format, int width, int height, int levels) {
+	const uint32_t capsFlag = 0x1, heightFlag = 0x2, widthFlag = 0x4, pixelFormatFlag = 0x1000, mipCountFlag = 0x20000, linearSizeFlag = 0x80000;
+	const uint32_t fourCCFlag = 0x4;
+	const uint32_t complexCaps = 0x8, textureCaps = 0x1000, mipmapCaps = 0x400000;
+	data.insert(data.end(), { 'D', 'D', 'S', ' ' });
+	writeUint32(data, 124);
+	writeUint32(data, capsFlag | heightFlag | widthFlag | pixelFormatFlag | mipCountFlag | linearSizeFlag);
+	writeUint32(data, height);
+	writeUint32(data, width);
+	writeUint32(data, levelBytes(format, width, height));
+	writeUint32(data, 0); //depth
+	writeUint32(data, levels);
+	for (int i = 0; i < 11; i++) {
+		writeUint32(data, 0);
+	}
+	//pixel format
+	writeUint32(data, 32);
+	writeUint32(data, fourCCFlag);
+	data.insert(data.end(), { 'D', 'X', 'T', (unsigned char)(format == BC1Format ? '1' : '5') });
+	for (int i = 0; i < 5; i++) {
+		writeUint32(data, 0);
+	}
+	writeUint32(data, textureCaps | complexCaps | mipmapCaps);
+	for (int i = 0; i < 4; i++) {
+		writeUint32(data, 0);
+	}
+}
+
+//Textures
+
+struct TextureJob {
+	string source;
+	string output;
+	bool converted = false;
+	string error;
+	int sourceWidth = 0;
+	int sourceHeight = 0;
+	int width = 0;
+	int height = 0;
+	int levels = 0;
+	BlockFormat format = BC1Format;
+	long long uncompressedBytes = 0; //what D3DX makes of the image: A8R8G8B8 with the same mips
+	long long compressedBytes = 0;
+	ImageError quality = {};
+	double milliseconds = 0;
+};
+
+string outputFileName(const string& source, const string& outputDirectory) {
+	string name = source.substr(0, source.find_last_of('.')) + ".dds";
+	if (outputDirectory.empty()) {
+		return name;
+	}
+	size_t slash = name.find_last_of("/\\");
+	return outputDirectory + "/" + (slash == string::npos ? name : name.substr(slash + 1));
+}
+
+void convertTexture(TextureJob& job) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Image source;
+	if (!loadImage(job.source, source, job.error)) {
+		return;
+	}
+	job.sourceWidth = source.width;
+	job.sourceHeight = source.height;
+	Image level = resizeToPowerOfTwo(source);
+	job.width = level.width;
+	job.height = level.height;
+	job.format = level.isOpaque() ? BC1Format : BC3Format;
+
+	vector<unsigned char> data;
+	while (true) {
+		if (job.levels == 0) {
+			writeDdsHeader(data, job.format, level.width, level.height, 1);
+		}
+		size_t offset = data.size();
+		data.resize(offset + levelBytes(job.format, level.width, level.height));
+		compressLevel(level, job.format, &data[offset]);
+		if (job.levels == 0) {
+			job.quality = compareImages(level, decompressLevel(&data[offset], job.format, level.width, level.height));
+		}
+		job.uncompressedBytes += (long long)level.width * level.height * 4;
+		job.levels++;
+		if (level.width == 1 && level.height == 1) {
+			break;
+		}
+		level = nextMip(level);
+	}
+	//mip count sits 28 bytes into the file, after the magic and five header fields
+	for (int i = 0; i < 4; i++) {
+		data[28 + i] = (job.levels >> (i * 8)) & 0xff;
+	}
+	job.compressedBytes = data.size();
+
+	ofstream file(job.output.c_str(), ios::binary | ios::trunc);
+	if (!file.write((const char*)data.data(), data.size())) {
+		job.error = "cannot write " + job.output;
+		return;
+	}
+	job.converted = true;
+	job.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+	int threads = 0;
+	string outputDirectory;
+	vector<TextureJob> jobs;
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		if (argument == "-j" && i + 1 < argc) {
+			threads = atoi(argv[++i]);
+		}
+		else if (argument == "-o" && i + 1 < argc) {
+			outputDirectory = argv[++i];
+		}
+		else {
+			TextureJob job;
+			job.source = argument;
+			jobs.push_back(job);
+		}
+	}
+	if (jobs.empty()) {
+		cout << "Usage: TextureTool [-j threads] [-o outputDirectory] images..." << endl;
+		return 1;
+	}
+	for (TextureJob& job : jobs) {
+		job.output = outputFileName(job.source, outputDirectory);
+	}
+
+	JobSystem jobSystem;
+	jobSystem.init(threads);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	jobSystem.parallelFor(0, (int)jobs.size(), 1, [&jobs](int index) {
+		convertTexture(jobs[index]);
+	});
+	double totalMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	int threadCount = jobSystem.getWorkerCount() + 1; //the main thread helps while it waits
+	jobSystem.shutdown();
+
+	int failed = 0;
+	long long uncompressedTotal = 0, compressedTotal = 0;
+	printf("%-16s %-11s %-11s %-6s %5s %10s %10s %9s %9s %8s\n", "texture", "source", "texture", "format", "mips", "argb", "dds", "rgb dB", "alpha dB", "ms");
+	for (const TextureJob& job : jobs) {
+		if (!job.converted) {
+			printf("%-28s failed: %s\n", job.source.c_str(), job.error.c_str());
+			failed++;
+			continue;
+		}
+		size_t slash = job.source.find_last_of("/\\");
+		string name = slash == string::npos ? job.source : job.source.substr(slash + 1);
+		char sourceSize[32], textureSize[32];
+		snprintf(sourceSize, sizeof(sourceSize), "%dx%d", job.sourceWidth, job.sourceHeight);
+		snprintf(textureSize, sizeof(textureSize), "%dx%d", job.width, job.height);
+		printf("%-16s %-11s %-11s %-6s %5d %10lld %10lld %9.2f %9.2f %8.1f\n", name.c_str(), sourceSize, textureSize,
+			job.format == BC1Format ? "BC1" : "BC3", job.levels, job.uncompressedBytes, job.compressedBytes,
+			job.quality.colorPsnr, job.quality.alphaPsnr, job.milliseconds);
+		uncompressedTotal += job.uncompressedBytes;
+		compressedTotal += job.compressedBytes;
+	}
+	printf("%d textures, %lld bytes as A8R8G8B8, %lld bytes as DDS, %.1fms on %d threads\n", (int)jobs.size() - failed,
+		uncompressedTotal, compressedTotal, totalMilliseconds, threadCount);
+	return failed > 0 ? 1 : 0;
+}
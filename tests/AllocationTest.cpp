@@ -0,0 +1,115 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Check.h"
+#include "FrameArena.h"
+#include "MenuLayout.h"
+#include "RenderSnapshot.h"
+#include "Simulation.h"
+#include "StressTest.h"
+
+//Steady state allocations: once the pools have grown to the load, a tick of the headless driver (the simulation plus
+//the snapshot build the render thread draws from) and a changing HUD text must not touch the heap.
+//Every operator new of the program is counted.
+
+static std::atomic<long long> allocationCount{ 0 };
+
+void* operator new(std::size_t size)
+{
+	allocationCount++;
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == NULL) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	free(memory);
+}
+
+static Autopilot autopilot;
+static RenderSnapshot* snapshot = new RenderSnapshot();
+
+static void runTicks(int ticks)
+{
+	for (int i = 0; i < ticks; i++) {
+		PlayerInput inputs[maxPlayers] = { autopilot.next(screenWidth, screenHeight) };
+		//the ship never dies, so the load keeps up for the whole run
+		lives = 3;
+		advanceTick(inputs);
+		buildEntitySprites(*snapshot);
+	}
+}
+
+static void testSimulation()
+{
+	jobSystem->init(1);
+	seedSimulation(5);
+	particleSystem->init(maxParticles);
+	asteroidSolver->reserve(asteroidSolverBodies, asteroidSolverContacts, asteroidSolverCells);
+	resetSimulation();
+	//a few minutes of game time, every phase and power up has been through
+	runTicks(20000);
+	long long before = allocationCount;
+	runTicks(5000);
+	long long allocations = allocationCount - before;
+	printf("%lld allocations in 5000 steady state ticks (%d bullets, %d asteroids)\n", allocations, bulletQuery.count(), asteroidQuery.count());
+	CHECK(allocations == 0);
+	jobSystem->shutdown();
+}
+
+//The game over screen's texts change every game and the HUD is formatted every frame
+static void testMenuText()
+{
+	MenuLayout layout;
+	CHECK(layout.loadFromText("screen over\ntext scores text=\"Scores: \" x=100 y=100\nbutton retry size=200,50 action=retry\n"));
+	MenuScreen* screen = layout.getScreen("over");
+	CHECK(screen != NULL);
+	if (screen == NULL) {
+		return;
+	}
+	int scores = screen->findWidget("scores");
+	FrameArena arena;
+	arena.init(4096);
+	screen->getDrawList();
+	long long before = allocationCount;
+	for (int i = 0; i < 1000; i++) {
+		screen->setText(scores, arena.format("You survived %d min %d sec and scored %d", i / 60, i % 60, i * 37));
+		screen->getDrawList();
+		screen->hitTest(150, 25);
+		arena.reset();
+	}
+	long long allocations = allocationCount - before;
+	printf("%lld allocations for 1000 text changes\n", allocations);
+	CHECK(allocations == 0);
+	CHECK(screen->getWidget(scores).text == "You survived 16 min 39 sec and scored 36963");
+}
+
+int main()
+{
+	testSimulation();
+	testMenuText();
+	return finishTests("AllocationTest");
+}
@@ -0,0 +1,160 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "BlockCompression.h"
+#include "Check.h"
+
+//The texture tool's image steps: power of two resizing, alpha weighted mips and BC1/BC3 encoding, checked on images
+//made in the test so nothing depends on the asset files
+
+static Image solidImage(int width, int height, int r, int g, int b, int a)
+{
+	Image image;
+	image.resize(width, height);
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			unsigned char* texel = image.pixel(x, y);
+			texel[0] = (unsigned char)r;
+			texel[1] = (unsigned char)g;
+			texel[2] = (unsigned char)b;
+			texel[3] = (unsigned char)a;
+		}
+	}
+	return image;
+}
+
+//Smooth colour across the image, alpha ramps down to the right when withAlpha is set
+static Image gradientImage(int width, int height, bool withAlpha)
+{
+	Image image;
+	image.resize(width, height);
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			unsigned char* texel = image.pixel(x, y);
+			texel[0] = (unsigned char)(x * 255 / (width - 1));
+			texel[1] = (unsigned char)(y * 255 / (height - 1));
+			texel[2] = (unsigned char)(128 + 64 * sin(x * 0.1) * cos(y * 0.1));
+			texel[3] = withAlpha ? (unsigned char)(255 - x * 255 / (width - 1)) : 255;
+		}
+	}
+	return image;
+}
+
+static Image roundTrip(const Image& image, BlockFormat format)
+{
+	std::vector<unsigned char> blocks(levelBytes(format, image.width, image.height));
+	compressLevel(image, format, blocks.data());
+	return decompressLevel(blocks.data(), format, image.width, image.height);
+}
+
+static int largestDifference(const Image& a, const Image& b, int channel)
+{
+	int largest = 0;
+	for (size_t i = channel; i < a.pixels.size(); i += 4) {
+		largest = std::max(largest, abs(a.pixels[i] - b.pixels[i]));
+	}
+	return largest;
+}
+
+static void testSizes()
+{
+	CHECK(blockBytes(BC1Format) == 8);
+	CHECK(blockBytes(BC3Format) == 16);
+	CHECK(levelBytes(BC1Format, 1, 1) == 8);
+	CHECK(levelBytes(BC1Format, 256, 64) == 64 * 16 * 8);
+	CHECK(levelBytes(BC3Format, 5, 3) == 2 * 16);
+	Image resized = resizeToPowerOfTwo(solidImage(100, 30, 10, 20, 30, 255));
+	CHECK(resized.width == 128 && resized.height == 32);
+	CHECK(largestDifference(resized, solidImage(128, 32, 10, 20, 30, 255), 0) == 0);
+	Image exact = gradientImage(64, 16, true);
+	CHECK(resizeToPowerOfTwo(exact).pixels == exact.pixels);
+	//every level halves down to 1x1, a side already at 1 stays at 1
+	Image level = solidImage(8, 2, 0, 0, 0, 255);
+	int widths[] = { 4, 2, 1 };
+	int heights[] = { 1, 1, 1 };
+	for (int i = 0; i < 3; i++) {
+		level = nextMip(level);
+		CHECK(level.width == widths[i] && level.height == heights[i]);
+	}
+}
+
+//Transparent texels must not darken the visible ones next to them
+static void testAlphaWeighting()
+{
+	Image image = solidImage(4, 4, 0, 0, 0, 0);
+	for (int y = 0; y < 4; y++) {
+		for (int x = 0; x < 2; x++) {
+			unsigned char* texel = image.pixel(x, y);
+			texel[0] = 200;
+			texel[3] = 255;
+		}
+	}
+	Image mip = nextMip(image);
+	CHECK(mip.pixel(0, 0)[0] == 200 && mip.pixel(0, 0)[3] == 255);
+	CHECK(mip.pixel(1, 0)[3] == 0);
+	Image half = nextMip(mip);
+	CHECK(half.pixel(0, 0)[0] == 200);
+	CHECK(abs(half.pixel(0, 0)[3] - 128) <= 1);
+	Image wide = resizeToPowerOfTwo(solidImage(3, 1, 200, 0, 0, 255));
+	CHECK(wide.pixel(3, 0)[0] == 200);
+	CHECK(image.isOpaque() == false);
+	CHECK(solidImage(2, 2, 1, 2, 3, 255).isOpaque());
+}
+
+static void testSolidBlocks()
+{
+	int colors[][4] = { { 0, 0, 0, 255 }, { 255, 255, 255, 255 }, { 255, 0, 0, 255 }, { 12, 200, 99, 255 }, { 90, 90, 200, 77 } };
+	for (int i = 0; i < 5; i++) {
+		Image image = solidImage(4, 4, colors[i][0], colors[i][1], colors[i][2], colors[i][3]);
+		if (image.isOpaque()) {
+			Image decoded = roundTrip(image, BC1Format);
+			//565 keeps 5 or 6 bits of each channel
+			CHECK(largestDifference(image, decoded, 0) <= 4);
+			CHECK(largestDifference(image, decoded, 1) <= 2);
+			CHECK(largestDifference(image, decoded, 2) <= 4);
+			CHECK(largestDifference(image, decoded, 3) == 0);
+		}
+		Image decoded = roundTrip(image, BC3Format);
+		CHECK(largestDifference(image, decoded, 0) <= 4);
+		CHECK(largestDifference(image, decoded, 3) == 0);
+	}
+	//two colours a block can hold exactly
+	Image checker = solidImage(4, 4, 0, 0, 0, 255);
+	for (int y = 0; y < 4; y++) {
+		for (int x = (y & 1); x < 4; x += 2) {
+			unsigned char* texel = checker.pixel(x, y);
+			texel[0] = texel[1] = texel[2] = 255;
+		}
+	}
+	Image decoded = roundTrip(checker, BC1Format);
+	CHECK(decoded.pixels == checker.pixels);
+}
+
+static void testQuality()
+{
+	Image opaque = gradientImage(64, 64, false);
+	ImageError bc1 = compareImages(opaque, roundTrip(opaque, BC1Format));
+	Image blended = gradientImage(64, 64, true);
+	ImageError bc3 = compareImages(blended, roundTrip(blended, BC3Format));
+	printf("gradient BC1 %.2f dB, BC3 %.2f dB colour %.2f dB alpha\n", bc1.colorPsnr, bc3.colorPsnr, bc3.alphaPsnr);
+	CHECK(bc1.colorPsnr > 35);
+	CHECK(bc1.alphaPsnr == 99);
+	CHECK(bc3.colorPsnr > 35);
+	CHECK(bc3.alphaPsnr > 45);
+	ImageError same = compareImages(opaque, opaque);
+	CHECK(same.colorPsnr == 99 && same.alphaPsnr == 99);
+	//sizes that are not a multiple of the block keep their size and their colour
+	Image odd = solidImage(6, 5, 40, 80, 120, 255);
+	Image oddDecoded = roundTrip(odd, BC1Format);
+	CHECK(oddDecoded.width == 6 && oddDecoded.height == 5);
+	CHECK(largestDifference(odd, oddDecoded, 0) <= 4);
+}
+
+int main()
+{
+	testSizes();
+	testAlphaWeighting();
+	testSolidBlocks();
+	testQuality();
+	return finishTests("BlockCompressionTest");
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdio>
+
+//Minimal checks for the test programs, a failed check prints where it is and the program returns non zero
+static int checkFailures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			checkFailures++; \
+		} \
+	} while (0)
+
+inline int finishTests(const char* name)
+{
+	if (checkFailures > 0) {
+		printf("%s: %d check(s) failed\n", name, checkFailures);
+		return 1;
+	}
+	printf("%s: all checks passed\n", name);
+	return 0;
+}
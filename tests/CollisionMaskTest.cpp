@@ -0,0 +1,96 @@
+#include "Check.h"
+#include "MaskCorpus.h"
+#include "RandomStream.h"
+
+//CollisionMask: masks match the alpha they were built from, and the word-wise test agrees with a pixel by pixel
+//test on every pair of the corpus at every scale and rotation bucket the game uses
+
+static const float scales[] = { 1, 1.5f, 2 };
+static const int scaleCount = 3;
+static const int rotationBuckets = 16;
+
+static void testUnrotatedMaskIsAlpha(const MaskShape& shape)
+{
+	CollisionMask mask;
+	mask.build(shape.alpha.data(), shape.width, 0, 0, shape.width, shape.height, 1, 0, shape.width / 2.0f, shape.height / 2.0f, 128);
+	CHECK(mask.getOffsetX() == 0 && mask.getOffsetY() == 0);
+	CHECK(mask.getWidth() == shape.width && mask.getHeight() == shape.height);
+	bool same = true;
+	for (int y = 0; y < shape.height; y++) {
+		for (int x = 0; x < shape.width; x++) {
+			same = same && mask.getPixel(x, y) == (shape.alpha[y * shape.width + x] > 128);
+		}
+	}
+	CHECK(same);
+}
+
+//Random placements whose boxes overlap, so the fine test always runs
+static void testAgainstPixels(const std::vector<CollisionMaskSet>& sets, RandomStream& random, int placements)
+{
+	int hits = 0;
+	int disagreements = 0;
+	for (int i = 0; i < placements; i++) {
+		const CollisionMask& a = sets[random.range((uint32_t)sets.size())].get(random.range(scaleCount), random.nextFloat() * 6.2831853f);
+		const CollisionMask& b = sets[random.range((uint32_t)sets.size())].get(random.range(scaleCount), random.nextFloat() * 6.2831853f);
+		int bx = random.range(-b.getWidth() + 1, a.getWidth());
+		int by = random.range(-b.getHeight() + 1, a.getHeight());
+		bool overlaps = CollisionMask::overlaps(a, 0, 0, b, bx, by);
+		if (overlaps != overlapsByPixel(a, 0, 0, b, bx, by)) {
+			disagreements++;
+		}
+		hits += overlaps ? 1 : 0;
+	}
+	printf("%d placements, %d overlapping, %d disagreements\n", placements, hits, disagreements);
+	CHECK(disagreements == 0);
+	//the corpus has to exercise both answers
+	CHECK(hits > placements / 10 && hits < placements * 9 / 10);
+}
+
+//Two discs whose boxes overlap only at the corners do not touch, moved closer they do
+static void testDiscCorners(const MaskShape& disc)
+{
+	CollisionMask mask;
+	mask.build(disc.alpha.data(), disc.width, 0, 0, disc.width, disc.height, 1, 0, disc.width / 2.0f, disc.height / 2.0f, 128);
+	CHECK(!CollisionMask::overlaps(mask, 0, 0, mask, disc.width - 5, disc.height - 5));
+	CHECK(CollisionMask::overlaps(mask, 0, 0, mask, disc.width / 2, disc.height / 2));
+	CHECK(!CollisionMask::overlaps(mask, 0, 0, mask, disc.width, 0));
+}
+
+//Rotating by a quarter turn maps the mask onto itself turned, for the ship that moves the nose to the right
+static void testQuarterTurn(const MaskShape& ship)
+{
+	CollisionMask turned;
+	turned.build(ship.alpha.data(), ship.width, 0, 0, ship.width, ship.height, 1, 1.5707963f, ship.width / 2.0f, ship.height / 2.0f, 128);
+	CHECK(turned.getWidth() >= ship.height && turned.getHeight() >= ship.width);
+	int mismatches = 0;
+	for (int y = 0; y < ship.height; y++) {
+		for (int x = 0; x < ship.width; x++) {
+			//pixel (x, y) lands on (width - 1 - y, x) around the centre of a square image
+			bool source = ship.alpha[y * ship.width + x] > 128;
+			int turnedX = ship.width - 1 - y - turned.getOffsetX();
+			int turnedY = x - turned.getOffsetY();
+			mismatches += source != turned.getPixel(turnedX, turnedY) ? 1 : 0;
+		}
+	}
+	//pixel centres on the diagonal edges may round either way
+	CHECK(mismatches < ship.width * 2);
+}
+
+int main()
+{
+	std::vector<MaskShape> corpus = makeMaskCorpus();
+	std::vector<CollisionMaskSet> sets(corpus.size());
+	for (size_t i = 0; i < corpus.size(); i++) {
+		const MaskShape& shape = corpus[i];
+		testUnrotatedMaskIsAlpha(shape);
+		sets[i].build(shape.alpha.data(), shape.width, 0, 0, shape.width, shape.height, scales, scaleCount, rotationBuckets,
+			shape.width / 2.0f, shape.height / 2.0f, 128);
+		CHECK(!sets[i].isEmpty());
+	}
+	RandomStream random;
+	random.seed(33, 1);
+	testAgainstPixels(sets, random, 20000);
+	testDiscCorners(corpus[0]);
+	testQuarterTurn(corpus[2]);
+	return finishTests("CollisionMaskTest");
+}
@@ -0,0 +1,122 @@
+#include <vector>
+#include "Check.h"
+#include "Simulation.h"
+#include "StressTest.h"
+
+//The simulation is a function of the seed and the inputs: two runs give the same state tick for tick whatever the
+//number of worker threads, and replaying the inputs from a saved tick (a rollback) reaches the same state again.
+//Two player games and post mortems depend on it.
+
+typedef std::vector<unsigned char> Bytes;
+
+const int checkEvery = 100;
+
+static Bytes save()
+{
+	StateWriter writer;
+	saveGameState(writer);
+	return Bytes(writer.getData(), writer.getData() + writer.getSize());
+}
+
+//A fresh stage from seed, the job system with workers threads
+static void startRun(unsigned long long seed, int workers)
+{
+	jobSystem->shutdown();
+	jobSystem->init(workers);
+	seedSimulation(seed);
+	resetSimulation();
+	particleSystem->clear();
+}
+
+//Plays ticks with the autopilot, the state every checkEvery ticks goes into trace
+static void runTicks(Autopilot& autopilot, int ticks, std::vector<PlayerInput>* inputs, std::vector<Bytes>& trace)
+{
+	for (int i = 0; i < ticks; i++) {
+		PlayerInput input[maxPlayers] = { autopilot.next(screenWidth, screenHeight) };
+		if (inputs != NULL) {
+			inputs->push_back(input[0]);
+		}
+		//the autopilot does not try to survive
+		lives = 3;
+		advanceTick(input);
+		if (gameTick % checkEvery == 0) {
+			trace.push_back(save());
+		}
+	}
+}
+
+static std::vector<Bytes> run(unsigned long long seed, int workers, int ticks)
+{
+	startRun(seed, workers);
+	Autopilot autopilot;
+	std::vector<Bytes> trace;
+	runTicks(autopilot, ticks, NULL, trace);
+	return trace;
+}
+
+static void testRepeatable()
+{
+	std::vector<Bytes> first = run(7, 1, 3000);
+	std::vector<Bytes> second = run(7, 1, 3000);
+	std::vector<Bytes> threaded = run(7, 3, 3000);
+	CHECK(first.size() == 30);
+	int firstDifference = -1;
+	for (int i = 0; i < (int)first.size() && firstDifference < 0; i++) {
+		if (first[i] != second[i] || first[i] != threaded[i]) {
+			firstDifference = i;
+		}
+	}
+	if (firstDifference >= 0) {
+		printf("runs differ from tick %d\n", (firstDifference + 1) * checkEvery);
+	}
+	CHECK(firstDifference < 0);
+	printf("%d entities after 3000 ticks, %d bytes of state\n", bulletQuery.count() + asteroidQuery.count() + powerUpQuery.count(), (int)first.back().size());
+	//a different seed is a different game
+	std::vector<Bytes> other = run(8, 1, 3000);
+	CHECK(other.back() != first.back());
+	//Retry resets the stage without seeding it again and plays the same game
+	resetSimulation();
+	Autopilot autopilot;
+	std::vector<Bytes> retried;
+	runTicks(autopilot, 3000, NULL, retried);
+	CHECK(retried == other);
+}
+
+//Load an earlier tick and feed the same inputs again, as the rollback session does when a late input arrives
+static void testReplay()
+{
+	startRun(9, 2);
+	Autopilot autopilot;
+	std::vector<Bytes> trace;
+	runTicks(autopilot, 1000, NULL, trace);
+	Bytes saved = save();
+	std::vector<PlayerInput> inputs;
+	std::vector<Bytes> played;
+	runTicks(autopilot, 1000, &inputs, played);
+	for (int replay = 0; replay < 3; replay++) {
+		CHECK(loadGameState(saved.data(), saved.size(), true));
+		std::vector<Bytes> replayed;
+		for (int i = 0; i < (int)inputs.size(); i++) {
+			PlayerInput input[maxPlayers] = { inputs[i] };
+			lives = 3;
+			advanceTick(input);
+			if (gameTick % checkEvery == 0) {
+				replayed.push_back(save());
+			}
+		}
+		CHECK(replayed == played);
+	}
+}
+
+int main()
+{
+	//small jobs and many asteroids, so the threaded runs really split the work
+	entityGrainSize = 4;
+	asteroidSpawnRate = 40;
+	particleSystem->init(maxParticles);
+	asteroidSolver->reserve(asteroidSolverBodies, asteroidSolverContacts, asteroidSolverCells);
+	testRepeatable();
+	testReplay();
+	jobSystem->shutdown();
+	return finishTests("DeterminismTest");
+}
@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "Check.h"
+#include "FileWatcher.h"
+
+//FileWatcher on inotify in a folder of its own: a write is seen once it is finished, saves through a temporary file
+//are seen, other files in the folder are not
+
+static void writeFile(const std::string& fileName, const char* text)
+{
+	std::ofstream file(fileName);
+	file << text;
+}
+
+int main()
+{
+	char folderTemplate[] = "/tmp/filewatchertestXXXXXX";
+	char* folder = mkdtemp(folderTemplate);
+	CHECK(folder != NULL);
+	if (folder == NULL) {
+		return finishTests("FileWatcherTest");
+	}
+	std::string fileName = std::string(folder) + "/tuning.cfg";
+	std::string otherName = std::string(folder) + "/other.cfg";
+	std::string temporaryName = std::string(folder) + "/tuning.cfg.tmp";
+	writeFile(fileName, "friction = 0.01\n");
+
+	FileWatcher watcher;
+	CHECK(watcher.init(fileName));
+	CHECK(!watcher.hasChanged());
+
+	//any number of writes is one change
+	writeFile(fileName, "friction = 0.02\n");
+	writeFile(fileName, "friction = 0.03\n");
+	CHECK(watcher.hasChanged());
+	CHECK(!watcher.hasChanged());
+
+	//an editor part way through a save: nothing until the file is closed
+	{
+		std::ofstream file(fileName, std::ios::trunc);
+		file << "friction = ";
+		file.flush();
+		CHECK(!watcher.hasChanged());
+		file << "0.04\n";
+	}
+	CHECK(watcher.hasChanged());
+
+	//a new file is only seen once written, not when it is created
+	remove(fileName.c_str());
+	CHECK(!watcher.hasChanged());
+	{
+		std::ofstream file(fileName);
+		CHECK(!watcher.hasChanged());
+		file << "friction = 0.05\n";
+	}
+	CHECK(watcher.hasChanged());
+
+	//saved through a temporary file moved over the old one
+	writeFile(temporaryName, "friction = 0.06\n");
+	CHECK(!watcher.hasChanged());
+	CHECK(rename(temporaryName.c_str(), fileName.c_str()) == 0);
+	CHECK(watcher.hasChanged());
+
+	writeFile(otherName, "something else\n");
+	CHECK(!watcher.hasChanged());
+
+	watcher.shutdown();
+	writeFile(fileName, "friction = 0.07\n");
+	CHECK(!watcher.hasChanged());
+	CHECK(!watcher.init(std::string(folder) + "/missing/tuning.cfg"));
+
+	remove(fileName.c_str());
+	remove(otherName.c_str());
+	rmdir(folder);
+	return finishTests("FileWatcherTest");
+}
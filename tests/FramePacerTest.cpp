@@ -0,0 +1,123 @@
+#include <chrono>
+#include <thread>
+#include "Check.h"
+#include "FramePacer.h"
+#include "Simulation.h"
+
+//FramePacer: wakes at the target rate on a fixed schedule, does not rush to catch up after a stall and sleeps
+//instead of spinning. The simulation runs one tick per wake, so the slower rates have to add up from ticks alone.
+
+typedef FramePacer::Clock Clock;
+
+static double secondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void testRate()
+{
+	FramePacer pacer;
+	pacer.init(200, 200);
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < 100; i++) {
+		pacer.waitForNextFrame();
+	}
+	double elapsed = secondsSince(start);
+	printf("100 frames at 200/s in %.3fs, jitter %.3fms average %.3fms max\n", elapsed, pacer.getAverageJitter(), pacer.getMaxJitter());
+	CHECK(pacer.getFrameCount() == 100);
+	CHECK(elapsed > 0.49 && elapsed < 0.6);
+}
+
+//Work shorter than a frame does not push the following deadlines back
+static void testFixedSchedule()
+{
+	FramePacer pacer;
+	pacer.init(100, 100);
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < 50; i++) {
+		pacer.waitForNextFrame();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	double elapsed = secondsSince(start);
+	printf("50 frames with 5ms of work at 100/s in %.3fs\n", elapsed);
+	CHECK(elapsed > 0.49 && elapsed < 0.6);
+}
+
+//After a stall of several frames the loop starts again from now instead of running the missed frames back to back.
+//Counted rather than timed gap by gap, a late wake on a busy machine shortens one gap but never adds wakes.
+static void testStall()
+{
+	FramePacer pacer;
+	pacer.init(100, 100);
+	for (int i = 0; i < 5; i++) {
+		pacer.waitForNextFrame();
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(60));
+	Clock::time_point start = Clock::now();
+	int wakes = 0;
+	while (secondsSince(start) < 0.025) {
+		pacer.waitForNextFrame();
+		wakes++;
+	}
+	//now, 10ms and 20ms (and the one that ends the loop), catching up would add the six missed frames
+	printf("%d wakes in the 25ms after a 60ms stall\n", wakes);
+	CHECK(wakes <= 4);
+}
+
+static void testIdleRate()
+{
+	FramePacer pacer;
+	pacer.init(200, 50);
+	pacer.setIdle(true);
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < 10; i++) {
+		pacer.waitForNextFrame();
+	}
+	double elapsed = secondsSince(start);
+	CHECK(elapsed > 0.19 && elapsed < 0.3);
+}
+
+//Waiting at 60 frames a second leaves the core mostly idle
+static void testSleeps()
+{
+	FramePacer pacer;
+	pacer.init(60, 60);
+	long long cpuStart = FramePacer::processCpuMicroseconds();
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < 30; i++) {
+		pacer.waitForNextFrame();
+	}
+	double cpu = (FramePacer::processCpuMicroseconds() - cpuStart) / 1000000.0;
+	double elapsed = secondsSince(start);
+	printf("%.1f%% of a core while waiting\n", 100 * cpu / elapsed);
+	CHECK(cpu < elapsed / 2);
+}
+
+//Bullets, asteroids and the wave clock counted from the tick come out at their rate every second, however many
+//seconds the game has been running
+static void testTicksDue()
+{
+	int rates[] = { 1, 7, 10, 20, 49, 50 };
+	for (int rate : rates) {
+		for (long long second = 0; second < 100; second++) {
+			int total = 0;
+			for (int i = 0; i < gameUpdateRate; i++) {
+				int due = ticksDue(second * gameUpdateRate + i, rate);
+				CHECK(due == 0 || due == 1);
+				total += due;
+			}
+			CHECK(total == rate);
+		}
+	}
+}
+
+int main()
+{
+	testRate();
+	testFixedSchedule();
+	testStall();
+	testIdleRate();
+	testSleeps();
+	testTicksDue();
+	return finishTests("FramePacerTest");
+}
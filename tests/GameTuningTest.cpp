@@ -0,0 +1,109 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "Check.h"
+#include "GameTuning.h"
+
+//TuningFile: a valid file changes the values it names, anything wrong anywhere in a file rejects all of it and the
+//values in use stay as they were
+
+//GameTuning is only floats and ints, compared as bytes
+static bool same(const GameTuning& a, const GameTuning& b)
+{
+	return memcmp(&a, &b, sizeof(GameTuning)) == 0;
+}
+
+static void testValid()
+{
+	GameTuning tuning;
+	TuningFile file;
+	std::string text =
+		"# balance pass\n"
+		"friction = 0.02\r\n"
+		"\n"
+		"  maxPowerUps=5   # more on screen\n"
+		"asteroidRotationRate = -0.5\n"
+		"secondPhaseTimer = 0\n"
+		"thirdPhaseTimer = 59\n"
+		"largeAsteroidHp = 7.0\n";
+	CHECK(file.loadFromText(text, tuning));
+	CHECK(file.getError().empty());
+	CHECK(tuning.friction == 0.02f);
+	CHECK(tuning.maxPowerUps == 5);
+	CHECK(tuning.asteroidRotationRate == -0.5f);
+	CHECK(tuning.secondPhaseTimer == 0 && tuning.thirdPhaseTimer == 59);
+	CHECK(tuning.largeAsteroidHp == 7);
+	//names the file does not mention keep their value
+	CHECK(tuning.spaceshipMass == GameTuning().spaceshipMass);
+	GameTuning empty = tuning;
+	CHECK(file.loadFromText("", empty) && same(empty, tuning));
+}
+
+//Each text is rejected whole even though its first line is valid
+static void testRejected()
+{
+	const char* bad[] = {
+		"unknownValue = 1",
+		"Friction = 0.5",
+		"friction 0.5",
+		"friction =",
+		"friction = nan",
+		"friction = inf",
+		"bulletPower = -inf",
+		"bulletPower = 1e40",
+		"friction = 0.5x",
+		"friction = 0.5 0.6",
+		"friction = 0.5;",
+		"maxPowerUps = 2.5",
+		"timeStopDuration = 1e-3",
+		"friction = 1.5",
+		"friction = -0.01",
+		"spaceshipMass = 0",
+		"secondPhaseTimer = 60",
+		"maxPowerUps = 101",
+		"asteroidSolverIterations = -1",
+	};
+	GameTuning before;
+	before.friction = 0.05f;
+	before.maxPowerUps = 4;
+	for (int i = 0; i < (int)(sizeof(bad) / sizeof(bad[0])); i++) {
+		GameTuning tuning = before;
+		TuningFile file;
+		std::string text = std::string("maxPowerUps = 9\n") + bad[i] + "\nbulletPower = 20\n";
+		bool loaded = file.loadFromText(text, tuning);
+		CHECK(!loaded);
+		CHECK(same(tuning, before));
+		//the error names the line
+		CHECK(file.getError().compare(0, 7, "line 2:") == 0);
+		if (loaded || !same(tuning, before)) {
+			printf("accepted: %s\n", bad[i]);
+		}
+	}
+	GameTuning tuning = before;
+	TuningFile file;
+	CHECK(!file.loadFromFile("no_such_tuning.cfg", tuning));
+	CHECK(same(tuning, before));
+	CHECK(!file.getError().empty());
+}
+
+static void testFile()
+{
+	const char* fileName = "tuning_test.cfg";
+	std::ofstream out(fileName);
+	out << "bulletPowerUpSpeed = 30\nasteroidRestitution = 0.5\n";
+	out.close();
+	GameTuning tuning;
+	TuningFile file;
+	CHECK(file.loadFromFile(fileName, tuning));
+	CHECK(tuning.bulletPowerUpSpeed == 30 && tuning.asteroidRestitution == 0.5f);
+	remove(fileName);
+}
+
+int main()
+{
+	testValid();
+	testRejected();
+	testFile();
+	return finishTests("GameTuningTest");
+}
@@ -0,0 +1,114 @@
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "Check.h"
+#include "JobSystem.h"
+
+//JobSystem: every index runs once, dependent jobs start only after their dependency, idle threads sleep
+
+static std::vector<int> hits;
+static std::vector<int> firstStep;
+static std::vector<int> secondStep;
+
+static void countHit(int index)
+{
+	hits[index]++;
+}
+
+static void runFirstStep(int index)
+{
+	firstStep[index] = index * 2;
+}
+
+//Reads what the first step wrote, -1 marks an index that ran too early
+static void runSecondStep(int index)
+{
+	secondStep[index] = firstStep[index] == index * 2 ? firstStep[index] + 1 : -1;
+}
+
+static void sleepJob(int)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+static double cpuSeconds()
+{
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static void testParallelFor(JobSystem& jobs)
+{
+	hits.assign(100000, 0);
+	jobs.parallelFor(0, (int)hits.size(), 1000, countHit);
+	bool once = true;
+	for (int hit : hits) {
+		once = once && hit == 1;
+	}
+	CHECK(once);
+}
+
+static void testRunAfter(JobSystem& jobs)
+{
+	for (int repeat = 0; repeat < 50; repeat++) {
+		firstStep.assign(20000, -1);
+		secondStep.assign(20000, 0);
+		JobCounter firstDone;
+		JobCounter secondDone;
+		jobs.parallelFor(0, (int)firstStep.size(), 500, runFirstStep, firstDone);
+		//submitted before the first step finishes, one continuation per chunk
+		for (int begin = 0; begin < (int)secondStep.size(); begin += 500) {
+			jobs.runAfter(firstDone, runSecondStep, begin, begin + 500, secondDone);
+		}
+		jobs.wait(secondDone);
+		CHECK(firstDone.isDone());
+		bool ordered = true;
+		for (int i = 0; i < (int)secondStep.size(); i++) {
+			ordered = ordered && secondStep[i] == i * 2 + 1;
+		}
+		CHECK(ordered);
+	}
+	//a dependency that is already done queues the job right away
+	JobCounter done;
+	JobCounter counter;
+	hits.assign(1, 0);
+	jobs.runAfter(done, countHit, 0, 1, counter);
+	jobs.wait(counter);
+	CHECK(hits[0] == 1);
+}
+
+//Workers with nothing to do, and a thread waiting on a job that sleeps, should cost next to no CPU time
+static void testIdleThreadsSleep(JobSystem& jobs)
+{
+	double cpuBefore = cpuSeconds();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	double idleCpu = cpuSeconds() - cpuBefore;
+	printf("idle workers: %.1f ms CPU over 200 ms\n", idleCpu * 1000);
+	CHECK(idleCpu < 0.02);
+
+	cpuBefore = cpuSeconds();
+	JobCounter counter;
+	jobs.run(sleepJob, 0, 1, counter);
+	jobs.wait(counter);
+	double waitCpu = cpuSeconds() - cpuBefore;
+	printf("waiting on a 100 ms job: %.1f ms CPU\n", waitCpu * 1000);
+	CHECK(waitCpu < 0.02);
+}
+
+int main()
+{
+	JobSystem jobs;
+	jobs.init(4);
+	testParallelFor(jobs);
+	testRunAfter(jobs);
+	testIdleThreadsSleep(jobs);
+	jobs.shutdown();
+
+	//one worker, the waiting thread runs most of the jobs itself
+	JobSystem singleWorker;
+	singleWorker.init(1);
+	testParallelFor(singleWorker);
+	testRunAfter(singleWorker);
+	singleWorker.shutdown();
+	return finishTests("JobSystemTest");
+}
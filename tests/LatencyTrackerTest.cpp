@@ -0,0 +1,112 @@
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "Check.h"
+#include "LatencyTracker.h"
+
+//LatencyTracker with the present step stubbed: inputs held for known times before the tick and before the present,
+//the percentiles and the exported file. Times are only checked from below and loosely from above, sleeps overshoot.
+
+static void sleepMilliseconds(int milliseconds)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+static void testHistogram()
+{
+	LatencyHistogram histogram;
+	CHECK(histogram.percentile(50) == 0);
+	//1ms to 100ms once each, in whole milliseconds so every sample starts a bucket
+	for (int i = 1; i <= 100; i++) {
+		histogram.record(i * 1000);
+	}
+	CHECK(histogram.getSampleCount() == 100);
+	CHECK(histogram.percentile(50) > 50.9f && histogram.percentile(50) < 51.2f);
+	CHECK(histogram.percentile(95) > 95.9f && histogram.percentile(95) < 96.2f);
+	CHECK(histogram.percentile(99) > 99.9f && histogram.percentile(99) < 100.2f);
+	//past the last bucket everything is counted at its edge
+	histogram.record(10000000);
+	CHECK(histogram.getBucket(LatencyHistogram::bucketCount - 1) == 1);
+	histogram.reset();
+	CHECK(histogram.getSampleCount() == 0);
+}
+
+static void testTracking()
+{
+	LatencyTracker tracker;
+	for (int tick = 1; tick <= 20; tick++) {
+		tracker.captureInput(tick % 2 == 0 ? KeyboardInput : MouseInput);
+		sleepMilliseconds(4);
+		tracker.consumeInput(KeyboardInput | MouseInput, tick);
+		//the frame that shows it is built and presented later
+		sleepMilliseconds(4);
+		tracker.framePresented(tick);
+	}
+	//an event from a tick that is not presented yet stays queued
+	tracker.captureInput(KeyboardInput);
+	tracker.consumeInput(KeyboardInput, 21);
+	tracker.framePresented(20);
+	CHECK(tracker.getInputToSim().getSampleCount() == 21);
+	CHECK(tracker.getInputToPresent().getSampleCount() == 20);
+	tracker.framePresented(21);
+	CHECK(tracker.getInputToPresent().getSampleCount() == 21);
+	//input nobody consumes is never counted
+	tracker.captureInput(MouseInput);
+	tracker.consumeInput(KeyboardInput, 22);
+	CHECK(tracker.getInputToSim().getSampleCount() == 21);
+	tracker.captureInput(0);
+
+	LatencyHistogram& toSim = tracker.getInputToSim();
+	LatencyHistogram& toPresent = tracker.getInputToPresent();
+	printf("input to sim p50 %.1fms p99 %.1fms, to present p50 %.1fms p99 %.1fms\n", toSim.percentile(50), toSim.percentile(99),
+		toPresent.percentile(50), toPresent.percentile(99));
+	CHECK(toSim.percentile(50) >= 4 && toSim.percentile(50) < 50);
+	CHECK(toPresent.percentile(50) >= 8 && toPresent.percentile(50) < 50);
+	CHECK(toSim.percentile(50) <= toSim.percentile(95) && toSim.percentile(95) <= toSim.percentile(99));
+	CHECK(toPresent.percentile(99) >= toSim.percentile(50));
+	CHECK(tracker.getDroppedEvents() == 0);
+
+	char overlay[256];
+	tracker.formatOverlay(overlay, sizeof(overlay));
+	CHECK(std::string(overlay).find("Input->Present p50") != std::string::npos);
+
+	const char* fileName = "latency_test.csv";
+	CHECK(tracker.exportToFile(fileName));
+	std::ifstream file(fileName);
+	std::string header, toSimLine, toPresentLine, dropped;
+	std::getline(file, header);
+	std::getline(file, toSimLine);
+	std::getline(file, toPresentLine);
+	std::getline(file, dropped);
+	CHECK(header == "metric,samples,p50_ms,p95_ms,p99_ms");
+	CHECK(toSimLine.compare(0, 16, "input_to_sim,21,") == 0);
+	CHECK(toPresentLine.compare(0, 20, "input_to_present,21,") == 0);
+	CHECK(dropped == "dropped_events,0");
+	file.close();
+	remove(fileName);
+
+	tracker.reset();
+	CHECK(tracker.getInputToSim().getSampleCount() == 0 && tracker.getInputToPresent().getSampleCount() == 0);
+}
+
+//More input than the tracker holds between ticks is dropped and counted, never written past the end
+static void testDropped()
+{
+	LatencyTracker tracker;
+	for (int i = 0; i < 300; i++) {
+		tracker.captureInput(KeyboardInput);
+	}
+	CHECK(tracker.getDroppedEvents() == 300 - 256);
+	tracker.consumeInput(KeyboardInput, 1);
+	tracker.framePresented(1);
+	CHECK(tracker.getInputToPresent().getSampleCount() == 256);
+}
+
+int main()
+{
+	testHistogram();
+	testTracking();
+	testDropped();
+	return finishTests("LatencyTrackerTest");
+}
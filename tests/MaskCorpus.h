@@ -0,0 +1,81 @@
+#pragma once
+#include <vector>
+#include "CollisionMask.h"
+
+//Alpha images the collision mask test and benchmark share: shapes like the game's sprites plus a few that are
+//hard on the word packing (thin lines, holes, masks wider than a 64 bit word once scaled and rotated)
+
+struct MaskShape {
+	const char* name;
+	int width;
+	int height;
+	std::vector<unsigned char> alpha;
+};
+
+inline MaskShape makeShape(const char* name, int width, int height, bool (*inside)(float x, float y, int width, int height))
+{
+	MaskShape shape = { name, width, height, std::vector<unsigned char>(width * height) };
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			shape.alpha[y * width + x] = inside(x + 0.5f, y + 0.5f, width, height) ? 255 : 0;
+		}
+	}
+	return shape;
+}
+
+//asteroid.png is a rough disc
+inline bool insideDisc(float x, float y, int width, int height)
+{
+	float dx = x - width / 2.0f;
+	float dy = y - height / 2.0f;
+	return dx * dx + dy * dy < width * width / 4.0f;
+}
+
+inline bool insideRing(float x, float y, int width, int height)
+{
+	float dx = x - width / 2.0f;
+	float dy = y - height / 2.0f;
+	float distanceSquared = dx * dx + dy * dy;
+	return distanceSquared < width * width / 4.0f && distanceSquared > width * width / 9.0f;
+}
+
+//Pointed nose up like ship.png
+inline bool insideShip(float x, float y, int width, int height)
+{
+	float halfWidthAtY = (y / height) * width / 2;
+	return x > width / 2.0f - halfWidthAtY && x < width / 2.0f + halfWidthAtY;
+}
+
+inline bool insideBullet(float x, float y, int width, int height)
+{
+	return x > width / 4.0f && x < width * 3 / 4.0f && y > 2 && y < height - 2;
+}
+
+inline bool insideDiagonal(float x, float y, int, int)
+{
+	return (int)x == (int)y;
+}
+
+inline std::vector<MaskShape> makeMaskCorpus()
+{
+	std::vector<MaskShape> corpus;
+	corpus.push_back(makeShape("disc 60", 60, 60, insideDisc));
+	corpus.push_back(makeShape("ring 70", 70, 70, insideRing));
+	corpus.push_back(makeShape("ship 50", 50, 50, insideShip));
+	corpus.push_back(makeShape("bullet 16x28", 16, 28, insideBullet));
+	corpus.push_back(makeShape("diagonal 80", 80, 80, insideDiagonal));
+	return corpus;
+}
+
+//Pixel by pixel answer to CollisionMask::overlaps
+inline bool overlapsByPixel(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by)
+{
+	for (int y = 0; y < a.getHeight(); y++) {
+		for (int x = 0; x < a.getWidth(); x++) {
+			if (a.getPixel(x, y) && b.getPixel(x + ax - bx, y + ay - by)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
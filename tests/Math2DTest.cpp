@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Check.h"
+#include "Math2D.h"
+#include "RandomStream.h"
+
+//Math2D against double precision references: the polynomial sinCos (scalar and four wide), the D3DX composition
+//transformation2D stands in for, and the batched sprite kernel the snapshot is built with (SIMD lanes and scalar tail)
+
+//Largest error allowed, absolute for sin and cos, relative to max(1, |reference|) for matrix elements
+const double sinCosTolerance = 1.3e-7;
+const double matrixTolerance = 1.2e-4;
+
+struct Matrix {
+	double m11, m12;
+	double m21, m22;
+	double dx, dy;
+};
+
+static Matrix multiply(const Matrix& a, const Matrix& b)
+{
+	return Matrix{
+		a.m11 * b.m11 + a.m12 * b.m21, a.m11 * b.m12 + a.m12 * b.m22,
+		a.m21 * b.m11 + a.m22 * b.m21, a.m21 * b.m12 + a.m22 * b.m22,
+		a.dx * b.m11 + a.dy * b.m21 + b.dx, a.dx * b.m12 + a.dy * b.m22 + b.dy
+	};
+}
+
+static Matrix translation(double x, double y)
+{
+	return Matrix{ 1, 0, 0, 1, x, y };
+}
+
+static Matrix rotation(double angle)
+{
+	return Matrix{ cos(angle), sin(angle), -sin(angle), cos(angle), 0, 0 };
+}
+
+//D3DXMatrixTransformation2D as documented: Msc^-1 * Msr^-1 * Ms * Msr * Msc * Mrc^-1 * Mr * Mrc * Mt
+static Matrix referenceTransformation(Vec2 scalingCenter, float scalingRotation, Vec2 scaling, Vec2 rotationCenter, float angle, Vec2 position)
+{
+	Matrix m = translation(-scalingCenter.x, -scalingCenter.y);
+	m = multiply(m, rotation(-(double)scalingRotation));
+	m = multiply(m, Matrix{ scaling.x, 0, 0, scaling.y, 0, 0 });
+	m = multiply(m, rotation(scalingRotation));
+	m = multiply(m, translation(scalingCenter.x, scalingCenter.y));
+	m = multiply(m, translation(-rotationCenter.x, -rotationCenter.y));
+	m = multiply(m, rotation(angle));
+	m = multiply(m, translation(rotationCenter.x, rotationCenter.y));
+	return multiply(m, translation(position.x, position.y));
+}
+
+static double elementError(float value, double reference)
+{
+	return fabs(value - reference) / std::max(1.0, fabs(reference));
+}
+
+static double matrixError(const Mat3x2& m, const Matrix& reference)
+{
+	double error = elementError(m.m11, reference.m11);
+	error = std::max(error, elementError(m.m12, reference.m12));
+	error = std::max(error, elementError(m.m21, reference.m21));
+	error = std::max(error, elementError(m.m22, reference.m22));
+	error = std::max(error, elementError(m.dx, reference.dx));
+	return std::max(error, elementError(m.dy, reference.dy));
+}
+
+static double matrixError(const Mat3x2& m, const Mat3x2& reference)
+{
+	return matrixError(m, Matrix{ reference.m11, reference.m12, reference.m21, reference.m22, reference.dx, reference.dy });
+}
+
+static float randomFloat(RandomStream& random, float low, float high)
+{
+	return low + random.nextFloat() * (high - low);
+}
+
+static void testSinCos()
+{
+	RandomStream random;
+	random.seed(46, 1);
+	double worst = 0;
+	double worstWide = 0;
+	for (int i = 0; i < 400000; i++) {
+		//the last quarter covers the exact quadrant boundaries
+		float angle = i < 300000 ? randomFloat(random, -3000, 3000) : (i - 350000) * 1.5707963267948966f / 16;
+		float sine, cosine;
+		sinCos(angle, sine, cosine);
+		worst = std::max(worst, std::max(fabs(sine - sin((double)angle)), fabs(cosine - cos((double)angle))));
+#ifdef MATH2D_SSE2
+		__m128 wideSine, wideCosine;
+		sinCos4(_mm_set_ps(angle, -angle, angle * 0.5f, 0), wideSine, wideCosine);
+		float sines[4], cosines[4];
+		_mm_storeu_ps(sines, wideSine);
+		_mm_storeu_ps(cosines, wideCosine);
+		float angles[4] = { 0, angle * 0.5f, -angle, angle };
+		for (int lane = 0; lane < 4; lane++) {
+			worstWide = std::max(worstWide, std::max(fabs(sines[lane] - sin((double)angles[lane])), fabs(cosines[lane] - cos((double)angles[lane]))));
+		}
+#endif
+	}
+	printf("sinCos worst error %.3g, four wide %.3g (tolerance %.3g)\n", worst, worstWide, sinCosTolerance);
+	CHECK(worst <= sinCosTolerance);
+	CHECK(worstWide <= sinCosTolerance);
+	float sine, cosine;
+	sinCos(0, sine, cosine);
+	CHECK(sine == 0 && cosine == 1);
+}
+
+static void testTransformation()
+{
+	RandomStream random;
+	random.seed(46, 2);
+	double worst = 0;
+	for (int i = 0; i < 100000; i++) {
+		Vec2 scalingCenter(randomFloat(random, -100, 100), randomFloat(random, -100, 100));
+		float scalingRotation = i % 2 == 0 ? 0 : randomFloat(random, -7, 7);
+		Vec2 scaling(randomFloat(random, 0.1f, 3), randomFloat(random, 0.1f, 3));
+		Vec2 rotationCenter(randomFloat(random, -100, 100), randomFloat(random, -100, 100));
+		float angle = randomFloat(random, -7, 7);
+		Vec2 position(randomFloat(random, -2000, 3000), randomFloat(random, -2000, 3000));
+		Mat3x2 m = transformation2D(scalingCenter, scalingRotation, scaling, rotationCenter, angle, position);
+		worst = std::max(worst, matrixError(m, referenceTransformation(scalingCenter, scalingRotation, scaling, rotationCenter, angle, position)));
+	}
+	printf("transformation2D worst error %.3g (tolerance %.3g)\n", worst, matrixTolerance);
+	CHECK(worst <= matrixTolerance);
+	//a point goes through scale, rotation and translation in that order
+	Vec2 point = transformPoint(transformation2D(Vec2(0, 0), 0, Vec2(2, 2), Vec2(0, 0), 1.5707963f, Vec2(10, 0)), Vec2(1, 0));
+	CHECK(fabs(point.x - 10) < 1e-5f && fabs(point.y - 2) < 1e-5f);
+}
+
+//Counts that leave every possible scalar tail after the SIMD lanes, with and without scaling
+static void testSpriteMatrices()
+{
+	RandomStream random;
+	random.seed(46, 3);
+	double worstReference = 0;
+	double worstTransformation = 0;
+	for (int round = 0; round < 2000; round++) {
+		int count = 1 + round % 67;
+		bool scaled = round % 3 != 0;
+		std::vector<float> x(count), y(count), angle(count), scaleX(count), scaleY(count);
+		for (int i = 0; i < count; i++) {
+			x[i] = randomFloat(random, -2000, 3000);
+			y[i] = randomFloat(random, -2000, 3000);
+			angle[i] = randomFloat(random, -100, 100);
+			scaleX[i] = randomFloat(random, 0.1f, 3);
+			scaleY[i] = randomFloat(random, 0.1f, 3);
+		}
+		float centerX = randomFloat(random, 0, 100);
+		float centerY = randomFloat(random, 0, 100);
+		std::vector<Mat3x2> matrices(count + 1);
+		matrices[count] = Mat3x2{ 7, 7, 7, 7, 7, 7 };
+		buildSpriteMatrices(count, x.data(), y.data(), angle.data(), scaled ? scaleX.data() : NULL, scaled ? scaleY.data() : NULL, centerX, centerY, matrices.data());
+		//nothing written past the end
+		CHECK(matrices[count].m11 == 7 && matrices[count].dy == 7);
+		for (int i = 0; i < count; i++) {
+			Vec2 center(centerX, centerY);
+			Vec2 scaling = scaled ? Vec2(scaleX[i], scaleY[i]) : Vec2(1, 1);
+			Vec2 position(x[i], y[i]);
+			worstReference = std::max(worstReference, matrixError(matrices[i], referenceTransformation(center, 0, scaling, center, angle[i], position)));
+			worstTransformation = std::max(worstTransformation, matrixError(matrices[i], transformation2D(center, 0, scaling, center, angle[i], position)));
+		}
+	}
+	printf("buildSpriteMatrices worst error %.3g against the reference, %.3g against transformation2D (tolerance %.3g)\n",
+		worstReference, worstTransformation, matrixTolerance);
+	CHECK(worstReference <= matrixTolerance);
+	CHECK(worstTransformation <= matrixTolerance);
+}
+
+//The SIMD integration steps give exactly the scalar results
+static void testIntegrate()
+{
+	RandomStream random;
+	random.seed(46, 4);
+	for (int count = 0; count < 9; count++) {
+		std::vector<Vec2> position(count), velocity(count), add(count);
+		for (int i = 0; i < count; i++) {
+			position[i] = Vec2(randomFloat(random, -500, 500), randomFloat(random, -500, 500));
+			velocity[i] = Vec2(randomFloat(random, -5, 5), randomFloat(random, -5, 5));
+			add[i] = Vec2(randomFloat(random, -5, 5), randomFloat(random, -5, 5));
+		}
+		std::vector<Vec2> expectedPosition = position;
+		std::vector<Vec2> expectedVelocity = velocity;
+		for (int i = 0; i < count; i++) {
+			expectedPosition[i] += expectedVelocity[i];
+			expectedVelocity[i] *= 0.98f;
+			expectedVelocity[i] += add[i] * 0.5f;
+		}
+		integrate2D(count, position.data(), velocity.data(), 0.98f);
+		addScaled2D(count, velocity.data(), add.data(), 0.5f);
+		for (int i = 0; i < count; i++) {
+			CHECK(position[i] == expectedPosition[i]);
+			CHECK(velocity[i] == expectedVelocity[i]);
+		}
+	}
+}
+
+int main()
+{
+	testSinCos();
+	testTransformation();
+	testSpriteMatrices();
+	testIntegrate();
+	return finishTests("Math2DTest");
+}
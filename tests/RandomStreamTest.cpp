@@ -0,0 +1,140 @@
+#include <cstdint>
+#include <vector>
+#include "Check.h"
+#include "RandomStream.h"
+
+//RandomStream against the reference PCG32 sequence, so a seed gives the same game on every platform, and the bulk
+//fills against the calls they stand in for
+
+//pcg32_srandom_r(&rng, 42, 54) in the reference implementation, the first six pcg32_random_r
+static void testKnownAnswer()
+{
+	const uint32_t expected[] = { 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+	RandomStream random;
+	random.seed(42, 54);
+	for (int i = 0; i < 6; i++) {
+		uint32_t value = random.next();
+		CHECK(value == expected[i]);
+		if (value != expected[i]) {
+			printf("value %d is 0x%08x, expected 0x%08x\n", i, value, expected[i]);
+		}
+	}
+	//another stream of the same seed is another sequence
+	RandomStream other;
+	other.seed(42, 55);
+	RandomStream same;
+	same.seed(42, 54);
+	CHECK(other.next() != same.next());
+}
+
+//Counts on both sides of the four lanes, the stream carries on from the same place afterwards
+static void testFill()
+{
+	const int counts[] = { 0, 1, 3, 4, 5, 8, 1001 };
+	for (int count : counts) {
+		RandomStream bulk;
+		bulk.seed(7, AsteroidStream);
+		RandomStream single;
+		single.seed(7, AsteroidStream);
+		std::vector<uint32_t> values(count + 1);
+		bulk.fill(values.data(), count);
+		bool same = true;
+		for (int i = 0; i < count; i++) {
+			same = same && values[i] == single.next();
+		}
+		CHECK(same);
+		CHECK(bulk.next() == single.next());
+	}
+}
+
+//A small bound redraws about once in a billion values, so the bulk values are the ones range() gives
+static void testFillRange()
+{
+	const uint32_t bounds[] = { 1, 2, 6, 360, 1200 };
+	for (uint32_t bound : bounds) {
+		RandomStream bulk;
+		bulk.seed(11, EffectStream);
+		RandomStream single;
+		single.seed(11, EffectStream);
+		std::vector<uint32_t> values(1001);
+		bulk.fillRange(values.data(), (int)values.size(), bound);
+		bool same = true;
+		for (uint32_t value : values) {
+			same = same && value == single.range(bound);
+		}
+		CHECK(same);
+	}
+	//just over half the range redraws nearly every other value, the bulk values still stay in bounds and repeat
+	const uint32_t largeBound = 0x80000001;
+	std::vector<uint32_t> first(1000);
+	std::vector<uint32_t> second(1000);
+	RandomStream random;
+	random.seed(11, EffectStream);
+	random.fillRange(first.data(), 1000, largeBound);
+	random.seed(11, EffectStream);
+	random.fillRange(second.data(), 1000, largeBound);
+	CHECK(first == second);
+	bool inBounds = true;
+	for (uint32_t value : first) {
+		inBounds = inBounds && value < largeBound;
+	}
+	CHECK(inBounds);
+	random.fillRange(first.data(), 1000, 0);
+	CHECK(first[0] == 0 && first[999] == 0);
+}
+
+static void testBounds()
+{
+	RandomStream random;
+	random.seed(3, PowerUpStream);
+	//every value of a small bound comes up, none outside it
+	int seen[6] = {};
+	bool inBounds = true;
+	for (int i = 0; i < 6000; i++) {
+		uint32_t value = random.range(6u);
+		inBounds = inBounds && value < 6;
+		if (value < 6) {
+			seen[value]++;
+		}
+	}
+	CHECK(inBounds);
+	for (int i = 0; i < 6; i++) {
+		CHECK(seen[i] > 800 && seen[i] < 1200);
+	}
+	const uint32_t largeBound = 0x80000001;
+	inBounds = true;
+	for (int i = 0; i < 10000; i++) {
+		inBounds = inBounds && random.range(largeBound) < largeBound;
+	}
+	CHECK(inBounds);
+	CHECK(random.range(0u) == 0 && random.range(1u) == 0);
+
+	//[low, high), negative and empty ranges included
+	bool lowSeen = false;
+	bool highSeen = false;
+	inBounds = true;
+	for (int i = 0; i < 2000; i++) {
+		int value = random.range(-3, 4);
+		inBounds = inBounds && value >= -3 && value < 4;
+		lowSeen = lowSeen || value == -3;
+		highSeen = highSeen || value == 3;
+	}
+	CHECK(inBounds && lowSeen && highSeen);
+	CHECK(random.range(5, 5) == 5 && random.range(5, 2) == 5);
+
+	inBounds = true;
+	for (int i = 0; i < 10000; i++) {
+		float value = random.nextFloat();
+		inBounds = inBounds && value >= 0 && value < 1;
+	}
+	CHECK(inBounds);
+}
+
+int main()
+{
+	testKnownAnswer();
+	testFill();
+	testFillRange();
+	testBounds();
+	return finishTests("RandomStreamTest");
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <map>
+#include <vector>
+#include "Check.h"
+#include "InputTransport.h"
+#include "RollbackSession.h"
+#include "Simulation.h"
+#include "StressTest.h"
+
+//Two rollback sessions over a loopback transport with latency, jitter and loss, as two machines would play.
+//Each machine's game is a saved state that is loaded before its session runs and saved after, so both share the
+//one simulation of this process. Every tick both have the real inputs for must end up the same on both.
+
+typedef std::vector<unsigned char> Bytes;
+
+const int rollbackWindow = 8;
+const int inputDelay = 2;
+const int tickMilliseconds = 20;
+
+static long long fakeTime = 0;
+
+static long long fakeClock()
+{
+	return fakeTime;
+}
+
+struct Machine {
+	RollbackSession session;
+	LoopbackTransport transport;
+	Autopilot autopilot;
+	Bytes state;
+	std::map<long long, Bytes> ticks; //state after every tick, replaced when the tick is simulated again
+};
+
+static Machine machines[2];
+static Machine* running = NULL;
+
+static Bytes save()
+{
+	StateWriter writer;
+	saveGameState(writer);
+	return Bytes(writer.getData(), writer.getData() + writer.getSize());
+}
+
+static bool loadRollbackState(const unsigned char* data, size_t size)
+{
+	return loadGameState(data, size, true);
+}
+
+static void advanceMachine(const PlayerInput* inputs)
+{
+	//the autopilot does not try to survive
+	lives = 3;
+	advanceTick(inputs);
+	running->ticks[gameTick] = save();
+}
+
+static void start(float lossRate)
+{
+	fakeTime = 0;
+	playerCount = 2;
+	seedSimulation(37);
+	resetSimulation();
+	Bytes initial = save();
+	LoopbackTransport::connect(machines[0].transport, machines[1].transport);
+	RollbackCallbacks callbacks = { saveGameState, loadRollbackState, advanceMachine };
+	for (int player = 0; player < 2; player++) {
+		Machine& machine = machines[player];
+		machine.transport.setConditions(60, 40, lossRate, player + 1);
+		machine.transport.setClock(fakeClock);
+		machine.session.init(player, rollbackWindow, inputDelay, &machine.transport, callbacks);
+		machine.autopilot = Autopilot();
+		machine.state = initial;
+		machine.ticks.clear();
+	}
+	//player two sweeps the other way round so the predictions are often wrong
+	for (int i = 0; i < 100; i++) {
+		machines[1].autopilot.next(screenWidth, screenHeight);
+	}
+}
+
+//One tick of the machine's session on its own game, false if it was stalled
+static bool step(Machine& machine)
+{
+	running = &machine;
+	CHECK(loadGameState(machine.state.data(), machine.state.size(), true));
+	bool advanced = machine.session.advance(machine.autopilot.next(screenWidth, screenHeight));
+	machine.state = save();
+	return advanced;
+}
+
+//Every tick confirmed on both machines has the same state on both
+static int compareConfirmed()
+{
+	long long confirmed = std::min(machines[0].session.getConfirmedTick(), machines[1].session.getConfirmedTick());
+	int compared = 0;
+	for (long long tick = 1; tick <= confirmed; tick++) {
+		CHECK(machines[0].ticks[tick] == machines[1].ticks[tick]);
+		compared++;
+	}
+	return compared;
+}
+
+static void testSameGame()
+{
+	start(0.1f);
+	int stalls = 0;
+	for (int i = 0; i < 1500; i++) {
+		fakeTime += tickMilliseconds;
+		for (int player = 0; player < 2; player++) {
+			stalls += step(machines[player]) ? 0 : 1;
+		}
+	}
+	int compared = compareConfirmed();
+	printf("%d ticks the same on both, %lld and %lld rollbacks, %d stalls, %lld of %lld packets lost\n", compared, machines[0].session.getRollbackCount(),
+		machines[1].session.getRollbackCount(), stalls, machines[0].transport.getDroppedCount(), machines[0].transport.getSentCount());
+	CHECK(compared > 1400);
+	CHECK(machines[0].session.getRollbackCount() > 0 && machines[1].session.getRollbackCount() > 0);
+	CHECK(machines[0].transport.getDroppedCount() > 0);
+}
+
+//Player one's game ends and it stops advancing, player two must still get every input player one played with
+static void testFinalInputs()
+{
+	start(0.2f);
+	for (int i = 0; i < 300; i++) {
+		fakeTime += tickMilliseconds;
+		//the packets with its last inputs are lost
+		if (i == 295) {
+			machines[0].transport.setConditions(60, 40, 1, 3);
+		}
+		step(machines[0]);
+		step(machines[1]);
+	}
+	machines[0].transport.setConditions(60, 40, 0.5f, 4);
+	long long lastTick = machines[0].session.getTick();
+	for (int i = 0; i < 300; i++) {
+		fakeTime += tickMilliseconds;
+		machines[0].session.flushInputs();
+		step(machines[1]);
+	}
+	CHECK(machines[1].session.getConfirmedTick() >= lastTick);
+	long long confirmed = machines[0].session.getConfirmedTick();
+	CHECK(confirmed > 0 && machines[0].ticks[confirmed] == machines[1].ticks[confirmed]);
+}
+
+int main()
+{
+	particleSystem->init(maxParticles);
+	asteroidSolver->reserve(asteroidSolverBodies, asteroidSolverContacts, asteroidSolverCells);
+	jobSystem->init(1);
+	testSameGame();
+	testFinalInputs();
+	jobSystem->shutdown();
+	return finishTests("RollbackSessionTest");
+}
@@ -0,0 +1,197 @@
+#include <unordered_map>
+#include "Check.h"
+#include "RandomStream.h"
+#include "SlotMap.h"
+
+//SlotMap: lookups, stale handles after their slot is reused, save/load, and slots whose generation wraps around
+
+static const uint32_t stateVersion = 1;
+
+static void testInsertEraseLookup()
+{
+	SlotMap<int> map;
+	SlotHandle a = map.insert(10);
+	SlotHandle b = map.insert(20);
+	SlotHandle c = map.insert(30);
+	CHECK(map.size() == 3);
+	CHECK(*map.get(a) == 10 && *map.get(b) == 20 && *map.get(c) == 30);
+	//erasing from the middle moves the last value into the gap, its handle still finds it
+	CHECK(map.erase(a));
+	CHECK(map.size() == 2);
+	CHECK(map.get(a) == NULL);
+	CHECK(*map.get(b) == 20 && *map.get(c) == 30);
+	CHECK(!map.erase(a));
+	CHECK(map.size() == 2);
+	//a default handle never matches
+	CHECK(!map.contains(SlotHandle()));
+}
+
+static void testStaleHandleAfterReuse()
+{
+	SlotMap<int> map;
+	SlotHandle old = map.insert(1);
+	map.erase(old);
+	SlotHandle reused = map.insert(2);
+	CHECK(reused.index == old.index);
+	CHECK(reused.generation != old.generation);
+	CHECK(!map.contains(old));
+	CHECK(map.get(old) == NULL);
+	CHECK(*map.get(reused) == 2);
+	//erasing through the stale handle must not touch the new value
+	CHECK(!map.erase(old));
+	CHECK(map.contains(reused));
+
+	//clear makes every handle stale, the slots are reused afterwards
+	SlotHandle beforeClear = map.insert(3);
+	map.clear();
+	CHECK(map.size() == 0);
+	CHECK(!map.contains(reused) && !map.contains(beforeClear));
+	SlotHandle afterClear = map.insert(4);
+	CHECK(afterClear.index == reused.index || afterClear.index == beforeClear.index);
+	CHECK(!map.contains(reused) && !map.contains(beforeClear) && *map.get(afterClear) == 4);
+}
+
+//Same operations on the slot map and on an unordered_map keyed by handle
+static void testAgainstUnorderedMap()
+{
+	SlotMap<int> map;
+	std::unordered_map<uint64_t, int> model;
+	std::vector<SlotHandle> handles;
+	RandomStream random;
+	random.seed(34, 1);
+	bool matches = true;
+	for (int step = 0; step < 100000; step++) {
+		if (handles.empty() || random.range(3) != 0) {
+			int value = (int)random.next();
+			SlotHandle handle = map.insert(value);
+			handles.push_back(handle);
+			model[(uint64_t)handle.index << 32 | handle.generation] = value;
+		}
+		else {
+			//erased handles stay in the list half the time so stale ones keep being looked up
+			int index = random.range((uint32_t)handles.size());
+			SlotHandle handle = handles[index];
+			bool erased = map.erase(handle);
+			matches = matches && erased == (model.erase((uint64_t)handle.index << 32 | handle.generation) == 1);
+			if (random.range(2) == 0) {
+				handles[index] = handles.back();
+				handles.pop_back();
+			}
+		}
+		SlotHandle probe = handles[random.range((uint32_t)handles.size())];
+		auto found = model.find((uint64_t)probe.index << 32 | probe.generation);
+		const int* value = map.get(probe);
+		matches = matches && (found == model.end() ? value == NULL : value != NULL && *value == found->second);
+	}
+	CHECK(matches);
+	CHECK(map.size() == (int)model.size());
+}
+
+static void testSaveLoad()
+{
+	SlotMap<int> map;
+	std::vector<SlotHandle> handles;
+	for (int i = 0; i < 100; i++) {
+		handles.push_back(map.insert(i));
+	}
+	for (int i = 0; i < 100; i += 3) {
+		map.erase(handles[i]);
+	}
+	StateWriter writer;
+	writer.begin(stateVersion);
+	map.save(writer);
+	writer.end();
+
+	int savedCount = map.size();
+
+	SlotMap<int> loaded;
+	StateReader reader;
+	CHECK(reader.begin(writer.getData(), writer.getSize(), stateVersion));
+	CHECK(loaded.load(reader) && reader.isFinished());
+	bool same = loaded.size() == map.size();
+	for (int i = 0; i < 100; i++) {
+		same = same && loaded.contains(handles[i]) == (i % 3 != 0) && (i % 3 == 0 || *loaded.get(handles[i]) == i);
+	}
+	CHECK(same);
+	//the free list came along, the next insert takes the same slot in both
+	CHECK(loaded.insert(7).index == map.insert(7).index);
+
+	//an untrusted load catches a dense index that points at the wrong slot
+	std::vector<unsigned char> damaged(writer.getData(), writer.getData() + writer.getSize());
+	size_t denseSlotsStart = 16 + 4 + savedCount * sizeof(int) + 4; //header, values with their count, dense slot count
+	damaged[denseSlotsStart] ^= 1;
+	SlotMap<int> rejected;
+	CHECK(reader.begin(damaged.data(), damaged.size(), stateVersion));
+	CHECK(!rejected.load(reader));
+}
+
+//Slot layout as SlotMap saves it
+struct SavedSlot {
+	uint32_t denseIndex;
+	uint32_t generation;
+};
+
+//Builds a map holding one value in slot 0 at the given (odd) generation
+static bool loadSlotAtGeneration(SlotMap<int>& map, uint32_t generation)
+{
+	int value = 5;
+	uint32_t denseSlot = 0;
+	SavedSlot slot = { 0, generation };
+	StateWriter writer;
+	writer.begin(stateVersion);
+	writer.writeArray(&value, 1);
+	writer.writeArray(&denseSlot, 1);
+	writer.writeArray(&slot, 1);
+	writer.write((uint32_t)0xffffffff);
+	writer.end();
+	StateReader reader;
+	return reader.begin(writer.getData(), writer.getSize(), stateVersion) && map.load(reader) && reader.isFinished();
+}
+
+static void testGenerationWraparound()
+{
+	SlotMap<int> map;
+	CHECK(loadSlotAtGeneration(map, 0xfffffffd));
+	SlotHandle last = { 0, 0xfffffffd };
+	CHECK(map.contains(last) && *map.get(last) == 5);
+	map.erase(last);
+	SlotHandle final = map.insert(6);
+	CHECK(final.index == 0 && final.generation == 0xffffffff);
+	CHECK(!map.contains(last));
+	//the next erase wraps the generation, the slot is retired so old handles of slot 0 never match again
+	map.erase(final);
+	SlotHandle next = map.insert(7);
+	CHECK(next.index != 0);
+	SlotHandle firstEver = { 0, 1 };
+	CHECK(!map.contains(firstEver) && !map.contains(final) && !map.contains(last));
+	CHECK(*map.get(next) == 7);
+
+	//clear retires wrapping slots the same way
+	SlotMap<int> cleared;
+	CHECK(loadSlotAtGeneration(cleared, 0xffffffff));
+	cleared.clear();
+	SlotHandle afterClear = cleared.insert(8);
+	CHECK(afterClear.index != 0);
+	CHECK(!cleared.contains(SlotHandle{ 0, 1 }));
+
+	//a retired slot saves and loads as an empty slot outside the free list
+	StateWriter writer;
+	writer.begin(stateVersion);
+	map.save(writer);
+	writer.end();
+	SlotMap<int> loaded;
+	StateReader reader;
+	CHECK(reader.begin(writer.getData(), writer.getSize(), stateVersion));
+	CHECK(loaded.load(reader));
+	CHECK(loaded.insert(9).index != 0);
+}
+
+int main()
+{
+	testInsertEraseLookup();
+	testStaleHandleAfterReuse();
+	testAgainstUnorderedMap();
+	testSaveLoad();
+	testGenerationWraparound();
+	return finishTests("SlotMapTest");
+}
@@ -0,0 +1,270 @@
+#include <vector>
+#include "Check.h"
+#include "Simulation.h"
+#include "StressTest.h"
+
+//Game state save/load: a loaded state saves back to the same bytes and plays on the same way, damaged or cut short
+//data is rejected and leaves the running stage exactly as it was
+
+typedef std::vector<unsigned char> Bytes;
+
+static Autopilot autopilot;
+
+static void runTicks(int ticks)
+{
+	for (int i = 0; i < ticks; i++) {
+		PlayerInput inputs[maxPlayers] = { autopilot.next(screenWidth, screenHeight) };
+		updateBullet(ticksDue(gameTick, tuning.defaultBulletInterval), inputs);
+		updateAsteroid(ticksDue(gameTick, asteroidSpawnRate * 4));
+		updateWave(ticksDue(gameTick, waveUpdateRate));
+		update(1, inputs);
+		gameTick++;
+		//the autopilot is not trying to survive
+		lives = 3;
+	}
+}
+
+//Same, but lives are left alone
+static void runTicksWithoutRefill(int ticks)
+{
+	for (int i = 0; i < ticks; i++) {
+		PlayerInput inputs[maxPlayers] = { autopilot.next(screenWidth, screenHeight) };
+		advanceTick(inputs);
+	}
+}
+
+static Bytes save()
+{
+	StateWriter writer;
+	saveGameState(writer);
+	return Bytes(writer.getData(), writer.getData() + writer.getSize());
+}
+
+static bool load(const Bytes& data, bool trusted)
+{
+	return loadGameState(data.data(), data.size(), trusted);
+}
+
+static void testRoundTrip(const Bytes& state)
+{
+	CHECK(load(state, false));
+	CHECK(save() == state);
+	CHECK(load(state, true));
+	CHECK(save() == state);
+
+	//a loaded state plays on exactly like the one that was saved
+	runTicks(200);
+	Bytes played = save();
+	CHECK(load(state, true));
+	runTicks(200);
+	CHECK(save() == played);
+	CHECK(load(state, true));
+}
+
+//A rejected load must leave every byte of the stage as it was
+static void expectRejected(const Bytes& data, bool trusted, int& failures)
+{
+	Bytes live = save();
+	if (load(data, trusted) || save() != live) {
+		failures++;
+	}
+}
+
+static void testTruncated(const Bytes& state)
+{
+	int failures = 0;
+	for (size_t size = 0; size < state.size(); size += state.size() / 97 + 1) {
+		expectRejected(Bytes(state.begin(), state.begin() + size), false, failures);
+		expectRejected(Bytes(state.begin(), state.begin() + size), true, failures);
+	}
+	expectRejected(Bytes(state.begin(), state.end() - 1), false, failures);
+	CHECK(failures == 0);
+}
+
+//Flips bytes all over the state. Flips that land in a plain value (a position, a timer) are accepted,
+//everything else has to be rejected without touching the stage
+static void testDamaged(const Bytes& state)
+{
+	int rejected = 0;
+	int accepted = 0;
+	int failures = 0;
+	RandomStream random;
+	random.seed(36, 1);
+	for (int i = 0; i < 3000; i++) {
+		//an accepted state may have added an (empty) archetype, so the live bytes are taken again every time
+		Bytes live = save();
+		Bytes damaged = state;
+		damaged[random.range((uint32_t)damaged.size())] ^= (unsigned char)(1 + random.range(255));
+		if (load(damaged, false)) {
+			accepted++;
+			//whatever was accepted is a consistent state of its own
+			Bytes resaved = save();
+			failures += load(resaved, false) ? 0 : 1;
+			CHECK(load(state, true));
+		}
+		else {
+			rejected++;
+			failures += save() == live ? 0 : 1;
+		}
+	}
+	printf("damaged states: %d rejected, %d accepted\n", rejected, accepted);
+	CHECK(failures == 0);
+	CHECK(rejected > 0);
+}
+
+//Out of range indices that a byte flip may not hit, each saved from a modified stage and loaded over the real one
+static void testOutOfRangeValues(const Bytes& state)
+{
+	int failures = 0;
+	spaceships[0].hull = 5;
+	Bytes badHull = save();
+	CHECK(load(state, true));
+	expectRejected(badHull, false, failures);
+	expectRejected(badHull, true, failures);
+
+	spaceshipAnimations[0].clip = 99;
+	Bytes badClip = save();
+	CHECK(load(state, true));
+	expectRejected(badClip, false, failures);
+
+	turretAnimations[0].frame = turretSprite.getFrameCount();
+	Bytes badFrame = save();
+	CHECK(load(state, true));
+	expectRejected(badFrame, false, failures);
+
+	currentPhase = 7;
+	Bytes badPhase = save();
+	CHECK(load(state, true));
+	expectRejected(badPhase, false, failures);
+
+	Entity asteroid = Entity();
+	CHECK(asteroidQuery.findFirst([](Entity, Position&, Rotation&, Scaling&, Velocity&, Asteroid&) { return true; }, asteroid));
+	world.get<Asteroid>(asteroid)->type = 7;
+	Bytes badType = save();
+	CHECK(load(state, true));
+	expectRejected(badType, false, failures);
+
+	Entity powerUp = Entity();
+	if (powerUpQuery.findFirst([](Entity, Position&, PowerUp&) { return true; }, powerUp)) {
+		world.get<PowerUp>(powerUp)->type = -1;
+		Bytes badPowerUp = save();
+		CHECK(load(state, true));
+		expectRejected(badPowerUp, false, failures);
+	}
+	CHECK(failures == 0);
+}
+
+//The game over and the high score it set are part of the state, rolling back to before it takes both back
+static void testGameOverRollsBack(const Bytes& state)
+{
+	int highScoresBefore = highScores;
+	//lose every life at once
+	lives = 1;
+	bool ended = false;
+	for (int i = 0; i < 2000 && !ended; i++) {
+		runTicksWithoutRefill(1);
+		ended = gameOver;
+	}
+	CHECK(ended);
+	CHECK(gameOverTick < gameTick);
+	Bytes over = save();
+	CHECK(load(state, true));
+	CHECK(!gameOver && highScores == highScoresBefore);
+	CHECK(load(over, true));
+	CHECK(gameOver);
+	//a post mortem loaded from a file can be played on
+	CHECK(load(over, false));
+	CHECK(!gameOver);
+	CHECK(load(state, true));
+}
+
+//World data written by hand: columns whose size does not match the component, components this build does not have,
+//an archetype saved twice. None of it may reach the world.
+struct TestA {
+	int value;
+};
+struct TestB {
+	double value;
+};
+
+static void writeArchetype(StateWriter& writer, ComponentMask mask, int id, int elementSize, int rows)
+{
+	writer.write(mask);
+	writer.write(1);
+	writer.write(id);
+	writer.write(elementSize);
+	std::vector<unsigned char> column(rows * elementSize);
+	writer.writeArray(column.data(), (int)column.size());
+	std::vector<Entity> entities(rows);
+	writer.writeArray(entities.data(), rows);
+}
+
+static void testWorldLayout()
+{
+	World testWorld;
+	Entity kept = testWorld.create(TestA{ 42 });
+	StateWriter writer;
+	int idA = ComponentRegistry::id<TestA>();
+	ComponentMask maskA = ComponentRegistry::mask<TestA>();
+
+	//TestA saved with 8 byte elements
+	writer.begin(1);
+	writer.write(1);
+	writeArchetype(writer, maskA, idA, 8, 0);
+	writer.end();
+	StateReader reader;
+	CHECK(reader.begin(writer.getData(), writer.getSize(), 1));
+	CHECK(!testWorld.load(reader));
+
+	//a component id nothing was registered for
+	writer.begin(1);
+	writer.write(1);
+	writeArchetype(writer, ComponentMask(1) << 63, 63, 4, 0);
+	writer.end();
+	CHECK(reader.begin(writer.getData(), writer.getSize(), 1));
+	CHECK(!testWorld.load(reader));
+
+	//the same archetype twice
+	writer.begin(1);
+	writer.write(2);
+	writeArchetype(writer, maskA, idA, sizeof(TestA), 0);
+	writeArchetype(writer, maskA, idA, sizeof(TestA), 0);
+	writer.end();
+	CHECK(reader.begin(writer.getData(), writer.getSize(), 1));
+	CHECK(!testWorld.load(reader));
+
+	//an archetype that is new to this world comes with all of its columns
+	World saved;
+	saved.create(TestA{ 1 }, TestB{ 2 });
+	writer.begin(1);
+	saved.save(writer);
+	writer.end();
+	CHECK(reader.begin(writer.getData(), writer.getSize(), 1));
+	World other;
+	CHECK(other.load(reader) && reader.isFinished());
+	CHECK(other.getEntityCount() == 1);
+
+	CHECK(testWorld.isAlive(kept) && testWorld.get<TestA>(kept)->value == 42 && testWorld.getEntityCount() == 1);
+}
+
+int main()
+{
+	jobSystem->init(1);
+	seedSimulation(36);
+	resetSimulation();
+	runTicks(600);
+	//power ups get their own check
+	spawnPowerUp(Vec2(100, 300), timePowerUp);
+	Bytes state = save();
+	printf("state of %d entities, %d bytes\n", world.getEntityCount(), (int)state.size());
+	CHECK(world.getEntityCount() > 50);
+
+	testRoundTrip(state);
+	testTruncated(state);
+	testDamaged(state);
+	testOutOfRangeValues(state);
+	testGameOverRollsBack(state);
+	testWorldLayout();
+	jobSystem->shutdown();
+	return finishTests("StateBufferTest");
+}
@@ -0,0 +1,148 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "Check.h"
+#include "Telemetry.h"
+
+//The HDR histogram against distributions whose percentiles are known, and the row ring between the game threads and
+//the writer thread: full ring drops and counts, shutdown writes what is still queued
+
+//Buckets are 1/32 of their power of two wide, the reported value is the bucket's upper edge
+const double bucketError = 1.0 / HdrHistogram::subBucketCount;
+
+static void testBuckets()
+{
+	//every value falls between the upper edge of the bucket before its own and the upper edge of its own
+	long long previousIndex = 0;
+	for (long long value = 0; value < (1 << 20); value += 1 + value / 1000) {
+		int index = HdrHistogram::bucketIndex(value);
+		CHECK(index >= previousIndex);
+		CHECK(value < HdrHistogram::bucketUpperEdge(index));
+		CHECK(index == 0 || value >= HdrHistogram::bucketUpperEdge(index - 1));
+		previousIndex = index;
+	}
+	for (int value = 0; value < 2 * HdrHistogram::subBucketCount; value++) {
+		CHECK(HdrHistogram::bucketIndex(value) == value);
+	}
+	CHECK(HdrHistogram::bucketIndex(-5) == 0);
+	CHECK(HdrHistogram::bucketIndex(1LL << 40) == HdrHistogram::bucketCount - 1);
+	CHECK(HdrHistogram::bucketIndex((1LL << 32) - 1) < HdrHistogram::bucketCount);
+}
+
+//Each value from 1us to 100ms once, so the p-th percentile is p% of 100ms
+static void testUniformPercentiles()
+{
+	HdrHistogram histogram;
+	const long long count = 100000;
+	for (long long value = 1; value <= count; value++) {
+		histogram.record(value);
+	}
+	CHECK(histogram.getSampleCount() == count);
+	float percentiles[] = { 1, 10, 50, 90, 95, 99, 99.9f };
+	for (int i = 0; i < 7; i++) {
+		double exact = count * percentiles[i] / 100 / 1000.0;
+		double reported = histogram.percentile(percentiles[i]);
+		//never optimistic, never more than a bucket above
+		CHECK(reported >= exact);
+		CHECK(reported <= exact * (1 + bucketError) + 0.001);
+	}
+	CHECK(histogram.getMax() == 100);
+	CHECK(histogram.getMean() > 49.99f && histogram.getMean() < 50.01f);
+	histogram.reset();
+	CHECK(histogram.getSampleCount() == 0 && histogram.percentile(50) == 0 && histogram.getMax() == 0);
+}
+
+//Frames of 16ms with one 250ms spike in every hundred: p50 and p95 are the frame, p99.5 is the spike
+static void testSpikes()
+{
+	HdrHistogram histogram;
+	for (int i = 0; i < 10000; i++) {
+		histogram.record(i % 100 == 99 ? 250000 : 16000);
+	}
+	printf("frames p50 %.3fms p95 %.3fms p99.5 %.3fms\n", histogram.percentile(50), histogram.percentile(95), histogram.percentile(99.5f));
+	CHECK(histogram.percentile(50) >= 16 && histogram.percentile(50) <= 16 * (1 + bucketError));
+	CHECK(histogram.percentile(95) == histogram.percentile(50));
+	CHECK(histogram.percentile(99.5f) >= 250 && histogram.percentile(99.5f) <= 250 * (1 + bucketError));
+	CHECK(histogram.getMax() == 250);
+}
+
+static int countLines(const char* fileName)
+{
+	std::ifstream file(fileName);
+	std::string line;
+	int lines = 0;
+	while (std::getline(file, line)) {
+		lines++;
+	}
+	return lines;
+}
+
+//The writer waits a minute between flushes, so nothing leaves the ring until shutdown
+static void testFullRing()
+{
+	const char* fileName = "telemetry_test.csv";
+	Telemetry telemetry;
+	CHECK(telemetry.init(fileName, 60000));
+	telemetry.recordFrame(16000);
+	for (int i = 0; i < 600; i++) {
+		telemetry.recordTick(i);
+		telemetry.setGauge(BulletGauge, i);
+		telemetry.endTick();
+	}
+	CHECK(telemetry.getWrittenRows() == 0);
+	CHECK(telemetry.getDroppedRows() == 600 - 512);
+	telemetry.shutdown();
+	CHECK(telemetry.getWrittenRows() == 512);
+	CHECK(countLines(fileName) == 513); //header and the rows
+	//the last row written is the last one that fitted
+	std::ifstream file(fileName);
+	std::string line, last;
+	while (std::getline(file, line)) {
+		last = line;
+	}
+	CHECK(last.compare(0, 4, "512,") == 0);
+	CHECK(last.find(",511,16000,511,") != std::string::npos);
+	file.close();
+	CHECK(telemetry.getTickTime().getSampleCount() == 600);
+	remove(fileName);
+}
+
+//With a short interval the writer keeps up and nothing is dropped
+static void testFlushing()
+{
+	const char* fileName = "telemetry_flush_test.csv";
+	Telemetry telemetry;
+	CHECK(telemetry.init(fileName, 5));
+	for (int i = 0; i < 2000; i++) {
+		telemetry.endTick();
+		if (i % 100 == 99) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+	}
+	for (int i = 0; i < 1000 && telemetry.getWrittenRows() < 2000; i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(telemetry.getWrittenRows() == 2000);
+	CHECK(telemetry.getDroppedRows() == 0);
+	telemetry.shutdown();
+	CHECK(countLines(fileName) == 2001);
+	remove(fileName);
+	//a file that cannot be written leaves the histograms working
+	Telemetry unwritable;
+	CHECK(!unwritable.init("no_such_directory/telemetry.csv", 5));
+	unwritable.recordFrame(1000);
+	CHECK(unwritable.getFrameTime().getSampleCount() == 1);
+	unwritable.shutdown();
+}
+
+int main()
+{
+	testBuckets();
+	testUniformPercentiles();
+	testSpikes();
+	testFullRing();
+	testFlushing();
+	return finishTests("TelemetryTest");
+}
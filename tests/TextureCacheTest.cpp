@@ -0,0 +1,197 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "Check.h"
+#include "TextureCache.h"
+
+//TextureCache with fake textures the size the game's take as A8R8G8B8 with mips, under the game's 3MB budget:
+//the menus' textures are released while the game is shown and come back in the background after it
+
+struct FakeTexture {
+	const char* fileName;
+	long long bytes;
+};
+
+//Sizes of the game's textures, power of two sides with a full mip chain
+static FakeTexture fakeTextures[] = {
+	{ "bg.png", 2796202 },
+	{ "buttonBg.png", 174762 },
+	{ "cursor.png", 5461 },
+	{ "ship.png", 87381 },
+	{ "ship2.png", 87381 },
+	{ "crosshair.png", 5461 },
+	{ "turret.png", 699050 },
+	{ "asteroid.png", 21845 },
+	{ "bullet.png", 2730 },
+	{ "powerup1.png", 21845 },
+};
+const int fakeTextureCount = sizeof(fakeTextures) / sizeof(fakeTextures[0]);
+const long long budget = 3 << 20;
+
+static std::atomic<int> liveTextures{ 0 };
+static std::atomic<int> releasedTextures{ 0 };
+
+//Anything not in the table fails to load, like a missing file
+static void* loadFake(const char* fileName, long long& bytes)
+{
+	for (int i = 0; i < fakeTextureCount; i++) {
+		if (strcmp(fakeTextures[i].fileName, fileName) == 0) {
+			bytes = fakeTextures[i].bytes;
+			liveTextures++;
+			return &fakeTextures[i];
+		}
+	}
+	return NULL;
+}
+
+static void releaseFake(void* texture)
+{
+	CHECK(texture != NULL);
+	liveTextures--;
+	releasedTextures++;
+}
+
+static int assets[fakeTextureCount];
+
+static void drawFrame(TextureCache& cache, const int* drawn, int count)
+{
+	for (int i = 0; i < count; i++) {
+		CHECK(cache.get(assets[drawn[i]]) == &fakeTextures[drawn[i]]);
+	}
+	cache.endFrame();
+}
+
+//Waits for the loader thread, false if it takes more than a second
+static bool waitUntilResident(TextureCache& cache, int asset)
+{
+	for (int i = 0; i < 1000 && !cache.isResident(asset); i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return cache.isResident(asset);
+}
+
+static void testMenuAndGame()
+{
+	TextureCache cache;
+	TextureCallbacks callbacks = { loadFake, releaseFake };
+	cache.init(callbacks, budget);
+	for (int i = 0; i < fakeTextureCount; i++) {
+		assets[i] = cache.add(fakeTextures[i].fileName);
+	}
+	CHECK(cache.add("bg.png") == assets[0]);
+	CHECK(cache.getBudget() == budget);
+
+	const int menu[] = { 0, 1, 2 };
+	const int selection[] = { 0, 1, 2, 3, 5 };
+	const int game[] = { 3, 5, 6, 7, 8, 9 };
+	cache.beginScene("main");
+	drawFrame(cache, menu, 3);
+	cache.beginScene("spaceshipSelection");
+	drawFrame(cache, selection, 5);
+	CHECK(cache.getEvictionCount() == 0);
+	CHECK(cache.getResidentBytes() <= budget);
+
+	//the menu's textures and the game's do not fit together, everything only the menus draw goes
+	cache.beginScene("game");
+	for (int frame = 0; frame < 3; frame++) {
+		drawFrame(cache, game, 6);
+	}
+	printf("game: %lld bytes resident, %d evictions\n", cache.getResidentBytes(), cache.getEvictionCount());
+	CHECK(cache.getResidentBytes() <= budget);
+	CHECK(!cache.isResident(assets[0]));
+	CHECK(cache.getEvictionCount() > 0);
+	for (int i = 0; i < 6; i++) {
+		CHECK(cache.isResident(assets[game[i]]));
+	}
+
+	//back in the menu the background loads again in the background, and the game's textures make room for it
+	int loads = cache.getLoadCount();
+	cache.beginScene("main");
+	CHECK(waitUntilResident(cache, assets[0]));
+	CHECK(waitUntilResident(cache, assets[1]));
+	CHECK(cache.getLoadCount() > loads);
+	drawFrame(cache, menu, 3);
+	CHECK(cache.getResidentBytes() <= budget);
+	CHECK(!cache.isResident(assets[6]));
+
+	CHECK(cache.writeReport("texture_cache_test.csv"));
+	std::ifstream report("texture_cache_test.csv");
+	std::string line;
+	int lines = 0;
+	while (std::getline(report, line)) {
+		lines++;
+	}
+	CHECK(lines == 4); //header and three scenes
+	report.close();
+	remove("texture_cache_test.csv");
+
+	cache.shutdown();
+	CHECK(liveTextures == 0);
+	CHECK(cache.getResidentBytes() == 0);
+}
+
+//Switching to a scene that was shown before releases what it does not draw right away, least recently drawn first,
+//referenced textures and the scene's own stay even over the budget
+static void testSceneChange()
+{
+	TextureCache cache;
+	TextureCallbacks callbacks = { loadFake, releaseFake };
+	cache.init(callbacks, 1 << 20);
+	for (int i = 0; i < fakeTextureCount; i++) {
+		assets[i] = cache.add(fakeTextures[i].fileName);
+	}
+	int missing = cache.add("missing.png");
+	const int small[] = { 3, 7, 8 };
+	const int turret[] = { 6 };
+	cache.beginScene("small");
+	drawFrame(cache, small, 3);
+	cache.beginScene("turret");
+	drawFrame(cache, turret, 1);
+	cache.acquire(assets[5]);
+	CHECK(cache.isResident(assets[5]));
+
+	//the background alone is over the budget, it stays while it is drawn
+	const int background[] = { 0 };
+	cache.beginScene("background");
+	drawFrame(cache, background, 1);
+	CHECK(cache.isResident(assets[0]));
+	CHECK(cache.isResident(assets[5]));
+	CHECK(!cache.isResident(assets[6]) && !cache.isResident(assets[3]));
+
+	//loaded without being drawn, the turret goes as soon as a scene that does not draw it starts
+	cache.load(assets[6]);
+	cache.load(assets[3]);
+	int evictions = cache.getEvictionCount();
+	cache.beginScene("small");
+	CHECK(cache.getEvictionCount() > evictions);
+	CHECK(!cache.isResident(assets[0]) && !cache.isResident(assets[6]));
+	CHECK(cache.isResident(assets[5]));
+	CHECK(cache.isResident(assets[3]));
+	cache.release(assets[5]);
+	CHECK(waitUntilResident(cache, assets[7]) && waitUntilResident(cache, assets[8]));
+
+	//a file that fails to load is tried once
+	int loads = cache.getLoadCount();
+	CHECK(cache.get(missing) == NULL);
+	CHECK(cache.get(missing) == NULL);
+	CHECK(cache.getLoadCount() == loads + 1);
+	CHECK(cache.get(-1) == NULL);
+
+	char overlay[256];
+	cache.formatOverlay(overlay, sizeof(overlay));
+	CHECK(strstr(overlay, "scene small") != NULL);
+	cache.shutdown();
+	CHECK(liveTextures == 0);
+}
+
+int main()
+{
+	testMenuAndGame();
+	testSceneChange();
+	printf("%d textures released\n", (int)releasedTextures);
+	return finishTests("TextureCacheTest");
+}
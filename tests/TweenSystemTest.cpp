@@ -0,0 +1,181 @@
+#include <cmath>
+#include "Check.h"
+#include "TweenSystem.h"
+
+//TweenSystem driven by a fake clock: time only moves by the steps given to update(), so a test can run the same
+//transition at different frame rates and compare where it is at the same moment
+
+const int easingCount = EaseOutBack + 1;
+
+static bool near(float a, float b, float tolerance = 1e-4f)
+{
+	return fabsf(a - b) <= tolerance;
+}
+
+//Steps a system by seconds per frame for frames frames
+static void advance(TweenSystem& tweens, float seconds, int frames)
+{
+	for (int i = 0; i < frames; i++) {
+		tweens.update(seconds);
+	}
+}
+
+static void testEasing()
+{
+	for (int easing = 0; easing < easingCount; easing++) {
+		CHECK(near(TweenSystem::ease(easing, 0), 0));
+		CHECK(near(TweenSystem::ease(easing, 1), 1));
+	}
+	CHECK(near(TweenSystem::ease(EaseInOutQuad, 0.5f), 0.5f));
+	CHECK(near(TweenSystem::ease(EaseInOutCubic, 0.5f), 0.5f));
+	CHECK(TweenSystem::ease(EaseInQuad, 0.25f) < 0.25f);
+	CHECK(TweenSystem::ease(EaseOutQuad, 0.25f) > 0.25f);
+	bool overshoots = false;
+	for (int i = 1; i < 100; i++) {
+		overshoots = overshoots || TweenSystem::ease(EaseOutBack, i / 100.0f) > 1;
+	}
+	CHECK(overshoots);
+}
+
+static void testTween()
+{
+	TweenSystem tweens;
+	float value = -1;
+	TweenHandle tween = tweens.start(&value, 0, 100, 0.5f, Linear);
+	CHECK(value == 0);
+	CHECK(tweens.isActive(tween));
+	advance(tweens, 1 / 32.0f, 8);
+	CHECK(near(value, 50));
+	advance(tweens, 1 / 32.0f, 8);
+	CHECK(value == 100);
+	CHECK(!tweens.isActive(tween));
+	CHECK(tweens.getCount() == 0);
+	//a step far past the end lands exactly on it
+	tweens.start(&value, 100, -20, 0.1f, EaseOutBack);
+	tweens.update(5);
+	CHECK(value == -20);
+}
+
+//The same transition stepped at 32 and 128 frames a second is in the same place at the same time
+static void testFrameRateIndependence()
+{
+	for (int easing = 0; easing < easingCount; easing++) {
+		TweenSystem slow;
+		TweenSystem fast;
+		float slowValue = 0;
+		float fastValue = 0;
+		slow.start(&slowValue, 2000, 0, 0.5f, easing);
+		fast.start(&fastValue, 2000, 0, 0.5f, easing);
+		for (int step = 0; step < 20; step++) {
+			advance(slow, 1 / 32.0f, 1);
+			advance(fast, 1 / 128.0f, 4);
+			CHECK(near(slowValue, fastValue, 0.05f));
+		}
+		CHECK(slowValue == 0 && fastValue == 0);
+	}
+}
+
+//Time past the end of one tween of a sequence carries over to the next
+static void testSequence()
+{
+	TweenSystem slow;
+	TweenSystem fast;
+	float slowValue = 0;
+	float fastValue = 0;
+	TweenHandle slowFirst = slow.start(&slowValue, 0, 10, 0.3f, Linear);
+	slow.then(slow.then(slowFirst, &slowValue, 10, 20, 0.3f, Linear), &slowValue, 20, 0, 0.3f, EaseInQuad);
+	TweenHandle fastFirst = fast.start(&fastValue, 0, 10, 0.3f, Linear);
+	fast.then(fast.then(fastFirst, &fastValue, 10, 20, 0.3f, Linear), &fastValue, 20, 0, 0.3f, EaseInQuad);
+	CHECK(slow.getCount() == 3);
+	advance(slow, 0.125f, 4);
+	advance(fast, 1 / 128.0f, 64);
+	//0.2s into the second tween
+	CHECK(near(slowValue, 10 + 10 * 0.2f / 0.3f, 1e-3f));
+	CHECK(near(fastValue, slowValue, 1e-3f));
+	CHECK(slow.getCount() == 2);
+	advance(slow, 0.125f, 4);
+	advance(fast, 1 / 128.0f, 64);
+	CHECK(slowValue == 0 && fastValue == 0);
+	CHECK(slow.getCount() == 0 && fast.getCount() == 0);
+}
+
+static int completedArgument = 0;
+static int completedCount = 0;
+static float* completedTarget = NULL;
+static float valueAtCompletion = 0;
+static TweenSystem* callbackTweens = NULL;
+
+static void onComplete(int argument)
+{
+	completedArgument = argument;
+	completedCount++;
+	valueAtCompletion = *completedTarget;
+	//a callback may start the next transition, the way a menu slides in the next screen
+	if (argument == 7) {
+		callbackTweens->start(completedTarget, 0, 1, 1, Linear);
+	}
+}
+
+static void testCallbacks()
+{
+	TweenSystem tweens;
+	callbackTweens = &tweens;
+	float value = 0;
+	completedTarget = &value;
+	TweenHandle tween = tweens.start(&value, 5, 9, 0.25f, EaseOutCubic);
+	tweens.setOnComplete(tween, onComplete, 7);
+	advance(tweens, 0.1f, 2);
+	CHECK(completedCount == 0);
+	tweens.update(0.1f);
+	CHECK(completedCount == 1);
+	CHECK(completedArgument == 7);
+	CHECK(valueAtCompletion == 9);
+	//the started tween runs from the next update
+	CHECK(value == 0);
+	CHECK(tweens.getCount() == 1);
+	tweens.update(0.5f);
+	CHECK(near(value, 0.5f));
+	advance(tweens, 0.5f, 4);
+	CHECK(completedCount == 1);
+}
+
+static void testStop()
+{
+	TweenSystem tweens;
+	float value = 0;
+	float other = 0;
+	completedCount = 0;
+	completedTarget = &value;
+	TweenHandle first = tweens.start(&value, 0, 10, 1, Linear);
+	TweenHandle second = tweens.then(first, &value, 10, 0, 1, Linear);
+	tweens.setOnComplete(first, onComplete, 1);
+	tweens.setOnComplete(second, onComplete, 2);
+	tweens.start(&other, 0, 1, 4, Linear);
+	tweens.update(0.5f);
+	tweens.stop(first);
+	CHECK(!tweens.isActive(first) && !tweens.isActive(second));
+	CHECK(tweens.getCount() == 1);
+	advance(tweens, 1, 2);
+	CHECK(near(value, 5));
+	CHECK(completedCount == 0);
+	CHECK(near(other, 0.625f));
+	//following a stopped tween starts at once
+	TweenHandle late = tweens.then(first, &value, 3, 4, 1, Linear);
+	CHECK(value == 3);
+	tweens.update(0.5f);
+	CHECK(near(value, 3.5f));
+	CHECK(tweens.isActive(late));
+	tweens.clear();
+	CHECK(tweens.getCount() == 0 && !tweens.isActive(late));
+}
+
+int main()
+{
+	testEasing();
+	testTween();
+	testFrameRateIndependence();
+	testSequence();
+	testCallbacks();
+	testStop();
+	return finishTests("TweenSystemTest");
+}
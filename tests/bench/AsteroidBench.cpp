@@ -0,0 +1,56 @@
+#include <cstdio>
+#include "Bench.h"
+#include "Simulation.h"
+
+//Headless game ticks with 20k asteroids, the asteroid solver has to stay inside a 60 Hz frame (16.7 ms) on one core.
+//The playfield is widened so that many asteroids fit, at the game's density they would all overlap.
+
+static void spawnAsteroids(int count)
+{
+	RandomStream random;
+	random.seed(31, 1);
+	for (int i = 0; i < count; i++) {
+		int type = random.range(3);
+		float scale = type == smallAsteroid ? 1 : type == mediumAsteroid ? 1.5f : 2;
+		Vec2 position((float)random.range(0, screenWidth), (float)random.range(0, screenHeight));
+		CollisionBounds bounds = {};
+		world.create(Position{ position }, Rotation{ 0 }, Scaling{ Vec2(scale, scale) }, Velocity{ Vec2(random.nextFloat() - 0.5f, random.nextFloat() - 0.5f) },
+			Asteroid{ 3, type }, bounds);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int asteroidCount = quick ? 2000 : 20000;
+	int ticks = quick ? 10 : 120;
+
+	jobSystem->init(1);
+	screenWidth = 16000;
+	screenHeight = 16000;
+	seedSimulation(31);
+	resetSimulation();
+	spawnAsteroids(asteroidCount);
+
+	PlayerInput inputs[maxPlayers] = {};
+	double tickSeconds = 0;
+	double worstTickSeconds = 0;
+	long long solverContacts = 0;
+	long long collisionTotal = 0;
+	for (int tick = 0; tick < ticks; tick++) {
+		lives = 3;
+		double start = benchSeconds();
+		update(1, inputs);
+		double seconds = benchSeconds() - start;
+		tickSeconds += seconds;
+		worstTickSeconds = seconds > worstTickSeconds ? seconds : worstTickSeconds;
+		collisionTotal += collisionMicroseconds;
+		solverContacts += asteroidSolver->getContactCount();
+	}
+	jobSystem->shutdown();
+
+	printf("%d asteroids, %d ticks\n", asteroidQuery.count(), ticks);
+	printf("tick: %.2f ms average, %.2f ms worst (60 Hz budget 16.7 ms)\n", tickSeconds * 1000 / ticks, worstTickSeconds * 1000);
+	printf("collisions (solver, bounds, bullets): %.2f ms average, %lld contacts per tick\n", collisionTotal / 1000.0 / ticks, solverContacts / ticks);
+	return 0;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <chrono>
+#include <cstring>
+
+//Helpers shared by the benchmarks
+
+inline double benchSeconds()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-quick shrinks the counts so ctest only checks that the benchmark still runs
+inline bool benchQuick(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-quick") == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//Keeps the optimiser from dropping work whose result is never used
+template <typename T>
+inline void benchKeep(const T& value)
+{
+	asm volatile("" : : "g"(&value) : "memory");
+}
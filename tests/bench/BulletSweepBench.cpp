@@ -0,0 +1,58 @@
+#include <cstdio>
+#include "Bench.h"
+#include "Simulation.h"
+
+//Cost of the swept bullet test at 10k bullets against the discrete one.
+//Every bullet misses (asteroids above, bullets below flying up), so each one is tested against every asteroid,
+//the worst case for both tests. collisionMicroseconds also covers the asteroid solver and bounds, which are the
+//same in both runs.
+
+static void buildScene(int bulletCount, int asteroidCount)
+{
+	resetSimulation();
+	RandomStream random;
+	random.seed(32, 1);
+	for (int i = 0; i < asteroidCount; i++) {
+		int type = random.range(3);
+		float scale = type == smallAsteroid ? 1 : type == mediumAsteroid ? 1.5f : 2;
+		CollisionBounds bounds = {};
+		world.create(Position{ Vec2((float)random.range(0, screenWidth - 120), (float)random.range(0, 250)) }, Rotation{ 0 }, Scaling{ Vec2(scale, scale) },
+			Velocity{ Vec2(0, 0) }, Asteroid{ 3, type }, bounds);
+	}
+	for (int i = 0; i < bulletCount; i++) {
+		world.create(Position{ Vec2((float)random.range(0, screenWidth), (float)random.range(500, screenHeight)) }, Rotation{ 0 }, Bullet());
+	}
+}
+
+static double measureCollisions(int bulletCount, int asteroidCount, float sweepThreshold, int ticks)
+{
+	bulletSweepThreshold = sweepThreshold;
+	PlayerInput inputs[maxPlayers] = {};
+	long long microseconds = 0;
+	for (int tick = 0; tick < ticks; tick++) {
+		buildScene(bulletCount, asteroidCount);
+		update(1, inputs);
+		microseconds += collisionMicroseconds;
+	}
+	return microseconds / 1000.0 / ticks;
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int bulletCount = quick ? 1000 : 10000;
+	int asteroidCounts[] = { 50, 200 };
+	int ticks = quick ? 3 : 30;
+
+	jobSystem->init(1);
+	seedSimulation(32);
+	printf("%d bullets, bulletPower %.0f, collision ms per tick\n", bulletCount, tuning.bulletPower);
+	printf("asteroids  discrete   swept  overhead\n");
+	for (int asteroidCount : asteroidCounts) {
+		double discrete = measureCollisions(bulletCount, asteroidCount, 1e9f, ticks);
+		double swept = measureCollisions(bulletCount, asteroidCount, 0, ticks);
+		printf("%9d  %8.2f  %6.2f  %7.2fx\n", asteroidCount, discrete, swept, swept / discrete);
+	}
+	jobSystem->shutdown();
+	return 0;
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <vector>
+#include "../MaskCorpus.h"
+#include "Bench.h"
+#include "RandomStream.h"
+
+//Mask tests per second on the test corpus, for placements whose boxes overlap (the only ones the game tests).
+//The pixel by pixel test is the reference the word-wise test replaces.
+
+struct Placement {
+	const CollisionMask* a;
+	const CollisionMask* b;
+	int bx;
+	int by;
+};
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int placementCount = quick ? 2000 : 100000;
+	int rounds = quick ? 1 : 20;
+	const float scales[] = { 1, 1.5f, 2 };
+
+	std::vector<MaskShape> corpus = makeMaskCorpus();
+	std::vector<CollisionMaskSet> sets(corpus.size());
+	for (size_t i = 0; i < corpus.size(); i++) {
+		sets[i].build(corpus[i].alpha.data(), corpus[i].width, 0, 0, corpus[i].width, corpus[i].height, scales, 3, 16,
+			corpus[i].width / 2.0f, corpus[i].height / 2.0f, 128);
+	}
+
+	RandomStream random;
+	random.seed(33, 2);
+	std::vector<Placement> placements(placementCount);
+	for (Placement& placement : placements) {
+		placement.a = &sets[random.range((uint32_t)sets.size())].get(random.range(3), random.nextFloat() * 6.2831853f);
+		placement.b = &sets[random.range((uint32_t)sets.size())].get(random.range(3), random.nextFloat() * 6.2831853f);
+		placement.bx = random.range(-placement.b->getWidth() + 1, placement.a->getWidth());
+		placement.by = random.range(-placement.b->getHeight() + 1, placement.a->getHeight());
+	}
+
+	int hits = 0;
+	double start = benchSeconds();
+	for (int round = 0; round < rounds; round++) {
+		for (const Placement& placement : placements) {
+			hits += CollisionMask::overlaps(*placement.a, 0, 0, *placement.b, placement.bx, placement.by) ? 1 : 0;
+		}
+	}
+	double maskSeconds = benchSeconds() - start;
+
+	int pixelHits = 0;
+	start = benchSeconds();
+	for (const Placement& placement : placements) {
+		pixelHits += overlapsByPixel(*placement.a, 0, 0, *placement.b, placement.bx, placement.by) ? 1 : 0;
+	}
+	double pixelSeconds = benchSeconds() - start;
+	benchKeep(hits);
+	benchKeep(pixelHits);
+
+	double maskTests = (double)placementCount * rounds;
+	printf("%d placements with overlapping boxes, %.0f%% of them touching\n", placementCount, 100.0 * pixelHits / placementCount);
+	printf("word-wise:      %6.1f M tests/s (%.0f ns per test)\n", maskTests / maskSeconds / 1e6, maskSeconds * 1e9 / maskTests);
+	printf("pixel by pixel: %6.3f M tests/s (%.0f ns per test)\n", placementCount / pixelSeconds / 1e6, pixelSeconds * 1e9 / placementCount);
+	return 0;
+}
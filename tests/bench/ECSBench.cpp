@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <vector>
+#include "Bench.h"
+#include "ECS.h"
+#include "Math2D.h"
+
+//Asteroid movement over the ECS against the arrays it replaced.
+//The old layout was one SpriteTransform per entity (matrix, transform parameters, asteroid hp and type, power up type
+//and velocity in one object) in a fixed array with an entry counter, removal shifted every later entry down a slot.
+//Both versions move every asteroid each tick, then destroy and respawn churn percent of them.
+
+struct OldSpriteTransform {
+	float matrix[16];
+	Vec2 scalingCenter;
+	float scalingRotation;
+	Vec2 scaling;
+	Vec2 rotationCenter;
+	float rotation;
+	Vec2 trans;
+	int powerUpChosen;
+	int asteroidHp;
+	int asteroidChosen;
+	Vec2 asteroidVelocity;
+};
+
+struct Position {
+	Vec2 value;
+};
+struct Rotation {
+	float value;
+};
+struct Scaling {
+	Vec2 value;
+};
+struct Velocity {
+	Vec2 value;
+};
+struct Asteroid {
+	int hp;
+	int type;
+};
+
+static const int churnPercent = 2;
+
+struct BenchResult {
+	double moveSeconds;
+	double churnSeconds;
+};
+
+static BenchResult runOldArrays(int count, int ticks)
+{
+	std::vector<OldSpriteTransform> asteroidTrans(count);
+	int asteroidEntry = 0;
+	for (int i = 0; i < count; i++) {
+		OldSpriteTransform& asteroid = asteroidTrans[asteroidEntry++];
+		asteroid.trans = Vec2((float)(i % 1280), 0);
+		asteroid.asteroidVelocity = Vec2(0, 1.5f);
+		asteroid.rotation = 0;
+	}
+	BenchResult result = { 0, 0 };
+	for (int tick = 0; tick < ticks; tick++) {
+		double start = benchSeconds();
+		for (int i = 0; i < asteroidEntry; i++) {
+			asteroidTrans[i].trans += asteroidTrans[i].asteroidVelocity;
+			asteroidTrans[i].rotation += 0.01f;
+		}
+		double moved = benchSeconds();
+		int removals = count * churnPercent / 100;
+		for (int removal = 0; removal < removals; removal++) {
+			int removedIndex = (tick * 7919 + removal * 104729) % asteroidEntry;
+			for (int i = removedIndex; i < asteroidEntry - 1; i++) {
+				asteroidTrans[i] = asteroidTrans[i + 1];
+			}
+			asteroidEntry--;
+		}
+		while (asteroidEntry < count) {
+			OldSpriteTransform& asteroid = asteroidTrans[asteroidEntry++];
+			asteroid.trans = Vec2((float)(asteroidEntry % 1280), 0);
+			asteroid.asteroidVelocity = Vec2(0, 1.5f);
+		}
+		result.moveSeconds += moved - start;
+		result.churnSeconds += benchSeconds() - moved;
+	}
+	benchKeep(asteroidTrans[count / 2].trans);
+	return result;
+}
+
+static BenchResult runECS(int count, int ticks)
+{
+	World world;
+	Query<Position, Rotation, Velocity> moveQuery(world);
+	std::vector<Entity> entities;
+	for (int i = 0; i < count; i++) {
+		entities.push_back(world.create(Position{ Vec2((float)(i % 1280), 0) }, Rotation{ 0 }, Scaling{ Vec2(1, 1) }, Velocity{ Vec2(0, 1.5f) }, Asteroid{ 3, 0 }));
+	}
+	BenchResult result = { 0, 0 };
+	for (int tick = 0; tick < ticks; tick++) {
+		double start = benchSeconds();
+		moveQuery.forEach([](Entity, Position& position, Rotation& rotation, Velocity& velocity) {
+			position.value += velocity.value;
+			rotation.value += 0.01f;
+		});
+		double moved = benchSeconds();
+		int removals = count * churnPercent / 100;
+		for (int removal = 0; removal < removals; removal++) {
+			int removedIndex = (tick * 7919 + removal * 104729) % (int)entities.size();
+			world.destroy(entities[removedIndex]);
+			entities[removedIndex] = entities.back();
+			entities.pop_back();
+		}
+		while ((int)entities.size() < count) {
+			entities.push_back(world.create(Position{ Vec2((float)(entities.size() % 1280), 0) }, Rotation{ 0 }, Scaling{ Vec2(1, 1) }, Velocity{ Vec2(0, 1.5f) }, Asteroid{ 3, 0 }));
+		}
+		result.moveSeconds += moved - start;
+		result.churnSeconds += benchSeconds() - moved;
+	}
+	benchKeep(world.get<Position>(entities[0])->value);
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int counts[] = { 200, 2000, 20000 };
+	int countCount = quick ? 2 : 3;
+	int ticks = quick ? 20 : 500;
+
+	printf("asteroid move + %d%% churn per tick, %d ticks\n", churnPercent, ticks);
+	printf("ns per entity and tick    move (old / ECS)    churn (old / ECS)\n");
+	for (int i = 0; i < countCount; i++) {
+		int count = counts[i];
+		BenchResult old = runOldArrays(count, ticks);
+		BenchResult ecs = runECS(count, ticks);
+		double nanoseconds = 1e9 / ((double)count * ticks);
+		printf("%8d entities    %6.2f / %6.2f     %8.2f / %6.2f\n", count, old.moveSeconds * nanoseconds, ecs.moveSeconds * nanoseconds,
+			old.churnSeconds * nanoseconds, ecs.churnSeconds * nanoseconds);
+	}
+	return 0;
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "Bench.h"
+#include "JobSystem.h"
+
+//Scaling of a simulation-like tick over 100k entities with 1 to 16 threads.
+//A tick integrates positions in parallel, then (as a continuation, without a wait in between) rebuilds bounds.
+//1 thread is the plain loop, N threads are N - 1 workers plus the submitting thread helping while it waits.
+
+struct Body {
+	float x, y;
+	float velocityX, velocityY;
+	float left, top, right, bottom;
+};
+
+static std::vector<Body> bodies;
+static const float tickSeconds = 1.0f / 60;
+
+static void integrate(void*, int begin, int end)
+{
+	for (int i = begin; i < end; i++) {
+		Body& body = bodies[i];
+		//a little more than a move so the work per entity is closer to the game's systems
+		body.velocityX += std::sin(body.y * 0.01f) * 0.1f;
+		body.velocityY += std::cos(body.x * 0.01f) * 0.1f;
+		body.x += body.velocityX * tickSeconds;
+		body.y += body.velocityY * tickSeconds;
+	}
+}
+
+static void buildBounds(void*, int begin, int end)
+{
+	for (int i = begin; i < end; i++) {
+		Body& body = bodies[i];
+		body.left = body.x - 16;
+		body.top = body.y - 16;
+		body.right = body.x + 16;
+		body.bottom = body.y + 16;
+	}
+}
+
+static void resetBodies(int count)
+{
+	bodies.resize(count);
+	for (int i = 0; i < count; i++) {
+		bodies[i] = Body{ (float)(i % 1000), (float)(i / 1000), 1, 1, 0, 0, 0, 0 };
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int entityCount = quick ? 10000 : 100000;
+	int ticks = quick ? 20 : 500;
+	int grainSize = 1024;
+	int maxThreads = quick ? 4 : 16;
+
+	printf("%d entities, %d ticks, grain %d\n", entityCount, ticks, grainSize);
+	printf("threads  ms/tick  ticks/s  speedup\n");
+	double singleThreadSeconds = 0;
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		resetBodies(entityCount);
+		JobSystem jobs;
+		if (threads > 1) {
+			jobs.init(threads - 1);
+		}
+		double start = benchSeconds();
+		for (int tick = 0; tick < ticks; tick++) {
+			if (threads == 1) {
+				integrate(NULL, 0, entityCount);
+				buildBounds(NULL, 0, entityCount);
+				continue;
+			}
+			JobCounter integrated;
+			JobCounter bounded;
+			for (int begin = 0; begin < entityCount; begin += grainSize) {
+				int end = begin + grainSize < entityCount ? begin + grainSize : entityCount;
+				jobs.run(integrate, NULL, begin, end, integrated);
+				jobs.runAfter(integrated, buildBounds, NULL, begin, end, bounded);
+			}
+			jobs.wait(bounded);
+		}
+		double seconds = benchSeconds() - start;
+		jobs.shutdown();
+		if (threads == 1) {
+			singleThreadSeconds = seconds;
+		}
+		benchKeep(bodies[entityCount / 2].left);
+		printf("%7d  %7.3f  %7.0f  %6.2fx\n", threads, seconds * 1000 / ticks, ticks / seconds, singleThreadSeconds / seconds);
+	}
+	return 0;
+}
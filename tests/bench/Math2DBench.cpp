@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <vector>
+#include "Bench.h"
+#include "Math2D.h"
+#include "RandomStream.h"
+
+//World matrices for sprites scaled and rotated about their center, the snapshot builds one per bullet, asteroid and
+//power up every tick. The batched kernel against transformation2D (the general D3DXMatrixTransformation2D
+//replacement) and a chain of matrix products with std::sin and std::cos.
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int spriteCount = quick ? 1000 : 100000;
+	int rounds = quick ? 3 : 50;
+
+	RandomStream random;
+	random.seed(46, 1);
+	std::vector<float> x(spriteCount), y(spriteCount), rotation(spriteCount), scaleX(spriteCount), scaleY(spriteCount);
+	for (int i = 0; i < spriteCount; i++) {
+		x[i] = random.nextFloat() * 1280;
+		y[i] = random.nextFloat() * 720;
+		rotation[i] = random.nextFloat() * 100 - 50;
+		scaleX[i] = 0.5f + random.nextFloat();
+		scaleY[i] = scaleX[i];
+	}
+	std::vector<Mat3x2> matrices(spriteCount);
+	const float center = 35;
+	double perSprite = 1e9 / ((double)spriteCount * rounds);
+
+	double start = benchSeconds();
+	for (int round = 0; round < rounds; round++) {
+		buildSpriteMatrices(spriteCount, x.data(), y.data(), rotation.data(), scaleX.data(), scaleY.data(), center, center, matrices.data());
+		benchKeep(matrices[round % spriteCount]);
+	}
+	double batched = benchSeconds() - start;
+
+	start = benchSeconds();
+	for (int round = 0; round < rounds; round++) {
+		for (int i = 0; i < spriteCount; i++) {
+			matrices[i] = transformation2D(Vec2(center, center), 0, Vec2(scaleX[i], scaleY[i]), Vec2(center, center), rotation[i], Vec2(x[i], y[i]));
+		}
+		benchKeep(matrices[round % spriteCount]);
+	}
+	double general = benchSeconds() - start;
+
+	start = benchSeconds();
+	for (int round = 0; round < rounds; round++) {
+		for (int i = 0; i < spriteCount; i++) {
+			matrices[i] = translation2D(-center, -center) * scaling2D(scaleX[i], scaleY[i]) * rotation2D(rotation[i]) * translation2D(center + x[i], center + y[i]);
+		}
+		benchKeep(matrices[round % spriteCount]);
+	}
+	double chain = benchSeconds() - start;
+
+	printf("%d sprites, %d rounds, ns per sprite\n", spriteCount, rounds);
+	printf("buildSpriteMatrices  %6.2f\n", batched * perSprite);
+	printf("transformation2D     %6.2f\n", general * perSprite);
+	printf("product chain        %6.2f\n", chain * perSprite);
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <vector>
+#include "Bench.h"
+#include "ParticleSystem.h"
+
+//The particle update kernel with 200k live particles, it has to fit a 60 Hz frame (16.7 ms) on one core.
+//Steady: every particle outlives the run, so update() is integration plus a compaction pass with nothing to remove.
+//Churn: particles live 30 to 90 ticks and bursts refill the system every tick, like a busy fight.
+
+static const float pi = 3.142f;
+
+static double runTicks(ParticleSystem& particles, const ParticleEmitter& emitter, int targetCount, int ticks, RandomStream& random,
+	double& updateSeconds, double& copySeconds)
+{
+	std::vector<ParticleSprite> sprites(particles.getCapacity());
+	updateSeconds = 0;
+	copySeconds = 0;
+	double emitSeconds = 0;
+	for (int tick = 0; tick < ticks; tick++) {
+		double start = benchSeconds();
+		while (particles.getCount() + emitter.count <= targetCount) {
+			particles.emit(emitter, (float)random.range(0, 1280), (float)random.range(0, 720), random.nextFloat() * 2 * pi, random);
+		}
+		double emitted = benchSeconds();
+		particles.update(1);
+		double updated = benchSeconds();
+		int copied = particles.copySprites(sprites.data(), (int)sprites.size());
+		double copiedEnd = benchSeconds();
+		benchKeep(sprites[copied / 2]);
+		emitSeconds += emitted - start;
+		updateSeconds += updated - emitted;
+		copySeconds += copiedEnd - updated;
+	}
+	return emitSeconds;
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int particleCount = quick ? 20000 : 200000;
+	int ticks = quick ? 20 : 300;
+
+	RandomStream random;
+	random.seed(35, 1);
+	ParticleEmitter steadyEmitter = { 100, 1, 5, 2 * pi, 1e9f, 1e9f, 0.02f, 2, 5, 0xffffc850, 0x0078280a };
+	ParticleEmitter churnEmitter = { 40, 1, 5, 2 * pi, 30, 90, 0.06f, 2, 5, 0xffffc850, 0x0078280a };
+	const ParticleEmitter* emitters[] = { &steadyEmitter, &churnEmitter };
+	const char* names[] = { "steady", "churn" };
+
+	printf("%d particles, %d ticks, ms per tick (60 Hz budget 16.7 ms)\n", particleCount, ticks);
+	printf("          update  ns/particle  copySprites  emit\n");
+	for (int i = 0; i < 2; i++) {
+		ParticleSystem particles;
+		particles.init(particleCount);
+		double updateSeconds;
+		double copySeconds;
+		double emitSeconds = runTicks(particles, *emitters[i], particleCount, ticks, random, updateSeconds, copySeconds);
+		printf("%-8s  %6.3f  %11.2f  %11.3f  %5.3f\n", names[i], updateSeconds * 1000 / ticks, updateSeconds * 1e9 / ticks / particleCount,
+			copySeconds * 1000 / ticks, emitSeconds * 1000 / ticks);
+	}
+	return 0;
+}
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "Bench.h"
+#include "Simulation.h"
+#include "StressTest.h"
+
+//A rollback of the whole window: load the state 8 ticks back and run the 8 ticks again, saving the state before each
+//one, as RollbackSession::rollback does when a late input turns out wrong. It has to stay under 2 ms so a rollback
+//fits in a tick. Measured on a two player game after a minute of play, and with 300 more asteroids, about ten times
+//what a wave has on screen.
+//Returns non zero if the median is over the target.
+
+static const int rollbackTicks = 8;
+static const double targetMilliseconds = 2;
+
+static double resimulationMilliseconds(int rounds)
+{
+	StateWriter start;
+	saveGameState(start);
+	std::vector<StateWriter> states(rollbackTicks);
+	PlayerInput inputs[maxPlayers] = {};
+	std::vector<double> times;
+	replayingTicks = true;
+	for (int round = 0; round < rounds; round++) {
+		double begin = benchSeconds();
+		loadGameState(start.getData(), start.getSize(), true);
+		for (int tick = 0; tick < rollbackTicks; tick++) {
+			saveGameState(states[tick]);
+			lives = 3;
+			advanceTick(inputs);
+		}
+		times.push_back(benchSeconds() - begin);
+	}
+	replayingTicks = false;
+	loadGameState(start.getData(), start.getSize(), true);
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2] * 1000;
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int rounds = quick ? 5 : 200;
+	int extraAsteroids = quick ? 100 : 300;
+
+	particleSystem->init(maxParticles);
+	asteroidSolver->reserve(asteroidSolverBodies, asteroidSolverContacts, asteroidSolverCells);
+	jobSystem->init(0);
+	playerCount = 2;
+	seedSimulation(37);
+	resetSimulation();
+	Autopilot autopilot;
+	for (int i = 0; i < 3000; i++) {
+		PlayerInput inputs[maxPlayers] = { autopilot.next(screenWidth, screenHeight), autopilot.next(screenWidth, screenHeight) };
+		lives = 3;
+		advanceTick(inputs);
+	}
+	int entities = world.getEntityCount();
+	double game = resimulationMilliseconds(rounds);
+
+	RandomStream random;
+	random.seed(37, 1);
+	for (int i = 0; i < extraAsteroids; i++) {
+		CollisionBounds bounds = {};
+		world.create(Position{ Vec2((float)random.range(0, screenWidth), (float)random.range(0, screenHeight)) }, Rotation{ 0 }, Scaling{ Vec2(1, 1) },
+			Velocity{ Vec2(random.nextFloat() - 0.5f, random.nextFloat()) }, Asteroid{ 3, smallAsteroid }, bounds);
+	}
+	double wave = resimulationMilliseconds(rounds);
+	jobSystem->shutdown();
+
+	printf("%d ticks resimulated, median ms (target %.0f ms)\n", rollbackTicks, targetMilliseconds);
+	printf("game, %5d entities   %6.3f\n", entities, game);
+	printf("wave, %5d entities   %6.3f\n", world.getEntityCount(), wave);
+	if (game > targetMilliseconds || wave > targetMilliseconds) {
+		printf("over the target\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+#include "Bench.h"
+#include "RandomStream.h"
+#include "SlotMap.h"
+
+//SlotMap against std::unordered_map keyed by an id and against the shift-compacted arrays the game used before
+//(values in spawn order, erase shifts every later value down, so a lookup by id is a binary search).
+//Each round erases a random tenth of the live values, inserts as many, and looks every live value up once.
+
+struct Payload {
+	float x, y, velocityX, velocityY;
+	int hp, type;
+};
+
+struct CompactedEntry {
+	uint32_t id;
+	Payload value;
+};
+
+struct Timing {
+	double insert;
+	double erase;
+	double lookup;
+	double iterate;
+};
+
+static int rounds = 200; //fewer for the largest count, shifting 100k values is slow
+
+static Payload makePayload(int i)
+{
+	return Payload{ (float)i, 0, 1, 1, 3, i % 3 };
+}
+
+static Timing runSlotMap(int count, uint32_t seed)
+{
+	RandomStream random;
+	random.seed(seed, 1);
+	SlotMap<Payload> map;
+	std::vector<SlotHandle> handles;
+	for (int i = 0; i < count; i++) {
+		handles.push_back(map.insert(makePayload(i)));
+	}
+	Timing timing = {};
+	float sum = 0;
+	for (int round = 0; round < rounds; round++) {
+		double start = benchSeconds();
+		for (int i = 0; i < count / 10; i++) {
+			int index = random.range((uint32_t)handles.size());
+			map.erase(handles[index]);
+			handles[index] = handles.back();
+			handles.pop_back();
+		}
+		double erased = benchSeconds();
+		for (int i = 0; i < count / 10; i++) {
+			handles.push_back(map.insert(makePayload(i)));
+		}
+		double inserted = benchSeconds();
+		for (const SlotHandle& handle : handles) {
+			sum += map.get(handle)->x;
+		}
+		double looked = benchSeconds();
+		for (Payload& value : map) {
+			value.x += value.velocityX;
+		}
+		double iterated = benchSeconds();
+		timing.erase += erased - start;
+		timing.insert += inserted - erased;
+		timing.lookup += looked - inserted;
+		timing.iterate += iterated - looked;
+	}
+	benchKeep(sum);
+	return timing;
+}
+
+static Timing runUnorderedMap(int count, uint32_t seed)
+{
+	RandomStream random;
+	random.seed(seed, 1);
+	std::unordered_map<uint32_t, Payload> map;
+	std::vector<uint32_t> ids;
+	uint32_t nextId = 0;
+	for (int i = 0; i < count; i++) {
+		map[nextId] = makePayload(i);
+		ids.push_back(nextId++);
+	}
+	Timing timing = {};
+	float sum = 0;
+	for (int round = 0; round < rounds; round++) {
+		double start = benchSeconds();
+		for (int i = 0; i < count / 10; i++) {
+			int index = random.range((uint32_t)ids.size());
+			map.erase(ids[index]);
+			ids[index] = ids.back();
+			ids.pop_back();
+		}
+		double erased = benchSeconds();
+		for (int i = 0; i < count / 10; i++) {
+			map[nextId] = makePayload(i);
+			ids.push_back(nextId++);
+		}
+		double inserted = benchSeconds();
+		for (uint32_t id : ids) {
+			sum += map.find(id)->second.x;
+		}
+		double looked = benchSeconds();
+		for (auto& entry : map) {
+			entry.second.x += entry.second.velocityX;
+		}
+		double iterated = benchSeconds();
+		timing.erase += erased - start;
+		timing.insert += inserted - erased;
+		timing.lookup += looked - inserted;
+		timing.iterate += iterated - looked;
+	}
+	benchKeep(sum);
+	return timing;
+}
+
+static bool entryBefore(const CompactedEntry& entry, uint32_t id)
+{
+	return entry.id < id;
+}
+
+static CompactedEntry* findCompacted(std::vector<CompactedEntry>& entries, int entryCount, uint32_t id)
+{
+	CompactedEntry* found = std::lower_bound(entries.data(), entries.data() + entryCount, id, entryBefore);
+	return found != entries.data() + entryCount && found->id == id ? found : NULL;
+}
+
+static Timing runShiftCompaction(int count, uint32_t seed)
+{
+	RandomStream random;
+	random.seed(seed, 1);
+	//sized once like the old fixed arrays
+	std::vector<CompactedEntry> entries(count);
+	int entryCount = 0;
+	std::vector<uint32_t> ids;
+	uint32_t nextId = 0;
+	for (int i = 0; i < count; i++) {
+		entries[entryCount++] = CompactedEntry{ nextId, makePayload(i) };
+		ids.push_back(nextId++);
+	}
+	Timing timing = {};
+	float sum = 0;
+	for (int round = 0; round < rounds; round++) {
+		double start = benchSeconds();
+		for (int i = 0; i < count / 10; i++) {
+			int index = random.range((uint32_t)ids.size());
+			int removedIndex = (int)(findCompacted(entries, entryCount, ids[index]) - entries.data());
+			for (int j = removedIndex; j < entryCount - 1; j++) {
+				entries[j] = entries[j + 1];
+			}
+			entryCount--;
+			ids[index] = ids.back();
+			ids.pop_back();
+		}
+		double erased = benchSeconds();
+		for (int i = 0; i < count / 10; i++) {
+			entries[entryCount++] = CompactedEntry{ nextId, makePayload(i) };
+			ids.push_back(nextId++);
+		}
+		double inserted = benchSeconds();
+		for (uint32_t id : ids) {
+			sum += findCompacted(entries, entryCount, id)->value.x;
+		}
+		double looked = benchSeconds();
+		for (int i = 0; i < entryCount; i++) {
+			entries[i].value.x += entries[i].value.velocityX;
+		}
+		double iterated = benchSeconds();
+		timing.erase += erased - start;
+		timing.insert += inserted - erased;
+		timing.lookup += looked - inserted;
+		timing.iterate += iterated - looked;
+	}
+	benchKeep(sum);
+	return timing;
+}
+
+static void printTiming(const char* name, const Timing& timing, int count)
+{
+	double changes = (double)(count / 10) * rounds;
+	double visits = (double)count * rounds;
+	printf("  %-16s  %8.1f  %8.1f  %8.1f  %8.2f\n", name, timing.insert * 1e9 / changes, timing.erase * 1e9 / changes,
+		timing.lookup * 1e9 / visits, timing.iterate * 1e9 / visits);
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int counts[] = { 200, 10000, 100000 };
+	int countCount = quick ? 1 : 3;
+	printf("ns per operation, rounds of 10%% churn\n");
+	for (int i = 0; i < countCount; i++) {
+		int count = counts[i];
+		rounds = count > 10000 ? 10 : 200;
+		printf("%d values, %d rounds  insert     erase    lookup   iterate\n", count, rounds);
+		printTiming("SlotMap", runSlotMap(count, 34), count);
+		printTiming("unordered_map", runUnorderedMap(count, 34), count);
+		printTiming("shift-compaction", runShiftCompaction(count, 34), count);
+	}
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "Bench.h"
+#include "Simulation.h"
+
+//Saving and loading the game state with 10k entities, each has to stay under 50 us so a rollback of several ticks
+//fits in a frame. Trusted loads are what the rollback session does, untrusted ones check every record and component.
+//Returns non zero if saving or a trusted load is over the target.
+
+static const double targetMicroseconds = 50;
+
+//The median call, one slow call (the machine doing something else) does not fail the benchmark
+static double median(std::vector<double> times)
+{
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+int main(int argc, char** argv)
+{
+	bool quick = benchQuick(argc, argv);
+	int iterations = quick ? 20 : 2000;
+
+	resetSimulation();
+	RandomStream random;
+	random.seed(36, 2);
+	for (int i = 0; i < 5000; i++) {
+		CollisionBounds bounds = {};
+		world.create(Position{ Vec2((float)random.range(0, 1280), (float)random.range(0, 720)) }, Rotation{ 0 }, Scaling{ Vec2(1, 1) },
+			Velocity{ Vec2(0, 0) }, Asteroid{ 3, (int)random.range(3) }, bounds);
+		world.create(Position{ Vec2((float)random.range(0, 1280), (float)random.range(0, 720)) }, Rotation{ 0 }, Bullet());
+	}
+	//holes in the entity records, like after a few waves
+	for (int i = 0; i < 200; i++) {
+		world.create(Position{ Vec2(0, 0) }, PowerUp{ hpPowerUp, i });
+	}
+	Entity powerUp = Entity();
+	while (powerUpQuery.findFirst([](Entity, Position&, PowerUp&) { return true; }, powerUp)) {
+		world.destroy(powerUp);
+	}
+
+	StateWriter writer;
+	saveGameState(writer);
+	std::vector<double> saveTimes, trustedTimes, untrustedTimes;
+	for (int i = 0; i < iterations; i++) {
+		double start = benchSeconds();
+		saveGameState(writer);
+		saveTimes.push_back(benchSeconds() - start);
+	}
+	std::vector<unsigned char> state(writer.getData(), writer.getData() + writer.getSize());
+
+	bool loaded = true;
+	for (int i = 0; i < iterations; i++) {
+		double start = benchSeconds();
+		loaded = loadGameState(state.data(), state.size(), true) && loaded;
+		trustedTimes.push_back(benchSeconds() - start);
+	}
+	for (int i = 0; i < iterations; i++) {
+		double start = benchSeconds();
+		loaded = loadGameState(state.data(), state.size(), false) && loaded;
+		untrustedTimes.push_back(benchSeconds() - start);
+	}
+	if (!loaded) {
+		printf("the state did not load\n");
+		return 1;
+	}
+
+	double save = median(saveTimes) * 1e6;
+	double trusted = median(trustedTimes) * 1e6;
+	printf("%d entities, %d bytes, median us per call (target %.0f us)\n", world.getEntityCount(), (int)state.size(), targetMicroseconds);
+	printf("save            %7.1f\n", save);
+	printf("load trusted    %7.1f\n", trusted);
+	printf("load untrusted  %7.1f\n", median(untrustedTimes) * 1e6);
+	//untrusted loads are for files and are allowed to take longer
+	if (save > targetMicroseconds || trusted > targetMicroseconds) {
+		printf("over the target\n");
+		return 1;
+	}
+	return 0;
+}